@@ -2,8 +2,10 @@
 
 #include "FlecsComponentHitSubsystem.h"
 
+#include "Algo/BinarySearch.h"
 #include "FlecsAgentComponent.h"
 #include "FlecsAgentSubsystem.h"
+#include "FlecsEntitySubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "FlecsSignals/Public/FlecsSignalSubsystem.h"
 #include "FlecsSimulationSubsystem.h"
@@ -24,15 +26,34 @@ namespace UE::FlecsComponentHit
 	};
 }
 
+namespace UE::FlecsComponentHit::Private
+{
+	// If new hit result comes during this duration, it will be merged to existing one.
+	constexpr double HitResultMergeDuration = 1.;
+	// Duration after the last filtered hit after which the hit result gets removed from the entity.
+	constexpr double HitResultDecayDuration = 1.;
+
+	FFlecsEntityView GetAgentEntity(const AActor* Actor)
+	{
+		const UFlecsAgentComponent* AgentComponent = Actor ? Actor->FindComponentByClass<UFlecsAgentComponent>() : nullptr;
+		return AgentComponent ? AgentComponent->GetEntityView() : FFlecsEntityView();
+	}
+
+	flecs::entity MakeMutable(const FFlecsEntityView Entity)
+	{
+		return flecs::entity(Entity.GetRawWorld(), Entity.GetRawId());
+	}
+}
+
 const FFlecsHitResult* UFlecsComponentHitSubsystem::GetLastHit(const FFlecsEntityView Entity) const
 {
-	return HitResults.Find(Entity);
+	return Entity.IsAlive() ? Entity.View().try_get<FFlecsHitResult>() : nullptr;
 }
 
 void UFlecsComponentHitSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
-	auto TEST = Collection.InitializeDependency<UFlecsSimulationSubsystem>();
+	Collection.InitializeDependency<UFlecsSimulationSubsystem>();
 
 	SignalSubsystem = Collection.InitializeDependency<UFlecsSignalSubsystem>();
 	checkfSlow(SignalSubsystem != nullptr, TEXT("FlecsSignalSubsystem is required"));
@@ -40,15 +61,24 @@ void UFlecsComponentHitSubsystem::Initialize(FSubsystemCollectionBase& Collectio
 	AgentSubsystem = Collection.InitializeDependency<UFlecsAgentSubsystem>();
 	checkfSlow(AgentSubsystem != nullptr, TEXT("FlecsAgentSubsystem is required"));
 
-	AgentSubsystem->GetOnFlecsAgentComponentEntityAssociated().AddLambda([this](const UFlecsAgentComponent& AgentComponent)
+	EntitySubsystem = Collection.InitializeDependency<UFlecsEntitySubsystem>();
+	checkfSlow(EntitySubsystem != nullptr, TEXT("FlecsEntitySubsystem is required"));
+
+	// Hit results come and go with every hit, keep them out of the entity's archetype.
+	EntitySubsystem->GetFlecsWorld().Component<FFlecsHitResult>().add(flecs::DontFragment);
+
+	AgentSubsystem->GetOnFlecsAgentComponentEntityAssociated().AddWeakLambda(this, [this](TConstArrayView<const UFlecsAgentComponent*> AgentComponents)
 	{
-		if (UCapsuleComponent* CapsuleComponent = AgentComponent.GetOwner()->FindComponentByClass<UCapsuleComponent>())
+		for (const UFlecsAgentComponent* AgentComponent : AgentComponents)
 		{
-			RegisterForComponentHit(AgentComponent.GetEntityView(), *CapsuleComponent);
+			if (UCapsuleComponent* CapsuleComponent = AgentComponent->GetOwner()->FindComponentByClass<UCapsuleComponent>())
+			{
+				RegisterForComponentHit(AgentComponent->GetEntityView(), *CapsuleComponent);
+			}
 		}
 	});
 
-	AgentSubsystem->GetOnFlecsAgentComponentEntityDetaching().AddLambda([this](const UFlecsAgentComponent& AgentComponent)
+	AgentSubsystem->GetOnFlecsAgentComponentEntityDetaching().AddWeakLambda(this, [this](const UFlecsAgentComponent& AgentComponent)
 	{
 		if (UCapsuleComponent* CapsuleComponent = AgentComponent.GetOwner()->FindComponentByClass<UCapsuleComponent>())
 		{
@@ -65,6 +95,8 @@ void UFlecsComponentHitSubsystem::Deinitialize()
 	AgentSubsystem->GetOnFlecsAgentComponentEntityAssociated().RemoveAll(this);
 	AgentSubsystem->GetOnFlecsAgentComponentEntityDetaching().RemoveAll(this);
 
+	ExpirationBuckets.Empty();
+
 	Super::Deinitialize();
 }
 
@@ -73,16 +105,63 @@ void UFlecsComponentHitSubsystem::Tick(float DeltaTime)
 	const TNotNull<const UWorld*> World = GetWorld();
 
 	const double CurrentTime = World->GetTimeSeconds();
-	constexpr double HitResultDecayDuration = 1.;
 
-	for (auto Iter = HitResults.CreateIterator(); Iter; ++Iter)
+	// Entities that received a merged hit since they were queued, they need to be visited again later
+	TArray<TPair<FFlecsEntityView, double>, TInlineAllocator<16>> ExtendedEntities;
+	TArray<FFlecsEntityView, TInlineAllocator<16>> ExpiredEntities;
+
+	TArray<FFlecsEntityType, TInlineAllocator<64>> Ids;
+	TArray<const FFlecsHitResult*, TInlineAllocator<64>> HitResults;
+
+	int32 NumExpiredBuckets = 0;
+	for (; NumExpiredBuckets < ExpirationBuckets.Num(); ++NumExpiredBuckets)
 	{
-		const FFlecsHitResult& HitResult = Iter.Value();
-		const double ElapsedTime = CurrentTime - HitResult.LastFilteredHitTime;
-		if (ElapsedTime > HitResultDecayDuration)
+		const FHitExpirationBucket& Bucket = ExpirationBuckets[NumExpiredBuckets];
+		if (Bucket.ExpirationTime > CurrentTime)
+		{
+			break;
+		}
+
+		Ids.Reset();
+		for (const FFlecsEntityView Entity : Bucket.Entities)
 		{
-			Iter.RemoveCurrent();
+			Ids.Add(Entity.GetRawId());
 		}
+
+		// Dead entities and entities without hit result get a null pointer
+		HitResults.SetNumUninitialized(Ids.Num(), EAllowShrinking::No);
+		EntitySubsystem->GetFlecsWorld().TryGetMany<FFlecsHitResult>(Ids, HitResults);
+
+		for (int32 Index = 0; Index < HitResults.Num(); ++Index)
+		{
+			const FFlecsHitResult* HitResult = HitResults[Index];
+			if (HitResult == nullptr)
+			{
+				continue;
+			}
+
+			if (HitResult->ExpirationTime > CurrentTime)
+			{
+				ExtendedEntities.Emplace(Bucket.Entities[Index], HitResult->ExpirationTime);
+			}
+			else
+			{
+				ExpiredEntities.Add(Bucket.Entities[Index]);
+			}
+		}
+	}
+
+	// Removing hit results moves the storage of others, only remove once all of them have been read
+	for (const FFlecsEntityView Entity : ExpiredEntities)
+	{
+		UE::FlecsComponentHit::Private::MakeMutable(Entity).remove<FFlecsHitResult>();
+	}
+
+	ExpirationBuckets.RemoveAt(0, NumExpiredBuckets, EAllowShrinking::No);
+
+	for (const TPair<FFlecsEntityView, double>& ExtendedEntity : ExtendedEntities)
+	{
+		QueueHitResultExpiration(ExtendedEntity.Key, ExtendedEntity.Value);
 	}
 }
 
@@ -93,27 +172,44 @@ TStatId UFlecsComponentHitSubsystem::GetStatId() const
 
 void UFlecsComponentHitSubsystem::RegisterForComponentHit(const FFlecsEntityView Entity, UCapsuleComponent& CapsuleComponent)
 {
-	EntityToComponentMap.Add(Entity, &CapsuleComponent);
-	ComponentToEntityMap.Add(&CapsuleComponent, Entity);
 	CapsuleComponent.OnComponentHit.AddDynamic(this, &UFlecsComponentHitSubsystem::OnHitCallback);
 }
 
 void UFlecsComponentHitSubsystem::UnregisterForComponentHit(const FFlecsEntityView Entity, UCapsuleComponent& CapsuleComponent)
 {
-	EntityToComponentMap.Remove(Entity);
-	ComponentToEntityMap.Remove(&CapsuleComponent);
 	CapsuleComponent.OnComponentHit.RemoveAll(this);
+
+	// The entity might still be queued in one of the buckets, Tick skips entities without hit result.
+	if (Entity.IsAlive())
+	{
+		UE::FlecsComponentHit::Private::MakeMutable(Entity).remove<FFlecsHitResult>();
+	}
+}
+
+void UFlecsComponentHitSubsystem::QueueHitResultExpiration(const FFlecsEntityView Entity, const double ExpirationTime)
+{
+	// Keep buckets sorted by expiration so an extended hit never holds back entities that expire earlier
+	const int32 BucketIndex = Algo::LowerBoundBy(ExpirationBuckets, ExpirationTime, &FHitExpirationBucket::ExpirationTime);
+	if (!ExpirationBuckets.IsValidIndex(BucketIndex) || ExpirationBuckets[BucketIndex].ExpirationTime != ExpirationTime)
+	{
+		FHitExpirationBucket NewBucket;
+		NewBucket.ExpirationTime = ExpirationTime;
+		ExpirationBuckets.Insert(MoveTemp(NewBucket), BucketIndex);
+	}
+
+	ExpirationBuckets[BucketIndex].Entities.Add(Entity);
 }
 
 void UFlecsComponentHitSubsystem::OnHitCallback(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
 	const TNotNull<const UWorld*> World = GetWorld();
 
+	// Only capsules of actors with an associated agent are registered, so the owner always holds the entity.
+	const FFlecsEntityView Entity = UE::FlecsComponentHit::Private::GetAgentEntity(HitComp != nullptr ? HitComp->GetOwner() : nullptr);
+	checkfSlow(Entity.IsSet(), TEXT("Receiving a hit for a component that is not associated to an entity"));
+	const FFlecsEntityView OtherEntity = UE::FlecsComponentHit::Private::GetAgentEntity(OtherComp != nullptr ? OtherComp->GetOwner() : nullptr);
 
-	const FFlecsEntityView Entity = ComponentToEntityMap.FindChecked(HitComp);
-	FFlecsEntityView* OtherEntity = ComponentToEntityMap.Find(OtherComp);
-
-	bool bProcessHit = (OtherEntity != nullptr && OtherEntity->IsSet());
+	bool bProcessHit = OtherEntity.IsSet();
 	if (bProcessHit && UE::FlecsComponentHit::bOnlyProcessHitsFromPlayers)
 	{
 		const APawn* HitActorAsPawn = (HitComp != nullptr) ? Cast<APawn>(HitComp->GetOwner()) : nullptr;
@@ -121,29 +217,36 @@ void UFlecsComponentHitSubsystem::OnHitCallback(UPrimitiveComponent* HitComp, AA
 		bProcessHit = (HitActorAsPawn != nullptr && HitActorAsPawn->IsPlayerControlled()) || (OtherAsPawn != nullptr && OtherAsPawn->IsPlayerControlled());
 	}
 
+	if (!bProcessHit || !Entity.IsAlive())
+	{
+		return;
+	}
+
 	const double CurrentTime = World->GetTimeSeconds();
+	const double ExpirationTime = CurrentTime + UE::FlecsComponentHit::Private::HitResultDecayDuration;
 
-	// If new hit result comes during this duration, it will be merged to existing one.
-	constexpr double HitResultMergeDuration = 1.;
-	if (bProcessHit)
+	const flecs::entity FlecsEntity = UE::FlecsComponentHit::Private::MakeMutable(Entity);
+	if (FFlecsHitResult* ExistingHitResult = FlecsEntity.try_get_mut<FFlecsHitResult>())
 	{
-		FFlecsHitResult* ExistingHitResult = HitResults.Find(Entity);
-		if (ExistingHitResult)
+		const double TimeSinceLastHit = CurrentTime - ExistingHitResult->LastFilteredHitTime;
+		if (TimeSinceLastHit < UE::FlecsComponentHit::Private::HitResultMergeDuration)
 		{
-			const double TimeSinceLastHit = CurrentTime - ExistingHitResult->LastFilteredHitTime;
-			if (TimeSinceLastHit < HitResultMergeDuration)
-			{
-				ExistingHitResult->LastFilteredHitTime = CurrentTime;
-				bProcessHit = false;
-			}
+			ExistingHitResult->LastFilteredHitTime = CurrentTime;
+			ExistingHitResult->ExpirationTime = ExpirationTime;
+			FlecsEntity.modified<FFlecsHitResult>();
+			return;
 		}
-	}
 
-	if (bProcessHit)
+		// The entity is already queued, Tick will requeue it when it finds the later expiration time.
+		*ExistingHitResult = FFlecsHitResult(OtherEntity, CurrentTime, ExpirationTime);
+		FlecsEntity.modified<FFlecsHitResult>();
+	}
+	else
 	{
-		HitResults.Add(Entity, {*OtherEntity, CurrentTime});
-
-		checkfSlow(SignalSubsystem != nullptr, TEXT("FlecsSignalSubsystem must have be set during initialization"));
-		SignalSubsystem->SignalEntity(UE::Flecs::Signals::HitReceived, Entity);
+		FlecsEntity.set<FFlecsHitResult>(FFlecsHitResult(OtherEntity, CurrentTime, ExpirationTime));
+		QueueHitResultExpiration(Entity, ExpirationTime);
 	}
+
+	checkfSlow(SignalSubsystem != nullptr, TEXT("FlecsSignalSubsystem must have be set during initialization"));
+	SignalSubsystem->SignalEntity(UE::Flecs::Signals::HitReceived, Entity);
 }
@@ -2,4 +2,44 @@
 
 #include "FlecsSystem_StateTree.h"
 
+#include "FlecsComponentHitTypes.h"
+#include "FlecsSignalSubsystem.h"
+#include "World/FlecsWorld.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_StateTree)
+
+void UFlecsSystem_StateTree::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+
+	InFlecsWorld.Component<FFlecsStateTreeInstanceComponent>();
+	InFlecsWorld.Component<FFlecsStateTreeActivatedTag>();
+
+	UFlecsSignalSubsystem* SignalSubsystem = UWorld::GetSubsystem<UFlecsSignalSubsystem>(InOwner.GetWorld());
+	check(SignalSubsystem);
+
+	SubscribeToSignal(*SignalSubsystem, UE::Flecs::Signals::StateTreeActivate);
+	SubscribeToSignal(*SignalSubsystem, UE::Flecs::Signals::HitReceived);
+}
+
+void UFlecsSystem_StateTree::SignalEntities(FFlecsWorld& FlecsWorld, FFlecsSignalNameLookup& EntitySignals)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FlecsStateTree_SignalEntities);
+
+	const double TimeInSeconds = GetWorld()->GetTimeSeconds();
+
+	ForEachSignaledTable([TimeInSeconds](const flecs::table& Table, TConstArrayView<FFlecsEntityView> Entities, TConstArrayView<int32> Rows)
+	{
+		// Signaled entities are not guaranteed to run a StateTree, the whole table is skipped when they don't.
+		FFlecsStateTreeInstanceComponent* Instances = Table.try_get<FFlecsStateTreeInstanceComponent>();
+		if (Instances == nullptr)
+		{
+			return;
+		}
+
+		for (const int32 Row : Rows)
+		{
+			Instances[Row].LastUpdateTimeInSeconds = TimeInSeconds;
+		}
+	});
+}
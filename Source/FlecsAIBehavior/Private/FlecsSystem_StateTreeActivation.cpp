@@ -0,0 +1,104 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSystem_StateTreeActivation.h"
+
+#include "FlecsBehaviorSettings.h"
+#include "FlecsLODTypes.h"
+#include "FlecsSignalSubsystem.h"
+#include "FlecsSystem_StateTree.h"
+#include "Phases/FlecsPhase.h"
+#include "World/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_StateTreeActivation)
+
+UFlecsSystem_StateTreeActivation::UFlecsSystem_StateTreeActivation()
+{
+	ExecutionFlags = (int32)EFlecsSystemExecutionFlags::AllNetModes;
+	ExecuteInPhase = UFlecsPhase_PreUpdate::StaticClass();
+
+	// The activation budgets are shared by all the entities.
+	bMultithreaded = false;
+}
+
+void UFlecsSystem_StateTreeActivation::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+
+	InFlecsWorld.Component<FFlecsStateTreeInstanceComponent>();
+	InFlecsWorld.Component<FFlecsStateTreeActivatedTag>();
+	InFlecsWorld.Component<FFlecsLODComponent>();
+
+	SignalSubsystem = UWorld::GetSubsystem<UFlecsSignalSubsystem>(InOwner.GetWorld());
+}
+
+void UFlecsSystem_StateTreeActivation::BuildSystem(flecs::system_builder<>& SystemBuilder)
+{
+	Super::BuildSystem(SystemBuilder);
+
+	SystemBuilder
+		.with<FFlecsStateTreeInstanceComponent>().inout()
+		.with<FFlecsLODComponent>().in().optional()
+		.without<FFlecsStateTreeActivatedTag>();
+}
+
+void UFlecsSystem_StateTreeActivation::Run(flecs::iter& Iterator)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FlecsStateTreeActivation);
+
+	const UFlecsBehaviorSettings* BehaviorSettings = GetDefault<UFlecsBehaviorSettings>();
+
+	int32 RemainingActivations[EFlecsLOD::Max];
+	int32 TotalRemainingActivations = 0;
+	for (int32 LOD = EFlecsLOD::High; LOD < EFlecsLOD::Max; ++LOD)
+	{
+		RemainingActivations[LOD] = FMath::Max(BehaviorSettings->MaxActivationsPerLOD[LOD], 0);
+		TotalRemainingActivations += RemainingActivations[LOD];
+	}
+
+	ActivatedEntities.Reset();
+	const double TimeInSeconds = GetWorld()->GetTimeSeconds();
+
+	// Signaled entities outlive this frame's stage, keep the actual world in them.
+	const flecs::world World = Iterator.world().get_world();
+
+	while (TotalRemainingActivations > 0 && Iterator.next())
+	{
+		const flecs::field<FFlecsStateTreeInstanceComponent> Instances = Iterator.field<FFlecsStateTreeInstanceComponent>(0);
+		const bool bHasLOD = Iterator.is_set(1);
+
+		for (const size_t Index : Iterator)
+		{
+			// Entities without LOD or whose LOD has not been computed yet use the High LOD budget.
+			const EFlecsLOD::Type LOD = bHasLOD ? Iterator.field_at<const FFlecsLODComponent>(1, Index).LOD.GetValue() : EFlecsLOD::High;
+			const int32 BudgetLOD = LOD == EFlecsLOD::Max ? EFlecsLOD::High : LOD;
+			if (RemainingActivations[BudgetLOD] <= 0)
+			{
+				continue;
+			}
+			--RemainingActivations[BudgetLOD];
+			--TotalRemainingActivations;
+
+			Instances[Index].LastUpdateTimeInSeconds = TimeInSeconds;
+
+			const flecs::entity Entity = Iterator.entity(Index);
+			Entity.add<FFlecsStateTreeActivatedTag>();
+			ActivatedEntities.Add(FFlecsEntityView(World.c_ptr(), Entity.id()));
+
+			if (TotalRemainingActivations == 0)
+			{
+				break;
+			}
+		}
+	}
+
+	if (TotalRemainingActivations == 0)
+	{
+		// Budget exhausted, the remaining entities will be activated in the next frames.
+		Iterator.fini();
+	}
+
+	if (ActivatedEntities.Num() > 0 && SignalSubsystem)
+	{
+		SignalSubsystem->SignalEntities(UE::Flecs::Signals::StateTreeActivate, ActivatedEntities);
+	}
+}
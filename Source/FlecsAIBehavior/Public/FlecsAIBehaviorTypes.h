@@ -16,7 +16,7 @@ UE_API DECLARE_LOG_CATEGORY_EXTERN(LogFlecsAIBehavior, Warning, All);
  *  e.g. the following:
  *		#if WITH_FLECSGAMEPLAY_DEBUG
  *			const FFlecsStateTreeExecutionContext& FlecsContext = static_cast<FFlecsStateTreeExecutionContext&>(Context);
- *			UE_VLOG(FlecsContext.GetOwner(), LogFlecsAIBehavior, Log, TEXT("Entity [%s]: Starting action: %s"), *FlecsContext.GetEntity().DebugGetDescription(), *StaticEnum<ESomeActionEnum>()->GetValueAsString(SomeActionEnumValue));
+ *			UE_VLOG(FlecsContext.GetOwner(), LogFlecsAIBehavior, Log, TEXT("Entity [%s]: Starting action: %s"), *WriteToString<128>(FlecsContext.GetEntity()), *StaticEnum<ESomeActionEnum>()->GetValueAsString(SomeActionEnumValue));
  *		#endif // WITH_FLECSGAMEPLAY_DEBUG
  *
  *	could be replaced by:
@@ -24,9 +24,9 @@ UE_API DECLARE_LOG_CATEGORY_EXTERN(LogFlecsAIBehavior, Warning, All);
  */
 #if WITH_FLECSGAMEPLAY_DEBUG
 #define FLECSBEHAVIOR_LOG(Verbosity, Format, ...) UE_VLOG_UELOG(static_cast<const FFlecsStateTreeExecutionContext&>(Context).GetOwner(), LogFlecsBehavior, Verbosity, \
-TEXT("Entity [%s][%s] ") Format, *static_cast<const FFlecsStateTreeExecutionContext&>(Context).GetEntity().DebugGetDescription(), *StaticStruct()->GetName(), ##__VA_ARGS__)
+TEXT("Entity [%s][%s] ") Format, *WriteToString<128>(static_cast<const FFlecsStateTreeExecutionContext&>(Context).GetEntity()), *StaticStruct()->GetName(), ##__VA_ARGS__)
 #define FLECSBEHAVIOR_CLOG(Condition, Verbosity, Format, ...) UE_CVLOG_UELOG((Condition), static_cast<const FFlecsStateTreeExecutionContext&>(Context).GetOwner(), LogFlecsBehavior, Verbosity, \
-TEXT("Entity [%s][%s] ") Format, *static_cast<const FFlecsStateTreeExecutionContext&>(Context).GetEntity().DebugGetDescription(), *StaticStruct()->GetName(), ##__VA_ARGS__)
+TEXT("Entity [%s][%s] ") Format, *WriteToString<128>(static_cast<const FFlecsStateTreeExecutionContext&>(Context).GetEntity()), *StaticStruct()->GetName(), ##__VA_ARGS__)
 #else
 #define FLECSBEHAVIOR_LOG(Verbosity, Format, ...)
 #define FLECSBEHAVIOR_CLOG(Condition, Verbosity, Format, ...)
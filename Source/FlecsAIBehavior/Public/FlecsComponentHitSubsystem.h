@@ -10,6 +10,7 @@
 #define UE_API FLECSAIBEHAVIOR_API
 
 class UFlecsAgentSubsystem;
+class UFlecsEntitySubsystem;
 class UCapsuleComponent;
 class UFlecsSignalSubsystem;
 class UFlecsSimulationSubsystem;
@@ -23,6 +24,10 @@ class UFlecsComponentHitSubsystem : public UFlecsTickableSubsystemBase
 	GENERATED_BODY()
 
 public:
+	/**
+	 * @return The last hit received by the given entity, or nullptr if it did not receive any or it already decayed.
+	 * The returned pointer points into the entity's storage and is only valid until the next structural change.
+	 */
 	UE_API const FFlecsHitResult* GetLastHit(const FFlecsEntityView Entity) const;
 
 protected:
@@ -34,6 +39,9 @@ protected:
 	UE_API void RegisterForComponentHit(const FFlecsEntityView Entity, UCapsuleComponent& CapsuleComponent);
 	UE_API void UnregisterForComponentHit(FFlecsEntityView Entity, UCapsuleComponent& CapsuleComponent);
 
+	/** Queues the entity to be visited once ExpirationTime has passed. Entities with the same expiration time share a bucket. */
+	UE_API void QueueHitResultExpiration(const FFlecsEntityView Entity, const double ExpirationTime);
+
 	UFUNCTION()
 	UE_API void OnHitCallback(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
@@ -44,13 +52,19 @@ protected:
 	TObjectPtr<UFlecsAgentSubsystem> AgentSubsystem;
 
 	UPROPERTY()
-	TMap<FFlecsEntityView, FFlecsHitResult> HitResults;
+	TObjectPtr<UFlecsEntitySubsystem> EntitySubsystem;
 
-	UPROPERTY()
-	TMap<TObjectPtr<UActorComponent>, FFlecsEntityView> ComponentToEntityMap;
+	/** Entities holding a FFlecsHitResult, grouped by expiration time. Hits received or extended during the same frame share it. */
+	struct FHitExpirationBucket
+	{
+		/** Expiration time of all the entities in the bucket */
+		double ExpirationTime = 0.;
 
-	UPROPERTY()
-	TMap<FFlecsEntityView, TObjectPtr<UActorComponent>> EntityToComponentMap;
+		TArray<FFlecsEntityView> Entities;
+	};
+
+	/** Ordered by ExpirationTime, Tick only visits the buckets at the front that already expired */
+	TArray<FHitExpirationBucket> ExpirationBuckets;
 };
 
 template <>
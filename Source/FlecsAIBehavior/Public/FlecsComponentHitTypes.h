@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/EngineTypes.h"
+#include "FlecsEntityElementTypes.h"
 #include "FlecsEntityView.h"
 
 #include "FlecsComponentHitTypes.generated.h"
@@ -12,18 +13,22 @@ namespace UE::Flecs::Signals
 	const FName HitReceived = FName(TEXT("HitReceived"));
 }
 
-
+/**
+ * Last hit received by an entity. Stored directly on the entity as a non-fragmenting component so adding
+ * and removing it on every hit does not move the entity between tables.
+ */
 USTRUCT()
-struct FFlecsHitResult
+struct FFlecsHitResult : public FFlecsComponent
 {
 	GENERATED_BODY()
 
 	FFlecsHitResult() = default;
 
-	FFlecsHitResult(const FFlecsEntityView InOtherEntity, const double InTime)
+	FFlecsHitResult(const FFlecsEntityView InOtherEntity, const double InTime, const double InExpirationTime)
 		: OtherEntity(InOtherEntity),
 		  HitTime(InTime),
-		  LastFilteredHitTime(InTime)
+		  LastFilteredHitTime(InTime),
+		  ExpirationTime(InExpirationTime)
 	{
 	}
 
@@ -36,4 +41,7 @@ struct FFlecsHitResult
 
 	/** Time used for filtering frequent hits. */
 	double LastFilteredHitTime = 0.;
+
+	/** Time after which the hit result decays and gets removed from the entity. */
+	double ExpirationTime = 0.;
 };
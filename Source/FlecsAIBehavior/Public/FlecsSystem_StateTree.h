@@ -9,6 +9,11 @@
 
 #define UE_API FLECSAIBEHAVIOR_API
 
+namespace UE::Flecs::Signals
+{
+	const FName StateTreeActivate = FName(TEXT("StateTreeActivate"));
+}
+
 /**
  * Special tag to know if the state tree has been activated
  */
@@ -19,12 +24,30 @@ struct FFlecsStateTreeActivatedTag : public FFlecsTag
 };
 
 /**
- * 
+ * Component holding the StateTree instance state of the entity
+ */
+USTRUCT()
+struct FFlecsStateTreeInstanceComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	/** Time the StateTree of the entity was last updated, 0 until activated */
+	double LastUpdateTimeInSeconds = 0.;
+};
+
+/**
+ * System updating the StateTree of the signaled entities, one table at a time.
+ * Entities are first signaled by UFlecsSystem_StateTreeActivation once activated.
+ * Only one instance is allowed, every instance would subscribe to the same signals and update the same entities.
  */
 UCLASS(MinimalAPI)
 class UFlecsSystem_StateTree : public UFlecsSystem_SignalBase
 {
 	GENERATED_BODY()
+
+protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
+	UE_API virtual void SignalEntities(FFlecsWorld& FlecsWorld, FFlecsSignalNameLookup& EntitySignals) override;
 };
 
 #undef UE_API
@@ -0,0 +1,39 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "Systems/FlecsSystem.h"
+
+#include "FlecsSystem_StateTreeActivation.generated.h"
+
+#define UE_API FLECSAIBEHAVIOR_API
+
+class UFlecsSignalSubsystem;
+
+/**
+ * System activating the StateTree of newly created entities. Activations are spread over frames, at most
+ * UFlecsBehaviorSettings::MaxActivationsPerLOD entities are activated per LOD each frame, so spawning a lot of
+ * entities at once does not cause a hitch. Activated entities get the FFlecsStateTreeActivatedTag and the
+ * StateTreeActivate signal.
+ */
+UCLASS(MinimalAPI)
+class UFlecsSystem_StateTreeActivation : public UFlecsSystem
+{
+	GENERATED_BODY()
+
+public:
+	UE_API UFlecsSystem_StateTreeActivation();
+
+protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
+	UE_API virtual void BuildSystem(flecs::system_builder<>& SystemBuilder) override;
+	UE_API virtual void Run(flecs::iter& Iterator) override;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsSignalSubsystem> SignalSubsystem;
+
+	/** Entities activated this frame, kept around to avoid reallocating */
+	TArray<FFlecsEntityView> ActivatedEntities;
+};
+
+#undef UE_API
@@ -2,4 +2,76 @@
 
 #include "FlecsAgentComponent.h"
 
+#include "Algo/BinarySearch.h"
+#include "FlecsAgentSubsystem.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsAgentComponent)
+
+UFlecsAgentComponent::UFlecsAgentComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UFlecsAgentComponent::Enable()
+{
+	if (State != EFlecsAgentComponentState::None && State != EFlecsAgentComponentState::PuppetPaused)
+	{
+		return;
+	}
+
+	if (UFlecsAgentSubsystem* AgentSubsystem = UWorld::GetSubsystem<UFlecsAgentSubsystem>(GetWorld()))
+	{
+		AgentSubsystem->RegisterAgentComponent(*this);
+	}
+}
+
+void UFlecsAgentComponent::Disable()
+{
+	if (State == EFlecsAgentComponentState::None || State == EFlecsAgentComponentState::PuppetPaused)
+	{
+		return;
+	}
+
+	if (UFlecsAgentSubsystem* AgentSubsystem = UWorld::GetSubsystem<UFlecsAgentSubsystem>(GetWorld()))
+	{
+		AgentSubsystem->UnregisterAgentComponent(*this);
+	}
+}
+
+void UFlecsAgentComponent::SetPuppetEntity(const FFlecsEntityView InEntity)
+{
+	if (ensureMsgf(State == EFlecsAgentComponentState::None, TEXT("Puppet entity needs to be set before enabling the component")))
+	{
+		AgentHandle = InEntity;
+	}
+}
+
+void UFlecsAgentComponent::AddEntityComponentType(const flecs::id_t InId)
+{
+	if (ensureMsgf(State == EFlecsAgentComponentState::None, TEXT("Entity component types need to be added before enabling the component")))
+	{
+		const int32 Index = Algo::LowerBound(EntityComponentTypes, InId);
+		if (!EntityComponentTypes.IsValidIndex(Index) || EntityComponentTypes[Index] != InId)
+		{
+			EntityComponentTypes.Insert(InId, Index);
+		}
+	}
+}
+
+void UFlecsAgentComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	const UWorld* World = GetWorld();
+	if (bAutoRegisterInAgentSubsystem && World && World->IsGameWorld())
+	{
+		Enable();
+	}
+}
+
+void UFlecsAgentComponent::OnUnregister()
+{
+	Disable();
+
+	Super::OnUnregister();
+}
@@ -2,4 +2,259 @@
 
 #include "FlecsAgentSubsystem.h"
 
+#include "FlecsActorComponents.h"
+#include "FlecsAgentComponent.h"
+#include "FlecsEntitySubsystem.h"
+#include "Algo/Compare.h"
+#include "Algo/Sort.h"
+#include "World/FlecsWorld.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsAgentSubsystem)
+
+void UFlecsAgentSubsystem::RegisterAgentComponent(UFlecsAgentComponent& AgentComponent)
+{
+	if (AgentComponent.GetEntityView().IsSet())
+	{
+		checkf(!PendingPuppetInitializations.Contains(&AgentComponent), TEXT("Agent component registered twice"));
+		AgentComponent.SetEntityHandle(AgentComponent.GetEntityView(), EFlecsAgentComponentState::PuppetPendingInitialization);
+		PendingPuppetInitializations.Add(&AgentComponent);
+	}
+	else
+	{
+		checkf(!PendingEntityCreations.Contains(&AgentComponent), TEXT("Agent component registered twice"));
+		AgentComponent.SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::EntityPendingCreation);
+		PendingEntityCreations.Add(&AgentComponent);
+	}
+}
+
+void UFlecsAgentSubsystem::UnregisterAgentComponent(UFlecsAgentComponent& AgentComponent)
+{
+	const FFlecsEntityView Entity = AgentComponent.GetEntityView();
+
+	switch (AgentComponent.GetState())
+	{
+	case EFlecsAgentComponentState::EntityPendingCreation:
+		PendingEntityCreations.RemoveSingleSwap(&AgentComponent, EAllowShrinking::No);
+		AgentComponent.SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::None);
+		break;
+
+	case EFlecsAgentComponentState::PuppetPendingInitialization:
+		PendingPuppetInitializations.RemoveSingleSwap(&AgentComponent, EAllowShrinking::No);
+		AgentComponent.SetEntityHandle(Entity, EFlecsAgentComponentState::PuppetPaused);
+		break;
+
+	case EFlecsAgentComponentState::EntityCreated:
+		OnFlecsAgentComponentEntityDetaching.Broadcast(AgentComponent);
+		if (Entity.IsAlive())
+		{
+			Entity.View().mut(EntitySubsystem->GetFlecsWorld()).destruct();
+		}
+		AgentComponent.SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::None);
+		break;
+
+	case EFlecsAgentComponentState::PuppetInitialized:
+		OnFlecsAgentComponentEntityDetaching.Broadcast(AgentComponent);
+		if (Entity.IsAlive())
+		{
+			Entity.View().mut(EntitySubsystem->GetFlecsWorld()).remove<FFlecsActorComponent>();
+		}
+		AgentComponent.SetEntityHandle(Entity, EFlecsAgentComponentState::PuppetPaused);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UFlecsAgentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	EntitySubsystem = Collection.InitializeDependency<UFlecsEntitySubsystem>();
+	checkfSlow(EntitySubsystem != nullptr, TEXT("FlecsEntitySubsystem is required"));
+
+	EntitySubsystem->GetFlecsWorld().Component<FFlecsActorComponent>();
+}
+
+void UFlecsAgentSubsystem::Deinitialize()
+{
+	for (UFlecsAgentComponent* AgentComponent : PendingEntityCreations)
+	{
+		if (AgentComponent)
+		{
+			AgentComponent->SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::None);
+		}
+	}
+	for (UFlecsAgentComponent* AgentComponent : PendingPuppetInitializations)
+	{
+		if (AgentComponent)
+		{
+			AgentComponent->SetEntityHandle(AgentComponent->GetEntityView(), EFlecsAgentComponentState::PuppetPaused);
+		}
+	}
+	PendingEntityCreations.Reset();
+	PendingPuppetInitializations.Reset();
+
+	Super::Deinitialize();
+}
+
+void UFlecsAgentSubsystem::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FlecsAgentSubsystem_Tick);
+
+	AssociatedComponents.Reset();
+
+	CreatePendingEntities();
+	InitializePendingPuppets();
+
+	if (AssociatedComponents.Num() > 0)
+	{
+		OnFlecsAgentComponentEntityAssociated.Broadcast(AssociatedComponents);
+	}
+}
+
+TStatId UFlecsAgentSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlecsAgentSubsystem, STATGROUP_Tickables);
+}
+
+void UFlecsAgentSubsystem::CreatePendingEntities()
+{
+	// Dropped components go back to None so that they can be enabled again.
+	PendingEntityCreations.RemoveAllSwap([](const TObjectPtr<UFlecsAgentComponent>& AgentComponent)
+	{
+		if (AgentComponent == nullptr)
+		{
+			return true;
+		}
+		if (AgentComponent->GetOwner() == nullptr)
+		{
+			AgentComponent->SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::None);
+			return true;
+		}
+		return false;
+	}, EAllowShrinking::No);
+
+	if (PendingEntityCreations.IsEmpty())
+	{
+		return;
+	}
+
+	// Agents requesting the same ids end up next to each other, each run is one archetype.
+	Algo::Sort(PendingEntityCreations, [](const TObjectPtr<UFlecsAgentComponent>& A, const TObjectPtr<UFlecsAgentComponent>& B)
+	{
+		const TConstArrayView<flecs::id_t> TypesA = A->GetEntityComponentTypes();
+		const TConstArrayView<flecs::id_t> TypesB = B->GetEntityComponentTypes();
+		if (TypesA.Num() != TypesB.Num())
+		{
+			return TypesA.Num() < TypesB.Num();
+		}
+		for (int32 Index = 0; Index < TypesA.Num(); ++Index)
+		{
+			if (TypesA[Index] != TypesB[Index])
+			{
+				return TypesA[Index] < TypesB[Index];
+			}
+		}
+		return false;
+	});
+
+	const FFlecsWorld& FlecsWorld = EntitySubsystem->GetFlecsWorld();
+	const flecs::entity_t ActorComponentId = FlecsWorld.Component<FFlecsActorComponent>();
+
+	TArray<FFlecsActorComponent> ActorComponents;
+	for (int32 Begin = 0; Begin < PendingEntityCreations.Num();)
+	{
+		const TConstArrayView<flecs::id_t> Types = PendingEntityCreations[Begin]->GetEntityComponentTypes();
+		int32 End = Begin + 1;
+		while (End < PendingEntityCreations.Num() && Algo::Compare(PendingEntityCreations[End]->GetEntityComponentTypes(), Types))
+		{
+			++End;
+		}
+
+		const int32 Num = End - Begin;
+		if (!ensureMsgf(Types.Num() < FLECS_ID_DESC_MAX - 1, TEXT("Agents can add at most %d component types"), FLECS_ID_DESC_MAX - 2))
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				PendingEntityCreations[Index]->SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::None);
+			}
+			Begin = End;
+			continue;
+		}
+
+		ActorComponents.Reset(Num);
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			ActorComponents.Emplace(PendingEntityCreations[Index]->GetOwner());
+		}
+
+		// Only the actor component gets data, the other ids are default constructed.
+		void* Data[FLECS_ID_DESC_MAX] = { ActorComponents.GetData() };
+
+		ecs_bulk_desc_t BulkDesc = {};
+		BulkDesc.count = Num;
+		BulkDesc.ids[0] = ActorComponentId;
+		FMemory::Memcpy(&BulkDesc.ids[1], Types.GetData(), Types.Num() * sizeof(flecs::id_t));
+		BulkDesc.data = Data;
+
+		const flecs::entity_t* Entities = ecs_bulk_init(FlecsWorld, &BulkDesc);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			UFlecsAgentComponent* AgentComponent = PendingEntityCreations[Begin + Index];
+			AgentComponent->SetEntityHandle(FFlecsEntityView(FlecsWorld, Entities[Index]), EFlecsAgentComponentState::EntityCreated);
+			AssociatedComponents.Add(AgentComponent);
+		}
+
+		Begin = End;
+	}
+
+	PendingEntityCreations.Reset();
+}
+
+void UFlecsAgentSubsystem::InitializePendingPuppets()
+{
+	if (PendingPuppetInitializations.IsEmpty())
+	{
+		return;
+	}
+
+	const FFlecsWorld& FlecsWorld = EntitySubsystem->GetFlecsWorld();
+
+	// Batched so every puppet entity moves tables once, whatever the number of ids added to it.
+	FlecsWorld.DeferBegin();
+	for (UFlecsAgentComponent* AgentComponent : PendingPuppetInitializations)
+	{
+		if (AgentComponent == nullptr)
+		{
+			continue;
+		}
+
+		// Skipped puppets are paused rather than left pending, so that enabling them again queues them again.
+		const FFlecsEntityView Entity = AgentComponent->GetEntityView();
+		if (AgentComponent->GetOwner() == nullptr)
+		{
+			AgentComponent->SetEntityHandle(Entity, EFlecsAgentComponentState::PuppetPaused);
+			continue;
+		}
+
+		if (!Entity.IsAlive())
+		{
+			AgentComponent->SetEntityHandle(FFlecsEntityView(), EFlecsAgentComponentState::None);
+			continue;
+		}
+
+		const flecs::entity PuppetEntity = Entity.View().mut(FlecsWorld);
+		PuppetEntity.set(FFlecsActorComponent(AgentComponent->GetOwner()));
+		for (const flecs::id_t Type : AgentComponent->GetEntityComponentTypes())
+		{
+			PuppetEntity.add(Type);
+		}
+
+		AgentComponent->SetEntityHandle(Entity, EFlecsAgentComponentState::PuppetInitialized);
+		AssociatedComponents.Add(AgentComponent);
+	}
+	FlecsWorld.DeferEnd();
+
+	PendingPuppetInitializations.Reset();
+}
@@ -0,0 +1,27 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "FlecsEntityElementTypes.h"
+
+#include "FlecsActorComponents.generated.h"
+
+class AActor;
+
+/**
+ * Component holding the actor associated to the entity
+ */
+USTRUCT()
+struct FFlecsActorComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	FFlecsActorComponent() = default;
+	explicit FFlecsActorComponent(AActor* InActor)
+		: Actor(InActor)
+	{
+	}
+
+	UPROPERTY(Transient, VisibleAnywhere, Category=Debug)
+	TWeakObjectPtr<AActor> Actor;
+};
@@ -40,10 +40,59 @@ class UFlecsAgentComponent : public UActorComponent
 	GENERATED_BODY()
 
 public:
+	UE_API UFlecsAgentComponent();
+
 	FFlecsEntityView GetEntityView() const { return AgentHandle; }
+	EFlecsAgentComponentState GetState() const { return State; }
+
+	/**
+	 * Queues the component with UFlecsAgentSubsystem. During the next subsystem tick an entity gets created for it,
+	 * or if it is a puppet the existing entity gets initialized.
+	 */
+	UE_API void Enable();
+
+	/** Removes the component from the pending queue or detaches it from its entity. */
+	UE_API void Disable();
+
+	/**
+	 * Makes the actor a puppet of an existing entity instead of creating a new one. Needs to be called before Enable.
+	 * @param InEntity Entity driving the actor
+	 */
+	UE_API void SetPuppetEntity(const FFlecsEntityView InEntity);
+
+	/**
+	 * Adds a component or tag to the entity created for this agent. Agents requesting the same set of ids share an
+	 * archetype and are created together. Needs to be called before Enable.
+	 */
+	UE_API void AddEntityComponentType(const flecs::id_t InId);
+
+	/** @return Additional ids of the entity created for this agent, sorted */
+	TConstArrayView<flecs::id_t> GetEntityComponentTypes() const { return EntityComponentTypes; }
 
 protected:
+	//~UActorComponent interface
+	UE_API virtual void OnRegister() override;
+	UE_API virtual void OnUnregister() override;
+	//~End of UActorComponent interface
+
+	friend class UFlecsAgentSubsystem;
+
+	void SetEntityHandle(const FFlecsEntityView InEntity, const EFlecsAgentComponentState InState)
+	{
+		AgentHandle = InEntity;
+		State = InState;
+	}
+
+	/** Whether the component registers itself with UFlecsAgentSubsystem when registered with its actor */
+	UPROPERTY(EditAnywhere, Category="Flecs")
+	uint8 bAutoRegisterInAgentSubsystem : 1 = true;
+
+	UPROPERTY(Transient, VisibleAnywhere, Category="Flecs")
+	EFlecsAgentComponentState State = EFlecsAgentComponentState::None;
+
 	FFlecsEntityView AgentHandle;
+
+	TArray<flecs::id_t> EntityComponentTypes;
 };
 
 #undef UE_API
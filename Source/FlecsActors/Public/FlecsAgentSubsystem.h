@@ -9,25 +9,31 @@
 #define UE_API FLECSACTORS_API
 
 class UFlecsAgentComponent;
+class UFlecsEntitySubsystem;
 
 namespace UE::FlecsActor
 {
 	DECLARE_MULTICAST_DELEGATE_OneParam(FFlecsAgentComponentDelegate, const UFlecsAgentComponent& /*AgentComponent*/);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FFlecsAgentComponentsDelegate, TConstArrayView<const UFlecsAgentComponent*> /*AgentComponents*/);
 }
 
 /**
- * 
+ * Subsystem associating actors with a UFlecsAgentComponent to flecs entities.
+ * Components register in any order and get queued, then once per tick all the pending entities get created with one
+ * bulk spawn per archetype, all the pending puppets get initialized in one deferred batch, and the associated
+ * components are broadcast together.
  */
 UCLASS(MinimalAPI)
-class UFlecsAgentSubsystem : public UFlecsSubsystemBase
+class UFlecsAgentSubsystem : public UFlecsTickableSubsystemBase
 {
 	GENERATED_BODY()
 
 public:
 	/**
-	 * @return The delegate of when FlecsAgentComponent gets associated to a flecs entity
+	 * @return The delegate of when FlecsAgentComponents get associated to flecs entities, broadcast once per tick
+	 * with all the components associated during that tick
 	 */
-	UE::FlecsActor::FFlecsAgentComponentDelegate& GetOnFlecsAgentComponentEntityAssociated()
+	UE::FlecsActor::FFlecsAgentComponentsDelegate& GetOnFlecsAgentComponentEntityAssociated()
 	{
 		return OnFlecsAgentComponentEntityAssociated;
 	}
@@ -40,9 +46,41 @@ public:
 		return OnFlecsAgentComponentEntityDetaching;
 	}
 
+	/** Queues the component for entity creation, or puppet initialization if it already has an entity */
+	UE_API void RegisterAgentComponent(UFlecsAgentComponent& AgentComponent);
+
+	/** Removes the component from the queues, or detaches it from its entity */
+	UE_API void UnregisterAgentComponent(UFlecsAgentComponent& AgentComponent);
+
 protected:
-	UE::FlecsActor::FFlecsAgentComponentDelegate OnFlecsAgentComponentEntityAssociated;
+	// USubsystem implementation Begin
+	UE_API virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	UE_API virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	UE_API virtual void Tick(float DeltaTime) override;
+	UE_API virtual TStatId GetStatId() const override;
+
+	/** Creates the entities of the pending agents, one bulk spawn per archetype. Skipped agents go back to None. */
+	UE_API void CreatePendingEntities();
+
+	/** Adds the agent components to the pending puppets' entities. Skipped puppets are paused, or reset if their entity died. */
+	UE_API void InitializePendingPuppets();
+
+	UE::FlecsActor::FFlecsAgentComponentsDelegate OnFlecsAgentComponentEntityAssociated;
 	UE::FlecsActor::FFlecsAgentComponentDelegate OnFlecsAgentComponentEntityDetaching;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsEntitySubsystem> EntitySubsystem;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFlecsAgentComponent>> PendingEntityCreations;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFlecsAgentComponent>> PendingPuppetInitializations;
+
+	/** Components associated during the current tick */
+	TArray<const UFlecsAgentComponent*> AssociatedComponents;
 };
 
 #undef UE_API
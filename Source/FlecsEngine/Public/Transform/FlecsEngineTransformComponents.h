@@ -0,0 +1,30 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "FlecsEntityElementTypes.h"
+
+#include "FlecsEngineTransformComponents.generated.h"
+
+/**
+ * Component holding the world transform of the entity
+ */
+USTRUCT()
+struct FFlecsTransformComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	FFlecsTransformComponent() = default;
+	explicit FFlecsTransformComponent(const FTransform& InTransform)
+		: Transform(InTransform)
+	{
+	}
+
+	const FTransform& GetTransform() const { return Transform; }
+	void SetTransform(const FTransform& InTransform) { Transform = InTransform; }
+	FTransform& GetMutableTransform() { return Transform; }
+
+protected:
+	UPROPERTY(Transient, VisibleAnywhere, Category=Debug)
+	FTransform Transform;
+};
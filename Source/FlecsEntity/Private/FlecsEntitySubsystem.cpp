@@ -5,11 +5,42 @@
 #include "FlecsEntityTypes.h"
 #include "FlecsEntityUtils.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Components/FlecsNameCacheComponent.h"
 #include "Settings/FlecsEntitySettings.h"
 #include "Systems/FlecsSystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsEntitySubsystem)
 
+namespace UE::Flecs::Private
+{
+	float DeleteEmptyTablesBudgetMs = 0.1f;
+	int32 DeleteEmptyTablesGeneration = 60;
+
+	namespace
+	{
+		FAutoConsoleVariableRef AnonymousCVars[] =
+		{
+			{TEXT("flecs.DeleteEmptyTablesBudgetMs"), DeleteEmptyTablesBudgetMs, TEXT("Time in milliseconds the entity subsystem spends each tick on deleting empty tables and releasing unused pair records. 0 disables it."), ECVF_Default},
+			{TEXT("flecs.DeleteEmptyTablesGeneration"), DeleteEmptyTablesGeneration, TEXT("Number of ticks a table needs to stay empty before it is deleted."), ECVF_Default}
+		};
+	}
+
+	void UpdateNameCache(const flecs::entity& InEntity, FFlecsNameCacheComponent& OutCache)
+	{
+		const EcsIdentifier* Identifier = static_cast<const EcsIdentifier*>(
+			ecs_get_id(InEntity.world(), InEntity, ecs_pair(ecs_id(EcsIdentifier), EcsName)));
+		if (!Identifier || !Identifier->value)
+		{
+			OutCache.Name = NAME_None;
+			OutCache.NameHash = 0;
+			return;
+		}
+
+		OutCache.Name = FName(Identifier->length, reinterpret_cast<const UTF8CHAR*>(Identifier->value));
+		OutCache.NameHash = Identifier->hash;
+	}
+}
+
 void UFlecsEntitySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -33,6 +64,15 @@ void UFlecsEntitySubsystem::Tick(float DeltaTime)
 	if (FlecsWorld)
 	{
 		FlecsWorld.Progress(DeltaTime);
+
+		// Tables and pair records of short lived entities (e.g. parents) would otherwise pile up
+		if (UE::Flecs::Private::DeleteEmptyTablesBudgetMs > 0.f)
+		{
+			ecs_delete_empty_tables_desc_t Desc = {};
+			Desc.delete_generation = static_cast<uint16>(FMath::Clamp(UE::Flecs::Private::DeleteEmptyTablesGeneration, 1, MAX_uint16));
+			Desc.time_budget_seconds = UE::Flecs::Private::DeleteEmptyTablesBudgetMs / 1000.0;
+			FlecsWorld.DeleteEmptyTables(Desc);
+		}
 	}
 }
 
@@ -178,9 +218,33 @@ void UFlecsEntitySubsystem::InitializeFlecsWorld()
 #endif
 	}
 
+	RegisterNameCacheObservers();
 	RegisterSystems();
 }
 
+void UFlecsEntitySubsystem::RegisterNameCacheObservers()
+{
+	FlecsWorld.Component<FFlecsNameCacheComponent>();
+
+	const flecs::world& World = FlecsWorld;
+	World.observer<FFlecsNameCacheComponent>()
+		.event(flecs::OnAdd)
+		.each([](flecs::entity Entity, FFlecsNameCacheComponent& Cache)
+		{
+			UE::Flecs::Private::UpdateNameCache(Entity, Cache);
+		});
+
+	// Runs after the identifier hook, which updates the name hash
+	World.observer<FFlecsNameCacheComponent>()
+		.term_at(0).filter()
+		.with<flecs::Identifier>(flecs::Name)
+		.event(flecs::OnSet)
+		.each([](flecs::entity Entity, FFlecsNameCacheComponent& Cache)
+		{
+			UE::Flecs::Private::UpdateNameCache(Entity, Cache);
+		});
+}
+
 void UFlecsEntitySubsystem::RegisterSystems()
 {
 	check(FlecsWorld);
@@ -0,0 +1,65 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsEntityView.h"
+
+#include "Components/FlecsNameCacheComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsEntityView)
+
+namespace UE::Flecs::Private
+{
+	/** Writes the path into a strbuf on the stack, which only allocates when the path doesn't fit its small string buffer. */
+	template <typename FunctionType>
+	void WithPath(const flecs::world_t* InWorld, const flecs::entity_t InParent, const flecs::entity_t InEntity,
+		const char* InSeparator, const char* InInitSeparator, FunctionType&& Function)
+	{
+		ecs_strbuf_t Buffer = {};
+		ecs_get_path_w_sep_buf(InWorld, InParent, InEntity, InSeparator, InInitSeparator, &Buffer, false);
+		Function(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Buffer.content), ecs_strbuf_written(&Buffer)));
+		ecs_strbuf_reset(&Buffer);
+	}
+}
+
+void FFlecsEntityView::AppendDebugDescription(FStringBuilderBase& OutBuilder) const
+{
+	OutBuilder << TEXT("id: ") << static_cast<uint64>(id_) << TEXT(", name: ") << NameView();
+}
+
+FName FFlecsEntityView::GetFName() const
+{
+	const EcsIdentifier* Identifier = static_cast<const EcsIdentifier*>(
+		ecs_get_id(world_, id_, ecs_pair(ecs_id(EcsIdentifier), EcsName)));
+	if (!Identifier || !Identifier->value)
+	{
+		return NAME_None;
+	}
+
+	const FFlecsNameCacheComponent* Cache = flecs::_::type<FFlecsNameCacheComponent>::registered(world_)
+		? View().try_get<FFlecsNameCacheComponent>()
+		: nullptr;
+
+	if (Cache && Cache->NameHash == Identifier->hash && !Cache->Name.IsNone())
+	{
+		return Cache->Name;
+	}
+
+	return FName(Identifier->length, reinterpret_cast<const UTF8CHAR*>(Identifier->value));
+}
+
+void FFlecsEntityView::AppendPathFrom(FUtf8StringBuilderBase& OutBuilder, const flecs::entity_t InParent,
+	const char* InSeparator, const char* InInitSeparator) const
+{
+	UE::Flecs::Private::WithPath(world_, InParent, id_, InSeparator, InInitSeparator, [&OutBuilder](const FUtf8StringView InPath)
+	{
+		OutBuilder << InPath;
+	});
+}
+
+void FFlecsEntityView::AppendPathFrom(FStringBuilderBase& OutBuilder, const flecs::entity_t InParent,
+	const char* InSeparator, const char* InInitSeparator) const
+{
+	UE::Flecs::Private::WithPath(world_, InParent, id_, InSeparator, InInitSeparator, [&OutBuilder](const FUtf8StringView InPath)
+	{
+		OutBuilder << InPath;
+	});
+}
@@ -462,6 +462,38 @@ namespace UE::Flecs
 				FMemory::Free(Ptr);
 			};
 
+			// Address space of the flat entity index (FLECS_ENTITY_INDEX_FLAT), which is committed a range at a time
+			os_api.vm_reserve_ = [](size_t Size) -> void*
+			{
+				using FVirtualMemoryBlock = FPlatformMemory::FPlatformVirtualMemoryBlock;
+				return FVirtualMemoryBlock::AllocateVirtual(Size).GetVirtualPointer();
+			};
+
+			os_api.vm_commit_ = [](void* Ptr, size_t Size) -> bool
+			{
+				using FVirtualMemoryBlock = FPlatformMemory::FPlatformVirtualMemoryBlock;
+
+				// The range is inside a reserved block, commit it through a block starting at the first page of the range
+				const size_t CommitAlignment = FVirtualMemoryBlock::GetCommitAlignment();
+				const UPTRINT Start = AlignDown(reinterpret_cast<UPTRINT>(Ptr), CommitAlignment);
+				const UPTRINT End = Align(reinterpret_cast<UPTRINT>(Ptr) + Size, CommitAlignment);
+
+				const size_t VirtualSizeAlignment = FVirtualMemoryBlock::GetVirtualSizeAlignment();
+				FVirtualMemoryBlock Block(reinterpret_cast<void*>(Start),
+					static_cast<uint32>(Align(End - Start, VirtualSizeAlignment) / VirtualSizeAlignment));
+				Block.Commit(0, End - Start);
+				return true;
+			};
+
+			os_api.vm_release_ = [](void* Ptr, size_t Size)
+			{
+				using FVirtualMemoryBlock = FPlatformMemory::FPlatformVirtualMemoryBlock;
+
+				const size_t VirtualSizeAlignment = FVirtualMemoryBlock::GetVirtualSizeAlignment();
+				FVirtualMemoryBlock Block(Ptr, static_cast<uint32>(Align(Size, VirtualSizeAlignment) / VirtualSizeAlignment));
+				Block.FreeVirtual();
+			};
+
 			ecs_os_set_api(&os_api);
 
 			bInitialized = true;
@@ -55,9 +55,15 @@ void UFlecsSystem::CallInitialize(const TNotNull<UObject*> InOwner, const FFlecs
 		System.priority(Priority);
 		System.kind(GetDefault<UFlecsPhase>(ExecuteInPhase)->GetFlecsPhaseId());
 
+		// Initialize first so the types used by the system query can be registered there.
+		InitializeInternal(*InOwner, InFlecsWorld);
+
 		BuildSystem(System);
 
-		InitializeInternal(*InOwner, InFlecsWorld);
+		if (bShareQueryCache)
+		{
+			System.share_cache();
+		}
 
 		using std::placeholders::_1;
 		System.run(std::bind(&UFlecsSystem::Run, this, _1));
@@ -124,6 +130,27 @@ bool UFlecsSystem::IsMultithreaded() const
 	return bMultithreaded;
 }
 
+bool UFlecsSystem::SharesQueryCache() const
+{
+	return bShareQueryCache;
+}
+
+const flecs::query_snapshot_t* UFlecsSystem::GetQuerySnapshot() const
+{
+	if (!OwnedSystem)
+	{
+		return nullptr;
+	}
+
+	const flecs::query<> Query = OwnedSystem.query();
+	if (!ecs_query_get_cache_query(Query.c_ptr()))
+	{
+		return nullptr;
+	}
+
+	return Query.snapshot();
+}
+
 FFlecsSystemExecutionOrder& UFlecsSystem::GetExecutionOrder()
 {
 	return ExecutionOrder;
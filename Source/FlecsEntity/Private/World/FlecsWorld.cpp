@@ -2,4 +2,351 @@
 
 #include "World/FlecsWorld.h"
 
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsWorld)
+
+namespace UE::Flecs::Private
+{
+	void ConvertLookupString(const FString& InString, TArray<UTF8CHAR>& OutString)
+	{
+		const auto Converted = StringCast<UTF8CHAR>(*InString);
+		OutString.Reset(Converted.Length() + 1);
+		OutString.Append(Converted.Get(), Converted.Length());
+		OutString.Add(UTF8CHAR('\0'));
+	}
+
+	const char* LookupCString(const TArray<UTF8CHAR>& InString)
+	{
+		return reinterpret_cast<const char*>(InString.GetData());
+	}
+
+	/** Entities found by FFlecsWorld::LookupCached(). */
+	struct FLookupCache
+	{
+		/** Entries are dropped once the cache holds this many names, in case names are generated at runtime */
+		static constexpr int32 MaxEntries = 4096;
+
+		struct FKey
+		{
+			FName Name;
+			FFlecsEntityType Scope = 0;
+			bool bRecursive = true;
+
+			// Entity names are case sensitive, FName comparison and GetTypeHash(FName) are not
+			bool operator==(const FKey& Other) const
+			{
+				return Name.IsEqual(Other.Name, ENameCase::CaseSensitive)
+					&& Scope == Other.Scope && bRecursive == Other.bRecursive;
+			}
+
+			friend uint32 GetTypeHash(const FKey& InKey)
+			{
+				const uint32 NameHash = HashCombineFast(GetTypeHash(InKey.Name.GetDisplayIndex()), InKey.Name.GetNumber());
+				return HashCombineFast(NameHash, GetTypeHash(InKey.Scope)) ^ InKey.bRecursive;
+			}
+		};
+
+		struct FEntry
+		{
+			FFlecsEntityType Entity = 0;
+			FFlecsLookupNames Names;
+
+			/** False for paths that are always searched in the world */
+			bool bCacheable = true;
+		};
+
+		FRWLock Lock;
+		TMap<FKey, FEntry> Entries;
+	};
+
+	/** Binding context of a world, holding the lookup cache and the context set with
+	 * FFlecsWorld::SetBindingContext(). */
+	struct FBindingContext
+	{
+		FLookupCache LookupCache;
+
+		void* Context = nullptr;
+		ecs_ctx_free_t ContextFree = nullptr;
+
+		static void Free(void* InBindingContext)
+		{
+			FBindingContext* BindingContext = static_cast<FBindingContext*>(InBindingContext);
+			if (BindingContext->ContextFree)
+			{
+				BindingContext->ContextFree(BindingContext->Context);
+			}
+
+			delete BindingContext;
+		}
+	};
+
+	FCriticalSection BindingContextLock;
+
+	/** @return The binding context of the world, created on first use */
+	FBindingContext& GetBindingContext(const FFlecsWorldType* InWorld)
+	{
+		FFlecsWorldType* const RealWorld = const_cast<FFlecsWorldType*>(ecs_get_world(InWorld));
+		if (void* BindingContext = ecs_get_binding_ctx(RealWorld))
+		{
+			return *static_cast<FBindingContext*>(BindingContext);
+		}
+
+		FScopeLock Lock(&BindingContextLock);
+		if (void* BindingContext = ecs_get_binding_ctx(RealWorld))
+		{
+			return *static_cast<FBindingContext*>(BindingContext);
+		}
+
+		FBindingContext* BindingContext = new FBindingContext();
+
+		// Publish the context only once it is constructed, lookups read it without locking
+		FPlatformMisc::MemoryBarrier();
+		ecs_set_binding_ctx(RealWorld, BindingContext, &FBindingContext::Free);
+		return *BindingContext;
+	}
+}
+
+FFlecsLookupNames::FFlecsLookupNames(const char* InPath, const char* InSeperator, const char* InRootSeperator)
+{
+	// The full path is looked up as an alias first
+	Hashes.Add(ecs_name_hash(InPath, 0));
+
+	const int32 RootSeperatorLength = InRootSeperator ? FCStringAnsi::Strlen(InRootSeperator) : 0;
+	if (RootSeperatorLength && !FCStringAnsi::Strncmp(InPath, InRootSeperator, RootSeperatorLength))
+	{
+		InPath += RootSeperatorLength;
+	}
+
+	const int32 SeperatorLength = InSeperator ? FCStringAnsi::Strlen(InSeperator) : 0;
+	while (*InPath)
+	{
+		const char* ElementEnd = SeperatorLength ? FCStringAnsi::Strstr(InPath, InSeperator) : nullptr;
+		const int32 ElementLength = ElementEnd
+			? static_cast<int32>(ElementEnd - InPath)
+			: FCStringAnsi::Strlen(InPath);
+
+		if (ElementLength)
+		{
+			Hashes.AddUnique(ecs_name_hash(InPath, ElementLength));
+		}
+
+		InPath += ElementLength;
+		if (ElementEnd)
+		{
+			InPath += SeperatorLength;
+		}
+	}
+}
+
+void FFlecsLookupNames::Resolve(const FFlecsWorldType* InWorld)
+{
+	Versions.SetNumUninitialized(Hashes.Num());
+	for (int32 Index = 0; Index < Hashes.Num(); ++Index)
+	{
+		Versions[Index] = ecs_get_name_version(InWorld, Hashes[Index]);
+	}
+}
+
+bool FFlecsLookupNames::IsResolved(const FFlecsWorldType* InWorld) const
+{
+	if (Versions.Num() != Hashes.Num())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Hashes.Num(); ++Index)
+	{
+		if (Versions[Index] != ecs_get_name_version(InWorld, Hashes[Index]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FFlecsLookupPath::FFlecsLookupPath(const FString& InPath, const FString& InSeperator,
+	const FString& InRootSeperator, const bool bInRecursive)
+	: bRecursive(bInRecursive)
+	, bCacheable(!InPath.Contains(TEXT("#")) && !InPath.Contains(TEXT("\\")))
+{
+	using namespace UE::Flecs::Private;
+	ConvertLookupString(InPath, Path);
+	ConvertLookupString(InSeperator, Seperator);
+	ConvertLookupString(InRootSeperator, RootSeperator);
+
+	if (bCacheable)
+	{
+		Names = FFlecsLookupNames(LookupCString(Path), LookupCString(Seperator), LookupCString(RootSeperator));
+	}
+}
+
+void FFlecsWorld::SetBindingContext(void* ctx, ecs_ctx_free_t ctx_free) const
+{
+	UE::Flecs::Private::FBindingContext& BindingContext = UE::Flecs::Private::GetBindingContext(World.c_ptr());
+	BindingContext.Context = ctx;
+	BindingContext.ContextFree = ctx_free;
+}
+
+void* FFlecsWorld::GetBindingContext() const
+{
+	return UE::Flecs::Private::GetBindingContext(World.c_ptr()).Context;
+}
+
+FFlecsEntity FFlecsWorld::Lookup(const FFlecsLookupPath& InPath) const
+{
+	using namespace UE::Flecs::Private;
+
+	if (InPath.Path.IsEmpty())
+	{
+		return FFlecsEntity();
+	}
+
+	FFlecsWorldType* const WorldPtr = World.c_ptr();
+	const FFlecsWorldType* const RealWorld = ecs_get_world(WorldPtr);
+	const FFlecsEntityType Scope = ecs_get_scope(WorldPtr);
+
+	// A custom lookup path can change without the world knowing, so always search the world
+	const bool bCanUseResolved = InPath.bCacheable && !ecs_get_lookup_path(WorldPtr);
+
+	if (bCanUseResolved
+		&& InPath.ResolvedWorld == RealWorld
+		&& InPath.ResolvedScope == Scope
+		&& InPath.Names.IsResolved(RealWorld))
+	{
+		return FFlecsEntity(flecs::entity(World, InPath.ResolvedEntity));
+	}
+
+	const FFlecsEntityType Entity = ecs_lookup_path_w_sep(WorldPtr, 0,
+		LookupCString(InPath.Path), LookupCString(InPath.Seperator), LookupCString(InPath.RootSeperator),
+		InPath.bRecursive);
+
+	if (bCanUseResolved)
+	{
+		InPath.ResolvedWorld = RealWorld;
+		InPath.ResolvedScope = Scope;
+		InPath.Names.Resolve(RealWorld);
+		InPath.ResolvedEntity = Entity;
+	}
+
+	return FFlecsEntity(flecs::entity(World, Entity));
+}
+
+FFlecsEntity FFlecsWorld::LookupCached(const FName& InName, const bool bInRecursive) const
+{
+	using namespace UE::Flecs::Private;
+
+	FFlecsWorldType* const WorldPtr = World.c_ptr();
+
+	// A custom lookup path can change without the world knowing, so always search the world
+	if (ecs_get_lookup_path(WorldPtr))
+	{
+		return Lookup(InName.ToString(), TEXT("::"), TEXT("::"), bInRecursive);
+	}
+
+	const FFlecsWorldType* const RealWorld = ecs_get_world(WorldPtr);
+	FLookupCache& LookupCache = GetBindingContext(RealWorld).LookupCache;
+	const FLookupCache::FKey Key { InName, ecs_get_scope(WorldPtr), bInRecursive };
+
+	bool bCacheable = true;
+
+	{
+		FReadScopeLock ReadLock(LookupCache.Lock);
+		if (const FLookupCache::FEntry* Entry = LookupCache.Entries.Find(Key))
+		{
+			if (!Entry->bCacheable)
+			{
+				bCacheable = false;
+			}
+			else if (Entry->Names.IsResolved(RealWorld))
+			{
+				return FFlecsEntity(flecs::entity(World, Entry->Entity));
+			}
+		}
+	}
+
+	const FString Name = InName.ToString();
+
+	FLookupCache::FEntry Entry;
+
+	// Paths with entity ids ("#123") depend on entity liveness, and escaped separators don't split into the names
+	// that are looked up
+	if (bCacheable)
+	{
+		Entry.bCacheable = !Name.Contains(TEXT("#")) && !Name.Contains(TEXT("\\"));
+	}
+
+	const auto Path = StringCast<UTF8CHAR>(*Name);
+	const char* const PathString = reinterpret_cast<const char*>(Path.Get());
+
+	if (Entry.bCacheable)
+	{
+		Entry.Names = FFlecsLookupNames(PathString, "::", "::");
+		Entry.Names.Resolve(RealWorld);
+	}
+
+	Entry.Entity = ecs_lookup_path_w_sep(WorldPtr, 0, PathString, "::", "::", bInRecursive);
+
+	const FFlecsEntityType Entity = Entry.Entity;
+
+	if (bCacheable)
+	{
+		// Replaces the entry if one of its names changed
+		FWriteScopeLock WriteLock(LookupCache.Lock);
+		if (LookupCache.Entries.Num() >= FLookupCache::MaxEntries && !LookupCache.Entries.Contains(Key))
+		{
+			LookupCache.Entries.Reset();
+		}
+
+		LookupCache.Entries.Add(Key, MoveTemp(Entry));
+	}
+
+	return FFlecsEntity(flecs::entity(World, Entity));
+}
+
+int32 FFlecsWorld::AreAlive(TConstArrayView<FFlecsEntityType> InEntities, TBitArray<>& OutAlive) const
+{
+	TArray<bool, TInlineAllocator<256>> Alive;
+	Alive.SetNumUninitialized(InEntities.Num());
+
+	const int32 NumAlive = ecs_is_alive_n(World.c_ptr(), InEntities.GetData(), InEntities.Num(), Alive.GetData());
+
+	OutAlive.Init(false, InEntities.Num());
+	for (int32 Index = 0; Index < Alive.Num(); ++Index)
+	{
+		if (Alive[Index])
+		{
+			OutAlive[Index] = true;
+		}
+	}
+
+	return NumAlive;
+}
+
+void FFlecsWorld::GetLocations(TConstArrayView<FFlecsEntityType> InEntities, TArrayView<FFlecsEntityLocation> OutLocations) const
+{
+	checkf(InEntities.Num() == OutLocations.Num(), TEXT("Expected %d locations, got %d"), InEntities.Num(), OutLocations.Num());
+
+	TArray<ecs_record_t*, TInlineAllocator<256>> Records;
+	Records.SetNumUninitialized(InEntities.Num());
+
+	ecs_record_find_n(World.c_ptr(), InEntities.GetData(), InEntities.Num(), Records.GetData());
+
+	for (int32 Index = 0; Index < Records.Num(); ++Index)
+	{
+		const ecs_record_t* Record = Records[Index];
+		OutLocations[Index] = Record
+			? FFlecsEntityLocation { Record->table, static_cast<int32>(ECS_RECORD_TO_ROW(Record->row)) }
+			: FFlecsEntityLocation();
+	}
+}
+
+void FFlecsWorld::TryGetMany(TConstArrayView<FFlecsEntityType> InEntities, const FFlecsIdType InComponent,
+	TArrayView<const void*> OutComponents) const
+{
+	checkf(InEntities.Num() == OutComponents.Num(), TEXT("Expected %d components, got %d"), InEntities.Num(), OutComponents.Num());
+
+	ecs_get_id_n(World.c_ptr(), InEntities.GetData(), InEntities.Num(), InComponent, OutComponents.GetData());
+}
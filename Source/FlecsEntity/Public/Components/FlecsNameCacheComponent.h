@@ -0,0 +1,23 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "FlecsEntityElementTypes.h"
+
+#include "FlecsNameCacheComponent.generated.h"
+
+/** 
+ * Caches the entity name as an FName, for entities whose name is frequently needed on the UE side.
+ * Filled when added and refreshed when the entity is renamed, by observers registered by UFlecsEntitySubsystem.
+ * FFlecsEntityView::GetFName only reads it.
+ */
+USTRUCT()
+struct FFlecsNameCacheComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	FName Name;
+
+	/** Hash of the flecs name that Name was created from. */
+	uint64 NameHash = 0;
+};
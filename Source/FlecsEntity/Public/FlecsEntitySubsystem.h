@@ -76,6 +76,9 @@ protected:
 
 	void RegisterSystems();
 
+	/** Registers the observers keeping FFlecsNameCacheComponent in sync with the entity name. */
+	void RegisterNameCacheObservers();
+
 protected:
 	UPROPERTY()
 	TArray<TObjectPtr<UFlecsSystem>> Systems;
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "FlecsId.h"
+#include "Containers/StringView.h"
+#include "Misc/StringBuilder.h"
 
 #include "FlecsEntityView.generated.h"
 
@@ -55,7 +57,22 @@ struct UE_API FFlecsEntityView : public FFlecsId
 		return ReturnValue;
 	}
 
-	FString DebugGetDescription() const { return FString::Printf(TEXT("id: %llu, name: %s"), id_, *Name()); }
+	FString DebugGetDescription() const
+	{
+		TStringBuilder<128> Builder;
+		AppendDebugDescription(Builder);
+		return FString(Builder.ToView());
+	}
+
+	/** Append "id: <id>, name: <name>" to a string builder. */
+	void AppendDebugDescription(FStringBuilderBase& OutBuilder) const;
+
+	/** Append "id: <id>, name: <name>" to a string builder, e.g. *WriteToString<128>(Entity) for logging. */
+	friend FStringBuilderBase& operator<<(FStringBuilderBase& OutBuilder, const FFlecsEntityView& InEntityView)
+	{
+		InEntityView.AppendDebugDescription(OutBuilder);
+		return OutBuilder;
+	}
 
 	/** Check if entity is valid.
 	 * An entity is valid if:
@@ -94,16 +111,43 @@ struct UE_API FFlecsEntityView : public FFlecsId
 	 */
 	FString Name() const
 	{
-		return View().name().c_str();
+		return FString(NameView());
 	}
 
+	/** Return the entity name without copying it.
+	 * The view is invalidated when the entity is renamed or deleted.
+	 *
+	 * @return The entity name, or an empty view if the entity has no name.
+	 */
+	FUtf8StringView NameView() const
+	{
+		return IdentifierView(EcsName);
+	}
+
+	/** Return the entity name as FName.
+	 * Entities with FFlecsNameCacheComponent return the cached FName, which is refreshed when they are renamed.
+	 *
+	 * @return The entity name, or NAME_None if the entity has no name.
+	 */
+	FName GetFName() const;
+
 	/** Return the entity symbol.
 	 *
 	 * @return The entity symbol.
 	 */
 	FString Symbol() const
 	{
-		return View().symbol().c_str();
+		return FString(SymbolView());
+	}
+
+	/** Return the entity symbol without copying it.
+	 * The view is invalidated when the symbol changes or the entity is deleted.
+	 *
+	 * @return The entity symbol, or an empty view if the entity has no symbol.
+	 */
+	FUtf8StringView SymbolView() const
+	{
+		return IdentifierView(EcsSymbol);
 	}
 
 	/** Return the entity path.
@@ -112,16 +156,37 @@ struct UE_API FFlecsEntityView : public FFlecsId
 	 */
 	FString Path(const char* InSeparator = "::", const char* InInitSeparator = "::") const
 	{
-		return View().path(InSeparator, InInitSeparator).c_str();
+		TStringBuilder<256> Builder;
+		AppendPath(Builder, InSeparator, InInitSeparator);
+		return FString(Builder.ToView());
+	}
+
+	/** Append the entity path to a string builder.
+	 * Paths that fit in a small stack buffer are written without allocating.
+	 */
+	void AppendPath(FUtf8StringBuilderBase& OutBuilder, const char* InSeparator = "::", const char* InInitSeparator = "::") const
+	{
+		AppendPathFrom(OutBuilder, 0, InSeparator, InInitSeparator);
 	}
 
+	void AppendPath(FStringBuilderBase& OutBuilder, const char* InSeparator = "::", const char* InInitSeparator = "::") const
+	{
+		AppendPathFrom(OutBuilder, 0, InSeparator, InInitSeparator);
+	}
+
+	/** Append the entity path relative to a parent to a string builder. */
+	void AppendPathFrom(FUtf8StringBuilderBase& OutBuilder, const flecs::entity_t InParent, const char* InSeparator = "::", const char* InInitSeparator = "::") const;
+	void AppendPathFrom(FStringBuilderBase& OutBuilder, const flecs::entity_t InParent, const char* InSeparator = "::", const char* InInitSeparator = "::") const;
+
 	/** Return the entity path relative to a parent.
 	 *
 	 * @return The relative hierarchical entity path.
 	 */
 	FString PathFrom(const flecs::entity_t InParent, const char* InSeparator = "::", const char* InInitSeparator = "::") const
 	{
-		return View().path_from(InParent, InSeparator, InInitSeparator).c_str();
+		TStringBuilder<256> Builder;
+		AppendPathFrom(Builder, InParent, InSeparator, InInitSeparator);
+		return FString(Builder.ToView());
 	}
 
 
@@ -132,7 +197,7 @@ struct UE_API FFlecsEntityView : public FFlecsId
 	template <typename Parent>
 	FString PathFrom(const char* InSeparator = "::", const char* InInitSeparator = "::") const
 	{
-		return View().template path_from<Parent>(InSeparator, InInitSeparator).c_str();
+		return PathFrom(flecs::_::type<Parent>::id(world_), InSeparator, InInitSeparator);
 	}
 
 	bool Enabled() const
@@ -150,6 +215,18 @@ public:
 	{
 		return GetTypeHash(InEntityView.id_);
 	}
+
+private:
+	FUtf8StringView IdentifierView(const flecs::entity_t InTag) const
+	{
+		const EcsIdentifier* Identifier = static_cast<const EcsIdentifier*>(
+			ecs_get_id(world_, id_, ecs_pair(ecs_id(EcsIdentifier), InTag)));
+		if (!Identifier || !Identifier->value)
+		{
+			return FUtf8StringView();
+		}
+		return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Identifier->value), Identifier->length);
+	}
 };
 
 static_assert(sizeof(FFlecsEntityView) == sizeof(flecs::entity_view), "FFlecsEntityView size mismatch with flecs::entity_view");
@@ -56,6 +56,11 @@ public:
 
 	bool IsImmediate() const;
 	bool IsMultithreaded() const;
+	bool SharesQueryCache() const;
+
+	/** Table ranges matched by the system query, rebuilt at most once per frame and shared between systems that
+	 *  share a query cache. Returns nullptr if the system isn't initialized or its query isn't cached. */
+	UE_API const flecs::query_snapshot_t* GetQuerySnapshot() const;
 
 	UE_API virtual FFlecsSystemExecutionOrder& GetExecutionOrder();
 
@@ -83,7 +88,7 @@ public:
 #endif
 
 protected:
-	/** Called to initialize the system's internal state. Override to perform custom steps. */
+	/** Called to initialize the system's internal state, before BuildSystem. Override to perform custom steps. */
 	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld);
 
 	UE_API virtual void BuildSystem(flecs::system_builder<>& SystemBuilder);
@@ -126,6 +131,11 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="System", Config)
 	uint8 bMultithreaded : 1 = false;
 
+	/** Specify whether the system query should share its cache with other systems with identical terms.
+	 * Only applies to queries without sorting, grouping or change detection. */
+	UPROPERTY(EditDefaultsOnly, Category="System", Config)
+	uint8 bShareQueryCache : 1 = false;
+
 	/** Interval in seconds at which the system should run */
 	UPROPERTY(EditDefaultsOnly, Category="System", Config)
 	double Interval = 0.0;
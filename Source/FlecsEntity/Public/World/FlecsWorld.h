@@ -34,6 +34,73 @@
  * that forces the API to ignore the old component ids. */
 typedef flecs::world_t FFlecsWorldType;
 
+/** Hashes of the names an entity path lookup depends on: the full path, which can be an alias, and each element of
+ * the path. Remembers the versions of the names so that a cached lookup is only invalidated when one of its names
+ * changed, see ecs_get_name_version().
+ */
+struct FFlecsLookupNames
+{
+	FFlecsLookupNames() = default;
+
+	UE_API FFlecsLookupNames(const char* InPath, const char* InSeperator, const char* InRootSeperator);
+
+	/** Stores the current versions of the names. */
+	UE_API void Resolve(const FFlecsWorldType* InWorld);
+
+	/** @return Whether none of the names changed since the last call to Resolve() */
+	UE_API bool IsResolved(const FFlecsWorldType* InWorld) const;
+
+private:
+	TArray<uint64, TInlineAllocator<4>> Hashes;
+	TArray<uint32, TInlineAllocator<4>> Versions;
+};
+
+/** Entity path that is converted to UTF-8 once, and remembers the entity it resolved to. Looking up the path again
+ * only searches the world after an entity or alias with one of the names in the path was created, deleted, renamed
+ * or reparented. Changing the parent of the current scope is not detected.
+ * A path must not be looked up from multiple threads at the same time.
+ *
+ * @see FFlecsWorld::Lookup()
+ */
+struct FFlecsLookupPath
+{
+	FFlecsLookupPath() = default;
+
+	UE_API explicit FFlecsLookupPath(const FString& InPath, const FString& InSeperator = "::",
+		const FString& InRootSeperator = "::", const bool bInRecursive = true);
+
+private:
+	friend struct FFlecsWorld;
+
+	TArray<UTF8CHAR> Path;
+	TArray<UTF8CHAR> Seperator;
+	TArray<UTF8CHAR> RootSeperator;
+	bool bRecursive = true;
+
+	/** Paths with entity ids ("#123") depend on entity liveness, and paths with escaped separators don't split into
+	 * the names they are looked up with. They are always looked up. */
+	bool bCacheable = true;
+
+	mutable FFlecsLookupNames Names;
+	mutable const FFlecsWorldType* ResolvedWorld = nullptr;
+	mutable FFlecsEntityType ResolvedScope = 0;
+	mutable FFlecsEntityType ResolvedEntity = 0;
+};
+
+/** Table and row of an entity, as returned by FFlecsWorld::GetLocations(). Only valid until the next structural
+ * change of the entity.
+ */
+struct FFlecsEntityLocation
+{
+	/** Table of the entity, or nullptr if the entity is not alive. */
+	flecs::table_t* Table = nullptr;
+
+	/** Row of the entity in the table, or INDEX_NONE if the entity is not alive. */
+	int32 Row = INDEX_NONE;
+
+	bool IsValid() const { return Table != nullptr; }
+};
+
 /**
  * The world.
  * 
@@ -191,6 +258,18 @@ struct FFlecsWorld
 	 */
 	bool UsesTaskThreads() const { return World.using_task_threads(); }
 
+	/** Set max time in seconds spent rematching query caches per merge. Queries that don't fit in the budget are
+	 * rematched in later merges and return stale (but valid) results until then. 0 rematches immediately.
+	 * @see ecs_set_rematch_budget
+	 */
+	void SetRematchBudget(const ecs_ftime_t InBudget) const { World.set_rematch_budget(InBudget); }
+
+	/** Get max time in seconds spent rematching query caches per merge. */
+	ecs_ftime_t GetRematchBudget() const { return World.get_rematch_budget(); }
+
+	/** Get number of queries that still need to be rematched. */
+	int32 GetPendingRematchCount() const { return World.get_pending_rematch_count(); }
+
 	/** Signal application should quit. After calling this operation, the next call to Progress() returns false. */
 	void Quit() const { World.quit(); }
 
@@ -444,13 +523,16 @@ struct FFlecsWorld
 	 * Same as set_ctx() but for binding context. A binding context is intended
 	 * specifically for language bindings to store binding specific data.
 	 *
+	 * The binding context of the world holds the cache of LookupCached(), the
+	 * context set here is stored next to it. Don't use ecs_set_binding_ctx()
+	 * directly on worlds used with FFlecsWorld.
+	 *
 	 * @param ctx A pointer to a user defined structure.
 	 * @param ctx_free A function that is invoked with ctx when the world is freed.
 	 *
-	 * @see ecs_set_binding_ctx()
 	 * @see FFlecsWorld::GetBindingContext()
 	 */
-	void SetBindingContext(void* ctx, ecs_ctx_free_t ctx_free = nullptr) const { World.set_binding_ctx(ctx, ctx_free); }
+	UE_API void SetBindingContext(void* ctx, ecs_ctx_free_t ctx_free = nullptr) const;
 
 	/** Get world binding context.
 	 * This operation retrieves a previously set world binding context.
@@ -458,10 +540,9 @@ struct FFlecsWorld
 	 * @return The context set with set_binding_ctx(). If no context was set, the
 	 *         function returns NULL.
 	 *
-	 * @see ecs_get_binding_ctx()
 	 * @see FFlecsWorld::SetBindingContext()
 	 */
-	void* GetBindingContext() const { return World.get_binding_ctx(); }
+	UE_API void* GetBindingContext() const;
 
 	/** Preallocate memory for number of entities.
 	 * This function preallocates memory for the entity index.
@@ -543,6 +624,28 @@ struct FFlecsWorld
 			bInRecursive));
 	}
 
+	/** Lookup entity by path with a pre-converted path, that remembers the entity it resolved to.
+	 *
+	 * @param InPath Entity path.
+	 * @result The entity if found, or 0 if not found.
+	 */
+	UE_API FFlecsEntity Lookup(const FFlecsLookupPath& InPath) const;
+
+	/** Lookup entity by name or "::" separated path, using a cache keyed by name and scope that is stored in the
+	 * binding context of the world. A name is only searched again after an entity or alias with one of the names in
+	 * the path was created, deleted, renamed or reparented. Changing the parent of the current scope is not detected.
+	 * Names that only differ in case are cached separately, except in builds without WITH_CASE_PRESERVING_NAME, where
+	 * FNames can't tell them apart.
+	 *
+	 * Intended for a fixed set of names. The cache is cleared once it holds a few thousand names, so looking up
+	 * names that are generated at runtime makes other lookups search the world again.
+	 *
+	 * @param InName Entity name.
+	 * @param bInRecursive When false, only the current scope is searched.
+	 * @result The entity if found, or 0 if not found.
+	 */
+	UE_API FFlecsEntity LookupCached(const FName& InName, const bool bInRecursive = true) const;
+
 	/** Set singleton component. */
 	template <typename T, flecs::if_t<!flecs::is_callable<T>::value> = 0>
 	void Set(const T& Value) const { World.set<T>(Value); }
@@ -1006,6 +1109,48 @@ struct FFlecsWorld
 	 */
 	bool IsValid(const FFlecsEntityType InEntity) const { return World.is_valid(InEntity); }
 
+	/** Check which entities of a list are alive. Faster than calling IsAlive() for each entity of a list that is not
+	 * in the order the entities were created in, as the lookups of multiple entities overlap. Entity id 0 is not alive.
+	 *
+	 * @param InEntities Entities to check.
+	 * @param OutAlive Set to one bit per entity.
+	 * @return The number of alive entities.
+	 * @see ecs_is_alive_n()
+	 * @see FFlecsWorld::IsAlive()
+	 */
+	UE_API int32 AreAlive(TConstArrayView<FFlecsEntityType> InEntities, TBitArray<>& OutAlive) const;
+
+	/** Get the table and row of each entity of a list. Locations of entities that are not alive are left unset.
+	 *
+	 * @param InEntities Entities to look up.
+	 * @param OutLocations Locations, must have the same number of elements as InEntities.
+	 * @see ecs_record_find_n()
+	 */
+	UE_API void GetLocations(TConstArrayView<FFlecsEntityType> InEntities, TArrayView<FFlecsEntityLocation> OutLocations) const;
+
+	/** Get a component of each entity of a list. Faster than calling TryGet() on each entity of a list that is not in
+	 * the order the entities were created in. Pointers are only valid until the next structural change of the entity.
+	 *
+	 * @param InEntities Entities to get the component of.
+	 * @param InComponent The component to get.
+	 * @param OutComponents Component pointers, must have the same number of elements as InEntities. Pointers are
+	 * nullptr for entities that are not alive or don't have the component.
+	 * @see ecs_get_id_n()
+	 */
+	UE_API void TryGetMany(TConstArrayView<FFlecsEntityType> InEntities, const FFlecsIdType InComponent,
+		TArrayView<const void*> OutComponents) const;
+
+	/** Get a component of each entity of a list.
+	 *
+	 * @see FFlecsWorld::TryGetMany()
+	 */
+	template <typename T>
+	void TryGetMany(TConstArrayView<FFlecsEntityType> InEntities, TArrayView<const T*> OutComponents) const
+	{
+		TryGetMany(InEntities, flecs::_::type<T>::id(World.c_ptr()),
+			TArrayView<const void*>(reinterpret_cast<const void**>(OutComponents.GetData()), OutComponents.Num()));
+	}
+
 	/** Get alive entity for id.
 	 * Returns the entity with the current generation.
 	 *
@@ -1042,6 +1187,14 @@ struct FFlecsWorld
 	 */
 	void Shrink() const { World.shrink(); }
 
+	/** Cleanup empty tables and release unused pair records.
+	 *
+	 * @param InDesc Configuration parameters.
+	 * @return Number of deleted tables.
+	 * @see ecs_delete_empty_tables()
+	 */
+	int32 DeleteEmptyTables(const ecs_delete_empty_tables_desc_t& InDesc) const { return ecs_delete_empty_tables(World.c_ptr(), &InDesc); }
+
 	/** Begin exclusive access
 	 * 
 	 * @param InThreadName Optional thread name for improved debug messages.
@@ -1065,6 +1218,16 @@ struct FFlecsWorld
 	template <typename T>
 	FFlecsIdType IdIfRegistered() const { return World.id_if_registered<T>(); }
 
+	/** Find or register component.
+	 * Auto registration is disabled, so components have to be registered
+	 * explicitly before they are used.
+	 *
+	 * @tparam T The component type.
+	 * @return The component.
+	 */
+	template <typename T>
+	flecs::component<T> Component() const { return World.component<T>(); }
+
 	/** Return type info */
 	const flecs::type_info_t* TypeInfo(const FFlecsIdType InComponent) { return World.type_info(InComponent); }
 
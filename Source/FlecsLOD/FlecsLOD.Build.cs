@@ -11,6 +11,7 @@ public class FlecsLOD : ModuleRules
             {
                 "Core",
                 "FlecsEntity",
+                "FlecsLibrary",
             }
         );
 
@@ -19,6 +20,7 @@ public class FlecsLOD : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "FlecsEngine",
             }
         );
     }
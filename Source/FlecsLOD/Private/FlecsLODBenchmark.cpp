@@ -0,0 +1,126 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsLODCalculation.h"
+#include "FlecsLODSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Transform/FlecsEngineTransformComponents.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFlecsLOD, Log, All);
+
+namespace UE::FlecsLOD::Private
+{
+	/**
+	 * Runs the viewer distance pass of UFlecsSystem_LODCalculator in a standalone world, batched as the system does and
+	 * one entity at a time for reference. Timings are averaged over the frames.
+	 */
+	void RunBenchmark(const TArray<FString>& Args)
+	{
+		const int32 NumEntities = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+		const int32 NumViewers = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 4;
+		const int32 NumFrames = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 60;
+
+		constexpr double Extent = 50000.;
+
+		flecs::world World;
+		World.component<FFlecsTransformComponent>();
+
+		FRandomStream Random(NumEntities);
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			const FVector Location(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), Random.FRandRange(0., 1000.));
+			World.entity().set<FFlecsTransformComponent>(FFlecsTransformComponent(FTransform(Location)));
+		}
+
+		TArray<FFlecsViewerInfo> ViewerInfos;
+		for (int32 Index = 0; Index < NumViewers; ++Index)
+		{
+			FFlecsViewerInfo& Viewer = ViewerInfos.AddDefaulted_GetRef();
+			Viewer.Location = FVector(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), 200.);
+			Viewer.Rotation = FRotator(0., Random.FRandRange(0., 360.), 0.);
+			BuildViewerFrustum(Viewer);
+		}
+
+		TArray<FViewerVectors> Viewers;
+		TArray<FPlaneVectors> Planes;
+		BuildViewerVectors(ViewerInfos, Viewers, Planes);
+
+		flecs::query<const FFlecsTransformComponent> Query = World.query_builder<const FFlecsTransformComponent>().build();
+
+		double BatchedTime = 0.;
+		double ScalarTime = 0.;
+		int64 NumBatchedVisible = 0;
+		int64 NumScalarVisible = 0;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			Query.run([&](flecs::iter& Iterator)
+			{
+				while (Iterator.next())
+				{
+					const flecs::field<const FFlecsTransformComponent> Transforms = Iterator.field<const FFlecsTransformComponent>(0);
+					const int32 Num = static_cast<int32>(Iterator.count());
+					for (int32 BatchStart = 0; BatchStart < Num; BatchStart += BatchSize)
+					{
+						const int32 BatchNum = FMath::Min(BatchSize, Num - BatchStart);
+
+						alignas(16) float X[BatchSize];
+						alignas(16) float Y[BatchSize];
+						alignas(16) float Z[BatchSize];
+						for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+						{
+							const FVector& Location = Transforms[BatchStart + FMath::Min(Lane, BatchNum - 1)].GetTransform().GetLocation();
+							X[Lane] = static_cast<float>(Location.X);
+							Y[Lane] = static_cast<float>(Location.Y);
+							Z[Lane] = static_cast<float>(Location.Z);
+						}
+
+						VectorRegister4Float ClosestDistanceSq;
+						VectorRegister4Float ClosestDistanceToFrustum;
+						CalculateViewerDistances(Viewers, Planes, VectorLoadAligned(X), VectorLoadAligned(Y), VectorLoadAligned(Z), ClosestDistanceSq, ClosestDistanceToFrustum);
+
+						alignas(16) float DistancesToFrustum[BatchSize];
+						VectorStoreAligned(ClosestDistanceToFrustum, DistancesToFrustum);
+						for (int32 Lane = 0; Lane < BatchNum; ++Lane)
+						{
+							NumBatchedVisible += DistancesToFrustum[Lane] <= 0.f;
+						}
+					}
+				}
+			});
+			BatchedTime += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			Query.each([&](const FFlecsTransformComponent& Transform)
+			{
+				const FVector& Location = Transform.GetTransform().GetLocation();
+				double ClosestDistanceSq = DBL_MAX;
+				double ClosestDistanceToFrustum = DBL_MAX;
+				for (const FFlecsViewerInfo& Viewer : ViewerInfos)
+				{
+					ClosestDistanceSq = FMath::Min(ClosestDistanceSq, FVector::DistSquared(Location, Viewer.Location));
+
+					double DistanceToFrustum = -DBL_MAX;
+					for (const FPlane& Plane : Viewer.Frustum.Planes)
+					{
+						DistanceToFrustum = FMath::Max(DistanceToFrustum, Plane.PlaneDot(Location));
+					}
+					ClosestDistanceToFrustum = FMath::Min(ClosestDistanceToFrustum, DistanceToFrustum);
+				}
+				NumScalarVisible += ClosestDistanceToFrustum <= 0.;
+			});
+			ScalarTime += FPlatformTime::Seconds() - StartTime;
+		}
+
+		const double FrameScale = 1000. / FMath::Max(NumFrames, 1);
+		UE_LOG(LogFlecsLOD, Display, TEXT("LOD distance benchmark: %d entities, %d viewers, %d frames"), NumEntities, NumViewers, NumFrames);
+		UE_LOG(LogFlecsLOD, Display, TEXT("  Batched: %.3f ms/frame, %lld visible"), BatchedTime * FrameScale, NumBatchedVisible);
+		UE_LOG(LogFlecsLOD, Display, TEXT("  Per entity: %.3f ms/frame, %lld visible"), ScalarTime * FrameScale, NumScalarVisible);
+	}
+
+	FAutoConsoleCommand BenchmarkCommand(
+		TEXT("flecs.LOD.Benchmark"),
+		TEXT("Benchmarks the viewer distance computation of the LOD calculator. Arguments: [NumEntities=100000] [NumViewers=4] [NumFrames=60]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmark));
+}
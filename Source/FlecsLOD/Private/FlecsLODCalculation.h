@@ -0,0 +1,46 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+struct FFlecsViewerInfo;
+
+/** LOD math shared by the LOD systems and the LOD benchmark */
+namespace UE::FlecsLOD::Private
+{
+	/** Number of entities processed at once by the distance computation */
+	constexpr int32 BatchSize = 4;
+
+	struct FPlaneVectors
+	{
+		VectorRegister4Float NormalX;
+		VectorRegister4Float NormalY;
+		VectorRegister4Float NormalZ;
+		VectorRegister4Float W;
+	};
+
+	struct FViewerVectors
+	{
+		VectorRegister4Float LocationX;
+		VectorRegister4Float LocationY;
+		VectorRegister4Float LocationZ;
+		int32 FirstPlane = 0;
+		int32 NumPlanes = 0;
+	};
+
+	/** Builds the side planes of the viewer's frustum from its location, rotation, FOV and aspect ratio */
+	void BuildViewerFrustum(FFlecsViewerInfo& Viewer);
+
+	/** Splats the viewers' locations and frustum planes once so they can be tested against a batch of entities at a time */
+	void BuildViewerVectors(TConstArrayView<FFlecsViewerInfo> Viewers, TArray<FViewerVectors>& OutViewers, TArray<FPlaneVectors>& OutPlanes);
+
+	/**
+	 * Computes the squared distance to the closest viewer and the signed distance to the closest frustum for a batch of locations.
+	 * Locations are processed in single precision, which is plenty for LOD purposes.
+	 */
+	void CalculateViewerDistances(TConstArrayView<FViewerVectors> Viewers, TConstArrayView<FPlaneVectors> Planes,
+		const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z,
+		VectorRegister4Float& OutClosestDistanceSq, VectorRegister4Float& OutClosestDistanceToFrustum);
+}
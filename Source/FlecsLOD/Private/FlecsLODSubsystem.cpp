@@ -0,0 +1,92 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsLODSubsystem.h"
+
+#include "FlecsEntitySubsystem.h"
+#include "World/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsLODSubsystem)
+
+namespace UE::MassLOD
+{
+	FColor LODColors[] =
+	{
+		FColor::Red,
+		FColor::Yellow,
+		FColor::Emerald,
+		FColor::White,
+		FColor::Green,
+	};
+	static_assert(UE_ARRAY_COUNT(LODColors) == EFlecsLOD::Max + 1, "Expecting a color per LOD plus one for the unset LOD");
+}
+
+namespace UE::Mass::ProcessorGroupNames
+{
+	const FName LODCollector = FName(TEXT("LODCollector"));
+	const FName LOD = FName(TEXT("LOD"));
+}
+
+UFlecsLODSubsystem::UFlecsLODSubsystem()
+{
+	TickPeriodPerLOD[EFlecsLOD::High] = 1;
+	TickPeriodPerLOD[EFlecsLOD::Medium] = 2;
+	TickPeriodPerLOD[EFlecsLOD::Low] = 4;
+	TickPeriodPerLOD[EFlecsLOD::Off] = 8;
+}
+
+void UFlecsLODSubsystem::SetViewers(TArray<FFlecsViewerInfo>&& InViewers)
+{
+	Viewers = MoveTemp(InViewers);
+	LastViewersUpdateFrame = GFrameCounter;
+}
+
+flecs::entity_t UFlecsLODSubsystem::AssignTickBucket(const EFlecsLOD::Type LOD)
+{
+	const int32 BucketIndex = NextTickBucket[LOD];
+	NextTickBucket[LOD] = (BucketIndex + 1) % TickBuckets[LOD].Num();
+	return TickBuckets[LOD][BucketIndex];
+}
+
+void UFlecsLODSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UFlecsEntitySubsystem* EntitySubsystem = Collection.InitializeDependency<UFlecsEntitySubsystem>();
+	checkfSlow(EntitySubsystem != nullptr, TEXT("FlecsEntitySubsystem is required"));
+
+	const FFlecsWorld& FlecsWorld = EntitySubsystem->GetFlecsWorld();
+
+	// The LOD tags are toggled rather than added and removed, so a LOD change never moves the entity between tables.
+	const flecs::entity LODTags[EFlecsLOD::Max] =
+	{
+		FlecsWorld.Component<FFlecsHighLODTag>().add(flecs::CanToggle),
+		FlecsWorld.Component<FFlecsMediumLODTag>().add(flecs::CanToggle),
+		FlecsWorld.Component<FFlecsLowLODTag>().add(flecs::CanToggle),
+		FlecsWorld.Component<FFlecsOffLODTag>().add(flecs::CanToggle),
+	};
+
+	FlecsWorld.Component<FFlecsViewerInfoComponent>();
+
+	const flecs::component<FFlecsLODComponent> LODComponent = FlecsWorld.Component<FFlecsLODComponent>();
+	LODComponent.add(flecs::With, FlecsWorld.Component<FFlecsViewerInfoComponent>());
+	for (const flecs::entity& LODTag : LODTags)
+	{
+		LODComponent.add(flecs::With, LODTag);
+	}
+
+	// The tick buckets don't fragment either. Each bucket keeps its entities in the pair's sparse set,
+	// which is what lets variable tick systems visit only the bucket that is due.
+	FlecsWorld.Component<FFlecsLODTickBucket>().add(flecs::Exclusive).add(flecs::DontFragment);
+
+	const flecs::world& World = FlecsWorld;
+	for (int32 LOD = EFlecsLOD::High; LOD < EFlecsLOD::Max; ++LOD)
+	{
+		const int32 TickPeriod = FMath::Clamp(TickPeriodPerLOD[LOD], 1, UE::MassLOD::MaxBucketsPerLOD);
+		TickBuckets[LOD].Reset(TickPeriod);
+		for (int32 BucketIndex = 0; BucketIndex < TickPeriod; ++BucketIndex)
+		{
+			TickBuckets[LOD].Add(World.entity());
+		}
+		NextTickBucket[LOD] = 0;
+	}
+}
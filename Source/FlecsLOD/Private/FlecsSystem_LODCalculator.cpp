@@ -0,0 +1,290 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSystem_LODCalculator.h"
+
+#include "FlecsLODCalculation.h"
+#include "FlecsLODSubsystem.h"
+#include "Phases/FlecsPhase.h"
+#include "Transform/FlecsEngineTransformComponents.h"
+#include "World/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_LODCalculator)
+
+namespace UE::FlecsLOD::Private
+{
+	void BuildViewerVectors(TConstArrayView<FFlecsViewerInfo> Viewers, TArray<FViewerVectors>& OutViewers, TArray<FPlaneVectors>& OutPlanes)
+	{
+		OutViewers.Reset(Viewers.Num());
+		OutPlanes.Reset();
+		for (const FFlecsViewerInfo& Viewer : Viewers)
+		{
+			FViewerVectors& ViewerVectors = OutViewers.AddDefaulted_GetRef();
+			ViewerVectors.LocationX = VectorSetFloat1(static_cast<float>(Viewer.Location.X));
+			ViewerVectors.LocationY = VectorSetFloat1(static_cast<float>(Viewer.Location.Y));
+			ViewerVectors.LocationZ = VectorSetFloat1(static_cast<float>(Viewer.Location.Z));
+			ViewerVectors.FirstPlane = OutPlanes.Num();
+			ViewerVectors.NumPlanes = Viewer.Frustum.Planes.Num();
+
+			for (const FPlane& Plane : Viewer.Frustum.Planes)
+			{
+				FPlaneVectors& PlaneVectors = OutPlanes.AddDefaulted_GetRef();
+				PlaneVectors.NormalX = VectorSetFloat1(static_cast<float>(Plane.X));
+				PlaneVectors.NormalY = VectorSetFloat1(static_cast<float>(Plane.Y));
+				PlaneVectors.NormalZ = VectorSetFloat1(static_cast<float>(Plane.Z));
+				PlaneVectors.W = VectorSetFloat1(static_cast<float>(Plane.W));
+			}
+		}
+	}
+
+	void CalculateViewerDistances(TConstArrayView<FViewerVectors> Viewers, TConstArrayView<FPlaneVectors> Planes,
+		const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z,
+		VectorRegister4Float& OutClosestDistanceSq, VectorRegister4Float& OutClosestDistanceToFrustum)
+	{
+		OutClosestDistanceSq = VectorSetFloat1(FLT_MAX);
+		OutClosestDistanceToFrustum = VectorSetFloat1(FLT_MAX);
+
+		for (const FViewerVectors& Viewer : Viewers)
+		{
+			const VectorRegister4Float DeltaX = VectorSubtract(X, Viewer.LocationX);
+			const VectorRegister4Float DeltaY = VectorSubtract(Y, Viewer.LocationY);
+			const VectorRegister4Float DeltaZ = VectorSubtract(Z, Viewer.LocationZ);
+			const VectorRegister4Float DistanceSq = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ)));
+			OutClosestDistanceSq = VectorMin(OutClosestDistanceSq, DistanceSq);
+
+			// Planes face outwards, the distance to the frustum is the largest distance to any of its planes
+			VectorRegister4Float DistanceToFrustum = VectorSetFloat1(-FLT_MAX);
+			for (const FPlaneVectors& Plane : Planes.Slice(Viewer.FirstPlane, Viewer.NumPlanes))
+			{
+				const VectorRegister4Float PlaneDot = VectorSubtract(
+					VectorMultiplyAdd(Plane.NormalX, X, VectorMultiplyAdd(Plane.NormalY, Y, VectorMultiply(Plane.NormalZ, Z))),
+					Plane.W);
+				DistanceToFrustum = VectorMax(DistanceToFrustum, PlaneDot);
+			}
+			OutClosestDistanceToFrustum = VectorMin(OutClosestDistanceToFrustum, DistanceToFrustum);
+		}
+	}
+}
+
+UFlecsSystem_LODCalculator::UFlecsSystem_LODCalculator()
+{
+	ExecutionFlags = (int32)EFlecsSystemExecutionFlags::AllNetModes;
+	ExecuteInPhase = UFlecsPhase_PreUpdate::StaticClass();
+
+	// The max counts are resolved over all the entities, a single run needs to see all of them.
+	bMultithreaded = false;
+
+	LODDistance[EFlecsLOD::High] = 0.f;
+	LODDistance[EFlecsLOD::Medium] = 1000.f;
+	LODDistance[EFlecsLOD::Low] = 2500.f;
+	LODDistance[EFlecsLOD::Off] = 10000.f;
+
+	VisibleLODDistance[EFlecsLOD::High] = 0.f;
+	VisibleLODDistance[EFlecsLOD::Medium] = 2000.f;
+	VisibleLODDistance[EFlecsLOD::Low] = 4000.f;
+	VisibleLODDistance[EFlecsLOD::Off] = 15000.f;
+
+	LODMaxCount[EFlecsLOD::High] = 50;
+	LODMaxCount[EFlecsLOD::Medium] = 100;
+	LODMaxCount[EFlecsLOD::Low] = 500;
+	LODMaxCount[EFlecsLOD::Off] = MAX_int32;
+}
+
+void UFlecsSystem_LODCalculator::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+	LODSubsystem = UWorld::GetSubsystem<UFlecsLODSubsystem>(InOwner.GetWorld());
+
+	LODTags[EFlecsLOD::High] = InFlecsWorld.Component<FFlecsHighLODTag>();
+	LODTags[EFlecsLOD::Medium] = InFlecsWorld.Component<FFlecsMediumLODTag>();
+	LODTags[EFlecsLOD::Low] = InFlecsWorld.Component<FFlecsLowLODTag>();
+	LODTags[EFlecsLOD::Off] = InFlecsWorld.Component<FFlecsOffLODTag>();
+	TickBucketRelationship = InFlecsWorld.Component<FFlecsLODTickBucket>();
+}
+
+void UFlecsSystem_LODCalculator::BuildSystem(flecs::system_builder<>& SystemBuilder)
+{
+	Super::BuildSystem(SystemBuilder);
+
+	SystemBuilder
+		.with<FFlecsTransformComponent>().in()
+		.with<FFlecsViewerInfoComponent>().out()
+		.with<FFlecsLODComponent>().inout();
+}
+
+void UFlecsSystem_LODCalculator::Run(flecs::iter& Iterator)
+{
+	using namespace UE::FlecsLOD::Private;
+	QUICK_SCOPE_CYCLE_COUNTER(FlecsLODCalculator);
+
+	check(LODSubsystem);
+
+	TArray<FViewerVectors> Viewers;
+	TArray<FPlaneVectors> Planes;
+	BuildViewerVectors(LODSubsystem->GetViewers(), Viewers, Planes);
+
+	const float Hysteresis = 1.f + BufferHysteresisOnDistancePercentage * 0.01f;
+	for (TStaticArray<int32, UE::MassLOD::MaxBucketsPerLOD>& LODBucketCounts : BucketCounts)
+	{
+		FMemory::Memzero(LODBucketCounts.GetData(), sizeof(int32) * UE::MassLOD::MaxBucketsPerLOD);
+	}
+	EntityBuckets.Reset();
+	TableRanges.Reset();
+
+	// Stage to queue the tag toggles on, they only flip bits and never move the entities.
+	const flecs::world Stage = Iterator.world();
+
+	// First pass: distances in batches, raw LOD and distance bucket of every entity.
+	while (Iterator.next())
+	{
+		const flecs::field<const FFlecsTransformComponent> Transforms = Iterator.field<const FFlecsTransformComponent>(0);
+		const flecs::field<FFlecsViewerInfoComponent> ViewerInfos = Iterator.field<FFlecsViewerInfoComponent>(1);
+		const flecs::field<FFlecsLODComponent> LODs = Iterator.field<FFlecsLODComponent>(2);
+		const int32 Num = static_cast<int32>(Iterator.count());
+
+		FTableRange& TableRange = TableRanges.AddDefaulted_GetRef();
+		TableRange.LODs = &LODs[0];
+		TableRange.Entities = Iterator.c_ptr()->entities;
+		TableRange.Num = Num;
+		TableRange.FirstBucket = EntityBuckets.Num();
+		EntityBuckets.AddUninitialized(Num);
+
+		for (int32 BatchStart = 0; BatchStart < Num; BatchStart += BatchSize)
+		{
+			const int32 BatchNum = FMath::Min(BatchSize, Num - BatchStart);
+
+			// Transpose the batch, the last one gets padded with its last location and the padding lanes are dropped.
+			alignas(16) float X[BatchSize];
+			alignas(16) float Y[BatchSize];
+			alignas(16) float Z[BatchSize];
+			for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+			{
+				const FVector& Location = Transforms[BatchStart + FMath::Min(Lane, BatchNum - 1)].GetTransform().GetLocation();
+				X[Lane] = static_cast<float>(Location.X);
+				Y[Lane] = static_cast<float>(Location.Y);
+				Z[Lane] = static_cast<float>(Location.Z);
+			}
+
+			VectorRegister4Float ClosestDistanceSq;
+			VectorRegister4Float ClosestDistanceToFrustum;
+			CalculateViewerDistances(Viewers, Planes, VectorLoadAligned(X), VectorLoadAligned(Y), VectorLoadAligned(Z), ClosestDistanceSq, ClosestDistanceToFrustum);
+
+			alignas(16) float DistancesSq[BatchSize];
+			alignas(16) float DistancesToFrustum[BatchSize];
+			VectorStoreAligned(ClosestDistanceSq, DistancesSq);
+			VectorStoreAligned(ClosestDistanceToFrustum, DistancesToFrustum);
+
+			for (int32 Lane = 0; Lane < BatchNum; ++Lane)
+			{
+				const int32 Index = BatchStart + Lane;
+
+				FFlecsViewerInfoComponent& ViewerInfo = ViewerInfos[Index];
+				ViewerInfo.ClosestViewerDistanceSq = DistancesSq[Lane];
+				ViewerInfo.ClosestDistanceToFrustum = DistancesToFrustum[Lane];
+
+				const bool bInFrustum = ViewerInfo.ClosestDistanceToFrustum <= DistanceToFrustum;
+				const float* Distances = bInFrustum ? VisibleLODDistance : LODDistance;
+				const float Distance = FMath::Sqrt(ViewerInfo.ClosestViewerDistanceSq);
+
+				int32 LOD = EFlecsLOD::High;
+				while (LOD < EFlecsLOD::Off && Distance >= Distances[LOD + 1])
+				{
+					++LOD;
+				}
+
+				FFlecsLODComponent& LODComponent = LODs[Index];
+				LODComponent.PrevVisibility = LODComponent.Visibility;
+				LODComponent.Visibility = LOD == EFlecsLOD::Off ? EFlecsVisibility::CulledByDistance
+					: bInFrustum ? EFlecsVisibility::CanBeSeen : EFlecsVisibility::CulledByFrustum;
+
+				// Only give up on the current LOD once far enough past its distance
+				if (LODComponent.LOD != EFlecsLOD::Max && LOD == LODComponent.LOD + 1 && Distance < Distances[LOD] * Hysteresis)
+				{
+					LOD = LODComponent.LOD;
+				}
+
+				FEntityLODBucket& EntityBucket = EntityBuckets[TableRange.FirstBucket + Index];
+				EntityBucket.LOD = static_cast<uint8>(LOD);
+				EntityBucket.Bucket = 0;
+				if (LOD < EFlecsLOD::Off)
+				{
+					const float LODRange = FMath::Max(Distances[LOD + 1] - Distances[LOD], UE_KINDA_SMALL_NUMBER);
+					const int32 Bucket = FMath::Clamp(FMath::FloorToInt32((Distance - Distances[LOD]) / LODRange * UE::MassLOD::MaxBucketsPerLOD), 0, UE::MassLOD::MaxBucketsPerLOD - 1);
+					EntityBucket.Bucket = static_cast<int16>(Bucket);
+					++BucketCounts[LOD][Bucket];
+				}
+			}
+		}
+	}
+
+	// Resolve the max counts: within each LOD the closest buckets are kept until the max count is reached, the buckets
+	// past it spill into the next LOD ahead of that LOD's own entities. An entity in bucket B of LOD L is pushed to the
+	// next LOD when B >= FirstSpilledBucket[L], entities spilled from the previous LOD sort before bucket 0.
+	int32 FirstSpilledBucket[EFlecsLOD::Max];
+	int32 SpilledCount = 0;
+	for (int32 LOD = EFlecsLOD::High; LOD < EFlecsLOD::Off; ++LOD)
+	{
+		int32 Count = SpilledCount;
+		FirstSpilledBucket[LOD] = Count > LODMaxCount[LOD] ? -1 : UE::MassLOD::MaxBucketsPerLOD;
+		SpilledCount = FirstSpilledBucket[LOD] < 0 ? SpilledCount : 0;
+
+		for (int32 Bucket = 0; Bucket < UE::MassLOD::MaxBucketsPerLOD; ++Bucket)
+		{
+			const int32 BucketCount = BucketCounts[LOD][Bucket];
+			if (FirstSpilledBucket[LOD] == UE::MassLOD::MaxBucketsPerLOD)
+			{
+				Count += BucketCount;
+				if (Count <= LODMaxCount[LOD])
+				{
+					continue;
+				}
+				FirstSpilledBucket[LOD] = Bucket;
+			}
+			SpilledCount += BucketCount;
+		}
+	}
+	FirstSpilledBucket[EFlecsLOD::Off] = UE::MassLOD::MaxBucketsPerLOD;
+
+	// Second pass: final LOD, the tags and tick bucket are only updated for the entities whose LOD changed.
+	for (const FTableRange& TableRange : TableRanges)
+	{
+		for (int32 Index = 0; Index < TableRange.Num; ++Index)
+		{
+			const FEntityLODBucket& EntityBucket = EntityBuckets[TableRange.FirstBucket + Index];
+			int32 LOD = EntityBucket.LOD;
+			int32 Bucket = EntityBucket.Bucket;
+			while (LOD < EFlecsLOD::Off && Bucket >= FirstSpilledBucket[LOD])
+			{
+				++LOD;
+				Bucket = -1;
+			}
+
+			FFlecsLODComponent& LODComponent = TableRange.LODs[Index];
+			LODComponent.PrevLOD = LODComponent.LOD;
+			LODComponent.LOD = static_cast<EFlecsLOD::Type>(LOD);
+			if (LODComponent.LOD == LODComponent.PrevLOD)
+			{
+				continue;
+			}
+
+			const flecs::entity Entity(Stage, TableRange.Entities[Index]);
+			if (LODComponent.PrevLOD == EFlecsLOD::Max)
+			{
+				// All the tags start enabled when added along with the LOD component
+				for (int32 OtherLOD = EFlecsLOD::High; OtherLOD < EFlecsLOD::Max; ++OtherLOD)
+				{
+					if (OtherLOD != LOD)
+					{
+						Entity.disable(LODTags[OtherLOD]);
+					}
+				}
+			}
+			else
+			{
+				Entity.disable(LODTags[LODComponent.PrevLOD]);
+				Entity.enable(LODTags[LOD]);
+			}
+
+			Entity.add(TickBucketRelationship, LODSubsystem->AssignTickBucket(LODComponent.LOD));
+		}
+	}
+}
@@ -0,0 +1,97 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSystem_LODVariableTick.h"
+
+#include "FlecsLODSubsystem.h"
+#include "World/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_LODVariableTick)
+
+UFlecsSystem_LODVariableTick::UFlecsSystem_LODVariableTick()
+{
+	// Each due bucket is iterated separately on the thread running the system.
+	bMultithreaded = false;
+
+	// The query is uncached, there is no cache to share.
+	bShareQueryCache = false;
+
+	bTickLOD[EFlecsLOD::High] = true;
+	bTickLOD[EFlecsLOD::Medium] = true;
+	bTickLOD[EFlecsLOD::Low] = true;
+	bTickLOD[EFlecsLOD::Off] = false;
+}
+
+void UFlecsSystem_LODVariableTick::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+	LODSubsystem = UWorld::GetSubsystem<UFlecsLODSubsystem>(InOwner.GetWorld());
+	check(LODSubsystem);
+
+	for (int32 LOD = EFlecsLOD::High; LOD < EFlecsLOD::Max; ++LOD)
+	{
+		BucketLastTickTimes[LOD].Init(-1., LODSubsystem->GetTickPeriod(static_cast<EFlecsLOD::Type>(LOD)));
+	}
+}
+
+void UFlecsSystem_LODVariableTick::BuildSystem(flecs::system_builder<>& SystemBuilder)
+{
+	Super::BuildSystem(SystemBuilder);
+
+	// First term so the iteration starts from the due bucket's sparse set instead of testing every entity.
+	SystemBuilder
+		.with<FFlecsLODTickBucket>("$TickBucket")
+		.cache_kind(flecs::QueryCacheNone);
+}
+
+void UFlecsSystem_LODVariableTick::Run(flecs::iter& Iterator)
+{
+	check(LODSubsystem);
+
+	const ecs_iter_t& SystemIterator = *Iterator.c_ptr();
+	flecs::world_t* Stage = SystemIterator.world;
+	const flecs::query_t* Query = SystemIterator.query;
+	const flecs::entity_t System = SystemIterator.system;
+	void* Param = SystemIterator.param;
+	void* Context = SystemIterator.ctx;
+	const ecs_ftime_t DeltaTime = SystemIterator.delta_time;
+	const ecs_ftime_t DeltaSystemTime = SystemIterator.delta_system_time;
+
+	const ecs_world_info_t* WorldInfo = ecs_get_world_info(Stage);
+	const int64 Frame = WorldInfo->frame_count_total;
+	const double Now = WorldInfo->world_time_total;
+
+	// The system iterator would visit every bucket, each due bucket gets its own iterator instead.
+	Iterator.fini();
+
+	if (TickBucketVariable < 0)
+	{
+		TickBucketVariable = ecs_query_find_var(Query, "TickBucket");
+		check(TickBucketVariable >= 0);
+	}
+
+	for (int32 LOD = EFlecsLOD::High; LOD < EFlecsLOD::Max; ++LOD)
+	{
+		if (!bTickLOD[LOD])
+		{
+			continue;
+		}
+
+		TArray<double>& LastTickTimes = BucketLastTickTimes[LOD];
+		const int32 BucketIndex = static_cast<int32>(Frame % LastTickTimes.Num());
+		const double LastTickTime = LastTickTimes[BucketIndex];
+		LastTickTimes[BucketIndex] = Now;
+
+		ecs_iter_t BucketIterator = ecs_query_iter(Stage, Query);
+		ecs_iter_set_var(&BucketIterator, TickBucketVariable, LODSubsystem->GetTickBucket(static_cast<EFlecsLOD::Type>(LOD), BucketIndex));
+		BucketIterator.system = System;
+		BucketIterator.param = Param;
+		BucketIterator.ctx = Context;
+		BucketIterator.delta_system_time = DeltaSystemTime;
+		BucketIterator.delta_time = LastTickTime < 0.
+			? DeltaTime * LastTickTimes.Num()
+			: static_cast<ecs_ftime_t>(Now - LastTickTime);
+
+		flecs::iter BucketFlecsIterator(&BucketIterator);
+		RunBucket(BucketFlecsIterator, static_cast<EFlecsLOD::Type>(LOD));
+	}
+}
@@ -0,0 +1,83 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSystem_LODViewerCollector.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "FlecsLODCalculation.h"
+#include "FlecsLODSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Phases/FlecsPhase.h"
+#include "SceneManagement.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_LODViewerCollector)
+
+namespace UE::FlecsLOD::Private
+{
+	void BuildViewerFrustum(FFlecsViewerInfo& Viewer)
+	{
+		// Same view and projection setup as the renderer, the near plane is left out as being behind the viewer
+		// only matters when inside of the near clipping distance.
+		const FMatrix ViewRotationMatrix = FInverseRotationMatrix(Viewer.Rotation) * FMatrix(
+			FPlane(0, 0, 1, 0),
+			FPlane(1, 0, 0, 0),
+			FPlane(0, 1, 0, 0),
+			FPlane(0, 0, 0, 1));
+		const FMatrix ViewMatrix = FTranslationMatrix(-Viewer.Location) * ViewRotationMatrix;
+		const float HalfFOVRad = FMath::DegreesToRadians(Viewer.FOV * 0.5f);
+		const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFOVRad, Viewer.AspectRatio, 1.f, GNearClippingPlane);
+
+		GetViewFrustumBounds(Viewer.Frustum, ViewMatrix * ProjectionMatrix, /*bUseNearPlane*/false);
+	}
+}
+
+UFlecsSystem_LODViewerCollector::UFlecsSystem_LODViewerCollector()
+{
+	ExecutionFlags = (int32)EFlecsSystemExecutionFlags::AllNetModes;
+	ExecuteInPhase = UFlecsPhase_PostLoad::StaticClass();
+}
+
+void UFlecsSystem_LODViewerCollector::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+	LODSubsystem = UWorld::GetSubsystem<UFlecsLODSubsystem>(InOwner.GetWorld());
+}
+
+void UFlecsSystem_LODViewerCollector::Run(flecs::iter& Iterator)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FlecsLODViewerCollector);
+
+	check(LODSubsystem);
+	const UWorld* World = LODSubsystem->GetWorld();
+
+	TArray<FFlecsViewerInfo> Viewers;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr)
+		{
+			continue;
+		}
+
+		FFlecsViewerInfo Viewer;
+		Viewer.PlayerController = PlayerController;
+		PlayerController->GetPlayerViewPoint(Viewer.Location, Viewer.Rotation);
+		if (const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager)
+		{
+			Viewer.FOV = CameraManager->GetFOVAngle();
+			Viewer.AspectRatio = CameraManager->DefaultAspectRatio;
+		}
+		UE::FlecsLOD::Private::BuildViewerFrustum(Viewer);
+
+#if UE_ALLOW_DEBUG_REPLICATION_DUPLICATE_VIEWERS_PER_CONTROLLER
+		for (int32 DuplicateIndex = 1; DuplicateIndex < UE::MassLOD::DebugNumberViewersPerController; ++DuplicateIndex)
+		{
+			Viewers.Add(Viewer);
+		}
+#endif
+
+		Viewers.Add(MoveTemp(Viewer));
+	}
+
+	LODSubsystem->SetViewers(MoveTemp(Viewers));
+}
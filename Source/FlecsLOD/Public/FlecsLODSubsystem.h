@@ -0,0 +1,84 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "ConvexVolume.h"
+#include "flecs.h"
+#include "FlecsLODTypes.h"
+#include "FlecsSubsystemBase.h"
+
+#include "FlecsLODSubsystem.generated.h"
+
+#define UE_API FLECSLOD_API
+
+class APlayerController;
+
+/**
+ * Point of view the LOD of the entities is computed from
+ */
+struct FFlecsViewerInfo
+{
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	float FOV = 90.f;
+	float AspectRatio = 16.f / 9.f;
+
+	/** Side planes of the view frustum, facing outwards */
+	FConvexVolume Frustum;
+};
+
+/**
+ * Subsystem holding the viewers used to compute the LOD of the entities. The viewers are refreshed once per frame
+ * by UFlecsSystem_LODViewerCollector and consumed by UFlecsSystem_LODCalculator.
+ * Also owns the tick buckets: each LOD is split into TickPeriodPerLOD round-robin buckets, and entities are assigned
+ * to one of their LOD's buckets so that UFlecsSystem_LODVariableTick only has to visit the bucket due this frame.
+ */
+UCLASS(MinimalAPI)
+class UFlecsLODSubsystem : public UFlecsSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	UE_API UFlecsLODSubsystem();
+
+	/** @return The viewers collected this frame */
+	TConstArrayView<FFlecsViewerInfo> GetViewers() const { return Viewers; }
+
+	/** Replaces the viewers used for the LOD calculation */
+	UE_API void SetViewers(TArray<FFlecsViewerInfo>&& InViewers);
+
+	/** @return Frame number the viewers were last collected on */
+	uint64 GetLastViewersUpdateFrame() const { return LastViewersUpdateFrame; }
+
+	/** @return Number of frames between two ticks of an entity in the given LOD, which is also its number of tick buckets */
+	int32 GetTickPeriod(const EFlecsLOD::Type LOD) const { return TickBuckets[LOD].Num(); }
+
+	/** @return The bucket entity used as FFlecsLODTickBucket target */
+	flecs::entity_t GetTickBucket(const EFlecsLOD::Type LOD, const int32 BucketIndex) const { return TickBuckets[LOD][BucketIndex]; }
+
+	/** @return Next bucket of the given LOD in round-robin order, to spread the entities entering that LOD evenly */
+	UE_API flecs::entity_t AssignTickBucket(const EFlecsLOD::Type LOD);
+
+protected:
+	// USubsystem implementation Begin
+	UE_API virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	// USubsystem implementation End
+
+	TArray<FFlecsViewerInfo> Viewers;
+
+	uint64 LastViewersUpdateFrame = 0;
+
+	/** Number of frames between two ticks of an entity in each LOD */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config, meta=(ClampMin="1", UIMin="1", ClampMax="250", UIMax="250"))
+	int32 TickPeriodPerLOD[EFlecsLOD::Max];
+
+	/** Bucket entities of each LOD */
+	TStaticArray<TArray<flecs::entity_t>, EFlecsLOD::Max> TickBuckets;
+
+	/** Round-robin cursor of each LOD */
+	TStaticArray<int32, EFlecsLOD::Max> NextTickBucket = TStaticArray<int32, EFlecsLOD::Max>(InPlace, 0);
+};
+
+#undef UE_API
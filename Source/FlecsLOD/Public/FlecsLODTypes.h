@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Containers/StaticArray.h"
+#include "FlecsEntityElementTypes.h"
 
 #include "FlecsLODTypes.generated.h"
 
@@ -55,4 +56,74 @@ enum class EFlecsVisibility : uint8
 	Max
 };
 
+/**
+ * Distances from the entity to the closest viewer, filled by the LOD calculation system
+ */
+USTRUCT()
+struct FFlecsViewerInfoComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	/** Squared distance to the closest viewer */
+	float ClosestViewerDistanceSq = FLT_MAX;
+
+	/** Signed distance to the closest viewer frustum, negative when inside of it */
+	float ClosestDistanceToFrustum = FLT_MAX;
+};
+
+/**
+ * LOD of the entity, computed from the viewer distances and the per-LOD count limits
+ */
+USTRUCT()
+struct FFlecsLODComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	/** LOD information */
+	TEnumAsByte<EFlecsLOD::Type> LOD = EFlecsLOD::Max;
+	TEnumAsByte<EFlecsLOD::Type> PrevLOD = EFlecsLOD::Max;
+
+	/** Visibility Info */
+	EFlecsVisibility Visibility = EFlecsVisibility::Max;
+	EFlecsVisibility PrevVisibility = EFlecsVisibility::Max;
+};
+
+/**
+ * LOD tags, all of them are added along with FFlecsLODComponent and only the one matching the current LOD is enabled.
+ * Toggling them does not move the entity between tables, so queries can filter on them without paying for LOD changes.
+ */
+USTRUCT()
+struct FFlecsHighLODTag : public FFlecsTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FFlecsMediumLODTag : public FFlecsTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FFlecsLowLODTag : public FFlecsTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FFlecsOffLODTag : public FFlecsTag
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Exclusive, non-fragmenting relationship to the tick bucket the entity is assigned to, reassigned whenever its LOD changes.
+ * @see UFlecsLODSubsystem::AssignTickBucket
+ */
+USTRUCT()
+struct FFlecsLODTickBucket : public FFlecsTag
+{
+	GENERATED_BODY()
+};
+
 #undef UE_API
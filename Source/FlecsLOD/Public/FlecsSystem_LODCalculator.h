@@ -0,0 +1,86 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "FlecsLODTypes.h"
+#include "Systems/FlecsSystem.h"
+
+#include "FlecsSystem_LODCalculator.generated.h"
+
+#define UE_API FLECSLOD_API
+
+class UFlecsLODSubsystem;
+
+/**
+ * System computing the LOD of every entity with a FFlecsLODComponent from the viewers collected by UFlecsSystem_LODViewerCollector.
+ * Distances to the viewers and to their frustums are computed 4 entities at a time, then the LOD distances are pulled in
+ * so that no LOD holds more than LODMaxCount entities. The resulting LOD is stored in FFlecsLODComponent and exposed
+ * through the toggled FFlecs*LODTag tags and the FFlecsLODTickBucket relationship.
+ */
+UCLASS(MinimalAPI)
+class UFlecsSystem_LODCalculator : public UFlecsSystem
+{
+	GENERATED_BODY()
+
+public:
+	UE_API UFlecsSystem_LODCalculator();
+
+protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
+	UE_API virtual void BuildSystem(flecs::system_builder<>& SystemBuilder) override;
+	UE_API virtual void Run(flecs::iter& Iterator) override;
+
+	/** Distance where each LOD becomes relevant, used for entities outside of the viewers' frustums */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config)
+	float LODDistance[EFlecsLOD::Max];
+
+	/** Distance where each LOD becomes relevant, used for entities inside of a viewer's frustum */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config)
+	float VisibleLODDistance[EFlecsLOD::Max];
+
+	/** Maximum number of entities per LOD, closest entities are kept and the others are pushed to the next LOD */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config, meta=(ClampMin="0", UIMin="0"))
+	int32 LODMaxCount[EFlecsLOD::Max];
+
+	/** Percentage of the LOD distance an entity needs to move past it before switching to a lower LOD */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config, meta=(ClampMin="0.0", UIMin="0.0"))
+	float BufferHysteresisOnDistancePercentage = 10.f;
+
+	/** Distance outside of a frustum under which an entity is still considered visible */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config, meta=(ClampMin="0.0", UIMin="0.0"))
+	float DistanceToFrustum = 0.f;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsLODSubsystem> LODSubsystem;
+
+private:
+	/** Raw LOD computed from the distances, before applying the max counts */
+	struct FEntityLODBucket
+	{
+		uint8 LOD = EFlecsLOD::Off;
+		int16 Bucket = 0;
+	};
+
+	/** Table range visited during the distance pass, revisited once the max counts are resolved */
+	struct FTableRange
+	{
+		FFlecsLODComponent* LODs = nullptr;
+		const flecs::entity_t* Entities = nullptr;
+		int32 Num = 0;
+		int32 FirstBucket = 0;
+	};
+
+	/** Number of entities in each distance bucket of each LOD */
+	TStaticArray<TStaticArray<int32, UE::MassLOD::MaxBucketsPerLOD>, EFlecsLOD::Max> BucketCounts;
+
+	/** Per frame scratch buffers */
+	TArray<FEntityLODBucket> EntityBuckets;
+	TArray<FTableRange> TableRanges;
+
+	/** Tag enabled on the entity for each LOD */
+	flecs::id_t LODTags[EFlecsLOD::Max] = {};
+
+	flecs::entity_t TickBucketRelationship = 0;
+};
+
+#undef UE_API
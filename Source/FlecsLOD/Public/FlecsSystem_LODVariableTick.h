@@ -0,0 +1,61 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "FlecsLODTypes.h"
+#include "Systems/FlecsSystem.h"
+
+#include "FlecsSystem_LODVariableTick.generated.h"
+
+#define UE_API FLECSLOD_API
+
+class UFlecsLODSubsystem;
+
+/**
+ * Base class for systems ticking their entities at a rate depending on their LOD.
+ * The system query starts with the FFlecsLODTickBucket relationship, and every frame only the entities of the bucket
+ * due in each LOD are iterated, so an entity in a LOD with a tick period of N frames is visited once every N frames.
+ * The relationship doesn't fragment, so the query is uncached and iterates the bucket's sparse set directly.
+ * The derived classes only need to implement RunBucket.
+ *
+ * The tick bucket term is added before the terms of the derived classes, which therefore start at FirstFieldIndex.
+ */
+UCLASS(MinimalAPI, Abstract)
+class UFlecsSystem_LODVariableTick : public UFlecsSystem
+{
+	GENERATED_BODY()
+
+public:
+	UE_API UFlecsSystem_LODVariableTick();
+
+	/** Field index of the first term added by derived classes, field 0 is the tick bucket */
+	static constexpr int8 FirstFieldIndex = 1;
+
+protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
+	UE_API virtual void BuildSystem(flecs::system_builder<>& SystemBuilder) override;
+	UE_API virtual void Run(flecs::iter& Iterator) override final;
+
+	/**
+	 * Called once per frame for each LOD with the iterator over its due bucket. Needs to iterate until completion.
+	 * @param Iterator Iterator over the due bucket, its delta time is the time elapsed since the bucket last ticked
+	 * @param LOD LOD of the entities in the bucket
+	 */
+	virtual void RunBucket(flecs::iter& Iterator, const EFlecsLOD::Type LOD) PURE_VIRTUAL(UFlecsSystem_LODVariableTick::RunBucket, Iterator.fini(););
+
+	/** Whether entities in each LOD are ticked at all */
+	UPROPERTY(EditDefaultsOnly, Category="LOD", Config)
+	bool bTickLOD[EFlecsLOD::Max];
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsLODSubsystem> LODSubsystem;
+
+private:
+	/** World time each bucket last ticked at */
+	TStaticArray<TArray<double>, EFlecsLOD::Max> BucketLastTickTimes;
+
+	/** Index of the query variable holding the due bucket, resolved on the first run */
+	int32 TickBucketVariable = -1;
+};
+
+#undef UE_API
@@ -0,0 +1,33 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "Systems/FlecsSystem.h"
+
+#include "FlecsSystem_LODViewerCollector.generated.h"
+
+#define UE_API FLECSLOD_API
+
+class UFlecsLODSubsystem;
+
+/**
+ * System collecting the viewers (player controllers' points of view and frustums) the LOD of the entities is computed from.
+ * Runs once per frame before UFlecsSystem_LODCalculator.
+ */
+UCLASS(MinimalAPI)
+class UFlecsSystem_LODViewerCollector : public UFlecsSystem
+{
+	GENERATED_BODY()
+
+public:
+	UE_API UFlecsSystem_LODViewerCollector();
+
+protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
+	UE_API virtual void Run(flecs::iter& Iterator) override;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsLODSubsystem> LODSubsystem;
+};
+
+#undef UE_API
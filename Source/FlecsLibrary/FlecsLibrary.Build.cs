@@ -10,6 +10,7 @@ public class FlecsLibrary : ModuleRules
 
         const bool bCompileWithLibraryTests = false;
         const bool bCompileWithJournal = false;
+        const bool bCompileWithFlatEntityIndex = false;
         
         Type = ModuleType.CPlusPlus;
         
@@ -90,6 +91,13 @@ public class FlecsLibrary : ModuleRules
         {
             PublicDefinitions.Add("FLECS_JOURNAL");
         }
+        
+        // Reserves address space for all entity ids up front, so only enable on 64-bit targets
+        // ReSharper disable once ConditionIsAlwaysTrueOrFalse
+        if (bCompileWithFlatEntityIndex)
+        {
+            PublicDefinitions.Add("FLECS_ENTITY_INDEX_FLAT");
+        }
 
         if (Target.bCompileAgainstEditor)
         {
@@ -373,7 +373,7 @@ int flecs_meta_member(
     ecs_meta_scope_t *scope = flecs_cursor_get_scope(cursor);
     scope = flecs_cursor_restore_scope(cursor, scope);
 
-    ecs_hashmap_t *members = scope->members;
+    ecs_name_index_t *members = scope->members;
     const ecs_world_t *world = cursor->world;
 
     if (!members) {
@@ -468,7 +468,7 @@ int flecs_meta_serialize_struct(
     ecs_member_t *members = ecs_vec_first(&ptr->members);
     int32_t i, count = ecs_vec_count(&ptr->members);
 
-    ecs_hashmap_t *member_index = NULL;
+    ecs_name_index_t *member_index = NULL;
     if (count) {        
         op->is.members = member_index = flecs_name_index_new(&world->allocator);
     }
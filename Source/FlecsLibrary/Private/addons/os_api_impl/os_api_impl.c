@@ -3,6 +3,14 @@
  * @brief Builtin implementation for OS API.
  */
 
+/* Needed for MAP_ANON, which is not part of POSIX */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+#ifndef _DARWIN_C_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+
 #include "../../private_api.h"
 
 #ifdef FLECS_OS_API_IMPL
@@ -13,6 +13,10 @@
 #include <time.h>
 #endif
 
+#ifndef __EMSCRIPTEN__
+#include <sys/mman.h>
+#endif
+
 /* This mutex is used to emulate atomic operations when the gnu builtins are
  * not supported. This is probably not very fast but if the compiler doesn't
  * support the gnu built-ins, then speed is probably not a priority. */
@@ -298,6 +302,46 @@ uint64_t posix_time_now(void) {
     return now;
 }
 
+#ifndef __EMSCRIPTEN__
+static
+void* posix_vm_reserve(
+    size_t size)
+{
+    int flags = MAP_PRIVATE | MAP_ANON;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+
+    void *ptr = mmap(NULL, size, PROT_NONE, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    /* Hint only, large reservations are mostly accessed randomly */
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+
+    return ptr;
+}
+
+static
+bool posix_vm_commit(
+    void *ptr,
+    size_t size)
+{
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+static
+void posix_vm_release(
+    void *ptr,
+    size_t size)
+{
+    munmap(ptr, size);
+}
+#endif
+
 void ecs_set_os_api_impl(void) {
     ecs_os_set_api_defaults();
 
@@ -323,6 +367,11 @@ void ecs_set_os_api_impl(void) {
     api.cond_wait_ = posix_cond_wait;
     api.sleep_ = posix_sleep;
     api.now_ = posix_time_now;
+#ifndef __EMSCRIPTEN__
+    api.vm_reserve_ = posix_vm_reserve;
+    api.vm_commit_ = posix_vm_commit;
+    api.vm_release_ = posix_vm_release;
+#endif
 
     posix_time_setup();
 
@@ -246,6 +246,30 @@ uint64_t win_time_now(void) {
     return now;
 }
 
+static
+void* win_vm_reserve(
+    size_t size)
+{
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static
+bool win_vm_commit(
+    void *ptr,
+    size_t size)
+{
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+static
+void win_vm_release(
+    void *ptr,
+    size_t size)
+{
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
 static
 void win_fini(void) {
     if (ecs_os_api.flags_ & EcsOsApiHighResolutionTimer) {
@@ -278,6 +302,9 @@ void ecs_set_os_api_impl(void) {
     api.cond_wait_ = win_cond_wait;
     api.sleep_ = win_sleep;
     api.now_ = win_time_now;
+    api.vm_reserve_ = win_vm_reserve;
+    api.vm_commit_ = win_vm_commit;
+    api.vm_release_ = win_vm_release;
     api.fini_ = win_fini;
 
     win_time_setup();
@@ -595,6 +595,31 @@ int32_t flecs_run_pipeline_ops(
     return i;
 }
 
+/* Sort queries of the systems in the current operation. Tables can't be sorted
+ * while workers are iterating them, so this happens before workers start. Once
+ * the workers are done, presort is false and queries can be sorted again. */
+static
+void flecs_pipeline_sort_queries(
+    ecs_world_t *world,
+    ecs_pipeline_state_t *pq,
+    bool presort)
+{
+    ecs_pipeline_op_t *op = pq->cur_op;
+    ecs_system_t **systems = ecs_vec_first_t(&pq->systems, ecs_system_t*);
+    int32_t i, end = op->offset + op->count;
+    if (end > ecs_vec_count(&pq->systems)) {
+        end = ecs_vec_count(&pq->systems);
+    }
+
+    for (i = pq->cur_i; i < end; i ++) {
+        if (presort) {
+            flecs_query_presort_tables(world, systems[i]->query);
+        } else {
+            flecs_query_presort_end(systems[i]->query);
+        }
+    }
+}
+
 void flecs_run_pipeline(
     ecs_world_t *world,
     ecs_pipeline_state_t *pq,
@@ -632,6 +657,11 @@ void flecs_run_pipeline(
 
         pq->immediate = immediate;
 
+        /* Sort before readonly mode, which flags the world as multithreaded */
+        if (op_multi_threaded) {
+            flecs_pipeline_sort_queries(world, pq, true);
+        }
+
         if (!immediate) {
             ecs_readonly_begin(world, multi_threaded);
         } else {
@@ -661,6 +691,7 @@ void flecs_run_pipeline(
 
         if (op_multi_threaded) {
             flecs_wait_for_sync(world);
+            flecs_pipeline_sort_queries(world, pq, false);
         }
 
         if (!immediate) {
@@ -915,6 +915,8 @@ void flecs_world_stats_to_json(
     ECS_COUNTER_APPEND(reply, stats, frame.systems_ran, "Systems ran in frame");
     ECS_COUNTER_APPEND(reply, stats, frame.observers_ran, "Number of times an observer was invoked in frame");
     ECS_COUNTER_APPEND(reply, stats, frame.event_emit_count, "Events emitted in frame");
+    ECS_COUNTER_APPEND(reply, stats, frame.event_forward_count, "Events forwarded by traversing relationships in frame");
+    ECS_COUNTER_APPEND(reply, stats, frame.event_forward_cached_count, "Events forwarded using cached data in frame");
     ECS_COUNTER_APPEND(reply, stats, frame.rematch_count, "Number of query cache revalidations");
 
     ECS_GAUGE_APPEND(reply, stats, tables.count, "Tables in the world (including empty)");
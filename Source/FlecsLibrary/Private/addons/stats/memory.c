@@ -75,6 +75,19 @@ ecs_size_t flecs_hashmap_memory_get(
     return result;
 }
 
+static
+ecs_size_t flecs_name_index_memory_get(
+    const ecs_name_index_t *name_index)
+{
+    if (!name_index->capacity) {
+        return 0;
+    }
+
+    return name_index->capacity * 
+        (ECS_SIZEOF(ecs_name_index_entry_t) + 1) + 
+            FLECS_NAME_INDEX_GROUP_SIZE;
+}
+
 static
 ecs_size_t flecs_sparse_memory_get(
     const ecs_sparse_t *sparse,
@@ -196,6 +209,21 @@ ecs_entities_memory_t ecs_entity_memory_get(
 
     result.bytes_entity_index = 
         ecs_vec_size(&index->dense) * ECS_SIZEOF(uint64_t);
+#ifdef FLECS_ENTITY_INDEX_FLAT
+    result.bytes_entity_index += ecs_vec_size(&index->committed) * 
+        ECS_SIZEOF(uint64_t);
+
+    /* Committed pages, not counting rounding to OS pages */
+    const uint64_t *committed = ecs_vec_first(&index->committed);
+    int32_t i, page_count = 0, words_count = ecs_vec_count(&index->committed);
+    for (i = 0; i < words_count; i++) {
+        uint64_t bits = committed[i];
+        while (bits) {
+            bits &= bits - 1;
+            page_count ++;
+        }
+    }
+#else
     result.bytes_entity_index += ecs_vec_size(&index->pages) * 
         ECS_SIZEOF(ecs_entity_index_page_t*);
 
@@ -206,6 +234,7 @@ ecs_entities_memory_t ecs_entity_memory_get(
             page_count ++;
         }
     }
+#endif
 
     result.bytes_entity_index += page_count * 
         ECS_SIZEOF(ecs_entity_index_page_t);
@@ -255,14 +284,23 @@ void ecs_component_record_memory_get(
         result->bytes_component_record += ECS_SIZEOF(ecs_pair_record_t);
         
         if (pair->name_index) {
-            result->bytes_name_index += ECS_SIZEOF(ecs_hashmap_t);
-            result->bytes_name_index += flecs_hashmap_memory_get(
+            result->bytes_name_index += ECS_SIZEOF(ecs_name_index_t);
+            result->bytes_name_index += flecs_name_index_memory_get(
                 pair->name_index);
 
         }
 
+        const ecs_ordered_children_t *oc = &pair->ordered_children;
         result->bytes_ordered_children += 
-            ecs_vec_size(&pair->ordered_children) * ECS_SIZEOF(ecs_entity_t);
+            ecs_vec_count(&oc->blocks) * 
+                ECS_SIZEOF(ecs_ordered_children_block_t);
+        result->bytes_ordered_children += 
+            ecs_vec_size(&oc->blocks) * 
+                ECS_SIZEOF(ecs_ordered_children_block_t*);
+        result->bytes_ordered_children += 
+            ecs_vec_size(&oc->flat) * ECS_SIZEOF(ecs_entity_t);
+        result->bytes_ordered_children += 
+            flecs_map_memory_get(&oc->index, 0);
         
         const ecs_reachable_cache_t *reachable = &pair->reachable;
         result->bytes_reachable_cache += 
@@ -280,6 +318,10 @@ ecs_component_index_memory_t ecs_component_index_memory_get(
     FLECS_EACH_COMPONENT_RECORD(cr, {
         ecs_component_record_memory_get(cr, &result);
     })
+
+    result.reclaim_count = ecs_vec_count(&world->store.reclaim_ids);
+    result.bytes_reclaim_queue = 
+        ecs_vec_size(&world->store.reclaim_ids) * ECS_SIZEOF(ecs_id_t);
     
 error:
     return result;
@@ -318,8 +360,8 @@ void ecs_query_memory_get(
         result->bytes_misc += query->field_count * ECS_SIZEOF(int32_t);
     }
     
-    /* Query cache memory */
-    if (impl->cache) {
+    /* Query cache memory. Shared caches are only counted for their owner. */
+    if (impl->cache && impl->cache->owner == impl) {
         ecs_query_cache_t *cache = impl->cache;
 
         result->cached_count++;
@@ -329,8 +371,16 @@ void ecs_query_memory_get(
             flecs_map_memory_get(&cache->tables, 
                 ECS_SIZEOF(ecs_query_cache_table_t));
         result->bytes_group_by += 
-            flecs_map_memory_get(&cache->groups, 
-                ECS_SIZEOF(ecs_query_cache_group_t));
+            flecs_map_memory_get(&cache->groups, 0);
+        result->bytes_group_by += 
+            ecs_vec_count(&cache->group_dir) * 
+                ECS_SIZEOF(ecs_query_cache_group_t);
+        result->bytes_group_by += 
+            ecs_vec_size(&cache->group_dir) * 
+                ECS_SIZEOF(ecs_query_cache_group_t*);
+        result->bytes_group_by += 
+            ecs_vec_size(&cache->group_index) * 
+                ECS_SIZEOF(ecs_query_cache_group_t**);
         
         ecs_size_t cache_elem_size = flecs_query_cache_elem_size(cache);
         ecs_query_cache_group_t *cur = cache->first_group;
@@ -365,6 +415,12 @@ void ecs_query_memory_get(
             ecs_vec_size(&cache->table_slices) * 
                 ECS_SIZEOF(ecs_table_range_t);
 
+        result->bytes_cache += 
+            ecs_vec_size(&cache->sharers) * ECS_SIZEOF(ecs_query_impl_t*);
+        result->bytes_cache += 
+            ecs_vec_size(&cache->snapshot_ranges) * 
+                ECS_SIZEOF(ecs_table_range_t);
+
         if (cache->sources) {
             result->bytes_cache += 
                 query->field_count * ECS_SIZEOF(ecs_entity_t);
@@ -862,8 +918,8 @@ void flecs_reflection_memory_get(
                 for (o = 0; o < ocount; o ++) {
                     ecs_meta_op_t *op = &ops[o];
                     if (op->kind == EcsOpPushStruct) {
-                        result->bytes_reflection += flecs_hashmap_memory_get(
-                            op->is.members);
+                        result->bytes_reflection += 
+                            flecs_name_index_memory_get(op->is.members);
                     } else if (op->kind == EcsOpEnum || 
                         op->kind == EcsOpBitmask) 
                     {
@@ -1074,6 +1130,8 @@ ecs_allocator_memory_t ecs_allocator_memory_get(
         &world->allocators.table_diff);
     result.bytes_sparse_chunk = flecs_ballocator_memory_get(
         &world->allocators.sparse_chunk);
+    result.bytes_table_records = flecs_allocator_memory_get(
+        &world->allocators.table_records);
 
     result.bytes_allocator = flecs_allocator_memory_get(&world->allocator);
     result.bytes_misc += ecs_vec_size(&world->allocators.diff_builder.added) *
@@ -1204,7 +1262,9 @@ void flecs_stats_memory_register_reflection(
             { .name = "bytes_table_cache", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_name_index", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_ordered_children", .type = ecs_id(ecs_i32_t), .unit = unit },
-            { .name = "bytes_reachable_cache", .type = ecs_id(ecs_i32_t), .unit = unit }
+            { .name = "bytes_reachable_cache", .type = ecs_id(ecs_i32_t), .unit = unit },
+            { .name = "reclaim_count", .type = ecs_id(ecs_i32_t) },
+            { .name = "bytes_reclaim_queue", .type = ecs_id(ecs_i32_t), .unit = unit }
         }
     });
 
@@ -1277,6 +1337,7 @@ void flecs_stats_memory_register_reflection(
             { .name = "bytes_pair_record", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_table_diff", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_sparse_chunk", .type = ecs_id(ecs_i32_t), .unit = unit },
+            { .name = "bytes_table_records", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_allocator", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_stack_allocator", .type = ecs_id(ecs_i32_t), .unit = unit },
             { .name = "bytes_cmd_entry_chunk", .type = ecs_id(ecs_i32_t), .unit = unit },
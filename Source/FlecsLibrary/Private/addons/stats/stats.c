@@ -256,6 +256,8 @@ void ecs_world_stats_get(
     ECS_COUNTER_RECORD(&s->frame.systems_ran, t, world->info.systems_ran_total);
     ECS_COUNTER_RECORD(&s->frame.observers_ran, t, world->info.observers_ran_total);
     ECS_COUNTER_RECORD(&s->frame.event_emit_count, t, world->event_id);
+    ECS_COUNTER_RECORD(&s->frame.event_forward_count, t, world->info.event_forward_total);
+    ECS_COUNTER_RECORD(&s->frame.event_forward_cached_count, t, world->info.event_forward_cached_total);
 
     double delta_world_time = 
     ECS_COUNTER_RECORD(&s->performance.world_time_raw, t, world->info.world_time_total_raw);
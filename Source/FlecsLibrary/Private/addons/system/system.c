@@ -217,6 +217,26 @@ void flecs_system_poly_fini(void *sys)
     flecs_system_fini(sys);
 }
 
+/* Results of dirty_rows queries are split by changed rows, which can't be
+ * distributed across workers. */
+static
+int flecs_system_check_multi_threaded(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    bool multi_threaded,
+    ecs_flags32_t query_flags)
+{
+    if (multi_threaded && (query_flags & EcsQueryDirtyRows)) {
+        char *name = ecs_get_path(world, entity);
+        ecs_err("system %s cannot be multi_threaded with a dirty_rows query", 
+            name);
+        ecs_os_free(name);
+        return -1;
+    }
+
+    return 0;
+}
+
 static
 int flecs_system_init_timer(
     ecs_world_t *world,
@@ -272,6 +292,13 @@ ecs_entity_t ecs_system_init(
 
     EcsPoly *poly = flecs_poly_bind(world, entity, ecs_system_t);
     if (!poly->poly) {
+        if (flecs_system_check_multi_threaded(world, entity, 
+            desc->multi_threaded, desc->query.flags)) 
+        {
+            ecs_delete(world, entity);
+            return 0;
+        }
+
         ecs_system_t *system = flecs_poly_new(ecs_system_t);
         ecs_assert(system != NULL, ECS_INTERNAL_ERROR, NULL);
         
@@ -387,6 +414,12 @@ ecs_entity_t ecs_system_init(
         }
 
         if (desc->multi_threaded) {
+            if (flecs_system_check_multi_threaded(world, entity, 
+                desc->multi_threaded, system->query->flags)) 
+            {
+                return 0;
+            }
+
             system->multi_threaded = desc->multi_threaded;
         }
 
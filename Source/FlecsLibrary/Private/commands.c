@@ -1126,6 +1126,15 @@ bool flecs_defer_end(
             ecs_table_diff_builder_t diff;
             flecs_table_diff_builder_init(world, &diff);
 
+            /* Record events for batched observers while merging to the world.
+             * Recording doesn't start while batches are being flushed. */
+            bool batch_observers = merge_to_world && 
+                !world->observer_batching &&
+                !ecs_vec_count(&world->observer_batches);
+            if (batch_observers) {
+                world->observer_batching = true;
+            }
+
             for (i = 0; i < count; i ++) {
                 ecs_cmd_t *cmd = &cmds[i];
                 ecs_entity_t e = cmd->entity;
@@ -1286,6 +1295,10 @@ bool flecs_defer_end(
                 }
             }
 
+            if (batch_observers) {
+                flecs_observer_batches_flush(world);
+            }
+
             stage->cmd_flushing = false;
 
             flecs_stack_reset(&commands->stack);
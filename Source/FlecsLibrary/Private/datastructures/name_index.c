@@ -5,89 +5,361 @@
 
 #include "../private_api.h"
 
+/* Control byte values. Slots that are in use store the upper 7 bits of the
+ * hash, which always have the most significant bit cleared. */
+#define FLECS_NAME_INDEX_EMPTY (0x80)
+#define FLECS_NAME_INDEX_DELETED (0xFE)
+
+#define FLECS_NAME_INDEX_LSB (0x0101010101010101ull)
+#define FLECS_NAME_INDEX_MSB (0x8080808080808080ull)
+
+/* Control bytes of an initialized index without storage, so that an empty
+ * index doesn't need an allocation. */
+static uint8_t flecs_name_index_empty[FLECS_NAME_INDEX_GROUP_SIZE] = {
+    FLECS_NAME_INDEX_EMPTY, FLECS_NAME_INDEX_EMPTY, 
+    FLECS_NAME_INDEX_EMPTY, FLECS_NAME_INDEX_EMPTY,
+    FLECS_NAME_INDEX_EMPTY, FLECS_NAME_INDEX_EMPTY, 
+    FLECS_NAME_INDEX_EMPTY, FLECS_NAME_INDEX_EMPTY
+};
+
+static
+uint8_t flecs_name_index_h2(
+    uint64_t hash)
+{
+    return (uint8_t)(hash >> 57);
+}
+
+/* Load group of control bytes, with the first control byte in the lowest bits */
+static
+uint64_t flecs_name_index_group(
+    const uint8_t *ctrl)
+{
+    uint64_t result;
+    ecs_os_memcpy(&result, ctrl, ECS_SIZEOF(uint64_t));
+#if defined(__BIG_ENDIAN__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    result = __builtin_bswap64(result);
+#endif
+    return result;
+}
+
+/* Mask of slots in group that may match h2. Can contain false positives, which
+ * are filtered out by comparing the full hash. */
+static
+uint64_t flecs_name_index_match(
+    uint64_t group,
+    uint8_t h2)
+{
+    uint64_t x = group ^ (FLECS_NAME_INDEX_LSB * h2);
+    return (x - FLECS_NAME_INDEX_LSB) & ~x & FLECS_NAME_INDEX_MSB;
+}
+
+static
+uint64_t flecs_name_index_match_empty(
+    uint64_t group)
+{
+    return (group & ~(group << 6)) & FLECS_NAME_INDEX_MSB;
+}
+
 static
-uint64_t flecs_name_index_hash(
-    const void *ptr)
+uint64_t flecs_name_index_match_free(
+    uint64_t group)
 {
-    const ecs_hashed_string_t *str = ptr;
-    ecs_assert(str->hash != 0, ECS_INTERNAL_ERROR, NULL);
-    return str->hash;
+    return (group & ~(group << 7)) & FLECS_NAME_INDEX_MSB;
 }
 
 static
-int flecs_name_index_compare(
-    const void *ptr1, 
-    const void *ptr2)
+int32_t flecs_name_index_slot(
+    const ecs_name_index_t *map,
+    int32_t pos,
+    uint64_t match)
 {
-    const ecs_hashed_string_t *str1 = ptr1;
-    const ecs_hashed_string_t *str2 = ptr2;
-    ecs_size_t len1 = str1->length;
-    ecs_size_t len2 = str2->length;
-    if (len1 != len2) {
-        return (len1 > len2) - (len1 < len2);
+    return (pos + (flecs_ctz64(match) >> 3)) & (map->capacity - 1);
+}
+
+static
+void flecs_name_index_set_ctrl(
+    ecs_name_index_t *map,
+    int32_t slot,
+    uint8_t value)
+{
+    map->ctrl[slot] = value;
+
+    /* The first group is mirrored after the last slot, so that groups can be
+     * loaded from any position without wrapping around. */
+    if (slot < FLECS_NAME_INDEX_GROUP_SIZE) {
+        map->ctrl[map->capacity + slot] = value;
     }
+}
 
-    return ecs_os_memcmp(str1->value, str2->value, len1);
+static
+ecs_size_t flecs_name_index_storage_size(
+    int32_t capacity)
+{
+    return capacity * ECS_SIZEOF(ecs_name_index_entry_t) + 
+        capacity + FLECS_NAME_INDEX_GROUP_SIZE;
+}
+
+static
+void flecs_name_index_storage_alloc(
+    ecs_name_index_t *map,
+    int32_t capacity)
+{
+    ecs_assert(capacity >= FLECS_NAME_INDEX_GROUP_SIZE, 
+        ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(capacity == flecs_next_pow_of_2(capacity), 
+        ECS_INTERNAL_ERROR, NULL);
+
+    ecs_size_t size = flecs_name_index_storage_size(capacity);
+    void *storage;
+    if (map->allocator) {
+        storage = flecs_alloc(map->allocator, size);
+    } else {
+        storage = ecs_os_malloc(size);
+    }
+
+    map->entries = storage;
+    map->ctrl = ECS_OFFSET(storage, 
+        capacity * ECS_SIZEOF(ecs_name_index_entry_t));
+    map->capacity = capacity;
+    map->count = 0;
+    map->tombstones = 0;
+    ecs_os_memset(map->ctrl, FLECS_NAME_INDEX_EMPTY, 
+        capacity + FLECS_NAME_INDEX_GROUP_SIZE);
+}
+
+static
+void flecs_name_index_storage_free(
+    ecs_allocator_t *allocator,
+    ecs_name_index_entry_t *entries,
+    int32_t capacity)
+{
+    if (!capacity) {
+        return;
+    }
+
+    ecs_size_t size = flecs_name_index_storage_size(capacity);
+    if (allocator) {
+        flecs_free(allocator, size, entries);
+    } else {
+        ecs_os_free(entries);
+    }
+}
+
+/* Find free slot for hash. Index must have at least one free slot. */
+static
+int32_t flecs_name_index_find_free(
+    const ecs_name_index_t *map,
+    uint64_t hash)
+{
+    int32_t mask = map->capacity - 1;
+    int32_t pos = (int32_t)(hash & (uint64_t)mask);
+    int32_t step = 0;
+
+    for (;;) {
+        uint64_t group = flecs_name_index_group(&map->ctrl[pos]);
+        uint64_t free = flecs_name_index_match_free(group);
+        if (free) {
+            return flecs_name_index_slot(map, pos, free);
+        }
+
+        step += FLECS_NAME_INDEX_GROUP_SIZE;
+        pos = (pos + step) & mask;
+        ecs_assert(step <= map->capacity, ECS_INTERNAL_ERROR, NULL);
+    }
+}
+
+static
+void flecs_name_index_insert(
+    ecs_name_index_t *map,
+    const ecs_name_index_entry_t *entry)
+{
+    int32_t slot = flecs_name_index_find_free(map, entry->hash);
+    if (map->ctrl[slot] == FLECS_NAME_INDEX_DELETED) {
+        map->tombstones --;
+    }
+
+    flecs_name_index_set_ctrl(map, slot, flecs_name_index_h2(entry->hash));
+    map->entries[slot] = *entry;
+    map->count ++;
+}
+
+static
+void flecs_name_index_rehash(
+    ecs_name_index_t *map,
+    int32_t capacity)
+{
+    ecs_name_index_entry_t *entries = map->entries;
+    uint8_t *ctrl = map->ctrl;
+    int32_t i, old_capacity = map->capacity;
+
+    flecs_name_index_storage_alloc(map, capacity);
+
+    for (i = 0; i < old_capacity; i ++) {
+        if (!(ctrl[i] & FLECS_NAME_INDEX_EMPTY)) {
+            flecs_name_index_insert(map, &entries[i]);
+        }
+    }
+
+    flecs_name_index_storage_free(map->allocator, entries, old_capacity);
+}
+
+/* Capacity at which count entries stay under the 7/8 max load factor */
+static
+int32_t flecs_name_index_capacity(
+    int32_t count)
+{
+    int32_t capacity = flecs_next_pow_of_2(count + (count / 7) + 1);
+    if (capacity < FLECS_NAME_INDEX_GROUP_SIZE) {
+        capacity = FLECS_NAME_INDEX_GROUP_SIZE;
+    }
+    return capacity;
+}
+
+/* Make sure there's room for one more entry */
+static
+void flecs_name_index_reserve(
+    ecs_name_index_t *map)
+{
+    int32_t capacity = map->capacity;
+    if (((map->count + map->tombstones + 1) * 8) <= (capacity * 7)) {
+        return;
+    }
+
+    /* If most used slots are tombstones, rehash without growing */
+    if (capacity && ((map->count * 2) < capacity)) {
+        flecs_name_index_rehash(map, capacity);
+    } else {
+        flecs_name_index_rehash(map, 
+            flecs_name_index_capacity(map->count + 1));
+    }
+}
+
+/* Find slot of entry with id and hash, or -1 if not found */
+static
+int32_t flecs_name_index_find_id(
+    const ecs_name_index_t *map,
+    uint64_t id,
+    uint64_t hash)
+{
+    if (!map->count) {
+        return -1;
+    }
+
+    uint8_t h2 = flecs_name_index_h2(hash);
+    int32_t mask = map->capacity - 1;
+    int32_t pos = (int32_t)(hash & (uint64_t)mask);
+    int32_t step = 0;
+
+    for (;;) {
+        uint64_t group = flecs_name_index_group(&map->ctrl[pos]);
+        uint64_t match = flecs_name_index_match(group, h2);
+        while (match) {
+            int32_t slot = flecs_name_index_slot(map, pos, match);
+            const ecs_name_index_entry_t *entry = &map->entries[slot];
+            if (entry->id == id && entry->hash == hash) {
+                return slot;
+            }
+            match &= match - 1;
+        }
+
+        if (flecs_name_index_match_empty(group)) {
+            return -1;
+        }
+
+        step += FLECS_NAME_INDEX_GROUP_SIZE;
+        pos = (pos + step) & mask;
+        if (step > map->capacity) {
+            return -1;
+        }
+    }
 }
 
 void flecs_name_index_init(
-    ecs_hashmap_t *hm,
+    ecs_name_index_t *map,
     ecs_allocator_t *allocator) 
 {
-    flecs_hashmap_init_(hm, 
-        ECS_SIZEOF(ecs_hashed_string_t), ECS_SIZEOF(uint64_t), 
-        flecs_name_index_hash, 
-        flecs_name_index_compare,
-        allocator);
+    map->ctrl = flecs_name_index_empty;
+    map->entries = NULL;
+    map->count = 0;
+    map->tombstones = 0;
+    map->capacity = 0;
+    map->allocator = allocator;
 }
 
 void flecs_name_index_init_if(
-    ecs_hashmap_t *hm,
+    ecs_name_index_t *map,
     ecs_allocator_t *allocator) 
 {
-    if (!hm->compare) {
-        flecs_name_index_init(hm, allocator);
+    if (!map->ctrl) {
+        flecs_name_index_init(map, allocator);
     }
 }
 
 bool flecs_name_index_is_init(
-    const ecs_hashmap_t *hm)
+    const ecs_name_index_t *map)
 {
-    return hm->compare != NULL;
+    return map->ctrl != NULL;
 }
 
-ecs_hashmap_t* flecs_name_index_new(
+ecs_name_index_t* flecs_name_index_new(
     ecs_allocator_t *allocator) 
 {
-    ecs_hashmap_t *result = flecs_alloc_t(allocator, ecs_hashmap_t);
+    ecs_name_index_t *result = flecs_alloc_t(allocator, ecs_name_index_t);
     flecs_name_index_init(result, allocator);
     return result;
 }
 
 void flecs_name_index_fini(
-    ecs_hashmap_t *map)
+    ecs_name_index_t *map)
 {
-    flecs_hashmap_fini(map);
+    flecs_name_index_storage_free(map->allocator, map->entries, map->capacity);
+    map->ctrl = NULL;
+    map->entries = NULL;
+    map->count = 0;
+    map->tombstones = 0;
+    map->capacity = 0;
 }
 
 void flecs_name_index_free(
-    ecs_hashmap_t *map)
+    ecs_name_index_t *map)
 {
     if (map) {
-        ecs_allocator_t *a = map->impl.allocator;
+        ecs_allocator_t *a = map->allocator;
         flecs_name_index_fini(map);
-        flecs_free_t(a, ecs_hashmap_t, map);
+        flecs_free_t(a, ecs_name_index_t, map);
     }
 }
 
-ecs_hashmap_t* flecs_name_index_copy(
-    ecs_hashmap_t *map)
+ecs_name_index_t* flecs_name_index_copy(
+    ecs_name_index_t *map)
 {
-    ecs_hashmap_t *result = flecs_alloc_t(map->impl.allocator, ecs_hashmap_t);
-    flecs_hashmap_copy(result, map);
+    ecs_name_index_t *result = flecs_name_index_new(map->allocator);
+    if (map->capacity) {
+        flecs_name_index_storage_alloc(result, map->capacity);
+        ecs_os_memcpy(result->entries, map->entries, 
+            flecs_name_index_storage_size(map->capacity));
+        result->count = map->count;
+        result->tombstones = map->tombstones;
+    }
     return result;
 }
 
+void flecs_name_index_reclaim(
+    ecs_name_index_t *map)
+{
+    if (!map->count) {
+        flecs_name_index_storage_free(
+            map->allocator, map->entries, map->capacity);
+        flecs_name_index_init(map, map->allocator);
+        return;
+    }
+
+    int32_t capacity = flecs_name_index_capacity(map->count);
+    if (capacity < map->capacity || map->tombstones) {
+        flecs_name_index_rehash(map, capacity);
+    }
+}
+
 ecs_hashed_string_t flecs_get_hashed_string(
     const char *name,
     ecs_size_t length,
@@ -113,40 +385,49 @@ ecs_hashed_string_t flecs_get_hashed_string(
 }
 
 const uint64_t* flecs_name_index_find_ptr(
-    const ecs_hashmap_t *map,
+    const ecs_name_index_t *map,
     const char *name,
     ecs_size_t length,
     uint64_t hash)
 {
-    ecs_hashed_string_t hs = flecs_get_hashed_string(name, length, hash);
-    ecs_hm_bucket_t *b = flecs_hashmap_get_bucket(map, hs.hash);
-    if (!b) {
+    if (!map->count) {
         return NULL;
     }
 
-    ecs_hashed_string_t *keys = ecs_vec_first(&b->keys);
-    int32_t i, count = ecs_vec_count(&b->keys);
+    ecs_hashed_string_t hs = flecs_get_hashed_string(name, length, hash);
+    uint8_t h2 = flecs_name_index_h2(hs.hash);
+    int32_t mask = map->capacity - 1;
+    int32_t pos = (int32_t)(hs.hash & (uint64_t)mask);
+    int32_t step = 0;
 
-    for (i = 0; i < count; i ++) {
-        ecs_hashed_string_t *key = &keys[i];
-        ecs_assert(key->hash == hs.hash, ECS_INTERNAL_ERROR, NULL);
+    for (;;) {
+        uint64_t group = flecs_name_index_group(&map->ctrl[pos]);
+        uint64_t match = flecs_name_index_match(group, h2);
+        while (match) {
+            int32_t slot = flecs_name_index_slot(map, pos, match);
+            const ecs_name_index_entry_t *entry = &map->entries[slot];
+            if (entry->hash == hs.hash && entry->length == hs.length) {
+                if (!ecs_os_memcmp(entry->name, name, hs.length)) {
+                    return &entry->id;
+                }
+            }
+            match &= match - 1;
+        }
 
-        if (hs.length != key->length) {
-            continue;
+        if (flecs_name_index_match_empty(group)) {
+            return NULL;
         }
 
-        if (!ecs_os_strcmp(name, key->value)) {
-            uint64_t *e = ecs_vec_get_t(&b->values, uint64_t, i);
-            ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
-            return e;
+        step += FLECS_NAME_INDEX_GROUP_SIZE;
+        pos = (pos + step) & mask;
+        if (step > map->capacity) {
+            return NULL;
         }
     }
-
-    return NULL;
 }
 
 uint64_t flecs_name_index_find(
-    const ecs_hashmap_t *map,
+    const ecs_name_index_t *map,
     const char *name,
     ecs_size_t length,
     uint64_t hash)
@@ -159,57 +440,50 @@ uint64_t flecs_name_index_find(
 }
 
 void flecs_name_index_remove(
-    ecs_hashmap_t *map,
+    ecs_name_index_t *map,
     uint64_t e,
     uint64_t hash)
 {
-    ecs_hm_bucket_t *b = flecs_hashmap_get_bucket(map, hash);
-    if (!b) {
+    int32_t slot = flecs_name_index_find_id(map, e, hash);
+    if (slot == -1) {
         return;
     }
 
-    uint64_t *ids = ecs_vec_first(&b->values);
-    int32_t i, count = ecs_vec_count(&b->values);
-    for (i = 0; i < count; i ++) {
-        if (ids[i] == e) {
-            flecs_hm_bucket_remove(map, b, hash, i);
-            break;
-        }
+    map->count --;
+    if (!map->count) {
+        /* Reset control bytes so lookups in an empty index don't have to
+         * skip over tombstones. */
+        ecs_os_memset(map->ctrl, FLECS_NAME_INDEX_EMPTY, 
+            map->capacity + FLECS_NAME_INDEX_GROUP_SIZE);
+        map->tombstones = 0;
+    } else {
+        flecs_name_index_set_ctrl(map, slot, FLECS_NAME_INDEX_DELETED);
+        map->tombstones ++;
     }
 }
 
 void flecs_name_index_update_name(
-    ecs_hashmap_t *map,
+    ecs_name_index_t *map,
     uint64_t e,
     uint64_t hash,
     const char *name)
 {
-    ecs_hm_bucket_t *b = flecs_hashmap_get_bucket(map, hash);
-    if (!b) {
+    int32_t slot = flecs_name_index_find_id(map, e, hash);
+    if (slot == -1) {
+        /* Entity isn't in the index, e.g. because its name was never set */
         return;
     }
 
-    uint64_t *ids = ecs_vec_first(&b->values);
-    int32_t i, count = ecs_vec_count(&b->values);
-    for (i = 0; i < count; i ++) {
-        if (ids[i] == e) {
-            ecs_hashed_string_t *key = ecs_vec_get_t(
-                &b->keys, ecs_hashed_string_t, i);
-            key->value = ECS_CONST_CAST(char*, name);
-            ecs_assert(ecs_os_strlen(name) == key->length,
-                ECS_INTERNAL_ERROR, NULL);
-            ecs_assert(flecs_hash(name, key->length) == key->hash,
-                ECS_INTERNAL_ERROR, NULL);
-            return;
-        }
-    }
-
-    /* Record must already have been in the index */
-    ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    ecs_name_index_entry_t *entry = &map->entries[slot];
+    entry->name = name;
+    ecs_assert(ecs_os_strlen(name) == entry->length,
+        ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(flecs_hash(name, entry->length) == entry->hash,
+        ECS_INTERNAL_ERROR, NULL);
 }
 
 void flecs_name_index_ensure(
-    ecs_hashmap_t *map,
+    ecs_name_index_t *map,
     uint64_t id,
     const char *name,
     ecs_size_t length,
@@ -228,11 +502,16 @@ void flecs_name_index_ensure(
                 "(existing = %u, new = %u)", 
                 name, (uint32_t)existing, (uint32_t)id);
         }
+        return;
     }
 
-    flecs_hashmap_result_t hmr = flecs_hashmap_ensure(
-        map, &key, uint64_t);
-    *((uint64_t*)hmr.value) = id;
+    flecs_name_index_reserve(map);
+    flecs_name_index_insert(map, &(ecs_name_index_entry_t){
+        .hash = key.hash,
+        .id = id,
+        .name = name,
+        .length = key.length
+    });
 error:
     return;
 }
@@ -3,8 +3,11 @@
  * @brief Data structure for resolving 64bit keys by string (name).
  */
 
-#ifndef FLECS_NAME_INDEX_H
-#define FLECS_NAME_INDEX_H
+#ifndef FLECS_NAME_INDEX_IMPL_H
+#define FLECS_NAME_INDEX_IMPL_H
+
+/* Number of control bytes that are scanned at once */
+#define FLECS_NAME_INDEX_GROUP_SIZE (8)
 
 /** Type used for internal string hashmap */
 typedef struct ecs_hashed_string_t {
@@ -14,27 +17,31 @@ typedef struct ecs_hashed_string_t {
 } ecs_hashed_string_t;
 
 void flecs_name_index_init(
-    ecs_hashmap_t *hm,
+    ecs_name_index_t *map,
     ecs_allocator_t *allocator);
 
 void flecs_name_index_init_if(
-    ecs_hashmap_t *hm,
+    ecs_name_index_t *map,
     ecs_allocator_t *allocator);
 
 bool flecs_name_index_is_init(
-    const ecs_hashmap_t *hm);
+    const ecs_name_index_t *map);
 
-ecs_hashmap_t* flecs_name_index_new(
+ecs_name_index_t* flecs_name_index_new(
     ecs_allocator_t *allocator);
 
 void flecs_name_index_fini(
-    ecs_hashmap_t *map);
+    ecs_name_index_t *map);
 
 void flecs_name_index_free(
-    ecs_hashmap_t *map);
+    ecs_name_index_t *map);
+
+ecs_name_index_t* flecs_name_index_copy(
+    ecs_name_index_t *map);
+
+void flecs_name_index_reclaim(
+    ecs_name_index_t *map);
 
-ecs_hashmap_t* flecs_name_index_copy(
-    ecs_hashmap_t *dst);
 
 ecs_hashed_string_t flecs_get_hashed_string(
     const char *name,
@@ -42,31 +49,31 @@ ecs_hashed_string_t flecs_get_hashed_string(
     uint64_t hash);
 
 const uint64_t* flecs_name_index_find_ptr(
-    const ecs_hashmap_t *map,
+    const ecs_name_index_t *map,
     const char *name,
     ecs_size_t length,
     uint64_t hash);
 
 uint64_t flecs_name_index_find(
-    const ecs_hashmap_t *map,
+    const ecs_name_index_t *map,
     const char *name,
     ecs_size_t length,
     uint64_t hash);
 
 void flecs_name_index_ensure(
-    ecs_hashmap_t *map,
+    ecs_name_index_t *map,
     uint64_t id,
     const char *name,
     ecs_size_t length,
     uint64_t hash);
 
 void flecs_name_index_remove(
-    ecs_hashmap_t *map,
+    ecs_name_index_t *map,
     uint64_t id,
     uint64_t hash);
 
 void flecs_name_index_update_name(
-    ecs_hashmap_t *map,
+    ecs_name_index_t *map,
     uint64_t e,
     uint64_t hash,
     const char *name);
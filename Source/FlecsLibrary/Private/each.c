@@ -123,9 +123,11 @@ ecs_iter_t ecs_children_w_rel(
     }
 
     if (cr->flags & EcsIdOrderedChildren) {
-        ecs_vec_t *v = &cr->pair->ordered_children;
-        it.entities = ecs_vec_first_t(v, ecs_entity_t);
-        it.count = ecs_vec_count(v);
+        ecs_vec_t *v = &cr->pair->ordered_children.blocks;
+        ecs_children_iter_t *children_iter = &it.priv_.iter.children;
+        children_iter->blocks = ecs_vec_first(v);
+        children_iter->count = ecs_vec_count(v);
+        children_iter->is_blocks = true;
         it.next = flecs_children_next_ordered;
         return it;
     } else if (cr->flags & EcsIdSparse) {
@@ -155,11 +157,26 @@ bool ecs_children_next(
     }
 
     if (it->next == flecs_children_next_ordered) {
+        ecs_children_iter_t *children_iter = &it->priv_.iter.children;
+        if (children_iter->is_blocks) {
+            /* Return ordered children one block at a time */
+            if (children_iter->index == children_iter->count) {
+                return false;
+            }
+
+            const ecs_ordered_children_block_t *block = 
+                children_iter->blocks[children_iter->index ++];
+            it->entities = block->entities;
+            it->count = block->count;
+
+            return true;
+        }
+
         if (!it->count) {
             return false;
         }
 
-        it->next = NULL; /* Only return once with ordered children vector */
+        it->next = NULL; /* Only return once with sparse children vector */
 
         return true;
     }
@@ -274,12 +274,12 @@ void flecs_commit(
     ecs_os_perf_trace_push("flecs.commit");
 
     ecs_assert(dst_table != NULL, ECS_INTERNAL_ERROR, NULL);
-    flecs_table_traversable_add(dst_table, is_trav);
+    flecs_table_traversable_add(world, dst_table, is_trav);
 
     flecs_move_entity(world, entity, record, dst_table, diff, 
         construct, evt_flags);
 
-    flecs_table_traversable_add(src_table, -is_trav);
+    flecs_table_traversable_add(world, src_table, -is_trav);
 
     /* If the entity is being watched, it is being monitored for changes and
      * requires rematching systems when components are added or removed. This
@@ -637,6 +637,7 @@ error:
 }
 
 void flecs_record_add_flag(
+    ecs_world_t *world,
     ecs_record_t *record,
     uint32_t flag)
 {
@@ -644,7 +645,7 @@ void flecs_record_add_flag(
         if (!(record->row & flag)) {
             ecs_table_t *table = record->table;
             ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
-            flecs_table_traversable_add(table, 1);
+            flecs_table_traversable_add(world, table, 1);
         }
     }
     record->row |= flag;
@@ -657,7 +658,7 @@ void flecs_add_flag(
 {
     ecs_record_t *record = flecs_entities_get_any(world, entity);
     ecs_assert(record != NULL, ECS_INTERNAL_ERROR, NULL);
-    flecs_record_add_flag(record, flag);
+    flecs_record_add_flag(world, record, flag);
 }
 
 void flecs_add_to_root_table(
@@ -897,7 +898,8 @@ void flecs_copy_id(
         ecs_os_memcpy(dst_ptr, src_ptr, flecs_utosize(size));
     }
 
-    flecs_table_mark_dirty(world, r->table, component);
+    flecs_table_mark_dirty(
+        world, r->table, component, ECS_RECORD_TO_ROW(r->row));
 
     ecs_table_t *table = r->table;
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -1700,7 +1702,7 @@ void ecs_delete(
             }
 
             if (row_flags & EcsEntityIsTraversable) {
-                flecs_table_traversable_add(r->table, -1);
+                flecs_table_traversable_add(world, r->table, -1);
             }
 
             /* Merge operations before deleting entity */
@@ -1956,6 +1958,89 @@ error:
     return NULL;
 }
 
+void ecs_get_id_n(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_id_t component,
+    const void **ptrs)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(count >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || (entities && ptrs), ECS_INVALID_PARAMETER, NULL);
+    ecs_check(ecs_id_is_valid(world, component) || ecs_id_is_wildcard(component), 
+        ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    flecs_check_exclusive_world_access_read(world);
+
+    ecs_component_record_t *cr = flecs_components_get(world, component);
+    if (!cr) {
+        if (count) {
+            ecs_os_memset_n(ptrs, 0, void*, count);
+        }
+        return;
+    }
+
+    /* Entities from an external list are often in the same table as the 
+     * previous entity, so remember the table record of the last table. */
+    ecs_table_t *last_table = NULL;
+    const ecs_table_record_t *tr = NULL;
+
+    ecs_record_t *records[FLECS_GET_N_BATCH_SIZE];
+    int32_t i, j;
+    for (i = 0; i < count; i += FLECS_GET_N_BATCH_SIZE) {
+        int32_t batch = count - i;
+        if (batch > FLECS_GET_N_BATCH_SIZE) {
+            batch = FLECS_GET_N_BATCH_SIZE;
+        }
+
+        flecs_entities_try_n(world, &entities[i], batch, records);
+
+        for (j = 0; j < batch; j ++) {
+            ecs_record_t *r = records[j];
+            ecs_table_t *table = r ? r->table : NULL;
+            const void *ptr = NULL;
+            if (!table) {
+                ptrs[i + j] = NULL;
+                continue;
+            }
+
+            if (cr->flags & EcsIdDontFragment) {
+                ptr = flecs_component_sparse_get(
+                    world, cr, table, entities[i + j]);
+                if (ptr) {
+                    ptrs[i + j] = ptr;
+                    continue;
+                }
+            }
+
+            if (table != last_table) {
+                tr = flecs_component_get_table(cr, table);
+                last_table = table;
+            }
+
+            if (!tr) {
+                ptr = flecs_get_base_component(world, table, component, cr, 0);
+            } else if (cr->flags & EcsIdSparse) {
+                ptr = flecs_component_sparse_get(
+                    world, cr, table, entities[i + j]);
+            } else {
+                ecs_check(tr->column != -1, ECS_INVALID_PARAMETER,
+                    "component '%s' passed to get() is a tag/zero sized",
+                        flecs_errstr(ecs_id_str(world, component)));
+                ptr = flecs_table_get_component(
+                    table, tr->column, ECS_RECORD_TO_ROW(r->row)).ptr;
+            }
+
+            ptrs[i + j] = ptr;
+        }
+    }
+error:
+    return;
+}
+
 #ifdef FLECS_DEBUG
 static
 bool flecs_component_has_on_replace(
@@ -2262,7 +2347,8 @@ void flecs_modified_id_if(
     flecs_notify_on_set(
         world, table, ECS_RECORD_TO_ROW(r->row), component, invoke_hook);
 
-    flecs_table_mark_dirty(world, table, component);
+    flecs_table_mark_dirty(
+        world, table, component, ECS_RECORD_TO_ROW(r->row));
     flecs_defer_end(world, stage);
 error:
     return;
@@ -2303,7 +2389,8 @@ void ecs_modified_id(
     flecs_notify_on_set(
         world, table, ECS_RECORD_TO_ROW(r->row), component, true);
 
-    flecs_table_mark_dirty(world, table, component);
+    flecs_table_mark_dirty(
+        world, table, component, ECS_RECORD_TO_ROW(r->row));
     flecs_defer_end(world, stage);
 error:
     return;
@@ -2351,7 +2438,8 @@ void flecs_set_id_move(
         ecs_os_memcpy(dst.ptr, ptr, flecs_utosize(size));
     }
 
-    flecs_table_mark_dirty(world, r->table, component);
+    flecs_table_mark_dirty(
+        world, r->table, component, ECS_RECORD_TO_ROW(r->row));
 
     if (cmd_kind == EcsCmdSet) {
         ecs_table_t *table = r->table;
@@ -2552,11 +2640,8 @@ ecs_entities_t ecs_get_ordered_children(
 
     ecs_assert(cr->pair != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    return (ecs_entities_t){
-        .count = ecs_vec_count(&cr->pair->ordered_children),
-        .alive_count = ecs_vec_count(&cr->pair->ordered_children),
-        .ids = ecs_vec_first(&cr->pair->ordered_children),
-    };
+    return flecs_ordered_children_get(
+        ECS_CONST_CAST(ecs_world_t*, world), cr);
 error:
     return (ecs_entities_t){0};
 }
@@ -2909,6 +2994,42 @@ error:
     return false;
 }
 
+int32_t ecs_is_alive_n(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    bool *alive)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(count >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || (entities && alive), ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    flecs_check_exclusive_world_access_read(world);
+
+    ecs_record_t *records[FLECS_GET_N_BATCH_SIZE];
+    int32_t i, j, result = 0;
+    for (i = 0; i < count; i += FLECS_GET_N_BATCH_SIZE) {
+        int32_t batch = count - i;
+        if (batch > FLECS_GET_N_BATCH_SIZE) {
+            batch = FLECS_GET_N_BATCH_SIZE;
+        }
+
+        flecs_entities_try_n(world, &entities[i], batch, records);
+
+        for (j = 0; j < batch; j ++) {
+            bool is_alive = records[j] != NULL;
+            alive[i + j] = is_alive;
+            result += is_alive;
+        }
+    }
+
+    return result;
+error:
+    return 0;
+}
+
 ecs_entity_t ecs_get_alive(
     const ecs_world_t *world,
     ecs_entity_t entity)
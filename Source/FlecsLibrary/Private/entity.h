@@ -15,6 +15,9 @@
             ECS_RECORD_TO_ROW(r->row));\
     }
 
+/* Number of entities that functions like ecs_get_id_n look up at a time */
+#define FLECS_GET_N_BATCH_SIZE (256)
+
 typedef struct {
     const ecs_type_info_t *ti;
     void *ptr;
@@ -78,6 +81,7 @@ void flecs_add_flag(
 
 /* Same as flecs_add_flag but for ecs_record_t. */
 void flecs_record_add_flag(
+    ecs_world_t *world,
     ecs_record_t *record,
     uint32_t flag);
 
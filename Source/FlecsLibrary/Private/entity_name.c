@@ -348,6 +348,16 @@ void flecs_bootstrap_entity_name(
     });
 }
 
+static
+void flecs_name_version_bump(
+    ecs_world_t *world,
+    uint64_t hash)
+{
+    if (hash) {
+        world->name_version[hash & ECS_NAME_VERSION_ARRAY_BITMASK] ++;
+    }
+}
+
 void ecs_on_set(EcsIdentifier)(
     ecs_iter_t *it) 
 {
@@ -360,7 +370,7 @@ void ecs_on_set(EcsIdentifier)(
     ecs_id_t evt_id = it->event_id;
     ecs_entity_t kind = ECS_PAIR_SECOND(evt_id); /* Name, Symbol, Alias */
     ecs_id_t pair = ecs_childof(0);
-    ecs_hashmap_t *index = NULL;
+    ecs_name_index_t *index = NULL;
 
     if (kind == EcsSymbol) {
         index = &world->symbols;
@@ -410,6 +420,10 @@ void ecs_on_set(EcsIdentifier)(
             cur->index_hash = 0;
         }
 
+        if (kind != EcsSymbol) {
+            flecs_name_version_bump(world, cur->hash);
+        }
+
         if (cur->value && (evt == EcsOnSet)) {
             len = cur->length = ecs_os_strlen(name);
             hash = cur->hash = flecs_hash(name, len);
@@ -419,6 +433,10 @@ void ecs_on_set(EcsIdentifier)(
             cur->index = NULL;
         }
 
+        if (kind != EcsSymbol) {
+            flecs_name_version_bump(world, hash);
+        }
+
         if (index) {
             uint64_t index_hash = cur->index_hash;
             ecs_entity_t e = it->entities[i];
@@ -443,9 +461,10 @@ void ecs_on_set(EcsIdentifier)(
 
 static
 void flecs_reparent_name_index_intern(
+    ecs_world_t *world,
     const ecs_entity_t *entities,
-    ecs_hashmap_t *src_index,
-    ecs_hashmap_t *dst_index,
+    ecs_name_index_t *src_index,
+    ecs_name_index_t *dst_index,
     EcsIdentifier *names,
     int32_t count) 
 {
@@ -479,6 +498,8 @@ void flecs_reparent_name_index_intern(
                 name->index = dst_index;
             }
         }
+
+        flecs_name_version_bump(world, name->hash);
     }
 }
 
@@ -511,8 +532,8 @@ void flecs_reparent_name_index(
     ecs_assert(src_pair != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(dst_pair != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_hashmap_t *src_index = src_pair->name_index;
-    ecs_hashmap_t *dst_index = dst_pair->name_index;
+    ecs_name_index_t *src_index = src_pair->name_index;
+    ecs_name_index_t *dst_index = dst_pair->name_index;
     if ((!src_index && !dst_index)) {
         return;
     }
@@ -521,9 +542,8 @@ void flecs_reparent_name_index(
         dst, EcsIdentifier, EcsName, offset);
     ecs_assert(names != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    flecs_reparent_name_index_intern(&ecs_table_entities(dst)[offset],
+    flecs_reparent_name_index_intern(world, &ecs_table_entities(dst)[offset],
         src_index, dst_index, names, count);
-
 }
 
 void flecs_unparent_name_index(
@@ -545,14 +565,14 @@ void flecs_unparent_name_index(
     }
 
     ecs_assert(src->_->childof_r != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_hashmap_t *src_index = src->_->childof_r->name_index;
-    ecs_hashmap_t *dst_index = dst ? dst->_->childof_r->name_index : NULL;
+    ecs_name_index_t *src_index = src->_->childof_r->name_index;
+    ecs_name_index_t *dst_index = dst ? dst->_->childof_r->name_index : NULL;
 
     EcsIdentifier *names = ecs_table_get_pair(world, 
         src, EcsIdentifier, EcsName, offset);
     ecs_assert(names != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    flecs_reparent_name_index_intern(&ecs_table_entities(src)[offset],
+    flecs_reparent_name_index_intern(world, &ecs_table_entities(src)[offset],
         src_index, dst_index, names, count);
 }
 
@@ -631,7 +651,7 @@ ecs_entity_t ecs_lookup_child(
 
     ecs_id_t pair = ecs_childof(parent);
     ecs_component_record_t *cr = flecs_components_get(world, pair);
-    ecs_hashmap_t *index = NULL;
+    ecs_name_index_t *index = NULL;
     if (cr) {
         index = flecs_component_name_index_get(world, cr);
     }
@@ -681,6 +701,30 @@ error:
     return 0;
 }
 
+uint64_t ecs_name_hash(
+    const char *name,
+    ecs_size_t length)
+{
+    ecs_check(name != NULL, ECS_INVALID_PARAMETER, NULL);
+    if (!length) {
+        length = ecs_os_strlen(name);
+    }
+    return flecs_hash(name, length);
+error:
+    return 0;
+}
+
+uint32_t ecs_get_name_version(
+    const ecs_world_t *world,
+    uint64_t name_hash)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    world = ecs_get_world(world);
+    return world->name_version[name_hash & ECS_NAME_VERSION_ARRAY_BITMASK];
+error:
+    return 0;
+}
+
 ecs_entity_t ecs_lookup_path_w_sep(
     const ecs_world_t *world,
     ecs_entity_t parent,
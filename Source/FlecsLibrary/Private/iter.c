@@ -812,6 +812,23 @@ error:
     return 0;
 }
 
+const uint64_t* ecs_iter_get_row_mask(
+    const ecs_iter_t *it)
+{
+    ecs_check(it != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (it->chain_it) {
+        return ecs_iter_get_row_mask(it->chain_it);
+    }
+
+    ecs_check(it->query != NULL, ECS_INVALID_PARAMETER, 
+        "ecs_iter_get_row_mask must be called on iterator that iterates a query");
+
+    return it->priv_.iter.query.row_mask;
+error:
+    return NULL;
+}
+
 static
 void ecs_chained_iter_fini(
     ecs_iter_t *it)
@@ -936,6 +953,8 @@ ecs_iter_t ecs_worker_iter(
     ecs_check(index >= 0, ECS_INVALID_PARAMETER, 
         "invalid field index %d", index);
     ecs_check(index < count, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!it->query || !(it->query->flags & EcsQueryDirtyRows), 
+        ECS_UNSUPPORTED, "cannot use worker iterator with EcsQueryDirtyRows");
 
     ecs_iter_t result = *it;
     result.priv_.stack_cursor = NULL; /* Don't copy allocator cursor */
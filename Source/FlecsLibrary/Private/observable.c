@@ -245,121 +245,176 @@ bool flecs_observers_exist(
 }
 
 static
-void flecs_emit_propagate(
+void flecs_emit_propagate_collect(
     ecs_world_t *world,
-    ecs_iter_t *it,
-    ecs_component_record_t *cr,
     ecs_component_record_t *tgt_cr,
-    ecs_entity_t trav,
-    ecs_event_id_record_t **iders,
-    int32_t ider_count);
+    ecs_entity_t propagate_trav,
+    ecs_vec_t *tables,
+    ecs_vec_t *records)
+{
+    ecs_assert(tgt_cr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* Collect tables of records of traversable relationships */
+    ecs_component_record_t *cur = tgt_cr;
+    while ((cur = flecs_component_trav_next(cur))) {
+        /* Get traversed relationship */
+        ecs_entity_t trav = ECS_PAIR_FIRST(cur->id);
+        if (propagate_trav && propagate_trav != trav) {
+            if (propagate_trav != EcsIsA) {
+                continue;
+            }
+        }
+
+        ecs_vec_append_t(&world->allocator, records, 
+            ecs_component_record_t*)[0] = cur;
+
+        ecs_table_cache_iter_t idt;
+        if (!flecs_table_cache_all_iter(&cur->cache, &idt)) {
+            continue;
+        }
+
+        /* Empty tables are added too, so that the cache stays valid when
+         * entities are added to them. */
+        const ecs_table_record_t *tr;
+        while ((tr = flecs_table_cache_next(&idt, ecs_table_record_t))) {
+            ecs_table_t *table = tr->hdr.table;
+            ecs_propagate_elem_t *elem = ecs_vec_append_t(
+                &world->allocator, tables, ecs_propagate_elem_t);
+            elem->table = table;
+            elem->trav = trav;
+
+            if (!table->_->traversable_count) {
+                continue;
+            }
+
+            const ecs_entity_t *entities = ecs_table_entities(table);
+            int32_t e, entity_count = ecs_table_count(table);
+            for (e = 0; e < entity_count; e ++) {
+                ecs_record_t *r = flecs_entities_get(world, entities[e]);
+                ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+                ecs_component_record_t *cr_t = r->cr;
+                if (cr_t) {
+                    /* Only walk entities that are used in pairs with
+                     * traversable relationships */
+                    flecs_emit_propagate_collect(
+                        world, cr_t, trav, tables, records);
+                }
+            }
+        }
+    }
+}
 
 static
-void flecs_emit_propagate_id(
+void flecs_emit_propagate_table(
     ecs_world_t *world,
     ecs_iter_t *it,
     ecs_component_record_t *cr,
-    ecs_component_record_t *cur,
+    ecs_table_t *table,
     ecs_entity_t trav,
     ecs_event_id_record_t **iders,
     int32_t ider_count)
 {
-    ecs_table_cache_iter_t idt;
-    if (!flecs_table_cache_all_iter(&cur->cache, &idt)) {
+    int32_t entity_count = ecs_table_count(table);
+    if (!entity_count) {
         return;
     }
 
-    const ecs_table_record_t *tr;
-    int32_t event_cur = it->event_cur;
-    while ((tr = flecs_table_cache_next(&idt, ecs_table_record_t))) {
-        ecs_table_t *table = tr->hdr.table;
-        if (!ecs_table_count(table)) {
-            continue;
-        }
-
-        bool owned = flecs_component_get_table(cr, table) != NULL;
-
-        int32_t e, entity_count = ecs_table_count(table);
-        it->table = table;
-        it->other_table = NULL;
-        it->offset = 0;
-        it->count = entity_count;
-        it->up_fields = 1;
-        if (entity_count) {
-            it->entities = ecs_table_entities(table);
-        }
-
-        int32_t ider_i;
-        for (ider_i = 0; ider_i < ider_count; ider_i ++) {
-            ecs_event_id_record_t *ider = iders[ider_i];
-            flecs_observers_invoke(world, &ider->up, it, table, trav);
+    bool owned = flecs_component_get_table(cr, table) != NULL;
 
-            if (!owned) {
-                /* Owned takes precedence */
-                flecs_observers_invoke(world, &ider->self_up, it, table, trav);
-            }
-        }
+    it->table = table;
+    it->other_table = NULL;
+    it->offset = 0;
+    it->count = entity_count;
+    it->up_fields = 1;
+    it->entities = ecs_table_entities(table);
 
-        if (!table->_->traversable_count) {
-            continue;
-        }
+    int32_t ider_i;
+    for (ider_i = 0; ider_i < ider_count; ider_i ++) {
+        ecs_event_id_record_t *ider = iders[ider_i];
+        flecs_observers_invoke(world, &ider->up, it, table, trav);
 
-        const ecs_entity_t *entities = ecs_table_entities(table);
-        for (e = 0; e < entity_count; e ++) {
-            ecs_record_t *r = flecs_entities_get(world, entities[e]);
-            ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
-            ecs_component_record_t *cr_t = r->cr;
-            if (cr_t) {
-                /* Only notify for entities that are used in pairs with
-                 * traversable relationships */
-                flecs_emit_propagate(world, it, cr, cr_t, trav,
-                    iders, ider_count);
-            }
+        if (!owned) {
+            /* Owned takes precedence */
+            flecs_observers_invoke(world, &ider->self_up, it, table, trav);
         }
     }
-
-    it->event_cur = event_cur;
-    it->up_fields = 0;
 }
 
+/* Propagate event to tables that can reach the target through traversable
+ * relationships. The tables are cached on the (*, tgt) record, and the cache
+ * is rebuilt when tables or traversable entities are created, deleted or moved.
+ * Propagating an event invalidates the reachable caches of the traversed
+ * records, which event forwarding relies on when an entity is moved to a table
+ * that already exists. */
 static
 void flecs_emit_propagate(
     ecs_world_t *world,
     ecs_iter_t *it,
     ecs_component_record_t *cr,
     ecs_component_record_t *tgt_cr,
-    ecs_entity_t propagate_trav,
     ecs_event_id_record_t **iders,
     int32_t ider_count)
 {
-    ecs_assert(tgt_cr != NULL, ECS_INTERNAL_ERROR, NULL);    
-
-    if (ecs_should_log_3()) {
-        char *idstr = ecs_id_str(world, tgt_cr->id);
-        ecs_dbg_3("propagate events/invalidate cache for %s", idstr);
-        ecs_os_free(idstr);
-    }
+    ecs_assert(tgt_cr != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(tgt_cr->pair != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_log_push_3();
+    ecs_propagate_cache_t *pc = &tgt_cr->pair->propagate;
+    ecs_vec_t tmp_tables, *tables = &pc->tables;
+    ecs_vec_t tmp_records, *records = &pc->records;
 
-    /* Propagate to records of traversable relationships */
-    ecs_component_record_t *cur = tgt_cr;
-    while ((cur = flecs_component_trav_next(cur))) {
-        cur->pair->reachable.generation ++; /* Invalidate cache */
+    if (pc->version != world->propagate_version) {
+        if (ecs_should_log_3()) {
+            char *idstr = ecs_id_str(world, tgt_cr->id);
+            ecs_dbg_3("propagate cache miss for %s", idstr);
+            ecs_os_free(idstr);
+        }
 
-        /* Get traversed relationship */
-        ecs_entity_t trav = ECS_PAIR_FIRST(cur->id);
-        if (propagate_trav && propagate_trav != trav) {
-            if (propagate_trav != EcsIsA) {
-                continue;
-            }
+        if (pc->lock) {
+            /* Cache is iterated by an observer up the stack, don't modify */
+            ecs_vec_init_t(&world->allocator, &tmp_tables, 
+                ecs_propagate_elem_t, 0);
+            ecs_vec_init_t(&world->allocator, &tmp_records, 
+                ecs_component_record_t*, 0);
+            tables = &tmp_tables;
+            records = &tmp_records;
+        } else {
+            ecs_vec_clear(tables);
+            ecs_vec_clear(records);
+            pc->version = world->propagate_version;
         }
 
-        flecs_emit_propagate_id(
-            world, it, cr, cur, trav, iders, ider_count);
+        flecs_emit_propagate_collect(world, tgt_cr, 0, tables, records);
+        world->info.event_forward_total ++;
+    } else {
+        world->info.event_forward_cached_total ++;
     }
 
-    ecs_log_pop_3();
+    int32_t i, count = ecs_vec_count(records);
+    ecs_component_record_t **crs = ecs_vec_first(records);
+    for (i = 0; i < count; i ++) {
+        crs[i]->pair->reachable.generation ++; /* Invalidate cache */
+    }
+
+    int32_t event_cur = it->event_cur;
+    pc->lock ++;
+
+    count = ecs_vec_count(tables);
+    ecs_propagate_elem_t *elems = ecs_vec_first_t(tables, ecs_propagate_elem_t);
+    for (i = 0; i < count; i ++) {
+        ecs_propagate_elem_t *elem = &elems[i];
+        flecs_emit_propagate_table(
+            world, it, cr, elem->table, elem->trav, iders, ider_count);
+    }
+
+    pc->lock --;
+    it->event_cur = event_cur;
+    it->up_fields = 0;
+
+    if (tables == &tmp_tables) {
+        ecs_vec_fini_t(&world->allocator, &tmp_tables, ecs_propagate_elem_t);
+        ecs_vec_fini_t(&world->allocator, &tmp_records, 
+            ecs_component_record_t*);
+    }
 }
 
 static
@@ -476,8 +531,7 @@ void flecs_propagate_entities(
             /* Entity is used as target in traversable pairs, propagate */
             ecs_entity_t e = src ? src : entities[i];
             it->sources[0] = e;
-            flecs_emit_propagate(
-                world, it, cr, cr_t, 0, iders, ider_count);
+            flecs_emit_propagate(world, it, cr, cr_t, iders, ider_count);
         }
     }
     
@@ -932,6 +986,7 @@ void flecs_emit_forward(
             ecs_os_free(idstr);
         }
         ecs_log_push_3();
+        world->info.event_forward_total ++;
 
         ecs_vec_t stack;
         ecs_vec_init_t(&world->allocator, &stack, ecs_table_t*, 0);
@@ -965,6 +1020,8 @@ void flecs_emit_forward(
             flecs_emit_dump_cache(world, &rc->ids);
         }
 
+        world->info.event_forward_cached_total ++;
+
         ecs_entity_t trav = ECS_PAIR_FIRST(cr->id);
         ecs_reachable_elem_t *elems = ecs_vec_first_t(&rc->ids, 
             ecs_reachable_elem_t);
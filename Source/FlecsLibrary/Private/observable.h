@@ -17,6 +17,16 @@ typedef struct ecs_event_id_record_t {
     int32_t observer_count;
 } ecs_event_id_record_t;
 
+/* Events for a batched observer and table, recorded while merging commands
+ * or queued for an async observer */
+typedef struct ecs_observer_batch_t {
+    ecs_observer_t *observer;        /* NULL if observer was deleted */
+    ecs_entity_t event;
+    ecs_id_t id;
+    uint64_t table_id;               /* Table id, table may be deleted */
+    ecs_vec_t entities;              /* vector<ecs_entity_t> */
+} ecs_observer_batch_t;
+
 typedef struct ecs_observer_impl_t {
     ecs_observer_t pub;
 
@@ -34,6 +44,12 @@ typedef struct ecs_observer_impl_t {
     ecs_query_t *not_query;     /**< Query used to populate observer data when a
                                      term with a not operator triggers. */
 
+    ecs_vec_t async_batches;    /**< Events queued for async observer */
+    ecs_map_t async_queued;     /**< map<entity, event bits> of queued events */
+    ecs_entity_t async_system;  /**< System that invokes async observer */
+    int32_t async_done;         /**< Stages that finished invoking observer */
+    bool async_drained;         /**< Were queued events invoked? */
+
     /* Mixins */
     flecs_poly_dtor_t dtor;
 } ecs_observer_impl_t;
@@ -115,6 +131,10 @@ void flecs_emit_propagate_invalidate(
     int32_t offset,
     int32_t count);
 
+/* Invoke batched observers for events recorded while merging commands. */
+void flecs_observer_batches_flush(
+    ecs_world_t *world);
+
 /* Set bit indicating that observer is disabled. */
 void flecs_observer_set_disable_bit(
     ecs_world_t *world,
@@ -272,20 +272,14 @@ void flecs_unregister_observer(
 }
 
 static
-bool flecs_ignore_observer(
+bool flecs_ignore_observer_for_table(
     ecs_observer_t *o,
-    ecs_table_t *table,
-    ecs_iter_t *it)
+    ecs_table_t *table)
 {
     ecs_assert(o != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
 
     ecs_observer_impl_t *impl = flecs_observer_impl(o);
-    int32_t *last_event_id = impl->last_event_id;
-    if (last_event_id && last_event_id[0] == it->event_cur) {
-        return true;
-    }
-
     if (impl->flags & (EcsObserverIsDisabled|EcsObserverIsParentDisabled)) {
         return true;
     }
@@ -300,6 +294,21 @@ bool flecs_ignore_observer(
     return result;
 }
 
+static
+bool flecs_ignore_observer(
+    ecs_observer_t *o,
+    ecs_table_t *table,
+    ecs_iter_t *it)
+{
+    ecs_observer_impl_t *impl = flecs_observer_impl(o);
+    int32_t *last_event_id = impl->last_event_id;
+    if (last_event_id && last_event_id[0] == it->event_cur) {
+        return true;
+    }
+
+    return flecs_ignore_observer_for_table(o, table);
+}
+
 static
 void flecs_default_uni_observer_run_callback(ecs_iter_t *it) {
     ecs_observer_t *o = it->ctx;
@@ -330,6 +339,203 @@ void flecs_observer_invoke(
     }
 }
 
+typedef struct flecs_observer_batch_key_t {
+    ecs_observer_t *observer;
+    ecs_entity_t event;
+    ecs_id_t id;
+    uint64_t table_id;
+} flecs_observer_batch_key_t;
+
+/* Test if event can be delivered later. Only OnAdd and OnSet events for
+ * entities that own the component can be delivered later, as OnRemove 
+ * observers must run before the component is removed. */
+static
+bool flecs_observer_can_defer(
+    ecs_observer_t *o,
+    const ecs_iter_t *it,
+    ecs_entity_t trav)
+{
+    ecs_entity_t event = it->event;
+    if (event != EcsOnAdd && event != EcsOnSet) {
+        return false;
+    }
+
+    if (trav || !it->count || it->sources[0] || 
+        (it->flags & EcsEventTableOnly)) 
+    {
+        return false;
+    }
+
+    /* Components that aren't stored in the table (DontFragment, Any) */
+    const ecs_table_record_t *tr = it->trs[0];
+    if (!tr || tr->index == -1) {
+        return false;
+    }
+
+    if (o->query && !(o->query->flags & EcsQueryMatchThis)) {
+        return false;
+    }
+
+    return true;
+}
+
+static
+void flecs_observer_batch_init(
+    ecs_world_t *world,
+    ecs_observer_batch_t *batch,
+    ecs_observer_t *o,
+    const ecs_iter_t *it,
+    ecs_table_t *table)
+{
+    batch->observer = o;
+    batch->event = it->event;
+    batch->id = it->ids[0];
+    batch->table_id = table->id;
+    ecs_vec_init_t(&world->allocator, &batch->entities, ecs_entity_t, 0);
+}
+
+static
+void flecs_observer_batch_add(
+    ecs_world_t *world,
+    ecs_observer_batch_t *batch,
+    const ecs_iter_t *it)
+{
+    ecs_entity_t *dst = ecs_vec_grow_t(
+        &world->allocator, &batch->entities, ecs_entity_t, it->count);
+    ecs_os_memcpy_n(dst, it->entities, ecs_entity_t, it->count);
+}
+
+static
+void flecs_observer_batches_fini(
+    ecs_world_t *world,
+    ecs_vec_t *batches)
+{
+    ecs_observer_batch_t *array = ecs_vec_first(batches);
+    int32_t i, count = ecs_vec_count(batches);
+    for (i = 0; i < count; i ++) {
+        ecs_vec_fini_t(&world->allocator, &array[i].entities, ecs_entity_t);
+    }
+    ecs_vec_clear(batches);
+}
+
+/* Record event for batched observer while merging commands. */
+static
+void flecs_observer_batch_append(
+    ecs_world_t *world,
+    ecs_observer_t *o,
+    const ecs_iter_t *it,
+    ecs_table_t *table)
+{
+    flecs_observer_batch_key_t key = {
+        .observer = o,
+        .event = it->event,
+        .id = it->ids[0],
+        .table_id = table->id
+    };
+
+    uint64_t hash = flecs_hash(&key, ECS_SIZEOF(key));
+    ecs_map_init_if(&world->observer_batch_index, &world->allocator);
+    ecs_map_val_t *index = ecs_map_ensure(&world->observer_batch_index, hash);
+
+    ecs_observer_batch_t *batch = NULL;
+    if (index[0]) {
+        batch = ecs_vec_get_t(&world->observer_batches, 
+            ecs_observer_batch_t, (int32_t)index[0] - 1);
+        if (batch->observer != o || batch->event != key.event || 
+            batch->id != key.id || batch->table_id != key.table_id) 
+        {
+            /* Hash collision, start a new batch */
+            batch = NULL;
+        }
+    }
+
+    if (!batch) {
+        batch = ecs_vec_append_t(&world->allocator, 
+            &world->observer_batches, ecs_observer_batch_t);
+        flecs_observer_batch_init(world, batch, o, it, table);
+        index[0] = flecs_ito(uint64_t, ecs_vec_count(&world->observer_batches));
+    }
+
+    flecs_observer_batch_add(world, batch, it);
+}
+
+static
+ecs_observer_batch_t* flecs_observer_async_batch(
+    ecs_world_t *world,
+    ecs_observer_t *o,
+    const ecs_iter_t *it,
+    ecs_table_t *table)
+{
+    ecs_vec_t *batches = &flecs_observer_impl(o)->async_batches;
+    if (ecs_vec_count(batches)) {
+        ecs_observer_batch_t *batch = ecs_vec_last_t(
+            batches, ecs_observer_batch_t);
+        if (batch->event == it->event && batch->id == it->ids[0] && 
+            batch->table_id == table->id) 
+        {
+            return batch;
+        }
+    }
+
+    ecs_observer_batch_t *batch = ecs_vec_append_t(
+        &world->allocator, batches, ecs_observer_batch_t);
+    flecs_observer_batch_init(world, batch, o, it, table);
+    return batch;
+}
+
+/* Queue event for async observer. Events are queued by the thread that does
+ * the structural change, and are only read by the system that invokes the
+ * observer while the world is readonly.
+ * An entity is queued at most once per event until the queue is drained, as
+ * the observer gets the component value at the time of delivery. This bounds
+ * the queue by the number of entities with the component, except for
+ * observers for a wildcard id, which can't tell queued ids apart. */
+static
+void flecs_observer_async_append(
+    ecs_world_t *world,
+    ecs_observer_t *o,
+    const ecs_iter_t *it,
+    ecs_table_t *table)
+{
+    ecs_observer_impl_t *impl = flecs_observer_impl(o);
+
+    if (impl->async_drained) {
+        flecs_observer_batches_fini(world, &impl->async_batches);
+        if (ecs_map_is_init(&impl->async_queued)) {
+            ecs_map_clear(&impl->async_queued);
+        }
+        impl->async_drained = false;
+    }
+
+    if (ecs_id_is_wildcard(flecs_observer_id(impl->register_id))) {
+        flecs_observer_batch_add(world, 
+            flecs_observer_async_batch(world, o, it, table), it);
+        return;
+    }
+
+    ecs_map_init_if(&impl->async_queued, &world->allocator);
+
+    ecs_observer_batch_t *batch = NULL;
+    ecs_map_val_t event_bit = it->event == EcsOnAdd ? 1 : 2;
+    int32_t i, count = it->count;
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = it->entities[i];
+        ecs_map_val_t *queued = ecs_map_ensure(&impl->async_queued, e);
+        if (queued[0] & event_bit) {
+            continue;
+        }
+
+        queued[0] |= event_bit;
+
+        if (!batch) {
+            batch = flecs_observer_async_batch(world, o, it, table);
+        }
+
+        ecs_vec_append_t(&world->allocator, &batch->entities, 
+            ecs_entity_t)[0] = e;
+    }
+}
+
 static
 void flecs_uni_observer_invoke(
     ecs_world_t *world,
@@ -342,6 +548,21 @@ void flecs_uni_observer_invoke(
         return;
     }
 
+    ecs_flags32_t flags = flecs_observer_impl(o)->flags;
+    if (flags & (EcsObserverBatched|EcsObserverAsync)) {
+        if (flecs_observer_can_defer(o, it, trav)) {
+            if (flags & EcsObserverAsync) {
+                flecs_observer_async_append(world, o, it, table);
+                return;
+            }
+
+            if (world->observer_batching) {
+                flecs_observer_batch_append(world, o, it, table);
+                return;
+            }
+        }
+    }
+
     if (ecs_should_log_3()) {
         char *path = ecs_get_path(world, it->system);
         ecs_dbg_3("observer: invoke %s", path);
@@ -470,6 +691,242 @@ void flecs_observers_invoke(
     }
 }
 
+/* Invoke async observer. This is called from multiple threads, and does not
+ * modify world state. */
+static
+void flecs_observer_async_invoke(
+    ecs_observer_t *o,
+    ecs_iter_t *it)
+{
+    /* Queued events are not delivered twice, so don't check the event id */
+    if (flecs_ignore_observer_for_table(o, it->table)) {
+        return;
+    }
+
+    ecs_observer_impl_t *impl = flecs_observer_impl(o);
+    it->system = o->entity;
+    it->ctx = o->ctx;
+    it->callback_ctx = o->callback_ctx;
+    it->run_ctx = o->run_ctx;
+    it->term_index = impl->term_index;
+    it->set_fields = 1;
+
+    ecs_query_t *query = o->query;
+    it->query = query;
+    if (query) {
+        ecs_term_t *term = &query->terms[0];
+        ECS_BIT_COND(it->flags, EcsIterNoData, term->inout == EcsInOutNone);
+        it->ref_fields = query->fixed_fields | query->row_fields;
+        it->row_fields = query->row_fields;
+        it->event = flecs_get_observer_event(term, it->event);
+    }
+
+    flecs_observer_invoke(o, it);
+}
+
+static
+void flecs_observer_batch_invoke_range(
+    ecs_world_t *world,
+    ecs_world_t *stage,
+    ecs_observer_batch_t *batch,
+    ecs_component_record_t *cr,
+    ecs_table_t *table,
+    int32_t offset,
+    int32_t count)
+{
+    /* Entity may no longer have the component */
+    const ecs_table_record_t *tr = flecs_component_get_table(cr, table);
+    if (!tr) {
+        return;
+    }
+
+    ecs_id_t id = batch->id;
+    ecs_size_t size = cr->type_info ? cr->type_info->size : 0;
+    ecs_entity_t src = 0;
+
+    ecs_iter_t it = {
+        .world = stage,
+        .real_world = world,
+        .event = batch->event,
+        .event_id = id,
+        .table = table,
+        .field_count = 1,
+        .ids = &id,
+        .sizes = &size,
+        .trs = &tr,
+        .sources = &src,
+        .entities = &ecs_table_entities(table)[offset],
+        .offset = offset,
+        .count = count,
+        .flags = EcsIterIsValid
+    };
+
+    if (stage != world) {
+        /* Tables can't change while observer runs on a readonly stage */
+        flecs_observer_async_invoke(batch->observer, &it);
+        return;
+    }
+
+    it.event_cur = ++ world->event_id;
+
+    ecs_table_lock(world, table);
+    flecs_uni_observer_invoke(world, batch->observer, &it, table, 0);
+    ecs_table_unlock(world, table);
+}
+
+/* Invoke observer for entities [start, end) of batch, in contiguous ranges. */
+static
+void flecs_observer_batch_invoke(
+    ecs_world_t *world,
+    ecs_world_t *stage,
+    ecs_observer_batch_t *batch,
+    int32_t start,
+    int32_t end)
+{
+    if (!batch->observer) {
+        return;
+    }
+
+    ecs_component_record_t *cr = flecs_components_get(world, batch->id);
+    if (!cr) {
+        return;
+    }
+
+    const ecs_entity_t *entities = ecs_vec_first(&batch->entities);
+    int32_t i = start;
+
+    while (i < end) {
+        /* Entities are looked up again, as they could have been deleted or
+         * moved to another table after the event was recorded. */
+        ecs_record_t *r = flecs_entities_try(world, entities[i]);
+        if (!r || !r->table) {
+            i ++;
+            continue;
+        }
+
+        ecs_table_t *table = r->table;
+        int32_t row = ECS_RECORD_TO_ROW(r->row);
+        int32_t run = 1;
+
+        if (table->id == batch->table_id) {
+            for (; (i + run) < end; run ++) {
+                ecs_record_t *next = flecs_entities_try(
+                    world, entities[i + run]);
+                if (!next || next->table != table || 
+                    ECS_RECORD_TO_ROW(next->row) != (row + run)) 
+                {
+                    break;
+                }
+            }
+        }
+
+        flecs_observer_batch_invoke_range(
+            world, stage, batch, cr, table, row, run);
+        i += run;
+    }
+}
+
+void flecs_observer_batches_flush(
+    ecs_world_t *world)
+{
+    /* Events emitted by batched observers are delivered immediately */
+    world->observer_batching = false;
+
+    int32_t i, count = ecs_vec_count(&world->observer_batches);
+    if (!count) {
+        return;
+    }
+
+    /* Tables are locked while observers run, so defer operations of the
+     * observers until all batches have been invoked. */
+    ecs_defer_begin(world);
+
+    /* No batches are recorded until the vector is cleared, so the pointer
+     * remains stable while observers are invoked. */
+    ecs_observer_batch_t *batches = ecs_vec_first(&world->observer_batches);
+    for (i = 0; i < count; i ++) {
+        flecs_observer_batch_invoke(world, world, &batches[i], 
+            0, ecs_vec_count(&batches[i].entities));
+    }
+
+    flecs_observer_batches_fini(world, &world->observer_batches);
+    ecs_map_clear(&world->observer_batch_index);
+
+    ecs_defer_end(world);
+}
+
+#ifdef FLECS_SYSTEM
+/* Run action of system that invokes an async observer. The system is multi
+ * threaded, each stage invokes the observer for its part of the events. */
+static
+void flecs_observer_async_run(
+    ecs_iter_t *it)
+{
+    ecs_observer_t *o = it->ctx;
+    ecs_observer_impl_t *impl = flecs_observer_impl(o);
+    ecs_world_t *world = it->real_world;
+
+    int32_t stage_index = 0, stage_count = 1;
+    if (world->flags & EcsWorldMultiThreaded) {
+        stage_index = ecs_stage_get_id(it->world);
+        stage_count = ecs_get_stage_count(world);
+    }
+
+    if (!impl->async_drained) {
+        ecs_observer_batch_t *batches = ecs_vec_first(&impl->async_batches);
+        int32_t i, count = ecs_vec_count(&impl->async_batches);
+        for (i = 0; i < count; i ++) {
+            ecs_observer_batch_t *batch = &batches[i];
+            int32_t n = ecs_vec_count(&batch->entities);
+            int32_t start = (n * stage_index) / stage_count;
+            int32_t end = (n * (stage_index + 1)) / stage_count;
+            flecs_observer_batch_invoke(world, it->world, batch, start, end);
+        }
+    }
+
+    /* The last stage to finish marks the queue as drained. The queue is 
+     * cleared when the next event is queued. */
+    if (ecs_os_ainc(&impl->async_done) == stage_count) {
+        impl->async_done = 0;
+        impl->async_drained = true;
+    }
+}
+
+static
+int flecs_observer_async_init(
+    ecs_world_t *world,
+    ecs_observer_t *o,
+    ecs_entity_t phase)
+{
+    ecs_entity_t system = ecs_entity(world, {
+        .add = ecs_ids(ecs_dependson(phase), phase)
+    });
+
+    flecs_observer_impl(o)->async_system = ecs_system(world, {
+        .entity = system,
+        .run = flecs_observer_async_run,
+        .ctx = o,
+        .multi_threaded = true
+    });
+
+    return flecs_observer_impl(o)->async_system ? 0 : -1;
+}
+#endif
+
+static
+void flecs_observer_batches_remove(
+    ecs_world_t *world,
+    ecs_observer_t *o)
+{
+    ecs_observer_batch_t *batches = ecs_vec_first(&world->observer_batches);
+    int32_t i, count = ecs_vec_count(&world->observer_batches);
+    for (i = 0; i < count; i ++) {
+        if (batches[i].observer == o) {
+            batches[i].observer = NULL;
+        }
+    }
+}
+
 static
 void flecs_multi_observer_invoke(
     ecs_iter_t *it) 
@@ -815,6 +1272,8 @@ int flecs_multi_observer_init(
     child_desc.run_ctx = NULL;
     child_desc.run_ctx_free = NULL;
     child_desc.yield_existing = false;
+    child_desc.batched = false;
+    child_desc.async_phase = 0;
     child_desc.flags_ &= ~(EcsObserverYieldOnCreate|EcsObserverYieldOnDelete);
     ecs_os_zeromem(&child_desc.entity);
     ecs_os_zeromem(&child_desc.query.terms);
@@ -1163,6 +1622,22 @@ ecs_observer_t* flecs_observer_init(
         if (flecs_uni_observer_init(world, o, term->id, desc)) {
             goto error;
         }
+
+        if (desc->batched) {
+            impl->flags |= EcsObserverBatched;
+        }
+
+        if (desc->async_phase) {
+#ifdef FLECS_SYSTEM
+            impl->flags |= EcsObserverAsync;
+            if (flecs_observer_async_init(world, o, desc->async_phase)) {
+                goto error;
+            }
+#else
+            ecs_throw(ECS_UNSUPPORTED, 
+                "async observers require the system addon");
+#endif
+        }
     } else {
         if (flecs_multi_observer_init(world, o, desc)) {
             goto error;
@@ -1304,6 +1779,24 @@ void flecs_observer_fini(
         flecs_observer_yield_existing(world, o, true);
     }
 
+    if (impl->flags & EcsObserverBatched) {
+        flecs_observer_batches_remove(world, o);
+    }
+
+    if (impl->flags & EcsObserverAsync) {
+        ecs_entity_t system = impl->async_system;
+        if (system && !(world->flags & EcsWorldFini) && 
+            ecs_is_alive(world, system)) 
+        {
+            ecs_delete(world, system);
+        }
+
+        flecs_observer_batches_fini(world, &impl->async_batches);
+        ecs_vec_fini_t(
+            &world->allocator, &impl->async_batches, ecs_observer_batch_t);
+        ecs_map_fini(&impl->async_queued);
+    }
+
     if (impl->flags & EcsObserverIsMulti) {
         ecs_observer_t **children = ecs_vec_first(&impl->children);
         int32_t i, children_count = ecs_vec_count(&impl->children);
@@ -570,6 +570,13 @@ bool ecs_os_has_heap(void) {
         (ecs_os_api.free_ != NULL);
 }
 
+bool ecs_os_has_vm(void) {
+    return 
+        (ecs_os_api.vm_reserve_ != NULL) &&
+        (ecs_os_api.vm_commit_ != NULL) &&
+        (ecs_os_api.vm_release_ != NULL);
+}
+
 bool ecs_os_has_threading(void) {
     return
         (ecs_os_api.mutex_new_ != NULL) &&
@@ -22,10 +22,10 @@
 #include "datastructures/name_index.h"
 #include "storage/entity_index.h"
 #include "storage/table_cache.h"
+#include "storage/ordered_children.h"
 #include "storage/component_index.h"
 #include "storage/table.h"
 #include "storage/sparse_storage.h"
-#include "storage/ordered_children.h"
 #include "query/query.h"
 #include "component_actions.h"
 #include "entity_name.h"
@@ -149,6 +149,24 @@ uint64_t flecs_hash(
 int32_t flecs_next_pow_of_2(
     int32_t n);
 
+/* Portable count-trailing-zeros for 64-bit values. Input must be nonzero. */
+static inline int32_t flecs_ctz64(uint64_t v) {
+#if defined(__clang__) || defined(__GNUC__)
+    return (int32_t)__builtin_ctzll(v);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return (int32_t)idx;
+#else
+    int32_t count = 0;
+    while ((v & 1u) == 0u) {
+        v >>= 1;
+        count ++;
+    }
+    return count;
+#endif
+}
+
 /* Compare function for entity ids used for order_by */
 int flecs_entity_compare(
     ecs_entity_t e1,
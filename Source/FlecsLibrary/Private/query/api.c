@@ -74,6 +74,7 @@ int flecs_query_set_caching_policy(
     ecs_query_cache_kind_t kind = desc->cache_kind;
     bool require_caching = desc->group_by || desc->group_by_callback || 
             desc->order_by || desc->order_by_callback || 
+            desc->order_by_key_callback || 
             (desc->flags & EcsQueryDetectChanges);
 
     /* If the query has a Cascade term it'll use group_by */
@@ -194,6 +195,14 @@ int flecs_query_create_cache(
         desc->entity = q->entity;
     }
 
+    uint64_t share_hash = 0;
+    if (q->cache_kind != EcsQueryCacheNone) {
+        if (flecs_query_cache_share(impl, desc, &share_hash)) {
+            /* Query uses the cache of a query with identical terms */
+            return 0;
+        }
+    }
+
     if (q->cache_kind == EcsQueryCacheAll) {
         /* Create query cache for all terms */
         if (!flecs_query_cache_init(impl, desc)) {
@@ -257,6 +266,10 @@ int flecs_query_create_cache(
         }
     }
 
+    if (share_hash && impl->cache) {
+        flecs_query_cache_register_shared(impl->cache, share_hash);
+    }
+
     return 0;
 error:
     return -1;
@@ -307,6 +320,14 @@ void flecs_query_fini(
     flecs_free_n(a, ecs_var_id_t, impl->pub.field_count, impl->src_vars);
     flecs_free_n(a, int32_t, impl->pub.field_count, impl->monitor);
 
+    if (impl->up_caches) {
+        int32_t i;
+        for (i = 0; i < impl->op_count; i ++) {
+            flecs_query_up_cache_fini(&impl->up_caches[i]);
+        }
+        flecs_free_n(a, ecs_trav_up_cache_t, impl->op_count, impl->up_caches);
+    }
+
     ecs_query_t *q = &impl->pub;
     if (q->flags & EcsQueryValid) {
         int i, count = q->term_count;
@@ -325,7 +346,7 @@ void flecs_query_fini(
         flecs_free(&impl->stage->allocator, impl->tokens_len, impl->tokens);
     }
 
-    if (impl->cache) {
+    if (impl->cache && !flecs_query_cache_release(impl)) {
         flecs_free_n(a, int8_t, FLECS_TERM_COUNT_MAX, impl->cache->field_map);
         flecs_query_cache_fini(impl);
     }
@@ -384,6 +405,11 @@ ecs_query_t* ecs_query_init(
     ecs_query_desc_t desc = *const_desc;
     ecs_entity_t entity = const_desc->entity;
 
+    /* Iterating changed rows builds on top of change detection */
+    if (desc.flags & EcsQueryDirtyRows) {
+        desc.flags |= EcsQueryDetectChanges;
+    }
+
     if (entity) {
         flecs_check_exclusive_world_access_write(world);
 
@@ -434,6 +460,14 @@ ecs_query_t* ecs_query_init(
         goto error;
     }
 
+    /* Dirty rows are tracked for the tables matched by the cache */
+    if ((desc.flags & EcsQueryDirtyRows) && !result->cache && 
+        !(result->pub.flags & EcsQueryNested)) 
+    {
+        ecs_err("cannot create uncached query with EcsQueryDirtyRows");
+        goto error;
+    }
+
     if (flecs_query_compile(world, stage, result)) {
         goto error;
     }
@@ -548,6 +582,32 @@ ecs_query_count_t ecs_query_count(
     return result;
 }
 
+ecs_query_trav_stats_t ecs_query_trav_stats(
+    const ecs_query_t *q)
+{
+    flecs_poly_assert(q, ecs_query_t);
+    ecs_query_trav_stats_t result = {0};
+
+    ecs_query_impl_t *impl = flecs_query_impl(q);
+    if (impl->up_caches) {
+        int32_t i;
+        for (i = 0; i < impl->op_count; i ++) {
+            result.hits += impl->up_caches[i].hits;
+            result.rebuilds += impl->up_caches[i].rebuilds;
+        }
+    }
+
+    /* Include traversals done while matching tables for the query cache */
+    if (impl->cache && impl->cache->query && impl->cache->query != q) {
+        ecs_query_trav_stats_t cache_stats = 
+            ecs_query_trav_stats(impl->cache->query);
+        result.hits += cache_stats.hits;
+        result.rebuilds += cache_stats.rebuilds;
+    }
+
+    return result;
+}
+
 bool ecs_query_is_true(
     const ecs_query_t *q)
 {
@@ -647,6 +707,56 @@ const ecs_query_group_info_t* ecs_query_get_group_info(
     return &node->info;
 }
 
+int32_t ecs_query_group_count(
+    const ecs_query_t *query)
+{
+    flecs_poly_assert(query, ecs_query_t);
+    ecs_query_cache_t *cache = flecs_query_impl(query)->cache;
+    ecs_check(cache != NULL, ECS_INVALID_PARAMETER, 
+        "query must be cached");
+    return ecs_vec_count(&cache->group_dir);
+error:
+    return 0;
+}
+
+const ecs_query_group_info_t* ecs_query_get_group_info_at(
+    const ecs_query_t *query,
+    int32_t index)
+{
+    flecs_poly_assert(query, ecs_query_t);
+    ecs_query_cache_t *cache = flecs_query_impl(query)->cache;
+    ecs_check(cache != NULL, ECS_INVALID_PARAMETER, 
+        "query must be cached");
+    ecs_check(index >= 0 && index < ecs_vec_count(&cache->group_dir), 
+        ECS_OUT_OF_RANGE, NULL);
+
+    ecs_query_cache_group_t *node = ecs_vec_get_t(
+        &cache->group_dir, ecs_query_cache_group_t*, index)[0];
+    return &node->info;
+error:
+    return NULL;
+}
+
+const ecs_query_snapshot_t* ecs_query_snapshot(
+    const ecs_query_t *query)
+{
+    flecs_poly_assert(query, ecs_query_t);
+    ecs_query_cache_t *cache = flecs_query_impl(query)->cache;
+    ecs_check(cache != NULL, ECS_INVALID_PARAMETER, 
+        "query must be cached");
+
+    ecs_world_t *world = query->real_world;
+    if (!(ecs_world_get_flags(query->world) & EcsWorldReadonly) && 
+         (query->flags & EcsQueryHasRefs)) 
+    {
+        flecs_eval_query_monitors(world, ECS_CONST_CAST(ecs_query_t*, query));
+    }
+
+    return flecs_query_cache_snapshot(world, cache);
+error:
+    return NULL;
+}
+
 void* ecs_query_get_group_ctx(
     const ecs_query_t *query,
     uint64_t group_id)
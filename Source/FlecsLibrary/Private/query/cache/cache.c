@@ -329,7 +329,8 @@ int flecs_query_cache_order_by(
     ecs_query_impl_t *impl,
     ecs_entity_t order_by,
     ecs_order_by_action_t order_by_callback,
-    ecs_sort_table_action_t action)
+    ecs_sort_table_action_t action,
+    ecs_order_by_key_action_t key_callback)
 {
     ecs_check(impl != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_query_cache_t *cache = impl->cache;
@@ -365,6 +366,7 @@ int flecs_query_cache_order_by(
     cache->order_by_callback = order_by_callback;
     cache->order_by_term = order_by_term;
     cache->order_by_table_callback = action;
+    cache->order_by_key_callback = key_callback;
 
     ecs_vec_fini_t(NULL, &cache->table_slices, ecs_query_cache_match_t);
     flecs_query_cache_sort_tables(world, impl);
@@ -399,6 +401,10 @@ void flecs_query_cache_group_by(
     cache->group_by_callback = group_by;
 
     ecs_map_init(&cache->groups, &cache->query->world->allocator);
+
+    ecs_allocator_t *a = &cache->query->real_world->allocator;
+    ecs_vec_init_t(a, &cache->group_index, ecs_query_cache_group_t**, 0);
+    ecs_vec_init_t(a, &cache->group_dir, ecs_query_cache_group_t*, 0);
 error:
     return;
 }
@@ -421,9 +427,7 @@ void flecs_query_cache_on_event(
         o_impl->last_event_id[0] = world->event_id;
     }
 
-    ecs_query_impl_t *impl = o->ctx;
-    flecs_poly_assert(impl, ecs_query_t);
-    ecs_query_cache_t *cache = impl->cache;
+    ecs_query_cache_t *cache = o->ctx;
     ecs_assert(cache != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_table_t *table = it->table;
     ecs_entity_t event = it->event;
@@ -513,11 +517,12 @@ void flecs_query_cache_fini(
 
     ecs_group_delete_action_t on_delete = cache->on_group_delete;
     if (on_delete) {
-        ecs_map_iter_t it = ecs_map_iter(&cache->groups);
-        while (ecs_map_next(&it)) {
-            ecs_query_cache_group_t *group = ecs_map_ptr(&it);
-            uint64_t group_id = ecs_map_key(&it);
-            on_delete(world, group_id, group->info.ctx, cache->group_by_ctx);
+        int32_t i, count = ecs_vec_count(&cache->group_dir);
+        ecs_query_cache_group_t **groups = ecs_vec_first(&cache->group_dir);
+        for (i = 0; i < count; i ++) {
+            ecs_query_cache_group_t *group = groups[i];
+            on_delete(world, group->info.id, group->info.ctx, 
+                cache->group_by_ctx);
         }
         cache->on_group_delete = NULL;
     }
@@ -531,6 +536,10 @@ void flecs_query_cache_fini(
     flecs_query_cache_for_each_component_monitor(world, impl, cache,
         flecs_monitor_unregister);
 
+    if (cache->rematch_pending) {
+        flecs_monitor_cancel_rematch(impl->pub.real_world, &impl->pub);
+    }
+
     flecs_query_cache_remove_all_tables(cache);
 
     ecs_assert(ecs_map_count(&cache->tables) == 0, ECS_INTERNAL_ERROR, NULL);
@@ -538,7 +547,14 @@ void flecs_query_cache_fini(
     
     ecs_map_fini(&cache->tables);
     ecs_map_fini(&cache->groups);
+    flecs_query_cache_group_index_fini(cache);
     ecs_vec_fini_t(NULL, &cache->table_slices, ecs_query_cache_match_t);
+
+    if (cache->snapshot_lock) {
+        ecs_os_mutex_free(cache->snapshot_lock);
+    }
+
+    ecs_vec_fini_t(NULL, &cache->snapshot_ranges, ecs_table_range_t);
     
     if (cache->query->term_count) {
         flecs_bfree(&cache->allocators.ids, cache->sources);
@@ -576,6 +592,7 @@ ecs_query_cache_t* flecs_query_cache_init(
     desc.group_by_callback = NULL;
     desc.group_by = 0;
     desc.order_by_callback = NULL;
+    desc.order_by_key_callback = NULL;
     desc.order_by = 0;
     desc.entity = 0;
 
@@ -587,6 +604,8 @@ ecs_query_cache_t* flecs_query_cache_init(
 
     ecs_query_cache_t *result = flecs_bcalloc(&stage->allocators.query_cache);
     result->entity = entity;
+    result->owner = impl;
+    result->snapshot.frame = -1;
     impl->cache = result;
 
     ecs_observer_desc_t observer_desc = { .query = desc };
@@ -597,7 +616,7 @@ ecs_query_cache_t* flecs_query_cache_init(
 
     /* order_by is not compatible with matching empty tables, as it causes
      * a query to return table slices, not entire tables. */
-    if (const_desc->order_by_callback) {
+    if (const_desc->order_by_callback || const_desc->order_by_key_callback) {
         query_flags &= ~EcsQueryMatchEmptyTables;
     }
 
@@ -621,6 +640,7 @@ ecs_query_cache_t* flecs_query_cache_init(
         {
             if (!const_desc->order_by && !const_desc->group_by && 
                 !const_desc->order_by_callback && 
+                !const_desc->order_by_key_callback && 
                 !const_desc->group_by_callback &&
                 !(const_desc->flags & EcsQueryDetectChanges))
             {
@@ -663,6 +683,7 @@ ecs_query_cache_t* flecs_query_cache_init(
     ecs_vec_init(&world->allocator, &result->default_group.tables, 
         elem_size, 0);
     result->first_group = &result->default_group;
+    result->default_group.dir_index = -1;
 
     /* The uncached query used to populate the cache always matches empty 
      * tables. This flag determines whether the empty tables are stored 
@@ -682,7 +703,7 @@ ecs_query_cache_t* flecs_query_cache_init(
 
     if (q->term_count) {
         observer_desc.run = flecs_query_cache_on_event;
-        observer_desc.ctx = impl;
+        observer_desc.ctx = result; /* Cache can outlive the query (shared) */
 
         int32_t event_index = 0;
         observer_desc.events[event_index ++] = EcsOnTableCreate;
@@ -703,6 +724,10 @@ ecs_query_cache_t* flecs_query_cache_init(
 
     result->prev_match_count = -1;
 
+    if (ecs_os_has_threading()) {
+        result->snapshot_lock = ecs_os_mutex_new();
+    }
+
     if (ecs_should_log_1()) {
         char *query_expr = ecs_query_str(result->query);
         ecs_dbg_1("#[green]query#[normal] [%s] created", 
@@ -733,15 +758,20 @@ ecs_query_cache_t* flecs_query_cache_init(
         result->on_group_create = const_desc->on_group_create;
         result->on_group_delete = const_desc->on_group_delete;
         result->group_by_ctx_free = const_desc->group_by_ctx_free;
+        result->group_id_offset = const_desc->group_id_offset;
     }
 
     ecs_map_init(&result->tables, &world->allocator);
     flecs_query_cache_match_tables(world, result);
 
-    if (const_desc->order_by_callback) {
+    if (const_desc->order_by_callback || const_desc->order_by_key_callback) {
+        ecs_check(!const_desc->order_by_callback || 
+            !const_desc->order_by_key_callback, ECS_INVALID_PARAMETER,
+                "cannot combine order_by_callback with order_by_key_callback");
         if (flecs_query_cache_order_by(world, impl, 
             const_desc->order_by, const_desc->order_by_callback,
-            const_desc->order_by_table_callback))
+            const_desc->order_by_table_callback,
+            const_desc->order_by_key_callback))
         {
             goto error;
         }
@@ -36,8 +36,16 @@ struct ecs_query_cache_group_t {
     ecs_vec_t tables;                 /* vec<ecs_query_cache_match_t> */
     ecs_query_group_info_t info;      /* Group info available to application. */
     ecs_query_cache_group_t *next;    /* Next group to iterate (only set for queries with group_by). */
+    int32_t dir_index;                /* Index in group directory (-1 for default group). */
 };
 
+/* Number of group ids, starting from the group id offset, that are resolved 
+ * through the paged group index instead of the groups map. */
+#define FLECS_QUERY_GROUP_INDEX_MAX (1u << 24)
+#define FLECS_QUERY_GROUP_PAGE_BITS (12)
+#define FLECS_QUERY_GROUP_PAGE_SIZE (1 << FLECS_QUERY_GROUP_PAGE_BITS)
+#define FLECS_QUERY_GROUP_PAGE_MASK (FLECS_QUERY_GROUP_PAGE_SIZE - 1)
+
 /** Table record type for query table cache. A query only has one per table. */
 typedef struct ecs_query_cache_table_t {
     ecs_query_cache_group_t *group;   /* Group the table is added to. */
@@ -63,7 +71,10 @@ typedef struct ecs_query_cache_t {
     ecs_map_t tables;
 
     /* Query groups, if group_by is used */
-    ecs_map_t groups;
+    ecs_map_t groups;                /* Groups with ids >= FLECS_QUERY_GROUP_INDEX_MAX */
+    ecs_vec_t group_index;           /* vec<ecs_query_cache_group_t**>, pages by id */
+    ecs_vec_t group_dir;             /* vec<ecs_query_cache_group_t*>, dense */
+    uint64_t group_id_offset;        /* First group id in group index */
 
     /* Default query group */
     ecs_query_cache_group_t default_group;
@@ -75,6 +86,7 @@ typedef struct ecs_query_cache_t {
     ecs_entity_t order_by;
     ecs_order_by_action_t order_by_callback;
     ecs_sort_table_action_t order_by_table_callback;
+    ecs_order_by_key_action_t order_by_key_callback;
     ecs_vec_t table_slices;
     int32_t order_by_term;
 
@@ -88,10 +100,12 @@ typedef struct ecs_query_cache_t {
 
     /* Monitor generation */
     int32_t monitor_generation;
+    bool rematch_pending;            /* Rematch deferred by world rematch budget */
 
     int32_t cascade_by;              /* Identify cascade term */
     int32_t match_count;             /* How often have tables been (un)matched */
     int32_t prev_match_count;        /* Track if sorting is needed */
+    bool presorted;                  /* Sorted by pipeline for current op */
     int32_t rematch_count;           /* Track which tables were added during rematch */
     
     ecs_entity_t entity;             /* Entity associated with query */
@@ -102,6 +116,18 @@ typedef struct ecs_query_cache_t {
     /* Map field indices from cache query to actual query */
     int8_t *field_map;
 
+    /* Cache sharing (EcsQueryShareCache) */
+    ecs_query_impl_t *owner;         /* Query registered with monitors */
+    ecs_vec_t sharers;               /* vec<ecs_query_impl_t*>, other users */
+    uint64_t share_hash;             /* Key in world shared cache map, or 0 */
+
+    /* Snapshot of matched table ranges */
+    ecs_query_snapshot_t snapshot;
+    ecs_vec_t snapshot_ranges;       /* vec<ecs_table_range_t> */
+    int32_t snapshot_match_count;    /* match_count when snapshot was taken */
+    uint32_t snapshot_table_count_version; /* world table count version */
+    ecs_os_mutex_t snapshot_lock;    /* Build snapshot once from multiple stages */
+
     /* Query-level allocators */
     ecs_query_cache_allocators_t allocators;
 } ecs_query_cache_t;
@@ -120,9 +146,38 @@ void flecs_query_cache_sort_tables(
 void flecs_query_cache_build_sorted_tables(
     ecs_query_cache_t *cache);
 
+/* Find cache of query with identical terms. If no cache was found but the 
+ * query can share its cache, share_hash is set to the key to register with. */
+bool flecs_query_cache_share(
+    ecs_query_impl_t *impl,
+    const ecs_query_desc_t *desc,
+    uint64_t *share_hash);
+
+/* Register cache so it can be found by queries with identical terms. */
+void flecs_query_cache_register_shared(
+    ecs_query_cache_t *cache,
+    uint64_t share_hash);
+
+/* Remove EcsEmpty tag from all queries that use the cache. */
+void flecs_query_cache_clear_empty(
+    ecs_query_cache_t *cache);
+
+/* Detach query from cache. Returns false if query was the last user. */
+bool flecs_query_cache_release(
+    ecs_query_impl_t *impl);
+
+/* Get snapshot of matched table ranges, rebuild if out of date. */
+const ecs_query_snapshot_t* flecs_query_cache_snapshot(
+    ecs_world_t *world,
+    ecs_query_cache_t *cache);
+
 bool flecs_query_cache_is_trivial(
     const ecs_query_cache_t *cache);
 
+/* Does cache use order_by */
+#define flecs_query_cache_is_ordered(cache)\
+    ((cache)->order_by_callback || (cache)->order_by_key_callback)
+
 ecs_size_t flecs_query_cache_elem_size(
     const ecs_query_cache_t *cache);
 
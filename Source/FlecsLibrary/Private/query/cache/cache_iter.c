@@ -9,9 +9,11 @@
  * another entity (typically a parent or prefab), that component could have 
  * moved which would cause the table record in the trs array to become invalid.
  * This function updates the table records array to make sure they're pointing
- * to the right table/column for fields that used up traversal. */
+ * to the right table/column for fields that used up traversal. 
+ * Returns false if the source no longer has the component, which can only
+ * happen while a rematch for the query is deferred. */
 static
-void flecs_query_update_node_up_trs(
+bool flecs_query_update_node_up_trs(
     const ecs_query_run_ctx_t *ctx,
     ecs_query_cache_match_t *node)
 {
@@ -31,21 +33,33 @@ void flecs_query_update_node_up_trs(
 
             ecs_entity_t src = node->_sources[f];
             if (src) {
-                ecs_record_t *r = flecs_entities_get(ctx->world, src);
-                ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
-                ecs_assert(r->table != NULL, ECS_INTERNAL_ERROR, NULL);
+                ecs_record_t *r = flecs_entities_try(ctx->world, src);
+                if (!r || !r->table) {
+                    ecs_assert(cache->rematch_pending, 
+                        ECS_INTERNAL_ERROR, NULL);
+                    return false;
+                }
+
                 if (r->table != node->_tables[f]) {
                     ecs_component_record_t *cr = flecs_components_get(
                         ctx->world, q->ids[f]);
-                    const ecs_table_record_t *tr = node->base.trs[f] = 
-                        flecs_component_get_table(cr, r->table);
-                    ecs_assert(tr != NULL, ECS_INTERNAL_ERROR, NULL);
+                    const ecs_table_record_t *tr = cr ? 
+                        flecs_component_get_table(cr, r->table) : NULL;
+                    if (!tr) {
+                        ecs_assert(cache->rematch_pending, 
+                            ECS_INTERNAL_ERROR, NULL);
+                        return false;
+                    }
+
+                    node->base.trs[f] = tr;
                     ctx->it->trs[field_map ? field_map[f] : f] = tr;
                     node->_tables[f] = r->table;
                 }
             }
         }
     }
+
+    return true;
 }
 
 /* Initialize cached query iterator. */
@@ -65,7 +79,7 @@ void flecs_query_cache_iter_init(
     qit->cur = 0;
 
     /* If query uses order_by, iterate the array with ordered table slices. */
-    if (cache->order_by_callback) {
+    if (flecs_query_cache_is_ordered(cache)) {
         /* Check if query needs sorting. */
         flecs_query_cache_sort_tables(it->real_world, impl);
         qit->tables = &cache->table_slices;
@@ -308,16 +322,17 @@ bool flecs_query_cache_search(
     ecs_assert(!flecs_query_cache_is_trivial(ctx->query->cache), 
         ECS_INTERNAL_ERROR, NULL);
 
-    ecs_query_cache_match_t *node = flecs_query_cache_next(ctx, false);
-    if (!node) {
-        return false;
-    }
-
-    flecs_query_cache_init_mapped_fields(ctx, node);
-    ctx->vars[0].range.count = node->_count;
-    ctx->vars[0].range.offset = node->_offset;
+    ecs_query_cache_match_t *node;
+    do {
+        node = flecs_query_cache_next(ctx, false);
+        if (!node) {
+            return false;
+        }
 
-    flecs_query_update_node_up_trs(ctx, node);
+        flecs_query_cache_init_mapped_fields(ctx, node);
+        ctx->vars[0].range.count = node->_count;
+        ctx->vars[0].range.offset = node->_offset;
+    } while (!flecs_query_update_node_up_trs(ctx, node));
 
     return true;
 }
@@ -329,19 +344,20 @@ bool flecs_query_is_cache_search(
     ecs_assert(!flecs_query_cache_is_trivial(ctx->query->cache), 
         ECS_INTERNAL_ERROR, NULL);
 
-    ecs_query_cache_match_t *node = flecs_query_cache_next(ctx, false);
-    if (!node) {
-        return false;
-    }
-
     ecs_iter_t *it = ctx->it;
-    it->trs = node->base.trs;
-    it->ids = node->_ids;
-    it->sources = node->_sources;
-    it->set_fields = node->base.set_fields;
-    it->up_fields = node->_up_fields;
+    ecs_query_cache_match_t *node;
+    do {
+        node = flecs_query_cache_next(ctx, false);
+        if (!node) {
+            return false;
+        }
 
-    flecs_query_update_node_up_trs(ctx, node);
+        it->trs = node->base.trs;
+        it->ids = node->_ids;
+        it->sources = node->_sources;
+        it->set_fields = node->base.set_fields;
+        it->up_fields = node->_up_fields;
+    } while (!flecs_query_update_node_up_trs(ctx, node));
 
     flecs_query_cache_update_ptrs(it, &node->base, node->base.table);
 
@@ -366,9 +382,7 @@ bool flecs_query_cache_test(
     }
 
     flecs_query_cache_init_mapped_fields(ctx, node);
-    flecs_query_update_node_up_trs(ctx, node);
-
-    return true;
+    return flecs_query_update_node_up_trs(ctx, node);
 }
 
 /* Test if query that is entirely cached matches constrained $this */
@@ -390,9 +404,7 @@ bool flecs_query_is_cache_test(
     it->sources = node->_sources;
     it->set_fields = node->base.set_fields;
 
-    flecs_query_update_node_up_trs(ctx, node);
-
-    return true;
+    return flecs_query_update_node_up_trs(ctx, node);
 }
 
 bool flecs_query_is_trivial_cache_test(
@@ -453,6 +453,7 @@ void flecs_query_mark_fields_dirty(
 
         ecs_entity_t src = it->sources[i];
         ecs_table_t *table;
+        int32_t row = it->offset, count = it->count;
         if (!src) {
             table = it->table;
         } else {
@@ -461,6 +462,9 @@ void flecs_query_mark_fields_dirty(
                 continue;
             }
 
+            row = ECS_RECORD_TO_ROW(r->row);
+            count = 1;
+
             if (q->shared_readonly_fields & flecs_ito(uint32_t, 1 << i)) {
                 /* Shared fields that aren't marked explicitly as out/inout 
                  * default to readonly */
@@ -484,7 +488,12 @@ void flecs_query_mark_fields_dirty(
 
         ecs_assert(type_index < table->type.count, ECS_INTERNAL_ERROR, NULL);
         int32_t column = table->column_map[type_index];
+        if (column < 0) {
+            continue; /* Tags have no data to mark dirty */
+        }
+
         dirty_state[column + 1] ++;
+        flecs_table_mark_dirty_rows(table, column, row, count);
     }
 }
 
@@ -524,6 +533,10 @@ void flecs_query_mark_fixed_fields_dirty(
         ecs_assert(it->trs[i]->column >= 0, ECS_INTERNAL_ERROR, NULL);
         int32_t column = table->column_map[it->trs[i]->column];
         dirty_state[column + 1] ++;
+        if (column >= 0) {
+            flecs_table_mark_dirty_rows(
+                table, column, ECS_RECORD_TO_ROW(r->row), 1);
+        }
     }
 }
 
@@ -579,6 +592,172 @@ void flecs_query_sync_match_monitor(
     cache->prev_match_count = cache->match_count;
 }
 
+/* Check if chunk of rows was written to since the monitor was synchronized */
+static
+bool flecs_query_dirty_rows_chunk_changed(
+    const ecs_iter_t *it,
+    const int32_t *monitor,
+    const ecs_vec_t *dirty_rows,
+    ecs_termset_t fields,
+    int32_t chunk)
+{
+    int32_t i, field_count = it->field_count;
+    for (i = 0; i < field_count; i ++) {
+        if (!(fields & (1llu << i))) {
+            continue;
+        }
+
+        const ecs_vec_t *chunks = &dirty_rows[it->trs[i]->column];
+        if (chunk >= ecs_vec_count(chunks)) {
+            continue; /* Chunk hasn't been written to since it was added */
+        }
+
+        /* Both are dirty state counters, compare so that wrapping is safe */
+        int32_t stamp = ecs_vec_get_t(chunks, int32_t, chunk)[0];
+        if ((int32_t)((uint32_t)stamp - (uint32_t)monitor[i + 1]) > 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Yield next range of changed rows for result split by EcsQueryDirtyRows.
+ * Adjacent changed chunks are yielded as a single range. */
+bool flecs_query_next_dirty_rows(
+    ecs_iter_t *it)
+{
+    ecs_query_iter_t *qit = &it->priv_.iter.query;
+    ecs_table_t *table = it->table;
+    ecs_assert(qit->elem != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(table->_->dirty_rows != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    const int32_t *monitor = qit->elem->_monitor;
+    const ecs_vec_t *dirty_rows = table->_->dirty_rows;
+    ecs_termset_t fields = qit->dirty_fields;
+    int32_t row = qit->dirty_row, end = qit->dirty_end, first = -1;
+
+    while (row < end) {
+        int32_t chunk = row >> FLECS_DIRTY_ROWS_CHUNK_SHIFT;
+        if (flecs_query_dirty_rows_chunk_changed(
+            it, monitor, dirty_rows, fields, chunk)) 
+        {
+            if (first == -1) {
+                first = row;
+            }
+        } else if (first != -1) {
+            break;
+        }
+
+        row = (chunk + 1) << FLECS_DIRTY_ROWS_CHUNK_SHIFT;
+    }
+
+    if (row > end) {
+        row = end;
+    }
+
+    qit->dirty_row = row;
+
+    if (first == -1) {
+        return false;
+    }
+
+    it->frame_offset += first - it->offset;
+    it->offset = first;
+    it->count = row - first;
+    it->entities = &ecs_table_entities(table)[first];
+
+    return true;
+}
+
+/* Find changed rows in the current result for EcsQueryDirtyRows. Returns false
+ * if nothing changed, in which case the result should be skipped. If the 
+ * result is split, it is narrowed down to the first range of changed rows. */
+bool flecs_query_find_dirty_rows(
+    ecs_iter_t *it)
+{
+    ecs_query_iter_t *qit = &it->priv_.iter.query;
+    ecs_query_impl_t *impl = flecs_query_impl(it->query);
+    ecs_query_cache_match_t *qm = qit->elem;
+    ecs_table_t *table = it->table;
+    ecs_world_t *world = it->real_world;
+
+    if (!qm || !table || !it->count) {
+        return true; /* Not a cached table result */
+    }
+
+    if (it->offset || it->count != ecs_table_count(table)) {
+        /* Other parts of the table can be yielded in another result, and the
+         * monitor is synchronized per result, so don't split. */
+        return true;
+    }
+
+    /* Rows are tracked from when the table was matched by the cache. Chunks
+     * are never created here, as this can run on a worker thread. */
+    if (!table->_->dirty_rows) {
+        return true;
+    }
+
+    if (flecs_query_get_match_monitor(impl, qm)) {
+        return true; /* First time table is iterated, everything changed */
+    }
+
+    const int32_t *monitor = qm->_monitor;
+    const int32_t *dirty_state = flecs_table_get_dirty_state(world, table);
+    if (monitor[0] != dirty_state[0]) {
+        return true; /* Entities were added, removed or moved */
+    }
+
+    ecs_termset_t fields = 0;
+    int32_t i, field_count = it->field_count;
+    for (i = 0; i < field_count; i ++) {
+        int32_t mon = monitor[i + 1];
+        if (mon == -1) {
+            continue;
+        }
+
+        if (!(it->set_fields & (1llu << i))) {
+            continue;
+        }
+
+        int32_t column = it->trs[i]->column;
+        if (!it->sources[i]) {
+            if (column >= 0 && mon != dirty_state[column + 1]) {
+                fields |= (ecs_termset_t)(1llu << i);
+            }
+            continue;
+        }
+
+        /* Rows of a field matched on another entity don't map to rows of the
+         * result, so if it changed the whole result is yielded. */
+        ecs_table_t *src_table = ecs_get_table(world, it->sources[i]);
+        ecs_assert(src_table != NULL, ECS_INTERNAL_ERROR, NULL);
+        if (mon != flecs_table_get_dirty_state(world, src_table)[column + 1]) {
+            return true;
+        }
+    }
+
+    if (!fields) {
+        return false;
+    }
+
+    qit->dirty_fields = fields;
+    qit->dirty_row = 0;
+    qit->dirty_end = it->count;
+    qit->dirty_skip = false;
+
+    if (flecs_query_next_dirty_rows(it)) {
+        return true;
+    }
+
+    /* The column changed without any rows being written to, for example when
+     * another query finished a split result. Nothing left to yield. */
+    qit->dirty_end = 0;
+    flecs_query_sync_match_monitor(impl, qm);
+    return false;
+}
+
 /* Public API call to check if any matches in the query have changed. */
 bool ecs_query_changed(
     ecs_query_t *q)
@@ -25,3 +25,9 @@ bool flecs_query_update_fixed_monitor(
 
 bool flecs_query_check_fixed_monitor(
     ecs_query_impl_t *impl);
+
+bool flecs_query_find_dirty_rows(
+    ecs_iter_t *it);
+
+bool flecs_query_next_dirty_rows(
+    ecs_iter_t *it);
@@ -19,6 +19,80 @@ uint64_t flecs_query_cache_get_group_id(
     }
 }
 
+/* Is group id resolved through the paged group index. Ids below the offset 
+ * wrap around and end up outside the index range. */
+static
+bool flecs_query_cache_group_is_indexed(
+    const ecs_query_cache_t *cache,
+    uint64_t group_id)
+{
+    return (group_id - cache->group_id_offset) < FLECS_QUERY_GROUP_INDEX_MAX;
+}
+
+/* Get slot in paged group index. Returns NULL if page doesn't exist. */
+static
+ecs_query_cache_group_t** flecs_query_cache_group_index_get(
+    const ecs_query_cache_t *cache,
+    uint64_t group_id)
+{
+    ecs_assert(flecs_query_cache_group_is_indexed(cache, group_id), 
+        ECS_INTERNAL_ERROR, NULL);
+
+    uint64_t index = group_id - cache->group_id_offset;
+    int32_t page_index = (int32_t)(index >> FLECS_QUERY_GROUP_PAGE_BITS);
+    if (page_index >= ecs_vec_count(&cache->group_index)) {
+        return NULL;
+    }
+
+    ecs_query_cache_group_t **page = ecs_vec_get_t(&cache->group_index, 
+        ecs_query_cache_group_t**, page_index)[0];
+    if (!page) {
+        return NULL;
+    }
+
+    return &page[index & FLECS_QUERY_GROUP_PAGE_MASK];
+}
+
+/* Get or create slot in paged group index. */
+static
+ecs_query_cache_group_t** flecs_query_cache_group_index_ensure(
+    ecs_query_cache_t *cache,
+    uint64_t group_id)
+{
+    ecs_allocator_t *a = &cache->query->real_world->allocator;
+    uint64_t index = group_id - cache->group_id_offset;
+    int32_t page_index = (int32_t)(index >> FLECS_QUERY_GROUP_PAGE_BITS);
+    ecs_vec_set_min_count_zeromem_t(a, &cache->group_index, 
+        ecs_query_cache_group_t**, page_index + 1);
+
+    ecs_query_cache_group_t ***page = ecs_vec_get_t(&cache->group_index, 
+        ecs_query_cache_group_t**, page_index);
+    if (!page[0]) {
+        page[0] = flecs_calloc_n(a, ecs_query_cache_group_t*, 
+            FLECS_QUERY_GROUP_PAGE_SIZE);
+    }
+
+    return &page[0][index & FLECS_QUERY_GROUP_PAGE_MASK];
+}
+
+/* Free pages and directory of group index. */
+void flecs_query_cache_group_index_fini(
+    ecs_query_cache_t *cache)
+{
+    ecs_allocator_t *a = &cache->query->real_world->allocator;
+    int32_t i, count = ecs_vec_count(&cache->group_index);
+    ecs_query_cache_group_t ***pages = ecs_vec_first(&cache->group_index);
+    for (i = 0; i < count; i ++) {
+        if (pages[i]) {
+            flecs_free_n(a, ecs_query_cache_group_t*, 
+                FLECS_QUERY_GROUP_PAGE_SIZE, pages[i]);
+        }
+    }
+
+    ecs_vec_fini_t(a, &cache->group_index, ecs_query_cache_group_t**);
+    ecs_vec_fini_t(a, &cache->group_dir, ecs_query_cache_group_t*);
+}
+
 /* Get group for group id. */
 ecs_query_cache_group_t* flecs_query_cache_get_group(
     const ecs_query_cache_t *cache,
@@ -28,6 +102,12 @@ ecs_query_cache_group_t* flecs_query_cache_get_group(
         return ECS_CONST_CAST(ecs_query_cache_group_t*, &cache->default_group);
     }
 
+    if (flecs_query_cache_group_is_indexed(cache, group_id)) {
+        ecs_query_cache_group_t **slot = 
+            flecs_query_cache_group_index_get(cache, group_id);
+        return slot ? slot[0] : NULL;
+    }
+
     return ecs_map_get_deref(
         &cache->groups, ecs_query_cache_group_t, group_id);
 }
@@ -84,15 +164,23 @@ ecs_query_cache_group_t* flecs_query_cache_ensure_group(
         return &cache->default_group;
     }
 
-    ecs_query_cache_group_t *group = ecs_map_get_deref(&cache->groups, 
-        ecs_query_cache_group_t, group_id);
+    ecs_query_cache_group_t *group = flecs_query_cache_get_group(
+        cache, group_id);
 
     if (!group) {
-        group = ecs_map_insert_alloc_t(&cache->groups, 
-            ecs_query_cache_group_t, group_id);
-        ecs_os_zeromem(group);
-
         ecs_allocator_t *a = &cache->query->real_world->allocator;
+        group = flecs_calloc_t(a, ecs_query_cache_group_t);
+
+        if (flecs_query_cache_group_is_indexed(cache, group_id)) {
+            flecs_query_cache_group_index_ensure(cache, group_id)[0] = group;
+        } else {
+            ecs_map_insert_ptr(&cache->groups, group_id, group);
+        }
+
+        group->dir_index = ecs_vec_count(&cache->group_dir);
+        ecs_vec_append_t(a, &cache->group_dir, ecs_query_cache_group_t*)[0] = 
+            group;
+
         if (flecs_query_cache_is_trivial(cache)) {
             ecs_vec_init_t(a, &group->tables, ecs_query_triv_cache_match_t, 0);
         } else {
@@ -128,9 +216,26 @@ void flecs_query_cache_group_fini(
     ecs_allocator_t *a = &cache->query->real_world->allocator;
     ecs_vec_fini(a, &group->tables, elem_size);
 
-    if (group != &cache->default_group) {
-        ecs_map_remove_free(&cache->groups, group->info.id);
+    if (group == &cache->default_group) {
+        return;
     }
+
+    uint64_t group_id = group->info.id;
+    if (flecs_query_cache_group_is_indexed(cache, group_id)) {
+        flecs_query_cache_group_index_get(cache, group_id)[0] = NULL;
+    } else {
+        ecs_map_remove(&cache->groups, group_id);
+    }
+
+    /* Remove group from directory, update index of moved group */
+    int32_t dir_index = group->dir_index;
+    ecs_vec_remove_t(&cache->group_dir, ecs_query_cache_group_t*, dir_index);
+    if (dir_index != ecs_vec_count(&cache->group_dir)) {
+        ecs_vec_get_t(&cache->group_dir, ecs_query_cache_group_t*, 
+            dir_index)[0]->dir_index = dir_index;
+    }
+
+    flecs_free_t(a, ecs_query_cache_group_t, group);
 }
 
 /* Remove group from cache. */
@@ -204,6 +309,11 @@ ecs_query_cache_match_t* flecs_query_cache_add_table_to_group(
     qt->group = group;
     qt->index = ecs_vec_count(&group->tables) - 1;
 
+    if (cache->group_by_callback) {
+        flecs_table_add_group_count(
+            cache->query->real_world, table, &group->info.entity_count);
+    }
+
     group->info.table_count ++;
     group->info.match_count ++;
     cache->match_count ++;
@@ -216,10 +326,16 @@ static
 void flecs_query_cache_remove_table_from_group(
     ecs_query_cache_t *cache,
     ecs_query_cache_group_t *group,
+    ecs_table_t *table,
     int32_t index)
 {
     cache->match_count ++;
 
+    if (cache->group_by_callback) {
+        flecs_table_remove_group_count(
+            cache->query->real_world, table, &group->info.entity_count);
+    }
+
     ecs_size_t elem_size = flecs_query_cache_elem_size(cache);
     ecs_vec_remove(&group->tables, elem_size, index);
     int32_t count = ecs_vec_count(&group->tables);
@@ -254,8 +370,8 @@ ecs_query_cache_match_t* flecs_query_cache_add_table(
     ecs_assert(ecs_map_get(&cache->tables, table->id) == NULL, 
         ECS_INTERNAL_ERROR, NULL);
 
-    if (!ecs_map_count(&cache->tables) && cache->entity) {
-        ecs_remove_id(cache->query->world, cache->entity, EcsEmpty);
+    if (!ecs_map_count(&cache->tables)) {
+        flecs_query_cache_clear_empty(cache);
     }
 
     uint64_t group_id = flecs_query_cache_get_group_id(cache, table);
@@ -301,7 +417,8 @@ void flecs_query_cache_move_table_to_group(
         ECS_INTERNAL_ERROR, NULL);
     
     /* Remove table from old group */
-    flecs_query_cache_remove_table_from_group(cache, src_group, src_index);
+    flecs_query_cache_remove_table_from_group(
+        cache, src_group, table, src_index);
 }
 
 /* Make sure a cache entry exists for table. */
@@ -351,7 +468,7 @@ void flecs_query_cache_remove_table(
 
     flecs_query_cache_match_fini(cache, match);
 
-    flecs_query_cache_remove_table_from_group(cache, group, qt->index);
+    flecs_query_cache_remove_table_from_group(cache, group, table, qt->index);
 
     ecs_allocator_t *a = &cache->query->real_world->allocator;
     flecs_free_t(a, ecs_query_cache_table_t, qt);
@@ -386,8 +503,14 @@ void flecs_query_cache_remove_all_tables(
     do {
         int32_t i, count = ecs_vec_count(&cur->tables);
         for (i = 0; i < count; i ++) {
-            flecs_query_cache_match_fini(
-                cache, ecs_vec_get(&cur->tables, elem_size, i));
+            ecs_query_cache_match_t *qm = 
+                ecs_vec_get(&cur->tables, elem_size, i);
+            if (cache->group_by_callback) {
+                flecs_table_remove_group_count(cache->query->real_world, 
+                    qm->base.table, &cur->info.entity_count);
+            }
+
+            flecs_query_cache_match_fini(cache, qm);
         }
 
         ecs_vec_fini(a, &cur->tables, elem_size);
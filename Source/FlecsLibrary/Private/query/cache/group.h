@@ -7,6 +7,9 @@ ecs_query_cache_group_t* flecs_query_cache_get_group(
     const ecs_query_cache_t *cache,
     uint64_t group_id);
 
+void flecs_query_cache_group_index_fini(
+    ecs_query_cache_t *cache);
+
 ecs_query_cache_match_t* flecs_query_cache_add_table(
     ecs_query_cache_t *cache,
     ecs_table_t *table);
@@ -153,6 +153,18 @@ void flecs_query_cache_match_set(
     }
 }
 
+/* Start tracking dirty rows for a newly matched table. This happens while 
+ * matching so that iterating the query never has to allocate row chunks. */
+static
+void flecs_query_cache_init_dirty_rows(
+    ecs_query_cache_t *cache,
+    ecs_table_t *table)
+{
+    if (cache->owner->pub.flags & EcsQueryDirtyRows) {
+        flecs_table_init_dirty_rows(cache->query->real_world, table);
+    }
+}
+
 /* Iterate the next match for table. This function accepts an iterator for the 
  * cache query and will keep on iterating until a result for a different table
  * is returned. Typically each table only returns one result, but wildcard 
@@ -169,6 +181,7 @@ bool flecs_query_cache_match_next(
 
     ecs_query_cache_match_t *first = flecs_query_cache_add_table(cache, table);
     ecs_query_cache_match_t *qm = first;
+    flecs_query_cache_init_dirty_rows(cache, table);
 
     ecs_size_t elem_size = flecs_query_cache_elem_size(cache);
     ecs_allocator_t *a = &cache->query->real_world->allocator;
@@ -209,6 +222,7 @@ bool flecs_query_cache_rematch_next(
     ecs_query_cache_match_t *first = 
         flecs_query_cache_ensure_table(cache, table);
     ecs_query_cache_match_t *qm = first;
+    flecs_query_cache_init_dirty_rows(cache, table);
     
     ecs_size_t elem_size = flecs_query_cache_elem_size(cache);
     ecs_allocator_t *a = &cache->query->real_world->allocator;
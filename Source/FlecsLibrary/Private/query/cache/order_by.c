@@ -43,11 +43,196 @@ void flecs_query_cache_sort_table(
     }
 }
 
+/* Minimum number of rows sorted per task when sorting tables in parallel */
+#define FLECS_ORDER_BY_TASK_MIN_ROWS (4096)
+
+/* Maximum number of tasks used for sorting tables in parallel */
+#define FLECS_ORDER_BY_TASK_MAX (8)
+
+/* Table that needs to be sorted by key */
+typedef struct flecs_query_sort_table_t {
+    ecs_table_t *table;
+    int32_t column;
+    bool reordered;
+} flecs_query_sort_table_t;
+
+/* Range of tables sorted by a single task */
+typedef struct flecs_query_sort_task_t {
+    ecs_world_t *world;
+    ecs_order_by_key_action_t key;
+    flecs_query_sort_table_t *tables;
+    int32_t count;
+} flecs_query_sort_task_t;
+
+/* Sort table with a stable LSD radix sort on the keys returned by the key
+ * callback. Only uses the OS allocator, so that it can run on task threads. */
+static
+bool flecs_query_cache_radix_sort_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t column_index,
+    ecs_order_by_key_action_t key)
+{
+    int32_t i, count = ecs_table_count(table);
+    if (count < 2) {
+        return false;
+    }
+
+    const ecs_entity_t *entities = table->data.entities;
+    const void *ptr = NULL;
+    ecs_size_t size = 0;
+    if (column_index != -1) {
+        ecs_column_t *column = &table->data.columns[column_index];
+        size = column->ti->size;
+        ptr = column->data;
+    }
+
+    uint64_t *keys = ecs_os_malloc_n(uint64_t, count * 2);
+    int32_t *rows = ecs_os_malloc_n(int32_t, count * 2);
+    uint64_t *keys_tmp = &keys[count];
+    int32_t *rows_tmp = &rows[count];
+
+    /* Histograms for all 8 digits are computed in a single pass */
+    int32_t hist[8][256] = {{0}};
+    bool sorted = true;
+    for (i = 0; i < count; i ++) {
+        uint64_t k = key(entities[i], ptr ? ECS_ELEM(ptr, size, i) : NULL);
+        keys[i] = k;
+        rows[i] = i;
+        if (i && k < keys[i - 1]) {
+            sorted = false;
+        }
+
+        int32_t d;
+        for (d = 0; d < 8; d ++) {
+            hist[d][(k >> (d * 8)) & 0xff] ++;
+        }
+    }
+
+    if (sorted) {
+        goto done;
+    }
+
+    int32_t d;
+    for (d = 0; d < 8; d ++) {
+        int32_t *h = hist[d];
+        int32_t b, offset = 0;
+        uint32_t shift = flecs_ito(uint32_t, d * 8);
+
+        /* Skip digit if all keys have the same value for it */
+        if (h[(keys[0] >> shift) & 0xff] == count) {
+            continue;
+        }
+
+        for (b = 0; b < 256; b ++) {
+            int32_t n = h[b];
+            h[b] = offset;
+            offset += n;
+        }
+
+        for (i = 0; i < count; i ++) {
+            int32_t dst = h[(keys[i] >> shift) & 0xff] ++;
+            keys_tmp[dst] = keys[i];
+            rows_tmp[dst] = rows[i];
+        }
+
+        uint64_t *keys_swap = keys; keys = keys_tmp; keys_tmp = keys_swap;
+        int32_t *rows_swap = rows; rows = rows_tmp; rows_tmp = rows_swap;
+    }
+
+    flecs_table_reorder(world, table, rows);
+
+done:
+    /* Buffers may have been swapped, free whichever half is first */
+    ecs_os_free(keys < keys_tmp ? keys : keys_tmp);
+    ecs_os_free(rows < rows_tmp ? rows : rows_tmp);
+    return !sorted;
+}
+
+static
+void* flecs_query_cache_sort_task(
+    void *arg)
+{
+    flecs_query_sort_task_t *task = arg;
+    int32_t i;
+    for (i = 0; i < task->count; i ++) {
+        flecs_query_sort_table_t *t = &task->tables[i];
+        t->reordered = flecs_query_cache_radix_sort_table(
+            task->world, t->table, t->column, task->key);
+    }
+    return NULL;
+}
+
+/* Sort tables by key. If the OS API supports tasks and there are enough rows to
+ * sort, tables are distributed over multiple tasks. Tables are only modified by
+ * a single task, and marked dirty on the calling thread after all tasks are
+ * done. */
+static
+void flecs_query_cache_sort_tables_by_key(
+    ecs_world_t *world,
+    ecs_order_by_key_action_t key,
+    flecs_query_sort_table_t *tables,
+    int32_t table_count)
+{
+    int32_t i, total = 0;
+    for (i = 0; i < table_count; i ++) {
+        total += ecs_table_count(tables[i].table);
+    }
+
+    int32_t task_count = total / FLECS_ORDER_BY_TASK_MIN_ROWS;
+    task_count = ECS_MIN(task_count, table_count);
+    task_count = ECS_MIN(task_count, FLECS_ORDER_BY_TASK_MAX);
+    if (task_count < 2 || !ecs_os_has_task_support()) {
+        task_count = 1;
+    }
+
+    flecs_query_sort_task_t tasks[FLECS_ORDER_BY_TASK_MAX];
+    ecs_os_thread_t threads[FLECS_ORDER_BY_TASK_MAX];
+
+    /* Assign consecutive tables to tasks so each task sorts ~the same number 
+     * of rows. */
+    int32_t t = 0, rows = 0;
+    tasks[0] = (flecs_query_sort_task_t){ world, key, tables, 0 };
+    for (i = 0; i < table_count; i ++) {
+        if (t < (task_count - 1) && 
+            rows >= (int64_t)total * (t + 1) / task_count) 
+        {
+            t ++;
+            tasks[t] = (flecs_query_sort_task_t){ world, key, &tables[i], 0 };
+        }
+        tasks[t].count ++;
+        rows += ecs_table_count(tables[i].table);
+    }
+
+    task_count = t + 1;
+
+    ecs_os_perf_trace_push("flecs.query.sort_tables_by_key");
+
+    for (t = 1; t < task_count; t ++) {
+        threads[t] = ecs_os_task_new(flecs_query_cache_sort_task, &tasks[t]);
+    }
+
+    flecs_query_cache_sort_task(&tasks[0]);
+
+    for (t = 1; t < task_count; t ++) {
+        ecs_os_task_join(threads[t]);
+    }
+
+    ecs_os_perf_trace_pop("flecs.query.sort_tables_by_key");
+
+    for (i = 0; i < table_count; i ++) {
+        if (tables[i].reordered) {
+            flecs_table_mark_table_dirty(world, tables[i].table, 0);
+        }
+    }
+}
+
 /* Helper struct for building sorted table ranges */
 typedef struct sort_helper_t {
     ecs_query_cache_match_t *match;
     ecs_entity_t *entities;
     const void *ptr;
+    uint64_t key;
     int32_t row;
     int32_t elem_size;
     int32_t count;
@@ -79,6 +264,75 @@ ecs_entity_t e_from_helper(
     }
 }
 
+static
+void flecs_query_cache_helper_key(
+    const ecs_query_cache_t *cache,
+    sort_helper_t *helper)
+{
+    ecs_order_by_key_action_t key = cache->order_by_key_callback;
+    if (key && helper->row < helper->count) {
+        helper->key = key(e_from_helper(helper), 
+            helper->ptr ? ptr_from_helper(helper) : NULL);
+    }
+}
+
+/* Returns whether the current row of helper a goes before helper b. Rows that
+ * compare equal are ordered by table. */
+static
+bool flecs_query_cache_helper_lt(
+    const ecs_query_cache_t *cache,
+    sort_helper_t *helper,
+    int32_t a,
+    int32_t b)
+{
+    sort_helper_t *h_a = &helper[a], *h_b = &helper[b];
+    if (cache->order_by_key_callback) {
+        if (h_a->key != h_b->key) {
+            return h_a->key < h_b->key;
+        }
+    } else {
+        int cmp = cache->order_by_callback(
+            e_from_helper(h_a), ptr_from_helper(h_a),
+            e_from_helper(h_b), ptr_from_helper(h_b));
+        if (cmp) {
+            return cmp < 0;
+        }
+    }
+
+    return a < b;
+}
+
+static
+void flecs_query_cache_heap_down(
+    const ecs_query_cache_t *cache,
+    sort_helper_t *helper,
+    int32_t *heap,
+    int32_t heap_count,
+    int32_t i)
+{
+    for (;;) {
+        int32_t min = i, l = i * 2 + 1, r = l + 1;
+        if (l < heap_count && 
+            flecs_query_cache_helper_lt(cache, helper, heap[l], heap[min])) 
+        {
+            min = l;
+        }
+        if (r < heap_count && 
+            flecs_query_cache_helper_lt(cache, helper, heap[r], heap[min])) 
+        {
+            min = r;
+        }
+        if (min == i) {
+            break;
+        }
+
+        int32_t tmp = heap[i];
+        heap[i] = heap[min];
+        heap[min] = tmp;
+        i = min;
+    }
+}
+
 static
 void flecs_query_cache_build_sorted_table_range(
     ecs_query_cache_t *cache,
@@ -90,7 +344,6 @@ void flecs_query_cache_build_sorted_table_range(
         "cannot sort query in multithreaded mode");
 
     ecs_entity_t id = cache->order_by;
-    ecs_order_by_action_t compare = cache->order_by_callback;
     int32_t i, table_count = ecs_vec_count(&group->tables);
     if (!table_count) {
         return;
@@ -102,6 +355,7 @@ void flecs_query_cache_build_sorted_table_range(
 
     sort_helper_t *helper = flecs_alloc_n(
         &world->allocator, sort_helper_t, table_count);
+    int32_t *heap = flecs_alloc_n(&world->allocator, int32_t, table_count);
     for (i = 0; i < table_count; i ++) {
         ecs_query_cache_match_t *qm = 
             ecs_vec_get_t(&group->tables, ecs_query_cache_match_t, i);
@@ -153,49 +407,22 @@ void flecs_query_cache_build_sorted_table_range(
         helper[to_sort].entities = table->data.entities;
         helper[to_sort].row = 0;
         helper[to_sort].count = ecs_table_count(table);
+        flecs_query_cache_helper_key(cache, &helper[to_sort]);
+        heap[to_sort] = to_sort;
         to_sort ++;      
     }
 
-    if (!to_sort) {
-        goto done;
+    /* Merge sorted tables with a k-way merge. The heap contains the tables 
+     * that have rows left, ordered by their current row. */
+    int32_t heap_count = to_sort;
+    for (i = heap_count / 2 - 1; i >= 0; i --) {
+        flecs_query_cache_heap_down(cache, helper, heap, heap_count, i);
     }
 
     ecs_query_cache_match_t *cur = NULL;
 
-    bool proceed;
-    do {
-        int32_t j, min = 0;
-        proceed = true;
-
-        ecs_entity_t e1;
-        while (!(e1 = e_from_helper(&helper[min]))) {
-            min ++;
-            if (min == to_sort) {
-                proceed = false;
-                break;
-            }
-        }
-
-        if (!proceed) {
-            break;
-        }
-
-        for (j = min + 1; j < to_sort; j++) {
-            ecs_entity_t e2 = e_from_helper(&helper[j]);
-            if (!e2) {
-                continue;
-            }
-
-            const void *ptr1 = ptr_from_helper(&helper[min]);
-            const void *ptr2 = ptr_from_helper(&helper[j]);
-
-            if (compare(e1, ptr1, e2, ptr2) > 0) {
-                min = j;
-                e1 = e_from_helper(&helper[min]);
-            }
-        }
-
-        sort_helper_t *cur_helper = &helper[min];
+    while (heap_count) {
+        sort_helper_t *cur_helper = &helper[heap[0]];
         if (!cur || cur->base.trs != cur_helper->match->base.trs) {
             cur = ecs_vec_append_t(NULL, &cache->table_slices, 
                 ecs_query_cache_match_t);
@@ -207,9 +434,16 @@ void flecs_query_cache_build_sorted_table_range(
         }
 
         cur_helper->row ++;
-    } while (proceed);
+        if (cur_helper->row < cur_helper->count) {
+            flecs_query_cache_helper_key(cache, cur_helper);
+        } else {
+            heap[0] = heap[-- heap_count];
+        }
 
-done:
+        flecs_query_cache_heap_down(cache, helper, heap, heap_count, 0);
+    }
+
+    flecs_free_n(&world->allocator, int32_t, table_count, heap);
     flecs_free_n(&world->allocator, sort_helper_t, table_count, helper);
 }
 
@@ -231,10 +465,21 @@ void flecs_query_cache_sort_tables(
 {
     ecs_query_cache_t *cache = impl->cache;
     ecs_order_by_action_t compare = cache->order_by_callback;
-    if (!compare) {
+    ecs_order_by_key_action_t key = cache->order_by_key_callback;
+    if (!compare && !key) {
         return;
     }
 
+    /* Queries of multithreaded systems are sorted by the pipeline before the
+     * workers start (see flecs_query_presort_tables). */
+    if (cache->presorted && (world->flags & EcsWorldMultiThreaded)) {
+        return;
+    }
+
+    ecs_vec_t key_tables;
+    ecs_vec_init_t(&world->allocator, &key_tables, 
+        flecs_query_sort_table_t, 0);
+
     ecs_sort_table_action_t sort = cache->order_by_table_callback;
     ecs_entity_t order_by = cache->order_by;
     int32_t order_by_term = cache->order_by_term;
@@ -302,15 +547,79 @@ void flecs_query_cache_sort_tables(
                 continue;
             }
 
+            /* Tables are sorted in place, which isn't safe while other threads
+             * may be iterating them. */
+            ecs_assert(!(world->flags & EcsWorldMultiThreaded), 
+                ECS_UNSUPPORTED, "cannot sort query in multithreaded mode");
+
+            tables_sorted = true;
+
+            if (key) {
+                /* Tables sorted by key are collected and sorted together */
+                if (ecs_table_count(table) > 1) {
+                    flecs_query_sort_table_t *t = ecs_vec_append_t(
+                        &world->allocator, &key_tables, 
+                        flecs_query_sort_table_t);
+                    t->table = table;
+                    t->column = column;
+                    t->reordered = false;
+                }
+                continue;
+            }
+
             /* Something has changed, sort the table. Prefers using 
             * flecs_query_cache_sort_table when available */
             flecs_query_cache_sort_table(world, table, column, compare, sort);
-            tables_sorted = true;
         }
     } while ((cur = cur->next)); /* Next group */
 
+    if (ecs_vec_count(&key_tables)) {
+        flecs_query_cache_sort_tables_by_key(world, key, 
+            ecs_vec_first(&key_tables), ecs_vec_count(&key_tables));
+    }
+
+    ecs_vec_fini_t(&world->allocator, &key_tables, flecs_query_sort_table_t);
+
     if (tables_sorted || cache->match_count != cache->prev_match_count) {
         flecs_query_cache_build_sorted_tables(cache);
         cache->match_count ++; /* Increase version if tables changed */
     }
 }
+
+void flecs_query_presort_tables(
+    ecs_world_t *world,
+    ecs_query_t *q)
+{
+    ecs_query_impl_t *impl = flecs_query_impl(q);
+    ecs_query_cache_t *cache = impl->cache;
+    if (cache && flecs_query_cache_is_ordered(cache)) {
+        flecs_query_cache_sort_tables(world, impl);
+        cache->presorted = true;
+    }
+}
+
+void flecs_query_presort_end(
+    ecs_query_t *q)
+{
+    ecs_query_cache_t *cache = flecs_query_impl(q)->cache;
+    if (cache) {
+        cache->presorted = false;
+    }
+}
+
+uint64_t ecs_order_by_key_i64(
+    int64_t value)
+{
+    return (uint64_t)value ^ (1ull << 63);
+}
+
+uint64_t ecs_order_by_key_f64(
+    double value)
+{
+    uint64_t bits;
+    ecs_os_memcpy_t(&bits, &value, uint64_t);
+    if (bits & (1ull << 63)) {
+        return ~bits;
+    }
+    return bits | (1ull << 63);
+}
@@ -0,0 +1,342 @@
+/**
+ * @file query/cache/share.c
+ * @brief Sharing caches between queries with identical terms, and snapshots.
+ *
+ * Queries created with EcsQueryShareCache look for an existing cache with the
+ * same (normalized) terms before creating their own. The query that created a
+ * cache is its owner, and is the query that is registered with component
+ * monitors. When the owner is deleted while other queries still use the cache,
+ * ownership is transferred to one of the remaining queries.
+ */
+
+#include "../../private_api.h"
+
+/* Flags that change which tables are stored in the cache */
+#define FLECS_QUERY_SHARE_FLAGS (\
+    EcsQueryMatchPrefab | EcsQueryMatchDisabled | EcsQueryMatchEmptyTables |\
+    EcsQueryTableOnly | EcsQueryAllowUnresolvedByName)
+
+/* Term members that determine how a term is matched. Names are left out, as
+ * they are resolved to ids when the query is finalized. */
+typedef struct flecs_query_share_term_t {
+    ecs_id_t id;
+    ecs_entity_t src;
+    ecs_entity_t first;
+    ecs_entity_t second;
+    ecs_entity_t trav;
+    int16_t inout;
+    int16_t oper;
+    ecs_flags16_t flags;
+} flecs_query_share_term_t;
+
+typedef struct flecs_query_share_key_t {
+    ecs_flags32_t flags;
+    int32_t cache_kind;
+    int32_t term_count;
+    flecs_query_share_term_t terms[FLECS_TERM_COUNT_MAX];
+} flecs_query_share_key_t;
+
+static
+bool flecs_query_ref_is_named_var(
+    const ecs_term_ref_t *ref)
+{
+    return (ref->id & EcsIsVariable) && !ECS_TERM_REF_ID(ref);
+}
+
+static
+bool flecs_query_cache_can_share(
+    const ecs_query_t *q,
+    const ecs_query_desc_t *desc)
+{
+    if (!(q->flags & EcsQueryShareCache)) {
+        return false;
+    }
+
+    /* Sorting, grouping and change detection state is specific to a query */
+    if (desc->order_by || desc->order_by_callback ||
+        desc->order_by_key_callback || desc->group_by ||
+        desc->group_by_callback)
+    {
+        return false;
+    }
+
+    if (q->flags & (EcsQueryDetectChanges | EcsQueryDirtyRows)) {
+        return false;
+    }
+
+    /* Two queries that only differ in variable names would compute the same
+     * key, so don't share caches of queries with named variables. */
+    int32_t i, count = q->term_count;
+    for (i = 0; i < count; i ++) {
+        const ecs_term_t *term = &q->terms[i];
+        if (flecs_query_ref_is_named_var(&term->src) ||
+            flecs_query_ref_is_named_var(&term->first) ||
+            flecs_query_ref_is_named_var(&term->second))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Create key from normalized terms. Returns the number of key bytes used. */
+static
+ecs_size_t flecs_query_cache_share_key(
+    const ecs_query_t *q,
+    flecs_query_share_key_t *key)
+{
+    ecs_os_memset_t(key, 0, flecs_query_share_key_t);
+    key->flags = q->flags & FLECS_QUERY_SHARE_FLAGS;
+    key->cache_kind = q->cache_kind;
+    key->term_count = q->term_count;
+
+    int32_t i, count = q->term_count;
+    for (i = 0; i < count; i ++) {
+        const ecs_term_t *term = &q->terms[i];
+        flecs_query_share_term_t *dst = &key->terms[i];
+        dst->id = term->id;
+        dst->src = term->src.id;
+        dst->first = term->first.id;
+        dst->second = term->second.id;
+        dst->trav = term->trav;
+        dst->inout = term->inout;
+        dst->oper = term->oper;
+        dst->flags = term->flags_;
+    }
+
+    /* Terms array is the last member, only use the part that is set */
+    return ECS_SIZEOF(flecs_query_share_key_t) - 
+        (FLECS_TERM_COUNT_MAX - count) * ECS_SIZEOF(flecs_query_share_term_t);
+}
+
+bool flecs_query_cache_share(
+    ecs_query_impl_t *impl,
+    const ecs_query_desc_t *desc,
+    uint64_t *share_hash)
+{
+    ecs_query_t *q = &impl->pub;
+    ecs_world_t *world = q->real_world;
+    *share_hash = 0;
+
+    if (!flecs_query_cache_can_share(q, desc)) {
+        return false;
+    }
+
+    flecs_query_share_key_t key;
+    ecs_size_t key_size = flecs_query_cache_share_key(q, &key);
+    uint64_t hash = flecs_hash(&key, key_size);
+    if (!hash) {
+        hash = 1; /* 0 means cache is not shared */
+    }
+
+    ecs_query_cache_t *cache = NULL;
+    if (ecs_map_is_init(&world->shared_caches)) {
+        cache = ecs_map_get_deref(
+            &world->shared_caches, ecs_query_cache_t, hash);
+    }
+
+    if (!cache) {
+        *share_hash = hash;
+        return false;
+    }
+
+    /* Check for hash collision. Terms are compared with the owner of the
+     * cache, which is guaranteed to be alive while the cache exists. */
+    ecs_query_impl_t *owner = cache->owner;
+    if (owner->stage != impl->stage) {
+        return false;
+    }
+
+    flecs_query_share_key_t owner_key;
+    if (flecs_query_cache_share_key(&owner->pub, &owner_key) != key_size ||
+        ecs_os_memcmp(&key, &owner_key, key_size))
+    {
+        return false;
+    }
+
+    ecs_vec_append_t(&world->allocator, &cache->sharers,
+        ecs_query_impl_t*)[0] = impl;
+    impl->cache = cache;
+    q->flags |= owner->pub.flags & EcsQueryHasRefs;
+
+    if (!ecs_map_count(&cache->tables) && cache->query->term_count) {
+        ecs_add_id(world, q->entity, EcsEmpty);
+    }
+
+    ecs_dbg_2("#[green]query#[normal] shares cache with query %u",
+        (uint32_t)owner->pub.entity);
+
+    return true;
+}
+
+void flecs_query_cache_register_shared(
+    ecs_query_cache_t *cache,
+    uint64_t share_hash)
+{
+    ecs_assert(share_hash != 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_world_t *world = cache->owner->pub.real_world;
+    ecs_map_init_if(&world->shared_caches, &world->allocator);
+    ecs_map_insert_ptr(&world->shared_caches, share_hash, cache);
+    cache->share_hash = share_hash;
+}
+
+void flecs_query_cache_clear_empty(
+    ecs_query_cache_t *cache)
+{
+    ecs_world_t *world = cache->query->world;
+    if (cache->entity) {
+        ecs_remove_id(world, cache->entity, EcsEmpty);
+    }
+
+    /* Queries that share the cache are tagged as empty separately */
+    int32_t i, count = ecs_vec_count(&cache->sharers);
+    ecs_query_impl_t **sharers = ecs_vec_first(&cache->sharers);
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t entity = sharers[i]->pub.entity;
+        if (entity) {
+            ecs_remove_id(world, entity, EcsEmpty);
+        }
+    }
+}
+
+bool flecs_query_cache_release(
+    ecs_query_impl_t *impl)
+{
+    ecs_query_cache_t *cache = impl->cache;
+    ecs_assert(cache != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_world_t *world = impl->pub.real_world;
+
+    int32_t i, count = ecs_vec_count(&cache->sharers);
+    if (!count) {
+        ecs_assert(cache->owner == impl, ECS_INTERNAL_ERROR, NULL);
+        if (cache->share_hash) {
+            ecs_map_remove(&world->shared_caches, cache->share_hash);
+            cache->share_hash = 0;
+        }
+
+        ecs_vec_fini_t(&world->allocator, &cache->sharers, ecs_query_impl_t*);
+        return false;
+    }
+
+    impl->cache = NULL;
+
+    if (cache->owner != impl) {
+        ecs_query_impl_t **sharers = ecs_vec_first(&cache->sharers);
+        for (i = 0; i < count; i ++) {
+            if (sharers[i] == impl) {
+                ecs_vec_remove_t(&cache->sharers, ecs_query_impl_t*, i);
+                break;
+            }
+        }
+
+        ecs_assert(i != count, ECS_INTERNAL_ERROR, NULL);
+        return true;
+    }
+
+    /* Transfer ownership to another query that uses the cache */
+    ecs_query_impl_t *owner = ecs_vec_last_t(
+        &cache->sharers, ecs_query_impl_t*)[0];
+    ecs_vec_remove_last(&cache->sharers);
+
+    flecs_monitor_replace_query(world, &impl->pub, &owner->pub);
+
+    cache->owner = owner;
+    cache->entity = owner->pub.entity;
+    if (cache->observer) {
+        cache->observer->entity = owner->pub.entity;
+    }
+
+    if (cache->entity && !(world->flags & (EcsWorldQuit | EcsWorldFini))) {
+        if (!ecs_map_count(&cache->tables) && cache->query->term_count) {
+            ecs_add_id(world, cache->entity, EcsEmpty);
+        }
+    }
+
+    return true;
+}
+
+const ecs_query_snapshot_t* flecs_query_cache_snapshot(
+    ecs_world_t *world,
+    ecs_query_cache_t *cache)
+{
+    ecs_query_snapshot_t *snapshot = &cache->snapshot;
+    int64_t frame = world->info.frame_count_total;
+
+    /* In multithreaded mode the snapshot is built by the first thread that
+     * gets here in a frame, and reused by the other threads. The ranges use
+     * the OS heap, as the world allocator is not thread safe and a buffer 
+     * from a stage allocator could be grown by another stage next frame. */
+    bool multi_threaded = (world->flags & EcsWorldMultiThreaded) &&
+        cache->snapshot_lock;
+    if (multi_threaded) {
+        ecs_os_mutex_lock(cache->snapshot_lock);
+    }
+
+    if (snapshot->frame == frame &&
+        cache->snapshot_match_count == cache->match_count &&
+        cache->snapshot_table_count_version == world->table_count_version)
+    {
+        goto done;
+    }
+
+    ecs_vec_t *ranges = &cache->snapshot_ranges;
+    ecs_vec_clear(ranges);
+    int32_t entity_count = 0;
+
+    if (flecs_query_cache_is_ordered(cache)) {
+        flecs_query_cache_sort_tables(world, cache->owner);
+
+        int32_t i, count = ecs_vec_count(&cache->table_slices);
+        ecs_query_cache_match_t *slices = ecs_vec_first(&cache->table_slices);
+        for (i = 0; i < count; i ++) {
+            ecs_query_cache_match_t *qm = &slices[i];
+            if (!qm->_count) {
+                continue;
+            }
+
+            ecs_table_range_t *range = ecs_vec_append_t(
+                NULL, ranges, ecs_table_range_t);
+            range->table = qm->base.table;
+            range->offset = qm->_offset;
+            range->count = qm->_count;
+            entity_count += qm->_count;
+        }
+    } else {
+        ecs_size_t elem_size = flecs_query_cache_elem_size(cache);
+        ecs_query_cache_group_t *cur = cache->first_group;
+        for (; cur; cur = cur->next) {
+            int32_t i, count = ecs_vec_count(&cur->tables);
+            for (i = 0; i < count; i ++) {
+                ecs_query_cache_match_t *qm =
+                    ecs_vec_get(&cur->tables, elem_size, i);
+                ecs_table_t *table = qm->base.table;
+                int32_t table_count = ecs_table_count(table);
+                if (!table_count) {
+                    continue;
+                }
+
+                ecs_table_range_t *range = ecs_vec_append_t(
+                    NULL, ranges, ecs_table_range_t);
+                range->table = table;
+                range->offset = 0;
+                range->count = table_count;
+                entity_count += table_count;
+            }
+        }
+    }
+
+    snapshot->ranges = ecs_vec_first(ranges);
+    snapshot->count = ecs_vec_count(ranges);
+    snapshot->entity_count = entity_count;
+    cache->snapshot_match_count = cache->match_count;
+    cache->snapshot_table_count_version = world->table_count_version;
+    snapshot->frame = frame;
+
+done:
+    if (multi_threaded) {
+        ecs_os_mutex_unlock(cache->snapshot_lock);
+    }
+
+    return snapshot;
+}
@@ -28,7 +28,7 @@ ecs_var_id_t flecs_query_add_var(
         }
     }
 
-    ecs_hashmap_t *var_index = NULL;
+    ecs_name_index_t *var_index = NULL;
     ecs_var_id_t var_id = EcsVarNone;
     if (name) {
         if (kind == EcsVarAny) {
@@ -616,6 +616,7 @@ void flecs_query_insert_trivial_search(
 
         /* Store the bitset with trivial terms on the instruction */
         trivial.src.entity = trivial_set;
+        flecs_query_write(0, &trivial.written);
         flecs_query_op_insert(&trivial, ctx);
 
         /* Mark $this as written */
@@ -840,6 +841,142 @@ int flecs_query_insert_fixed_src_terms(
     return 0;
 }
 
+static
+bool flecs_query_op_src_written(
+    const ecs_query_op_t *op,
+    ecs_write_flags_t written)
+{
+    if (!(op->flags & (EcsQueryIsVar << EcsQuerySrc))) {
+        return false;
+    }
+
+    return (written & (1ull << op->src.var)) != 0;
+}
+
+/* Replace instructions that check at runtime whether their source is written
+ * with variants that don't, and fuse Not blocks that contain a single With
+ * instruction. The written state is only tracked for the straight line part 
+ * of the program. Variables written inside Not and Optional blocks don't count
+ * as written after the block, which may underestimate what is written at 
+ * runtime (for example when variables are constrained by the iterator), but 
+ * never overestimates it. Evaluation stops at the first instruction that 
+ * doesn't fit in that model. */
+static
+void flecs_query_compile_specialize(
+    ecs_query_compile_ctx_t *ctx)
+{
+    ecs_query_op_t *ops = ecs_vec_first_t(ctx->ops, ecs_query_op_t);
+    int32_t i, count = ecs_vec_count(ctx->ops);
+    ecs_write_flags_t written = 0, block_written = 0;
+    int32_t block_end = -1;
+
+    for (i = 0; i < count; i ++) {
+        ecs_query_op_t *op = &ops[i];
+        bool in_block = i < block_end;
+        ecs_write_flags_t cur_written = in_block ? block_written : written;
+
+        if (op->kind == EcsQueryNot || op->kind == EcsQueryOptional) {
+            if (in_block) {
+                break; /* Nested block */
+            }
+
+            block_end = op->next;
+            block_written = written;
+            continue;
+        }
+
+        if (i == block_end) {
+            /* End of block, written state continues from before block */
+            ecs_assert(op->kind == EcsQueryEnd, ECS_INTERNAL_ERROR, NULL);
+            continue;
+        }
+
+        if (op->prev != (i - 1) || op->next != (i + 1)) {
+            break; /* Control flow that's not a simple block */
+        }
+
+        switch(op->kind) {
+        case EcsQueryAnd:
+            if (flecs_query_op_src_written(op, cur_written)) {
+                op->kind = EcsQueryWith;
+            }
+            break;
+        case EcsQueryUp:
+            if (flecs_query_op_src_written(op, cur_written)) {
+                op->kind = EcsQueryUpWith;
+            }
+            break;
+        case EcsQuerySelfUp:
+            if (flecs_query_op_src_written(op, cur_written)) {
+                op->kind = EcsQuerySelfUpWith;
+            }
+            break;
+        case EcsQueryToggle:
+            if (!op->second.entity) {
+                op->kind = EcsQueryToggleAnd;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (in_block) {
+            block_written |= op->written;
+        } else {
+            written |= op->written;
+        }
+    }
+
+    for (i = 0; i < (count - 2); i ++) {
+        ecs_query_op_t *op = &ops[i];
+        if (op->kind != EcsQueryNot || op->next != (i + 2)) {
+            continue;
+        }
+
+        const ecs_query_op_t *with_op = &ops[i + 1];
+        if (with_op->kind != EcsQueryWith) {
+            continue;
+        }
+
+        /* Other match flags (cacheable, trivial) don't change how With 
+         * evaluates, and are always set for plain component terms. */
+        if (with_op->match_flags & 
+            (EcsTermMatchAny|EcsTermMatchAnySrc|EcsTermReflexive)) 
+        {
+            continue;
+        }
+
+        if (flecs_query_ref_flags(with_op->flags, EcsQueryFirst) & EcsQueryIsVar) {
+            continue;
+        }
+
+        if (flecs_query_ref_flags(with_op->flags, EcsQuerySecond) & EcsQueryIsVar) {
+            continue;
+        }
+
+        ecs_assert(ops[i + 2].kind == EcsQueryEnd, ECS_INTERNAL_ERROR, NULL);
+        op->kind = EcsQueryNotWith;
+    }
+}
+
+/* Returns true if operation can evaluate up traversal for a known source */
+static
+bool flecs_query_op_is_up(
+    ecs_query_op_kind_t kind)
+{
+    switch(kind) {
+    case EcsQueryUp:
+    case EcsQuerySelfUp:
+    case EcsQueryUpWith:
+    case EcsQuerySelfUpWith:
+    case EcsQuerySparseUp:
+    case EcsQuerySparseSelfUp:
+        return true;
+    default:
+        return false;
+    }
+}
+
 int flecs_query_compile(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -1107,12 +1244,31 @@ int flecs_query_compile(
         flecs_query_op_insert(&yield, &ctx);
     }
 
+    flecs_query_compile_specialize(&ctx);
+
     int32_t op_count = ecs_vec_count(ctx.ops);
     if (op_count) {
         query->op_count = op_count;
         query->ops = flecs_alloc_n(&stage->allocator, ecs_query_op_t, op_count);
         ecs_query_op_t *query_ops = ecs_vec_first_t(ctx.ops, ecs_query_op_t);
         ecs_os_memcpy_n(query->ops, query_ops, ecs_query_op_t, op_count);
+
+        /* Up traversal caches for a known source outlive the iterator, so
+         * that hierarchies don't have to be traversed for each iteration. */
+        int32_t i;
+        for (i = 0; i < op_count; i ++) {
+            if (flecs_query_op_is_up(query_ops[i].kind)) {
+                break;
+            }
+        }
+
+        if (i != op_count) {
+            query->up_caches = flecs_calloc_n(
+                &stage->allocator, ecs_trav_up_cache_t, op_count);
+            for (i = 0; i < op_count; i ++) {
+                query->up_caches[i].persistent = true;
+            }
+        }
     }
 
     return 0;
@@ -223,6 +223,11 @@ bool flecs_query_toggle_option(
     bool redo,
     ecs_query_run_ctx_t *ctx);
 
+bool flecs_query_toggle_and(
+    const ecs_query_op_t *op,
+    bool redo,
+    ecs_query_run_ctx_t *ctx);
+
 
 /* Equality predicate evaluation */
 
@@ -1373,6 +1373,40 @@ bool flecs_query_not(
     return !flecs_query_run_block_w_reset(op, redo, ctx);
 }
 
+static
+bool flecs_query_not_with(
+    const ecs_query_op_t *op,
+    bool redo,
+    ecs_query_run_ctx_t *ctx)
+{
+    if (redo) {
+        return false;
+    }
+
+    /* Evaluate the With instruction of the block inline instead of running the
+     * block through the dispatch loop. The With instruction directly follows
+     * the Not instruction, and keeps its own context for caching the record. */
+    const ecs_query_op_t *with_op = &op[1];
+    ecs_query_and_ctx_t *with_ctx = &ctx->op_ctx[ctx->op_index + 1].is.and;
+    ecs_query_ctrl_ctx_t *op_ctx = flecs_op_ctx(ctx, ctrl);
+    bool result = false;
+
+    ecs_table_t *table = flecs_query_get_table(
+        with_op, &with_op->src, EcsQuerySrc, ctx);
+    if (table) {
+        ecs_id_t id = flecs_query_op_get_id(with_op, ctx);
+        ecs_component_record_t *cr = with_ctx->cr;
+        if (!cr || cr->id != id) {
+            cr = with_ctx->cr = flecs_components_get(ctx->world, id);
+        }
+
+        result = cr && flecs_component_get_table(cr, table) != NULL;
+    }
+
+    flecs_query_reset_after_block(op, ctx, op_ctx, result);
+    return !result;
+}
+
 static
 bool flecs_query_optional(
     const ecs_query_op_t *op,
@@ -1511,6 +1545,10 @@ bool flecs_query_dispatch(
     case EcsQuerySetId: return flecs_query_setid(op, redo, ctx);
     case EcsQueryContain: return flecs_query_contain(op, redo, ctx);
     case EcsQueryPairEq: return flecs_query_pair_eq(op, redo, ctx);
+    case EcsQueryUpWith: return flecs_query_up_with(op, redo, ctx);
+    case EcsQuerySelfUpWith: return flecs_query_self_up_with(op, redo, ctx, false);
+    case EcsQueryNotWith: return flecs_query_not_with(op, redo, ctx);
+    case EcsQueryToggleAnd: return flecs_query_toggle_and(op, redo, ctx);
     case EcsQueryYield: return false;
     case EcsQueryNothing: return false;
     }
@@ -80,7 +80,7 @@ void flecs_query_iter_constrain(
                 }
             }
         } else if (flags & EcsQueryIsCacheable) {
-            if (!cache->order_by_callback && 
+            if (!flecs_query_cache_is_ordered(cache) && 
                 (cache->query->flags & EcsQueryTrivialCache && 
                  !(query->pub.flags & EcsQueryHasChangeDetection))) 
             {
@@ -103,7 +103,7 @@ void flecs_query_iter_constrain(
                 }
             }
         } else if (flags & EcsQueryIsCacheable) {
-            if (!cache->order_by_callback && 
+            if (!flecs_query_cache_is_ordered(cache) && 
                 (cache->query->flags & EcsQueryTrivialCache && 
                  !(query->pub.flags & EcsQueryHasChangeDetection))) 
             {
@@ -152,15 +152,10 @@ void flecs_query_self_change_detection(
     flecs_query_change_detection(it, qit, impl);
 }
 
-bool ecs_query_next(
+static
+bool flecs_query_next(
     ecs_iter_t *it)
 {
-    ecs_assert(it != NULL, ECS_INVALID_PARAMETER, NULL);
-    ecs_assert(it->next == ecs_query_next || 
-        it->next == flecs_query_trivial_cached_next ||
-        it->next == flecs_default_next_callback,
-            ECS_INVALID_PARAMETER, NULL);
-
     ecs_os_perf_trace_push("flecs.query.next");
 
     ecs_query_iter_t *qit = &it->priv_.iter.query;
@@ -278,6 +273,73 @@ yield:
     return true;
 }
 
+/* Iterator mode for EcsQueryDirtyRows. Splits results into ranges of rows that
+ * changed since the last time the query iterated them. */
+static
+bool flecs_query_dirty_rows_next(
+    ecs_iter_t *it)
+{
+    ecs_query_iter_t *qit = &it->priv_.iter.query;
+    ecs_query_impl_t *impl = ECS_CONST_CAST(ecs_query_impl_t*, it->query);
+
+    if (qit->dirty_end) {
+        /* Rows of a split result are marked dirty per yielded range */
+        if (!(it->flags & EcsIterSkip)) {
+            flecs_query_mark_fields_dirty(impl, it);
+        } else {
+            qit->dirty_skip = true;
+        }
+
+        it->flags &= ~EcsIterSkip;
+
+        if (flecs_query_next_dirty_rows(it)) {
+            return true;
+        }
+
+        /* Done with the result. Move the iterator to an empty range at the end
+         * of the result so that change detection synchronizes the monitor
+         * without marking rows dirty again. */
+        it->frame_offset += qit->dirty_end - it->offset;
+        it->offset = qit->dirty_end;
+        it->count = 0;
+        qit->dirty_end = 0;
+        if (qit->dirty_skip) {
+            it->flags |= EcsIterSkip;
+        }
+    }
+
+    while (flecs_query_next(it)) {
+        if (flecs_query_find_dirty_rows(it)) {
+            return true;
+        }
+
+        /* Nothing changed in the result */
+        it->flags |= EcsIterSkip;
+    }
+
+    return false;
+}
+
+bool ecs_query_next(
+    ecs_iter_t *it)
+{
+    ecs_assert(it != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(it->next == ecs_query_next || 
+        it->next == flecs_query_trivial_cached_next ||
+        it->next == flecs_default_next_callback,
+            ECS_INVALID_PARAMETER, NULL);
+
+    const ecs_query_impl_t *impl = flecs_query_impl(it->query);
+    ecs_assert(impl != NULL, ECS_INVALID_OPERATION, 
+        "cannot call ecs_query_next on invalid iterator");
+
+    if ((impl->pub.flags & EcsQueryDirtyRows) && impl->cache) {
+        return flecs_query_dirty_rows_next(it);
+    }
+
+    return flecs_query_next(it);
+}
+
 bool flecs_query_trivial_cached_next(
     ecs_iter_t *it)
 {
@@ -333,8 +395,14 @@ void flecs_query_iter_fini_ctx(
         case EcsQueryTrav:
             flecs_query_trav_cache_fini(a, &ctx[i].is.trav.cache);
             break;
+        case EcsQueryToggle:
+        case EcsQueryToggleAnd:
+            ecs_vec_fini_t(a, &ctx[i].is.toggle.row_mask, uint64_t);
+            break;
         case EcsQueryUp:
         case EcsQuerySelfUp:
+        case EcsQueryUpWith:
+        case EcsQuerySelfUpWith:
         case EcsQuerySparseUp:
         case EcsQuerySparseSelfUp: {
             ecs_query_up_ctx_t *op_ctx = &ctx[i].is.up;
@@ -368,7 +436,16 @@ void flecs_query_iter_fini(
     int32_t var_count = flecs_query_impl(q)->var_count;
 
     if (it->flags & EcsIterIsValid) {
-        flecs_query_change_detection(it, qit, flecs_query_impl(q));
+        if (qit->dirty_end) {
+            /* Iteration stopped halfway a result split by EcsQueryDirtyRows.
+             * Don't synchronize the monitor, so the rows that weren't yielded
+             * yet are yielded next time. */
+            if (!(it->flags & EcsIterSkip)) {
+                flecs_query_mark_fields_dirty(flecs_query_impl(q), it);
+            }
+        } else {
+            flecs_query_change_detection(it, qit, flecs_query_impl(q));
+        }
     }
 
 #ifdef FLECS_DEBUG
@@ -547,7 +624,8 @@ ecs_iter_t ecs_query_iter(
         if (!(ecs_world_get_flags(world) & EcsWorldReadonly) && 
              (flags & EcsQueryHasRefs)) 
         {
-            flecs_eval_component_monitors(q->world);
+            flecs_eval_query_monitors(q->real_world, 
+                ECS_CONST_CAST(ecs_query_t*, q));
         }
     }
 
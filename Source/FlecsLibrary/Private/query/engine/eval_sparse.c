@@ -88,8 +88,30 @@ next:
     }
 
     if (op->flags & (EcsQueryIsVar << EcsQuerySrc)) {
+        int32_t count = 1;
+
+        /* Return consecutive matching rows of a table variable as a single
+         * result, unless the caller needs the component value per entity. */
+        if (!ptr_out && 
+            ctx->query_vars[op->src.var].kind == EcsVarTable) 
+        {
+            const ecs_entity_t *entities = 
+                ecs_table_entities(op_ctx->range.table);
+            int32_t next_row = op_ctx->cur + 1;
+            for (; next_row < end; next_row ++) {
+                bool has = flecs_sparse_has(op_ctx->sparse, entities[next_row]);
+                if (has == not) {
+                    break;
+                }
+            }
+
+            count = next_row - op_ctx->cur;
+        }
+
         flecs_query_var_narrow_range(op->src.var, op_ctx->range.table, 
-            op_ctx->cur, 1, ctx);
+            op_ctx->cur, count, ctx);
+
+        op_ctx->cur += count - 1;
     }
 
     return true;
@@ -130,6 +152,27 @@ next:
         goto next;
     }
 
+    /* Entities that are stored next to each other in a table are returned as
+     * a single result. Rows that follow another row with the component are
+     * part of the result that starts at the first row of the run. */
+    ecs_table_t *table = range.table;
+    if (table) {
+        const ecs_entity_t *entities = ecs_table_entities(table);
+        int32_t row = range.offset;
+        if (row && flecs_sparse_has(op_ctx->sparse, entities[row - 1])) {
+            goto next;
+        }
+
+        int32_t end = ecs_table_count(table);
+        for (row ++; row < end; row ++) {
+            if (!flecs_sparse_has(op_ctx->sparse, entities[row])) {
+                break;
+            }
+        }
+
+        range.count = row - range.offset;
+    }
+
     flecs_query_var_set_range(op, op->src.var, 
         range.table, range.offset, range.count, ctx);
     it->ids[field_index] = id;
@@ -10,24 +10,6 @@ typedef struct {
     bool has_bitset;
 } flecs_query_row_mask_t;
 
-/* Portable count-trailing-zeros for 64-bit values. Input must be nonzero. */
-static inline int32_t flecs_ctz64(uint64_t v) {
-#if defined(__clang__) || defined(__GNUC__)
-    return (int32_t)__builtin_ctzll(v);
-#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
-    unsigned long idx;
-    _BitScanForward64(&idx, v);
-    return (int32_t)idx;
-#else
-    int32_t count = 0;
-    while ((v & 1u) == 0u) {
-        v >>= 1;
-        count ++;
-    }
-    return count;
-#endif
-}
-
 static
 flecs_query_row_mask_t flecs_query_get_row_mask(
     ecs_iter_t *it,
@@ -115,6 +97,105 @@ bool flecs_query_toggle_for_up(
     return true;
 }
 
+/* Combine the toggle bitsets of the fields for the entire range in one pass
+ * per field, instead of yielding the ranges in between disabled rows. The
+ * resulting mask is indexed by table row, which lets results with a single
+ * toggle field point directly at the bitset of the table. */
+static
+bool flecs_query_toggle_row_mask(
+    ecs_iter_t *it,
+    ecs_table_range_t range,
+    ecs_flags64_t and_fields,
+    ecs_flags64_t not_fields,
+    ecs_query_toggle_ctx_t *op_ctx,
+    ecs_query_run_ctx_t *ctx)
+{
+    ecs_table_t *table = range.table;
+    int32_t first_block = range.offset / 64;
+    int32_t last_block = (range.offset + range.count - 1) / 64;
+    int32_t i, b, field_count = it->field_count;
+    ecs_flags64_t fields = and_fields | not_fields;
+    const uint64_t *mask = NULL;
+    uint64_t *combined = NULL;
+
+    for (i = 0; i < field_count; i ++) {
+        uint64_t field_bit = 1llu << i;
+        if (!(fields & field_bit)) {
+            continue;
+        }
+
+        if (not_fields & field_bit) {
+            it->set_fields &= (ecs_termset_t)~field_bit;
+        }
+
+        ecs_bitset_t *bs = flecs_table_get_toggle(table, it->ids[i]);
+        if (!bs) {
+            if ((not_fields & field_bit) && 
+                (op_ctx->prev_set_fields & field_bit)) 
+            {
+                return false;
+            }
+            continue;
+        }
+
+        ecs_assert((64 * last_block) < bs->size, ECS_INTERNAL_ERROR, NULL);
+
+        if (!mask && !(not_fields & field_bit)) {
+            mask = bs->data;
+            continue;
+        }
+
+        if (!combined) {
+            ecs_allocator_t *a = flecs_query_get_allocator(it);
+            ecs_vec_init_if_t(&op_ctx->row_mask, uint64_t);
+            ecs_vec_set_count_t(a, &op_ctx->row_mask, uint64_t, last_block + 1);
+            combined = ecs_vec_first_t(&op_ctx->row_mask, uint64_t);
+            for (b = first_block; b <= last_block; b ++) {
+                combined[b] = mask ? mask[b] : UINT64_MAX;
+            }
+            mask = combined;
+        }
+
+        const uint64_t *data = bs->data;
+        if (not_fields & field_bit) {
+            for (b = first_block; b <= last_block; b ++) {
+                combined[b] &= ~data[b];
+            }
+        } else {
+            for (b = first_block; b <= last_block; b ++) {
+                combined[b] &= data[b];
+            }
+        }
+    }
+
+    if (!mask) {
+        /* No bitsets for fields, all rows match unless fields were negated */
+        return !not_fields;
+    }
+
+    /* Skip range if it has no enabled rows */
+    int32_t first_bit = range.offset - (first_block * 64);
+    int32_t last_bit = (range.offset + range.count) - (last_block * 64);
+    uint64_t low_mask = ~0ull << first_bit;
+    uint64_t high_mask = (last_bit == 64) ? UINT64_MAX : ((1ull << last_bit) - 1ull);
+    uint64_t any;
+    if (first_block == last_block) {
+        any = mask[first_block] & low_mask & high_mask;
+    } else {
+        any = (mask[first_block] & low_mask) | (mask[last_block] & high_mask);
+        for (b = first_block + 1; !any && b < last_block; b ++) {
+            any = mask[b];
+        }
+    }
+
+    if (!any) {
+        return false;
+    }
+
+    ctx->qit->row_mask = mask;
+    return true;
+}
+
 static
 bool flecs_query_toggle_cmp(
     const ecs_query_op_t *op,
@@ -175,6 +256,19 @@ bool flecs_query_toggle_cmp(
         }
     }
 
+    if ((ctx->query->pub.flags & EcsQueryToggleRowMask) && 
+        (op->kind != EcsQueryToggleOption)) 
+    {
+        if (redo || !flecs_query_toggle_row_mask(
+            it, range, and_fields, not_fields, op_ctx, ctx)) 
+        {
+            ctx->qit->row_mask = NULL;
+            it->set_fields = op_ctx->prev_set_fields;
+            return false;
+        }
+        return true;
+    }
+
     int32_t last, block_index, cur;
     uint64_t block = 0;
     if (!redo) {
@@ -300,6 +394,7 @@ bool flecs_query_toggle(
     ecs_query_toggle_ctx_t *op_ctx = flecs_op_ctx(ctx, toggle);
     if (!redo) {
         op_ctx->prev_set_fields = it->set_fields;
+        ctx->qit->row_mask = NULL;
     }
 
     ecs_flags64_t and_fields = op->first.entity;
@@ -309,6 +404,35 @@ bool flecs_query_toggle(
         op, redo, ctx, and_fields, not_fields);
 }
 
+bool flecs_query_toggle_and(
+    const ecs_query_op_t *op,
+    bool redo,
+    ecs_query_run_ctx_t *ctx)
+{
+    ecs_iter_t *it = ctx->it;
+    ecs_query_toggle_ctx_t *op_ctx = flecs_op_ctx(ctx, toggle);
+    if (!redo) {
+        op_ctx->prev_set_fields = it->set_fields;
+        ctx->qit->row_mask = NULL;
+    }
+
+    ecs_flags64_t and_fields = op->first.entity;
+
+    /* Fast path for tables without bitsets, which match all entities as long
+     * as the toggle fields are set and not matched through traversal. */
+    if (!(it->up_fields & and_fields)) {
+        ecs_table_t *table = flecs_query_get_table(
+            op, &op->src, EcsQuerySrc, ctx);
+        ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+        if (!(table->flags & EcsTableHasToggle)) {
+            return !redo && 
+                ((and_fields & op_ctx->prev_set_fields) == and_fields);
+        }
+    }
+
+    return flecs_query_toggle_cmp(op, redo, ctx, and_fields, 0);
+}
+
 bool flecs_query_toggle_option(
     const ecs_query_op_t *op,
     bool redo,
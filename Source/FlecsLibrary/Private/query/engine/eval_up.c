@@ -312,8 +312,19 @@ bool flecs_query_up_with(
 
         /* Get entry from up traversal cache. The up traversal cache contains 
          * the entity on which the component was found, with additional metadata
-         * on where it is stored. */
-        ecs_trav_up_t *up = flecs_query_get_up_cache(ctx, &impl->cache, 
+         * on where it is stored. If possible use the cache owned by the query,
+         * so that entries are reused across iterations. This isn't possible 
+         * if the query is iterated from multiple threads, or when the result
+         * can change without the entity changing tables (DontFragment). */
+        ecs_trav_up_cache_t *cache = &impl->cache;
+        if (ctx->query->up_caches && 
+            !(it->real_world->flags & EcsWorldMultiThreaded) &&
+            !(impl->cr_with->flags & EcsIdDontFragment))
+        {
+            cache = &ctx->query->up_caches[ctx->op_index];
+        }
+
+        ecs_trav_up_t *up = flecs_query_get_up_cache(ctx, cache, 
             range.table, impl->with, impl->trav, impl->cr_with,
             impl->cr_trav);
 
@@ -5,6 +5,9 @@
 
 #include "../../private_api.h"
 
+/* Minimum number of entries before a persistent cache evicts dead entries */
+#define FLECS_TRAV_UP_EVICT_MIN (64)
+
 static
 ecs_trav_up_t* flecs_trav_up_ensure(
     const ecs_query_run_ctx_t *ctx,
@@ -16,7 +19,11 @@ ecs_trav_up_t* flecs_trav_up_ensure(
     ecs_trav_up_t **trav = ecs_map_ensure_ref(
         &cache->src, ecs_trav_up_t, table_id);
     if (!trav[0]) {
-        trav[0] = flecs_iter_calloc_t(ctx->it, ecs_trav_up_t);
+        if (cache->persistent) {
+            trav[0] = flecs_calloc_t(cache->src.allocator, ecs_trav_up_t);
+        } else {
+            trav[0] = flecs_iter_calloc_t(ctx->it, ecs_trav_up_t);
+        }
     }
 
     ecs_os_perf_trace_pop("flecs.trav.up_ensure");
@@ -63,6 +70,109 @@ int32_t flecs_trav_type_offset_search(
     return -1;
 }
 
+/* Check if a persistent cache entry is still valid. An entry only depends on
+ * the table of the entity it was computed for, and on the entry of the target
+ * it inherited its result from. If the entity is still alive (with the same 
+ * generation), didn't move to another table and the target entry is valid and
+ * wasn't recomputed since, the entry can be reused without traversing. */
+static
+bool flecs_trav_up_is_valid(
+    const ecs_world_t *world,
+    ecs_trav_up_t *up)
+{
+    if (up->version == world->trav_version) {
+        return true;
+    }
+
+    if (up->multi_dep) {
+        return false;
+    }
+
+    if (!up->entity || !flecs_entities_is_alive(world, up->entity)) {
+        return false;
+    }
+
+    ecs_record_t *r = flecs_entities_get_any(world, up->entity);
+    ecs_table_t *table = r ? r->table : NULL;
+    if ((table ? table->id : 0) != up->table_id) {
+        return false;
+    }
+
+    if (up->dep) {
+        if (!flecs_trav_up_is_valid(world, up->dep)) {
+            return false;
+        }
+
+        if (up->dep->generation != up->dep_generation) {
+            return false;
+        }
+    }
+
+    up->version = world->trav_version;
+    return true;
+}
+
+/* Returns true if the entity of an entry, or of an entry it depends on, is no
+ * longer alive. Marks the entry as not ready so it is only checked once. */
+static
+bool flecs_trav_up_is_dead(
+    const ecs_world_t *world,
+    ecs_trav_up_t *up)
+{
+    if (!up->ready) {
+        return true;
+    }
+
+    if (!up->entity || !flecs_entities_is_alive(world, up->entity) ||
+        (up->dep && flecs_trav_up_is_dead(world, up->dep)))
+    {
+        up->ready = false;
+        return true;
+    }
+
+    return false;
+}
+
+/* Entries are keyed by entity index, so without eviction entries for deleted 
+ * entities would stay in a persistent cache until their id is recycled. Dead
+ * entries are evicted each time the cache doubles in size since the last 
+ * eviction, which keeps the cost amortized over the entries added. */
+static
+void flecs_trav_up_cache_evict(
+    const ecs_world_t *world,
+    ecs_trav_up_cache_t *cache)
+{
+    ecs_allocator_t *a = cache->src.allocator;
+    ecs_vec_t dead;
+    ecs_vec_init_t(a, &dead, ecs_map_key_t, 0);
+
+    ecs_map_iter_t it = ecs_map_iter(&cache->src);
+    while (ecs_map_next(&it)) {
+        ecs_trav_up_t *up = ecs_map_ptr(&it);
+        if (flecs_trav_up_is_dead(world, up)) {
+            ecs_vec_append_t(a, &dead, ecs_map_key_t)[0] = ecs_map_key(&it);
+        }
+    }
+
+    /* Entries are freed after all of them have been checked, as dependent 
+     * entries point to the entries they depend on. */
+    int32_t i, count = ecs_vec_count(&dead);
+    ecs_map_key_t *keys = ecs_vec_first_t(&dead, ecs_map_key_t);
+    for (i = 0; i < count; i ++) {
+        ecs_trav_up_t *up = ecs_map_get_deref(&cache->src, ecs_trav_up_t, 
+            keys[i]);
+        ecs_map_remove(&cache->src, keys[i]);
+        flecs_free_t(a, ecs_trav_up_t, up);
+    }
+
+    ecs_vec_fini_t(a, &dead, ecs_map_key_t);
+
+    cache->evict_count = 2 * ecs_map_count(&cache->src);
+    if (cache->evict_count < FLECS_TRAV_UP_EVICT_MIN) {
+        cache->evict_count = FLECS_TRAV_UP_EVICT_MIN;
+    }
+}
+
 static
 ecs_trav_up_t* flecs_trav_table_up(
     const ecs_query_run_ctx_t *ctx,
@@ -77,11 +187,25 @@ ecs_trav_up_t* flecs_trav_table_up(
 {
     ecs_trav_up_t *up = flecs_trav_up_ensure(ctx, cache, src);
     if (up->ready) {
-        return up;
+        if (!cache->persistent) {
+            return up;
+        }
+
+        if (flecs_trav_up_is_valid(world, up)) {
+            cache->hits ++;
+            return up;
+        }
+
+        uint32_t generation = up->generation;
+        ecs_os_zeromem(up);
+        up->generation = generation + 1;
     }
 
     ecs_os_perf_trace_push("flecs.trav.table_up");
 
+    ecs_trav_up_t *dep = NULL;
+    int32_t dep_count = 0;
+
     ecs_record_t *src_record = flecs_entities_get_any(world, src);
     ecs_table_t *table = src_record->table;
     if (!table) {
@@ -126,6 +250,8 @@ ecs_trav_up_t* flecs_trav_table_up(
 
             ecs_trav_up_t *up_parent = flecs_trav_table_up(ctx, a, cache,
                 world, tgt, with, rel, cr_with, cr_trav);
+            dep = up_parent;
+            dep_count ++;
             if (up_parent->tr) {
                 up->src = up_parent->src;
                 up->tr = up_parent->tr;
@@ -148,6 +274,8 @@ ecs_trav_up_t* flecs_trav_table_up(
 
                 ecs_trav_up_t *up_parent = flecs_trav_table_up(ctx, a, cache,
                     world, tgt, with, rel, cr_with, cr_trav);
+                dep = up_parent;
+                dep_count ++;
                 if (up_parent->tr) {
                     up->src = up_parent->src;
                     up->tr = up_parent->tr;
@@ -164,6 +292,16 @@ ecs_trav_up_t* flecs_trav_table_up(
 not_found:
     up->tr = NULL;
 found:
+    if (cache->persistent) {
+        up->entity = flecs_entities_get_alive(world, src);
+        up->table_id = table ? table->id : 0;
+        up->dep = dep_count == 1 ? dep : NULL;
+        up->dep_generation = up->dep ? up->dep->generation : 0;
+        up->multi_dep = dep_count > 1;
+        up->version = world->trav_version;
+        cache->rebuilds ++;
+    }
+
     up->ready = true;
     ecs_os_perf_trace_pop("flecs.trav.table_up");
     return up;
@@ -184,8 +322,17 @@ ecs_trav_up_t* flecs_query_get_up_cache(
 
     ecs_world_t *world = ctx->it->real_world;
     ecs_allocator_t *a = flecs_query_get_allocator(ctx->it);
+    if (cache->persistent) {
+        a = &ctx->query->stage->allocator;
+    }
     ecs_map_init_if(&cache->src, a);
 
+    if (cache->persistent && 
+        ecs_map_count(&cache->src) >= cache->evict_count) 
+    {
+        flecs_trav_up_cache_evict(world, cache);
+    }
+
     ecs_assert(cache->dir != EcsTravDown, ECS_INTERNAL_ERROR, NULL);
     cache->dir = EcsTravUp;
     cache->with = with;
@@ -215,5 +362,13 @@ ecs_trav_up_t* flecs_query_get_up_cache(
 void flecs_query_up_cache_fini(
     ecs_trav_up_cache_t *cache)
 {
+    if (cache->persistent) {
+        ecs_map_iter_t it = ecs_map_iter(&cache->src);
+        while (ecs_map_next(&it)) {
+            ecs_trav_up_t *up = ecs_map_ptr(&it);
+            flecs_free_t(cache->src.allocator, ecs_trav_up_t, up);
+        }
+    }
+
     ecs_map_fini(&cache->src);
 }
@@ -48,6 +48,16 @@ void flecs_query_rematch(
     ecs_world_t *world,
     ecs_query_t *q);
 
+/* Sort tables of query with order_by before a multithreaded pipeline op. The
+ * query is not sorted again until flecs_query_presort_end is called. */
+void flecs_query_presort_tables(
+    ecs_world_t *world,
+    ecs_query_t *q);
+
+/* End of the multithreaded op the query was presorted for */
+void flecs_query_presort_end(
+    ecs_query_t *q);
+
 /* Reclaim memory from queries */
 void flecs_query_reclaim(
     ecs_query_t *query);
@@ -92,6 +92,10 @@ typedef enum {
     EcsQuerySetId,          /* Set id if not set */
     EcsQueryContain,        /* Test if table contains entity */
     EcsQueryPairEq,         /* Test if both elements of pair are the same */
+    EcsQueryUpWith,         /* Up traversal for source written by previous op */
+    EcsQuerySelfUpWith,     /* Self|up traversal for source written by previous op */
+    EcsQueryNotWith,        /* Not block with a single With operation */
+    EcsQueryToggleAnd,      /* Toggle without Not fields */
     EcsQueryYield,          /* Yield result back to application */
     EcsQueryNothing         /* Must be last */
 } ecs_query_op_kind_t;
@@ -169,10 +173,17 @@ typedef struct {
     bool ready;
 } ecs_trav_down_t;
 
-typedef struct {
+typedef struct ecs_trav_up_t {
     ecs_entity_t src;
     ecs_id_t id;
     ecs_table_record_t *tr;
+    ecs_entity_t entity;         /* Entity for which the entry was computed */
+    uint64_t table_id;           /* Table of entity when entry was computed */
+    struct ecs_trav_up_t *dep;   /* Entry of target the result depends on */
+    uint32_t dep_generation;     /* Generation of dep when entry was computed */
+    uint32_t generation;         /* Increases each time entry is recomputed */
+    uint32_t version;            /* World trav_version entry was validated at */
+    bool multi_dep;              /* Result depends on more than one target */
     bool ready;
 } ecs_trav_up_t;
 
@@ -185,6 +196,10 @@ typedef struct {
     ecs_map_t src;        /* map<entity, trav_down_t> or map<table_id, trav_up_t> */
     ecs_id_t with;
     ecs_trav_direction_t dir;
+    bool persistent;      /* Owned by query, entries outlive the iterator */
+    int32_t evict_count;  /* Entry count at which dead entries are evicted */
+    int64_t hits;         /* Lookups answered by a valid persistent entry */
+    int64_t rebuilds;     /* Persistent entries (re)computed */
 } ecs_trav_up_cache_t;
 
 /* And up context */
@@ -299,6 +314,7 @@ typedef struct {
     ecs_termset_t prev_set_fields;
     bool optional_not;
     bool has_bitset;
+    ecs_vec_t row_mask; /* Combined bitsets for EcsQueryToggleRowMask */
 } ecs_query_toggle_ctx_t;
 
 typedef struct ecs_query_op_ctx_t {
@@ -370,8 +386,8 @@ struct ecs_query_impl_t {
     ecs_query_var_t *vars;        /* Variables */
     int32_t var_count;            /* Number of variables */
     int32_t var_size;             /* Size of variable array */
-    ecs_hashmap_t tvar_index;     /* Name index for table variables */
-    ecs_hashmap_t evar_index;     /* Name index for entity variables */
+    ecs_name_index_t tvar_index;  /* Name index for table variables */
+    ecs_name_index_t evar_index;  /* Name index for entity variables */
     ecs_var_id_t *src_vars;       /* Array with ids to source variables for fields */
 
     /* Query plan */
@@ -382,6 +398,8 @@ struct ecs_query_impl_t {
     int16_t tokens_len;           /* Length of tokens buffer */
     char *tokens;                 /* Buffer with string tokens used by terms */
     int32_t *monitor;             /* Change monitor for fields with fixed src */
+    ecs_trav_up_cache_t *up_caches; /* Up traversal caches that persist across
+                                     * iterations, indexed by operation */
 
 #ifdef FLECS_DEBUG
     ecs_termset_t final_terms;    /* Terms that don't use component inheritance */
@@ -224,6 +224,10 @@ const char* flecs_query_op_str(
     case EcsQuerySetId:          return "setid     ";
     case EcsQueryContain:        return "contain   ";
     case EcsQueryPairEq:         return "pair_eq   ";
+    case EcsQueryUpWith:         return "up_w      ";
+    case EcsQuerySelfUpWith:     return "selfup_w  ";
+    case EcsQueryNotWith:        return "not_w     ";
+    case EcsQueryToggleAnd:      return "toggle_and";
     case EcsQueryYield:          return "yield     ";
     case EcsQueryNothing:        return "nothing   ";
     default:                     return "!invalid  ";
@@ -343,6 +347,7 @@ void flecs_query_plan_w_profile(
         hidden_chars = flecs_query_op_ref_str(impl, &op->src, src_flags, buf);
 
         if (op->kind == EcsQueryNot || 
+            op->kind == EcsQueryNotWith || 
             op->kind == EcsQueryOr || 
             op->kind == EcsQueryOptional || 
             op->kind == EcsQueryIfVar ||
@@ -361,6 +366,7 @@ void flecs_query_plan_w_profile(
         }
 
         bool is_toggle = op->kind == EcsQueryToggle || 
+            op->kind == EcsQueryToggleAnd ||
             op->kind == EcsQueryToggleOption;
 
         if (!first_flags && !second_flags && !is_toggle) {
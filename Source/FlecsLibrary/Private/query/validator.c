@@ -1502,7 +1502,7 @@ int flecs_query_finalize_terms(
      * optimized logic as it doesn't have to deal with order_by edge cases */
     ECS_BIT_COND(q->flags, EcsQueryIsCacheable, 
         cacheable && (cacheable_terms == term_count) &&
-            !desc->order_by_callback);
+            !desc->order_by_callback && !desc->order_by_key_callback);
 
     /* If none of the terms match a source, the query matches nothing */
     ECS_BIT_COND(q->flags, EcsQueryMatchNothing, match_nothing);
@@ -1590,7 +1590,9 @@ bool flecs_query_finalize_simple(
         return false;
     }
 
-    if (desc->order_by_callback || desc->group_by_callback) {
+    if (desc->order_by_callback || desc->order_by_key_callback || 
+        desc->group_by_callback) 
+    {
         return false;
     }
 
@@ -559,6 +559,7 @@ ecs_component_record_t* flecs_component_new(
         cr->pair = flecs_bcalloc_w_dbg_info(
             &world->allocators.pair_record, "ecs_pair_record_t");
         cr->pair->reachable.current = -1;
+        cr->pair->propagate.version = world->propagate_version - 1;
 
         flecs_ordered_children_init(world, cr);
 
@@ -618,12 +619,12 @@ ecs_component_record_t* flecs_component_new(
         /* Flag for OnDeleteTarget policies */
         ecs_record_t *tgt_r = flecs_entities_get_any(world, tgt);
         ecs_assert(tgt_r != NULL, ECS_INTERNAL_ERROR, NULL);
-        flecs_record_add_flag(tgt_r, EcsEntityIsTarget);
+        flecs_record_add_flag(world, tgt_r, EcsEntityIsTarget);
 
         if (cr->flags & EcsIdTraversable) {
             /* Flag used to determine if object should be traversed when
              * propagating events or with super/subset queries */
-            flecs_record_add_flag(tgt_r, EcsEntityIsTraversable);
+            flecs_record_add_flag(world, tgt_r, EcsEntityIsTraversable);
 
             /* Add reference to (*, tgt) component record to entity record */
             tgt_r->cr = cr_t;
@@ -746,6 +747,10 @@ void flecs_component_free(
         flecs_name_index_free(cr->pair->name_index);
         ecs_vec_fini_t(&world->allocator, &cr->pair->reachable.ids, 
             ecs_reachable_elem_t);
+        ecs_vec_fini_t(&world->allocator, &cr->pair->propagate.tables, 
+            ecs_propagate_elem_t);
+        ecs_vec_fini_t(&world->allocator, &cr->pair->propagate.records, 
+            ecs_component_record_t*);
         flecs_bfree_w_dbg_info(&world->allocators.pair_record, 
                 cr->pair, "ecs_pair_record_t");
     }
@@ -855,6 +860,145 @@ void flecs_component_release_tables(
     }
 }
 
+bool flecs_component_in_use(
+    const ecs_component_record_t *cr)
+{
+    if (cr->flags & EcsIdDontFragment) {
+        return flecs_sparse_count(cr->sparse) != 0;
+    } else {
+        return cr->cache.tables.count != 0;
+    }
+}
+
+/* Can the record be released without anyone else holding on to it */
+static
+bool flecs_component_can_reclaim(
+    const ecs_world_t *world,
+    const ecs_component_record_t *cr)
+{
+    if (cr->refcount != 1) {
+        return false; /* Claimed by something other than the component index */
+    }
+
+    if (cr->flags & (EcsIdMarkedForDelete|EcsIdOrderedChildren)) {
+        return false;
+    }
+
+    if (cr == world->cr_childof_0 || cr == world->cr_identifier_name) {
+        return false;
+    }
+
+    return !flecs_component_in_use(cr);
+}
+
+void flecs_component_reclaim_enqueue(
+    ecs_world_t *world,
+    ecs_component_record_t *cr)
+{
+    ecs_id_t id = cr->id;
+    if (!ECS_IS_PAIR(id) || ecs_id_is_wildcard(id)) {
+        return;
+    }
+
+    if (world->flags & EcsWorldFini) {
+        return;
+    }
+
+    if (cr->flags & EcsIdReclaimQueued) {
+        return;
+    }
+
+    if (flecs_component_can_reclaim(world, cr)) {
+        ecs_vec_append_t(&world->allocator, &world->store.reclaim_ids, 
+            ecs_id_t)[0] = id;
+        cr->flags |= EcsIdReclaimQueued;
+    }
+}
+
+/* Clear the references to a (*, T) record that is released while T is alive.
+ * They are set again when T is used as target again. */
+static
+void flecs_component_reclaim_target(
+    ecs_world_t *world,
+    ecs_component_record_t *cr_t)
+{
+    ecs_entity_t tgt = flecs_entities_get_alive(
+        world, ECS_PAIR_SECOND(cr_t->id));
+    if (!tgt) {
+        return;
+    }
+
+    ecs_record_t *r = flecs_entities_get(world, tgt);
+    ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (r->cr == cr_t) {
+        r->cr = NULL;
+    }
+
+    /* No pairs with the target are left, so also no traversable pairs */
+    if (r->row & EcsEntityIsTraversable) {
+        ecs_assert(r->table != NULL, ECS_INTERNAL_ERROR, NULL);
+        flecs_table_traversable_add(world, r->table, -1);
+        r->row &= ~EcsEntityIsTraversable;
+    }
+
+    /* (Flag, T) records are not in the (*, T) list */
+    if (!flecs_components_get(world, ecs_pair(EcsFlag, tgt))) {
+        r->row &= ~EcsEntityIsTarget;
+    }
+}
+
+int32_t flecs_components_reclaim(
+    ecs_world_t *world,
+    int32_t max_count)
+{
+    ecs_vec_t *ids = &world->store.reclaim_ids;
+    int32_t count = ecs_vec_count(ids);
+    int32_t i, reclaimed = 0;
+
+    if (count > max_count) {
+        count = max_count;
+    }
+
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = ecs_vec_last_t(ids, ecs_id_t)[0];
+        ecs_vec_remove_last(ids);
+
+        /* The id may have been reclaimed already, or be in use again */
+        ecs_component_record_t *cr = flecs_components_get(world, id);
+        if (!cr) {
+            continue;
+        }
+
+        cr->flags &= ~EcsIdReclaimQueued;
+        if (!flecs_component_can_reclaim(world, cr)) {
+            continue;
+        }
+
+        /* Traversal and propagation caches may store the record */
+        if (cr->flags & EcsIdTraversable) {
+            world->trav_version ++;
+            world->propagate_version ++;
+        }
+
+        flecs_component_release(world, cr);
+        reclaimed ++;
+
+        /* Release (*, T) record once no pairs with the target are left */
+        cr = flecs_components_get(world, 
+            ecs_pair(EcsWildcard, ECS_PAIR_SECOND(id)));
+        if (cr && !cr->pair->second.next && 
+            flecs_component_can_reclaim(world, cr)) 
+        {
+            flecs_component_reclaim_target(world, cr);
+            flecs_component_release(world, cr);
+            reclaimed ++;
+        }
+    }
+
+    return reclaimed;
+}
+
 bool flecs_component_set_type_info(
     ecs_world_t *world,
     ecs_component_record_t *cr,
@@ -881,12 +1025,12 @@ bool flecs_component_set_type_info(
     return changed;
 }
 
-ecs_hashmap_t* flecs_component_name_index_ensure(
+ecs_name_index_t* flecs_component_name_index_ensure(
     ecs_world_t *world,
     ecs_component_record_t *cr)
 {
     ecs_assert(cr->pair != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_hashmap_t *map = cr->pair->name_index;
+    ecs_name_index_t *map = cr->pair->name_index;
     if (!map) {
         map = cr->pair->name_index = flecs_name_index_new(&world->allocator);
     }
@@ -894,7 +1038,7 @@ ecs_hashmap_t* flecs_component_name_index_ensure(
     return map;
 }
 
-ecs_hashmap_t* flecs_component_name_index_get(
+ecs_name_index_t* flecs_component_name_index_get(
     const ecs_world_t *world,
     ecs_component_record_t *cr)
 {
@@ -1005,7 +1149,7 @@ void flecs_component_shrink(
     ecs_pair_record_t *pr = cr->pair;
     if (pr) {
         if (pr->name_index) {
-            ecs_map_reclaim(&pr->name_index->impl);
+            flecs_name_index_reclaim(pr->name_index);
         }
     }
 }
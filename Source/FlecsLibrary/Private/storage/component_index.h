@@ -27,13 +27,26 @@ typedef struct ecs_reachable_cache_t {
     ecs_vec_t ids; /* vec<reachable_elem_t> */
 } ecs_reachable_cache_t;
 
+typedef struct ecs_propagate_elem_t {
+    ecs_table_t *table;
+    ecs_entity_t trav;
+} ecs_propagate_elem_t;
+
+/* Tables that events for a target are propagated to, in traversal order */
+typedef struct ecs_propagate_cache_t {
+    uint32_t version;   /* World propagate_version the cache was built at */
+    int32_t lock;       /* Is cache being iterated */
+    ecs_vec_t tables;   /* vec<ecs_propagate_elem_t> */
+    ecs_vec_t records;  /* vec<ecs_component_record_t*>, traversed pairs */
+} ecs_propagate_cache_t;
+
 /* Component index data that just applies to pairs */
 typedef struct ecs_pair_record_t {
     /* Name lookup index (currently only used for ChildOf pairs) */
-    ecs_hashmap_t *name_index;
+    ecs_name_index_t *name_index;
 
-    /* Vector with ordered children */
-    ecs_vec_t ordered_children;
+    /* Ordered children */
+    ecs_ordered_children_t ordered_children;
 
     /* Lists for all id records that match a pair wildcard. The wildcard id
      * record is at the head of the list. */
@@ -46,6 +59,9 @@ typedef struct ecs_pair_record_t {
 
     /* Cache for finding components that are reachable through a relationship */
     ecs_reachable_cache_t reachable;
+
+    /* Cache for tables that events are propagated to (for (*, T) records) */
+    ecs_propagate_cache_t propagate;
 } ecs_pair_record_t;
 
 /* Payload for id index which contains all data structures for an id. */
@@ -116,6 +132,20 @@ void flecs_component_release_tables(
     ecs_world_t *world,
     ecs_component_record_t *cr);
 
+/* Does component record have tables or sparse entities */
+bool flecs_component_in_use(
+    const ecs_component_record_t *cr);
+
+/* Queue unused pair record for release by flecs_components_reclaim */
+void flecs_component_reclaim_enqueue(
+    ecs_world_t *world,
+    ecs_component_record_t *cr);
+
+/* Release up to max_count queued pair records that are still unused */
+int32_t flecs_components_reclaim(
+    ecs_world_t *world,
+    int32_t max_count);
+
 /* Set (component) type info for component record */
 bool flecs_component_set_type_info(
     ecs_world_t *world,
@@ -135,12 +165,12 @@ ecs_component_record_t* flecs_component_trav_next(
     ecs_component_record_t *cr);
 
 /* Ensure name index for component record */
-ecs_hashmap_t* flecs_component_name_index_ensure(
+ecs_name_index_t* flecs_component_name_index_ensure(
     ecs_world_t *world,
     ecs_component_record_t *cr);
 
 /* Get name index for component record */
-ecs_hashmap_t* flecs_component_name_index_get(
+ecs_name_index_t* flecs_component_name_index_get(
     const ecs_world_t *world,
     ecs_component_record_t *cr);
 
@@ -1,6 +1,135 @@
 #include "../private_api.h"
 #include <inttypes.h>
 
+#ifdef FLECS_ENTITY_INDEX_FLAT
+
+static
+bool flecs_entity_index_is_committed(
+    const ecs_entity_index_t *index,
+    uint32_t page_index)
+{
+    int32_t word = (int32_t)(page_index >> 6);
+    if (word >= ecs_vec_count(&index->committed)) {
+        return false;
+    }
+
+    uint64_t bits = ecs_vec_get_t(&index->committed, uint64_t, word)[0];
+    return (bits & (1llu << (page_index & 63))) != 0;
+}
+
+static
+ecs_record_t* flecs_entity_index_ensure_record(
+    ecs_entity_index_t *index,
+    uint32_t id)
+{
+    uint32_t page_index = id >> FLECS_ENTITY_PAGE_BITS;
+    if (!flecs_entity_index_is_committed(index, page_index)) {
+#if FLECS_ENTITY_INDEX_FLAT_BITS < 32
+        ecs_assert((uint64_t)id < (1llu << FLECS_ENTITY_INDEX_FLAT_BITS),
+            ECS_OUT_OF_RANGE, 
+            "entity %u is outside of the range of the flat entity index "
+            "(FLECS_ENTITY_INDEX_FLAT_BITS is %d)", 
+                id, FLECS_ENTITY_INDEX_FLAT_BITS);
+#endif
+
+        /* Round out to OS pages. This can commit part of the neighbouring 
+         * entity pages, committing those again later is a noop. */
+        size_t first = (size_t)page_index * FLECS_ENTITY_PAGE_SIZE;
+        uintptr_t start = (uintptr_t)&index->records[first];
+        uintptr_t end = (uintptr_t)&index->records[
+            first + FLECS_ENTITY_PAGE_SIZE];
+        start &= ~(uintptr_t)(FLECS_ENTITY_INDEX_COMMIT_ALIGN - 1);
+        end = (end + FLECS_ENTITY_INDEX_COMMIT_ALIGN - 1) & 
+            ~(uintptr_t)(FLECS_ENTITY_INDEX_COMMIT_ALIGN - 1);
+
+        if (!ecs_os_vm_commit((void*)start, (size_t)(end - start))) {
+            ecs_abort(ECS_OUT_OF_MEMORY, 
+                "failed to commit memory for flat entity index");
+        }
+
+        int32_t word = (int32_t)(page_index >> 6);
+        ecs_vec_set_min_count_zeromem_t(index->allocator, &index->committed,
+            uint64_t, word + 1);
+        ecs_vec_get_t(&index->committed, uint64_t, word)[0] |= 
+            1llu << (page_index & 63);
+    }
+
+    return &index->records[id];
+}
+
+static
+ecs_record_t* flecs_entity_index_find_record(
+    const ecs_entity_index_t *index,
+    uint32_t id)
+{
+    if (!flecs_entity_index_is_committed(index, id >> FLECS_ENTITY_PAGE_BITS)) {
+        return NULL;
+    }
+
+    return &index->records[id];
+}
+
+void flecs_entity_index_init(
+    ecs_allocator_t *allocator,
+    ecs_entity_index_t *index)
+{
+    ecs_check(ecs_os_has_vm(), ECS_MISSING_OS_API, 
+        "flat entity index requires vm_reserve, vm_commit and vm_release");
+
+    /* Leave room for aligning the records, and for rounding out the commit of
+     * the last page */
+    uint64_t size = (1llu << FLECS_ENTITY_INDEX_FLAT_BITS) * 
+        sizeof(ecs_record_t) + FLECS_ENTITY_INDEX_RESERVE_ALIGN + 
+            FLECS_ENTITY_INDEX_COMMIT_ALIGN;
+    ecs_assert(size <= SIZE_MAX, ECS_INVALID_OPERATION, 
+        "FLECS_ENTITY_INDEX_FLAT_BITS is too large for the address space");
+
+    index->reserved_size = (size_t)size;
+    index->reserved = ecs_os_vm_reserve(index->reserved_size);
+    if (!index->reserved) {
+        ecs_abort(ECS_OUT_OF_MEMORY, 
+            "failed to reserve address space for flat entity index");
+    }
+
+    uintptr_t records = ((uintptr_t)index->reserved + 
+        FLECS_ENTITY_INDEX_RESERVE_ALIGN - 1) & 
+            ~(uintptr_t)(FLECS_ENTITY_INDEX_RESERVE_ALIGN - 1);
+    index->records = (ecs_record_t*)records;
+
+    index->allocator = allocator;
+    index->alive_count = 1;
+    ecs_vec_init_t(allocator, &index->dense, uint64_t, 1);
+    ecs_vec_set_count_t(allocator, &index->dense, uint64_t, 1);
+    ecs_vec_init_t(allocator, &index->committed, uint64_t, 0);
+error:
+    return;
+}
+
+void flecs_entity_index_fini(
+    ecs_entity_index_t *index)
+{
+    ecs_vec_fini_t(index->allocator, &index->dense, uint64_t);
+    ecs_vec_fini_t(index->allocator, &index->committed, uint64_t);
+    if (index->reserved) {
+        ecs_os_vm_release(index->reserved, index->reserved_size);
+    }
+}
+
+ecs_record_t* flecs_entity_index_get_any(
+    const ecs_entity_index_t *index,
+    uint64_t entity)
+{
+    uint32_t id = (uint32_t)entity;
+    ecs_assert(flecs_entity_index_find_record(index, id) != NULL,
+        ECS_INVALID_PARAMETER, "entity %u does not exist", id);
+    ecs_record_t *r = &index->records[id];
+    ecs_assert(r->dense != 0, ECS_INVALID_PARAMETER,
+        "entity %u does not exist", (uint32_t)entity);
+    return r;
+}
+
+#else
+
 static
 ecs_entity_index_page_t* flecs_entity_index_ensure_page(
     ecs_entity_index_t *index,
@@ -23,6 +152,35 @@ ecs_entity_index_page_t* flecs_entity_index_ensure_page(
     return page;
 }
 
+static
+ecs_record_t* flecs_entity_index_ensure_record(
+    ecs_entity_index_t *index,
+    uint32_t id)
+{
+    ecs_entity_index_page_t *page = flecs_entity_index_ensure_page(index, id);
+    ecs_assert(page != NULL, ECS_INTERNAL_ERROR, NULL);
+    return &page->records[id & FLECS_ENTITY_PAGE_MASK];
+}
+
+static
+ecs_record_t* flecs_entity_index_find_record(
+    const ecs_entity_index_t *index,
+    uint32_t id)
+{
+    int32_t page_index = (int32_t)(id >> FLECS_ENTITY_PAGE_BITS);
+    if (page_index >= ecs_vec_count(&index->pages)) {
+        return NULL;
+    }
+
+    ecs_entity_index_page_t *page = ecs_vec_get_t(&index->pages,
+        ecs_entity_index_page_t*, page_index)[0];
+    if (!page) {
+        return NULL;
+    }
+
+    return &page->records[id & FLECS_ENTITY_PAGE_MASK];
+}
+
 void flecs_entity_index_init(
     ecs_allocator_t *allocator,
     ecs_entity_index_t *index)
@@ -60,6 +218,8 @@ ecs_record_t* flecs_entity_index_get_any(
     return r;
 }
 
+#endif
+
 ecs_record_t* flecs_entity_index_get(
     const ecs_entity_index_t *index,
     uint64_t entity)
@@ -76,20 +236,8 @@ ecs_record_t* flecs_entity_index_try_get_any(
     const ecs_entity_index_t *index,
     uint64_t entity)
 {
-    uint32_t id = (uint32_t)entity;
-    int32_t page_index = (int32_t)(id >> FLECS_ENTITY_PAGE_BITS);
-    if (page_index >= ecs_vec_count(&index->pages)) {
-        return NULL;
-    }
-
-    ecs_entity_index_page_t *page = ecs_vec_get_t(&index->pages,
-        ecs_entity_index_page_t*, page_index)[0];
-    if (!page) {
-        return NULL;
-    }
-
-    ecs_record_t *r = &page->records[id & FLECS_ENTITY_PAGE_MASK];
-    if (!r->dense) {
+    ecs_record_t *r = flecs_entity_index_find_record(index, (uint32_t)entity);
+    if (!r || !r->dense) {
         return NULL;
     }
 
@@ -117,9 +265,7 @@ ecs_record_t* flecs_entity_index_ensure(
     uint64_t entity)
 {
     uint32_t id = (uint32_t)entity;
-    ecs_entity_index_page_t *page = flecs_entity_index_ensure_page(index, id);
-    ecs_assert(page != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_record_t *r = &page->records[id & FLECS_ENTITY_PAGE_MASK];
+    ecs_record_t *r = flecs_entity_index_ensure_record(index, id);
 
     int32_t dense = r->dense;
     if (dense) {
@@ -260,9 +406,7 @@ uint64_t flecs_entity_index_new_id(
 
     ecs_vec_append_t(index->allocator, &index->dense, uint64_t)[0] = id;
 
-    ecs_entity_index_page_t *page = flecs_entity_index_ensure_page(index, id);
-    ecs_assert(page != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_record_t *r = &page->records[id & FLECS_ENTITY_PAGE_MASK];
+    ecs_record_t *r = flecs_entity_index_ensure_record(index, id);
     r->dense = index->alive_count ++;
     ecs_assert(index->alive_count == ecs_vec_count(&index->dense),
         ECS_INTERNAL_ERROR, NULL);
@@ -302,9 +446,7 @@ uint64_t* flecs_entity_index_new_ids(
 
         int32_t dense = dense_count + i;
         ecs_vec_get_t(&index->dense, uint64_t, dense)[0] = id;
-        ecs_entity_index_page_t *page = flecs_entity_index_ensure_page(index, id);
-        ecs_assert(page != NULL, ECS_INTERNAL_ERROR, NULL);
-        ecs_record_t *r = &page->records[id & FLECS_ENTITY_PAGE_MASK];
+        ecs_record_t *r = flecs_entity_index_ensure_record(index, id);
         r->dense = dense;
     }
 
@@ -340,6 +482,16 @@ int32_t flecs_entity_index_not_alive_count(
 void flecs_entity_index_clear(
     ecs_entity_index_t *index)
 {
+#ifdef FLECS_ENTITY_INDEX_FLAT
+    int32_t i, count = ecs_vec_count(&index->committed) * 64;
+    for (i = 0; i < count; i ++) {
+        if (flecs_entity_index_is_committed(index, (uint32_t)i)) {
+            ecs_os_memset_n(
+                &index->records[(uint32_t)i * FLECS_ENTITY_PAGE_SIZE], 0,
+                ecs_record_t, FLECS_ENTITY_PAGE_SIZE);
+        }
+    }
+#else
     int32_t i, count = ecs_vec_count(&index->pages);
     ecs_entity_index_page_t **pages = ecs_vec_first_t(&index->pages,
         ecs_entity_index_page_t*);
@@ -349,6 +501,7 @@ void flecs_entity_index_clear(
             ecs_os_zeromem(page);
         }
     }
+#endif
 
     ecs_vec_set_count_t(index->allocator, &index->dense, uint64_t, 1);
 
@@ -356,6 +509,31 @@ void flecs_entity_index_clear(
     index->max_id = 0;
 }
 
+static
+bool flecs_entity_index_page_has_alive(
+    const ecs_entity_index_t *index,
+    const ecs_record_t *records,
+    int32_t page_index)
+{
+    int32_t e;
+    for (e = 0; e < FLECS_ENTITY_PAGE_SIZE; e ++) {
+        const ecs_record_t *r = &records[e];
+        ecs_entity_t entity = 
+            ((uint32_t)page_index * FLECS_ENTITY_PAGE_SIZE) + (uint32_t)e;
+
+        if (r->dense) {
+            ecs_assert(flecs_entity_index_get_any(index, entity) == r,
+                ECS_INTERNAL_ERROR, NULL);
+
+            if (flecs_entity_index_is_alive(index, entity)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 void flecs_entity_index_shrink(
     ecs_entity_index_t *index)
 {
@@ -363,7 +541,23 @@ void flecs_entity_index_shrink(
         index->allocator, &index->dense, uint64_t, index->alive_count);
     ecs_vec_reclaim_t(index->allocator, &index->dense, uint64_t);
 
-    int32_t i, e, max_page_index = 0, count = ecs_vec_count(&index->pages);
+#ifdef FLECS_ENTITY_INDEX_FLAT
+    /* Committed memory is kept, clear pages without alive entities so they
+     * are in the same state as a page that was freed. */
+    int32_t i, count = ecs_vec_count(&index->committed) * 64;
+    for (i = 0; i < count; i ++) {
+        if (!flecs_entity_index_is_committed(index, (uint32_t)i)) {
+            continue;
+        }
+
+        ecs_record_t *records = 
+            &index->records[(uint32_t)i * FLECS_ENTITY_PAGE_SIZE];
+        if (!flecs_entity_index_page_has_alive(index, records, i)) {
+            ecs_os_memset_n(records, 0, ecs_record_t, FLECS_ENTITY_PAGE_SIZE);
+        }
+    }
+#else
+    int32_t i, max_page_index = 0, count = ecs_vec_count(&index->pages);
     ecs_entity_index_page_t **pages = ecs_vec_first_t(&index->pages,
         ecs_entity_index_page_t*);
     for (i = 0; i < count; i ++) {
@@ -372,25 +566,7 @@ void flecs_entity_index_shrink(
             continue;
         }
 
-        bool has_alive = false;
-        for (e = 0; e < FLECS_ENTITY_PAGE_SIZE; e ++) {
-            ecs_record_t *r = &page->records[e];
-            ecs_entity_t entity = flecs_ito(uint64_t, (i * FLECS_ENTITY_PAGE_SIZE) + e);
-
-            if (r->dense) {
-                ecs_assert(flecs_entity_index_get_any(index, entity) == r,
-                    ECS_INTERNAL_ERROR, NULL);
-
-                if (flecs_entity_index_is_alive(index, entity)) {
-                    ecs_assert(flecs_entity_index_is_alive(index, entity),
-                        ECS_INTERNAL_ERROR, NULL);
-                    has_alive = true;
-                    break;
-                }
-            }
-        }
-
-        if (!has_alive) {
+        if (!flecs_entity_index_page_has_alive(index, page->records, i)) {
             ecs_os_free(pages[i]);
             pages[i] = NULL;
         } else {
@@ -402,10 +578,54 @@ void flecs_entity_index_shrink(
         index->allocator, &index->pages, ecs_entity_index_page_t*, 
         max_page_index + 1);
     ecs_vec_reclaim_t(index->allocator, &index->pages, ecs_entity_index_page_t*);
+#endif
 }
 
 const uint64_t* flecs_entity_index_ids(
     const ecs_entity_index_t *index)
 {
     return ecs_vec_get_t(&index->dense, uint64_t, 1);
+}
+
+void flecs_entity_index_try_get_n(
+    const ecs_entity_index_t *index,
+    const uint64_t *entities,
+    int32_t count,
+    ecs_record_t **records)
+{
+    const uint64_t *dense = ecs_vec_first_t(&index->dense, uint64_t);
+    int32_t alive_count = index->alive_count;
+    int32_t i, j;
+
+    /* Each lookup loads a record and then the dense array element it points
+     * to. Issue the loads for a batch of entities before using any of them,
+     * so the cache misses of the batch overlap. */
+    for (i = 0; i < count; i += FLECS_ENTITY_INDEX_BATCH_SIZE) {
+        int32_t end = i + FLECS_ENTITY_INDEX_BATCH_SIZE;
+        if (end > count) {
+            end = count;
+        }
+
+        for (j = i; j < end; j ++) {
+            flecs_entity_index_prefetch(index, entities[j]);
+        }
+
+        for (j = i; j < end; j ++) {
+            ecs_record_t *r = flecs_entity_index_try_get_any(
+                index, entities[j]);
+            if (r && r->dense < alive_count) {
+                flecs_prefetch(&dense[r->dense]);
+            } else {
+                r = NULL;
+            }
+            records[j] = r;
+        }
+
+        for (j = i; j < end; j ++) {
+            ecs_record_t *r = records[j];
+            if (r && dense[r->dense] != entities[j]) {
+                records[j] = NULL;
+            }
+        }
+    }
 }
\ No newline at end of file
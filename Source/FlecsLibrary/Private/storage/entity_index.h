@@ -11,13 +11,43 @@
 #define FLECS_ENTITY_PAGE_SIZE (1 << FLECS_ENTITY_PAGE_BITS)
 #define FLECS_ENTITY_PAGE_MASK (FLECS_ENTITY_PAGE_SIZE - 1)
 
+#ifdef FLECS_ENTITY_INDEX_FLAT
+/* Committed ranges are aligned to the largest common OS page size */
+#define FLECS_ENTITY_INDEX_COMMIT_ALIGN (64 * 1024)
+
+/* The reserved range is aligned so that it can be backed by huge pages */
+#define FLECS_ENTITY_INDEX_RESERVE_ALIGN (2 * 1024 * 1024)
+#endif
+
+/* Number of lookups that are interleaved by flecs_entity_index_try_get_n */
+#define FLECS_ENTITY_INDEX_BATCH_SIZE (16)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define flecs_prefetch(ptr) __builtin_prefetch(ptr)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define flecs_prefetch(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <intrin.h>
+#define flecs_prefetch(ptr) __prefetch(ptr)
+#else
+#define flecs_prefetch(ptr) (void)(ptr)
+#endif
+
 typedef struct ecs_entity_index_page_t {
     ecs_record_t records[FLECS_ENTITY_PAGE_SIZE];
 } ecs_entity_index_page_t;
 
 typedef struct ecs_entity_index_t {
     ecs_vec_t dense;
+#ifdef FLECS_ENTITY_INDEX_FLAT
+    ecs_record_t *records;   /* Records, indexed by entity id */
+    ecs_vec_t committed;     /* Bitset with committed pages */
+    void *reserved;          /* Start of reserved address range */
+    size_t reserved_size;
+#else
     ecs_vec_t pages;
+#endif
     int32_t alive_count;
     uint64_t max_id;
     ecs_allocator_t *allocator;
@@ -125,6 +155,36 @@ void flecs_entity_index_shrink(
 const uint64_t* flecs_entity_index_ids(
     const ecs_entity_index_t *index);
 
+/* Get entities (may not exist/must be alive). Records of entities that are not
+ * alive are set to NULL. Lookups are interleaved to hide memory latency. */
+void flecs_entity_index_try_get_n(
+    const ecs_entity_index_t *index,
+    const uint64_t *entities,
+    int32_t count,
+    ecs_record_t **records);
+
+/* Prefetch record of entity, if it exists */
+static inline
+void flecs_entity_index_prefetch(
+    const ecs_entity_index_t *index,
+    uint64_t entity)
+{
+    uint32_t id = (uint32_t)entity;
+#ifdef FLECS_ENTITY_INDEX_FLAT
+    /* Prefetching an address that isn't committed does not fault */
+    flecs_prefetch(&index->records[id]);
+#else
+    int32_t page_index = (int32_t)(id >> FLECS_ENTITY_PAGE_BITS);
+    if (page_index < index->pages.count) {
+        ecs_entity_index_page_t *page = 
+            ((ecs_entity_index_page_t**)index->pages.array)[page_index];
+        if (page) {
+            flecs_prefetch(&page->records[id & FLECS_ENTITY_PAGE_MASK]);
+        }
+    }
+#endif
+}
+
 #define ecs_eis(world) (&((world)->store.entity_index))
 #define flecs_entities_init(world) flecs_entity_index_init(&world->allocator, ecs_eis(world))
 #define flecs_entities_fini(world) flecs_entity_index_fini(ecs_eis(world))
@@ -147,5 +207,7 @@ const uint64_t* flecs_entity_index_ids(
 #define flecs_entities_not_alive_count(world) flecs_entity_index_not_alive_count(ecs_eis(world))
 #define flecs_entities_clear(world) flecs_entity_index_clear(ecs_eis(world))
 #define flecs_entities_ids(world) flecs_entity_index_ids(ecs_eis(world))
+#define flecs_entities_try_n(world, entities, count, records) flecs_entity_index_try_get_n(ecs_eis(world), entities, count, records)
+#define flecs_entities_prefetch(world, entity) flecs_entity_index_prefetch(ecs_eis(world), entity)
 
 #endif
\ No newline at end of file
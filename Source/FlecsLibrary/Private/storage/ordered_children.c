@@ -1,84 +1,266 @@
 #include "../private_api.h"
 
+static
+ecs_ordered_children_block_t* flecs_ordered_children_block_new(
+    ecs_world_t *world,
+    ecs_ordered_children_t *oc)
+{
+    ecs_ordered_children_block_t *block = flecs_alloc_t(
+        &world->allocator, ecs_ordered_children_block_t);
+    block->count = 0;
+    ecs_vec_append_t(&world->allocator, &oc->blocks,
+        ecs_ordered_children_block_t*)[0] = block;
+    return block;
+}
+
+static
+void flecs_ordered_children_block_free(
+    ecs_world_t *world,
+    ecs_ordered_children_t *oc,
+    int32_t index)
+{
+    ecs_ordered_children_block_t **blocks = ecs_vec_first_t(
+        &oc->blocks, ecs_ordered_children_block_t*);
+    flecs_free_t(&world->allocator, ecs_ordered_children_block_t,
+        blocks[index]);
+    ecs_vec_remove_ordered_t(&oc->blocks, ecs_ordered_children_block_t*, index);
+}
+
+static
+void flecs_ordered_children_index_block(
+    ecs_ordered_children_t *oc,
+    ecs_ordered_children_block_t *block,
+    int32_t from)
+{
+    int32_t i;
+    for (i = from; i < block->count; i ++) {
+        ecs_map_ensure(&oc->index, block->entities[i])[0] =
+            (ecs_map_val_t)(uintptr_t)block;
+    }
+}
+
+static
+void flecs_ordered_children_free_blocks(
+    ecs_world_t *world,
+    ecs_ordered_children_t *oc)
+{
+    ecs_ordered_children_block_t **blocks = ecs_vec_first_t(
+        &oc->blocks, ecs_ordered_children_block_t*);
+    int32_t i, count = ecs_vec_count(&oc->blocks);
+    for (i = 0; i < count; i ++) {
+        flecs_free_t(&world->allocator, ecs_ordered_children_block_t,
+            blocks[i]);
+    }
+
+    ecs_vec_clear(&oc->blocks);
+    ecs_map_fini(&oc->index);
+    oc->count = 0;
+    oc->flat_valid = false;
+}
+
+static
+ecs_ordered_children_block_t* flecs_ordered_children_find(
+    const ecs_ordered_children_t *oc,
+    ecs_entity_t e,
+    int32_t *row_out)
+{
+    ecs_ordered_children_block_t *block = NULL;
+    if (ecs_map_is_init(&oc->index)) {
+        block = ecs_map_get_deref(
+            &oc->index, ecs_ordered_children_block_t, e);
+    } else if (ecs_vec_count(&oc->blocks)) {
+        block = ecs_vec_first_t(
+            &oc->blocks, ecs_ordered_children_block_t*)[0];
+    }
+
+    if (block) {
+        int32_t i;
+        for (i = 0; i < block->count; i ++) {
+            if (block->entities[i] == e) {
+                *row_out = i;
+                return block;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static
+void flecs_ordered_children_append(
+    ecs_world_t *world,
+    ecs_ordered_children_t *oc,
+    ecs_entity_t e)
+{
+    ecs_ordered_children_block_t *block = NULL;
+    int32_t block_count = ecs_vec_count(&oc->blocks);
+    if (block_count) {
+        block = ecs_vec_last_t(
+            &oc->blocks, ecs_ordered_children_block_t*)[0];
+    }
+
+    if (!block || block->count == FLECS_ORDERED_CHILDREN_BLOCK_SIZE) {
+        if (block_count == 1) {
+            /* Children are no longer in a single block, start indexing */
+            ecs_map_init(&oc->index, &world->allocator);
+            flecs_ordered_children_index_block(oc, block, 0);
+        }
+
+        block = flecs_ordered_children_block_new(world, oc);
+    }
+
+    block->entities[block->count ++] = e;
+    if (ecs_map_is_init(&oc->index)) {
+        ecs_map_insert_ptr(&oc->index, e, block);
+    }
+
+    oc->count ++;
+    oc->flat_valid = false;
+}
+
+/* Merge a block that dropped below half its capacity with a neighbour, so that
+ * removing children doesn't leave behind long lists of nearly empty blocks. */
+static
+void flecs_ordered_children_merge(
+    ecs_world_t *world,
+    ecs_ordered_children_t *oc,
+    ecs_ordered_children_block_t *block)
+{
+    ecs_ordered_children_block_t **blocks = ecs_vec_first_t(
+        &oc->blocks, ecs_ordered_children_block_t*);
+    int32_t i, count = ecs_vec_count(&oc->blocks);
+    for (i = 0; i < count; i ++) {
+        if (blocks[i] == block) {
+            break;
+        }
+    }
+
+    ecs_assert(i != count, ECS_INTERNAL_ERROR, NULL);
+
+    if (!block->count) {
+        flecs_ordered_children_block_free(world, oc, i);
+    } else {
+        ecs_ordered_children_block_t *dst = NULL, *src = NULL;
+        int32_t src_index = 0;
+        if ((i + 1) < count) {
+            dst = block;
+            src = blocks[i + 1];
+            src_index = i + 1;
+        }
+
+        if ((!src || (dst->count + src->count) >
+            (FLECS_ORDERED_CHILDREN_BLOCK_SIZE / 2)) && i)
+        {
+            dst = blocks[i - 1];
+            src = block;
+            src_index = i;
+        }
+
+        if (!src || (dst->count + src->count) >
+            (FLECS_ORDERED_CHILDREN_BLOCK_SIZE / 2))
+        {
+            return;
+        }
+
+        int32_t dst_count = dst->count;
+        ecs_os_memcpy_n(&dst->entities[dst_count], src->entities,
+            ecs_entity_t, src->count);
+        dst->count += src->count;
+        flecs_ordered_children_index_block(oc, dst, dst_count);
+        flecs_ordered_children_block_free(world, oc, src_index);
+    }
+
+    if (ecs_vec_count(&oc->blocks) <= 1) {
+        /* Single block is searched directly */
+        ecs_map_fini(&oc->index);
+    }
+}
+
+static
+void flecs_ordered_children_remove(
+    ecs_world_t *world,
+    ecs_ordered_children_t *oc,
+    ecs_entity_t e)
+{
+    int32_t row;
+    ecs_ordered_children_block_t *block = flecs_ordered_children_find(
+        oc, e, &row);
+    if (!block) {
+        return;
+    }
+
+    if (ecs_map_is_init(&oc->index)) {
+        ecs_map_remove(&oc->index, e);
+    }
+
+    block->count --;
+    ecs_os_memmove_n(&block->entities[row], &block->entities[row + 1],
+        ecs_entity_t, (block->count - row));
+
+    oc->count --;
+    oc->flat_valid = false;
+
+    if (block->count <= (FLECS_ORDERED_CHILDREN_BLOCK_SIZE / 2)) {
+        flecs_ordered_children_merge(world, oc, block);
+    }
+}
+
 void flecs_ordered_children_init(
     ecs_world_t *world,
     ecs_component_record_t *cr)
 {
+    ecs_ordered_children_t *oc = &cr->pair->ordered_children;
     ecs_vec_init_t(
-        &world->allocator, &cr->pair->ordered_children, ecs_entity_t, 0);
+        &world->allocator, &oc->blocks, ecs_ordered_children_block_t*, 0);
+    ecs_vec_init_t(NULL, &oc->flat, ecs_entity_t, 0);
+    oc->count = 0;
+    oc->flat_valid = false;
 }
 
 void flecs_ordered_children_fini(
     ecs_world_t *world,
     ecs_component_record_t *cr)
 {
+    ecs_ordered_children_t *oc = &cr->pair->ordered_children;
+    flecs_ordered_children_free_blocks(world, oc);
     ecs_vec_fini_t(
-        &world->allocator, &cr->pair->ordered_children, ecs_entity_t);
+        &world->allocator, &oc->blocks, ecs_ordered_children_block_t*);
+    ecs_vec_fini_t(NULL, &oc->flat, ecs_entity_t);
 }
 
 void flecs_ordered_children_populate(
     ecs_world_t *world,
     ecs_component_record_t *cr)
-{    
-    ecs_vec_t *v = &cr->pair->ordered_children;
-    ecs_assert(ecs_vec_count(v) == 0, ECS_INTERNAL_ERROR, NULL);
+{
+    ecs_ordered_children_t *oc = &cr->pair->ordered_children;
+    ecs_assert(oc->count == 0, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(ECS_IS_PAIR(cr->id), ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(ECS_PAIR_FIRST(cr->id) ==  EcsChildOf, 
+    ecs_assert(ECS_PAIR_FIRST(cr->id) ==  EcsChildOf,
         ECS_INTERNAL_ERROR, NULL);
 
     ecs_iter_t it = ecs_each_id(world, cr->id);
     while (ecs_each_next(&it)) {
         int32_t i;
         for (i = 0; i < it.count; i ++) {
-            ecs_vec_append_t(
-                &world->allocator, v, ecs_entity_t)[0] = it.entities[i];
+            flecs_ordered_children_append(world, oc, it.entities[i]);
         }
     }
 }
 
 void flecs_ordered_children_clear(
+    ecs_world_t *world,
     ecs_component_record_t *cr)
-{    
-    ecs_vec_t *v = &cr->pair->ordered_children;
+{
     ecs_assert(ECS_IS_PAIR(cr->id), ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(ECS_PAIR_FIRST(cr->id) ==  EcsChildOf, 
+    ecs_assert(ECS_PAIR_FIRST(cr->id) ==  EcsChildOf,
         ECS_INTERNAL_ERROR, NULL);
 
-    ecs_vec_clear(v);
-}
-
-static
-void flecs_ordered_entities_append(
-    ecs_world_t *world,
-    ecs_pair_record_t *pair,
-    ecs_entity_t e)
-{
-    ecs_assert(pair != NULL, ECS_INTERNAL_ERROR, NULL);
-
-    ecs_vec_append_t(
-        &world->allocator, &pair->ordered_children, ecs_entity_t)[0] = e;
-}
-
-static
-void flecs_ordered_entities_remove(
-    ecs_pair_record_t *pair,
-    ecs_entity_t e)
-{
-    ecs_assert(pair != NULL, ECS_INTERNAL_ERROR, NULL);
-
-    ecs_vec_t *vec = &pair->ordered_children;
-    int32_t i, count = ecs_vec_count(vec);
-    ecs_entity_t *entities = ecs_vec_first_t(vec, ecs_entity_t);
-
-    for (i = 0; i < count; i ++) {
-        if (entities[i] == e) {
-            ecs_vec_remove_ordered_t(vec, ecs_entity_t, i);
-        }
-    }
+    flecs_ordered_children_free_blocks(world, &cr->pair->ordered_children);
 }
 
 static
 void flecs_ordered_entities_unparent_internal(
+    ecs_world_t *world,
     const ecs_table_t *table,
     const ecs_table_t *entities_table,
     int32_t row,
@@ -86,11 +268,12 @@ void flecs_ordered_entities_unparent_internal(
 {
     if (table && (table->flags & EcsTableHasOrderedChildren)) {
         ecs_pair_record_t *pair = table->_->childof_r;
+        ecs_assert(pair != NULL, ECS_INTERNAL_ERROR, NULL);
         const ecs_entity_t *entities = ecs_table_entities(entities_table);
         int32_t i = row, end = row + count;
         for (; i < end; i ++) {
             ecs_entity_t e = entities[i];
-            flecs_ordered_entities_remove(pair, e);
+            flecs_ordered_children_remove(world, &pair->ordered_children, e);
         }
     }
 }
@@ -102,15 +285,16 @@ void flecs_ordered_children_reparent(
     int32_t row,
     int32_t count)
 {
-    flecs_ordered_entities_unparent_internal(src, dst, row, count);
+    flecs_ordered_entities_unparent_internal(world, src, dst, row, count);
 
     if (dst->flags & EcsTableHasOrderedChildren) {
         ecs_pair_record_t *pair = dst->_->childof_r;
+        ecs_assert(pair != NULL, ECS_INTERNAL_ERROR, NULL);
         const ecs_entity_t *entities = ecs_table_entities(dst);
         int32_t i = row, end = row + count;
         for (; i < end; i ++) {
             ecs_entity_t e = entities[i];
-            flecs_ordered_entities_append(world, pair, e);
+            flecs_ordered_children_append(world, &pair->ordered_children, e);
         }
     }
 }
@@ -121,8 +305,7 @@ void flecs_ordered_children_unparent(
     int32_t row,
     int32_t count)
 {
-    (void)world;
-    flecs_ordered_entities_unparent_internal(src, src, row, count);
+    flecs_ordered_entities_unparent_internal(world, src, src, row, count);
 }
 
 void flecs_ordered_children_reorder(
@@ -131,63 +314,100 @@ void flecs_ordered_children_reorder(
     const ecs_entity_t *children,
     int32_t child_count)
 {
-    (void)world;
-
     ecs_component_record_t *cr = flecs_components_get(
         world, ecs_childof(parent));
 
-    ecs_check(cr != NULL, ECS_INVALID_PARAMETER, 
+    ecs_check(cr != NULL, ECS_INVALID_PARAMETER,
         "ecs_set_child_order() is called for parent '%s' which does not have "
-        "the OrderedChildren trait", 
+        "the OrderedChildren trait",
             flecs_errstr(ecs_get_path(world, parent)));
 
     ecs_check(cr->flags & EcsIdOrderedChildren, ECS_INVALID_PARAMETER,
         "ecs_set_child_order() is called for parent '%s' which does not have "
-        "the OrderedChildren trait", 
+        "the OrderedChildren trait",
             flecs_errstr(ecs_get_path(world, parent)));
 
-    ecs_vec_t *vec = &cr->pair->ordered_children;
-    ecs_entity_t *parent_children = ecs_vec_first_t(vec, ecs_entity_t);
-    int32_t parent_child_count = ecs_vec_count(vec);
-    ecs_check(parent_child_count == child_count, ECS_INVALID_PARAMETER,
+    ecs_ordered_children_t *oc = &cr->pair->ordered_children;
+    ecs_check(oc->count == child_count, ECS_INVALID_PARAMETER,
         "children provided to set_child_order() for parent '%s' do not match "
         "existing children",
             flecs_errstr(ecs_get_path(world, parent)));
 
-    (void)parent_child_count;
-
-    if (parent_children == children) {
-        return; /* Application is passing the existing children array. */
+    if (!child_count) {
+        return;
     }
 
     ecs_check(children != NULL, ECS_INVALID_PARAMETER, NULL);
-    ecs_assert(parent_children != NULL, ECS_INTERNAL_ERROR, NULL);
 
     #ifdef FLECS_DEBUG
     /* Make sure that the provided child ids equal the existing children */
-    int i, j;
+    int i;
     for (i = 0; i < child_count; i ++) {
-        ecs_entity_t child = parent_children[i];
-        for (j = 0; j < child_count; j ++) {
-            ecs_entity_t child_arg = children[j];
-            if (child == child_arg) {
-                break;
-            }
-        }
-
-        if (j == child_count) {
-            ecs_throw(ECS_INVALID_PARAMETER, 
+        int32_t row;
+        if (!flecs_ordered_children_find(oc, children[i], &row)) {
+            ecs_throw(ECS_INVALID_PARAMETER,
                 "children provided to set_child_order() for parent '%s' do not "
-                "match existing children (child '%s' is missing in provided "
-                "children vector)",
+                "match existing children (child '%s' is not a child)",
                     flecs_errstr(ecs_get_path(world, parent)),
-                    flecs_errstr_2(ecs_get_path(world, child)));
+                    flecs_errstr_2(ecs_get_path(world, children[i])));
         }
     }
     #endif
 
+    /* Application can pass the array returned by ecs_get_ordered_children(),
+     * which stays valid as it now has the new order. */
+    bool is_flat = oc->flat_valid && children == ecs_vec_first(&oc->flat);
+
     /* The actual operation. */
-    ecs_os_memcpy_n(parent_children, children, ecs_entity_t, child_count);
+    flecs_ordered_children_free_blocks(world, oc);
+
+    int32_t j;
+    for (j = 0; j < child_count; j ++) {
+        flecs_ordered_children_append(world, oc, children[j]);
+    }
+
+    oc->flat_valid = is_flat;
 error:
     return;
 }
+
+ecs_entities_t flecs_ordered_children_get(
+    ecs_world_t *world,
+    ecs_component_record_t *cr)
+{
+    ecs_ordered_children_t *oc = &cr->pair->ordered_children;
+
+    /* In multithreaded mode the array is built by the first thread that gets
+     * here after the children changed. */
+    bool multi_threaded = (world->flags & EcsWorldMultiThreaded) &&
+        world->ordered_children_lock;
+    if (multi_threaded) {
+        ecs_os_mutex_lock(world->ordered_children_lock);
+    }
+
+    if (!oc->flat_valid) {
+        ecs_vec_set_count_t(NULL, &oc->flat, ecs_entity_t, oc->count);
+        ecs_entity_t *dst = ecs_vec_first_t(&oc->flat, ecs_entity_t);
+
+        ecs_ordered_children_block_t **blocks = ecs_vec_first_t(
+            &oc->blocks, ecs_ordered_children_block_t*);
+        int32_t i, count = ecs_vec_count(&oc->blocks);
+        for (i = 0; i < count; i ++) {
+            ecs_os_memcpy_n(dst, blocks[i]->entities, ecs_entity_t,
+                blocks[i]->count);
+            dst += blocks[i]->count;
+        }
+
+        oc->flat_valid = true;
+    }
+
+    if (multi_threaded) {
+        ecs_os_mutex_unlock(world->ordered_children_lock);
+    }
+
+    return (ecs_entities_t){
+        .count = oc->count,
+        .alive_count = oc->count,
+        .ids = ecs_vec_first(&oc->flat),
+    };
+}
@@ -6,6 +6,26 @@
 #ifndef FLECS_ORDERED_CHILDREN_H
 #define FLECS_ORDERED_CHILDREN_H
 
+/* Maximum number of children stored in a single block. */
+#define FLECS_ORDERED_CHILDREN_BLOCK_SIZE (256)
+
+/* Block with a range of ordered children. Blocks are never empty. */
+typedef struct ecs_ordered_children_block_t {
+    int32_t count;
+    ecs_entity_t entities[FLECS_ORDERED_CHILDREN_BLOCK_SIZE];
+} ecs_ordered_children_block_t;
+
+/* Ordered children are stored in a list of blocks, so that adding or removing
+ * a child only moves the children of one block. Once there is more than one
+ * block, the index maps children to the block that stores them. */
+typedef struct ecs_ordered_children_t {
+    ecs_vec_t blocks;       /* vec<ecs_ordered_children_block_t*> */
+    ecs_map_t index;        /* map<entity, ecs_ordered_children_block_t*> */
+    ecs_vec_t flat;         /* vec<entity>, for ecs_get_ordered_children() */
+    int32_t count;          /* Total number of children */
+    bool flat_valid;        /* Does flat match the blocks */
+} ecs_ordered_children_t;
+
 /* Initialize ordered children storage. */
 void flecs_ordered_children_init(
     ecs_world_t *world,
@@ -23,6 +43,7 @@ void flecs_ordered_children_populate(
 
 /* Clear ordered children storage. */
 void flecs_ordered_children_clear(
+    ecs_world_t *world,
     ecs_component_record_t *cr);
 
 /* Reparent entities in ordered children storage. */
@@ -47,4 +68,9 @@ void flecs_ordered_children_reorder(
     const ecs_entity_t *children,
     int32_t child_count);
 
+/* Get ordered children as a single array. */
+ecs_entities_t flecs_ordered_children_get(
+    ecs_world_t *world,
+    ecs_component_record_t *cr);
+
 #endif
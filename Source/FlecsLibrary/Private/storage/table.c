@@ -700,7 +700,8 @@ void flecs_table_init(
 
     /* Now that all records have been added, copy them to array */
     int32_t i, dst_record_count = ecs_vec_count(records);
-    ecs_table_record_t *dst_tr = flecs_wdup_n(world, ecs_table_record_t, 
+    ecs_table_record_t *dst_tr = flecs_dup_n(
+        &world->allocators.table_records, ecs_table_record_t, 
         dst_record_count, ecs_vec_first_t(records, ecs_table_record_t));
     table->_->record_count = flecs_ito(int16_t, dst_record_count);
     table->_->records = dst_tr;
@@ -736,6 +737,11 @@ void flecs_table_init(
         /* Initialize event flags */
         table->flags |= cr->flags & EcsIdEventMask;
 
+        /* Table can receive events propagated through relationship */
+        if (cr->flags & EcsIdTraversable) {
+            world->propagate_version ++;
+        }
+
         /* Initialize column index (will be overwritten by init_data) */
         tr->column = -1;
 
@@ -810,11 +816,18 @@ void flecs_table_records_unregister(
             ECS_INTERNAL_ERROR, NULL);
         (void)id;
 
+        if (cr->flags & EcsIdTraversable) {
+            world->propagate_version ++;
+        }
+
         ecs_table_cache_remove(&cr->cache, table_id, &tr->hdr);
-        flecs_component_release(world, cr);
+        if (flecs_component_release(world, cr)) {
+            flecs_component_reclaim_enqueue(world, cr);
+        }
     }
 
-    flecs_wfree_n(world, ecs_table_record_t, count, table->_->records);
+    flecs_free_n(&world->allocators.table_records, ecs_table_record_t, 
+        count, table->_->records);
 }
 
 /* Keep track for what kind of builtin events observers are registered that can
@@ -1119,6 +1132,68 @@ void flecs_table_dtor_all(
 #define FLECS_LOCKED_STORAGE_MSG(operation) \
     "a " #operation " operation failed because the table is locked, fix by surrounding the operation with defer_begin()/defer_end()"
 
+/* Update entity counts of query groups that the table is in. Counts aren't
+ * maintained while the world is quitting, as tables and query caches are then
+ * deleted without notifying each other. */
+static
+void flecs_table_update_group_counts(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t delta)
+{
+    if (!(table->flags & EcsTableHasGroupCount) || !delta) {
+        return;
+    }
+
+    if (world->flags & EcsWorldQuit) {
+        return;
+    }
+
+    int32_t i, count = ecs_vec_count(&table->_->group_counts);
+    int32_t **counts = ecs_vec_first(&table->_->group_counts);
+    for (i = 0; i < count; i ++) {
+        counts[i][0] += delta;
+    }
+}
+
+void flecs_table_add_group_count(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t *count)
+{
+    ecs_vec_append_t(&world->allocator, &table->_->group_counts, 
+        int32_t*)[0] = count;
+    table->flags |= EcsTableHasGroupCount;
+    count[0] += ecs_table_count(table);
+}
+
+void flecs_table_remove_group_count(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t *count)
+{
+    if (world->flags & EcsWorldQuit) {
+        return;
+    }
+
+    ecs_vec_t *counts = &table->_->group_counts;
+    int32_t i, group_count = ecs_vec_count(counts);
+    int32_t **arr = ecs_vec_first(counts);
+    for (i = 0; i < group_count; i ++) {
+        if (arr[i] == count) {
+            ecs_vec_remove_t(counts, int32_t*, i);
+            break;
+        }
+    }
+
+    ecs_assert(i != group_count, ECS_INTERNAL_ERROR, NULL);
+    count[0] -= ecs_table_count(table);
+
+    if (group_count == 1) {
+        table->flags &= ~EcsTableHasGroupCount;
+    }
+}
+
 /* Cleanup table storage */
 static
 void flecs_table_fini_data(
@@ -1180,7 +1255,12 @@ void flecs_table_fini_data(
         table->data.size = 0;
     }
 
+    flecs_table_update_group_counts(world, table, -table->data.count);
     table->data.count = 0;
+    if (table->_->traversable_count) {
+        world->trav_version ++;
+        world->propagate_version ++;
+    }
     table->_->traversable_count = 0;
     table->flags &= ~EcsTableHasTraversable;
 }
@@ -1264,8 +1344,20 @@ void flecs_table_fini(
             &world->store.table_map, &ids, ecs_table_t*, table->_->hash);
     }
 
+    ecs_assert((world->flags & EcsWorldQuit) || 
+        !ecs_vec_count(&table->_->group_counts), ECS_INTERNAL_ERROR, NULL);
+    ecs_vec_fini_t(&world->allocator, &table->_->group_counts, int32_t*);
+
     flecs_table_fini_overrides(world, table);
     flecs_wfree_n(world, int32_t, table->column_count + 1, table->dirty_state);
+    if (table->_->dirty_rows) {
+        int32_t i, column_count = table->column_count;
+        for (i = 0; i < column_count; i ++) {
+            ecs_vec_fini_t(&world->allocator, &table->_->dirty_rows[i], int32_t);
+        }
+        flecs_free_n(&world->allocator, ecs_vec_t, column_count, 
+            table->_->dirty_rows);
+    }
     flecs_wfree_n(world, int16_t, table->column_count + table->type.count, 
         table->column_map);
     flecs_wfree_n(world, int16_t, FLECS_HI_COMPONENT_ID, table->component_map);
@@ -1313,9 +1405,17 @@ void flecs_table_reset(
  * traversable count and flag are used by code to early out of mechanisms like
  * event propagation and recursive cleanup. */
 void flecs_table_traversable_add(
+    ecs_world_t *world,
     ecs_table_t *table,
     int32_t value)
 {
+    /* Traversable entities entering or leaving a table can change the result
+     * of up traversals and event propagation, so invalidate their caches. */
+    if (value) {
+        world->trav_version ++;
+        world->propagate_version ++;
+    }
+
     int32_t result = table->_->traversable_count += value;
     ecs_assert(result >= 0, ECS_INTERNAL_ERROR, NULL);
     if (result == 0) {
@@ -1327,7 +1427,6 @@ void flecs_table_traversable_add(
 
 /* Mark table column dirty. This usually happens as the result of a set 
  * operation, or iteration of a query with [out] fields. */
-static
 void flecs_table_mark_table_dirty(
     ecs_world_t *world,
     ecs_table_t *table,
@@ -1338,6 +1437,7 @@ void flecs_table_mark_table_dirty(
     }
     if (!index) {
         flecs_increment_table_version(world, table);
+        world->table_count_version ++;
     }
 }
 
@@ -1345,7 +1445,8 @@ void flecs_table_mark_table_dirty(
 void flecs_table_mark_dirty(
     ecs_world_t *world,
     ecs_table_t *table,
-    ecs_entity_t component)
+    ecs_entity_t component,
+    int32_t row)
 {
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
 
@@ -1373,6 +1474,7 @@ void flecs_table_mark_dirty(
         /* Column is offset by 1, 0 is reserved for entity column. */
 
         table->dirty_state[column] ++;
+        flecs_table_mark_dirty_rows(table, column - 1, row, 1);
 
         ecs_assert(!table->_->lock, ECS_LOCKED_STORAGE, 
             FLECS_LOCKED_STORAGE_MSG("dirty marking"));
@@ -1398,6 +1500,99 @@ int32_t* flecs_table_get_dirty_state(
     return table->dirty_state;
 }
 
+/* Grow dirty row chunks of table to cover all rows. Chunks for rows added after
+ * tracking started are zero, as those rows are yielded because the table
+ * changed. Called by operations that add rows, which run on the main thread. */
+static
+void flecs_table_grow_dirty_rows(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_vec_t *dirty_rows = table->_->dirty_rows;
+    if (!dirty_rows) {
+        return;
+    }
+
+    int32_t i, column_count = table->column_count;
+    int32_t chunk_count = (ecs_table_count(table) + 
+        (1 << FLECS_DIRTY_ROWS_CHUNK_SHIFT) - 1) >> 
+            FLECS_DIRTY_ROWS_CHUNK_SHIFT;
+
+    for (i = 0; i < column_count; i ++) {
+        ecs_vec_set_min_count_zeromem_t(
+            &world->allocator, &dirty_rows[i], int32_t, chunk_count);
+    }
+}
+
+/* Start tracking dirty row chunks of table. Each column has a vector with a 
+ * stamp per chunk, which is the value of the column dirty state when the chunk
+ * was last written to. Used by queries that only iterate changed rows. Must be
+ * called on the main thread (when a table is matched), so that iterators and
+ * writes from worker threads never allocate chunks. */
+void flecs_table_init_dirty_rows(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_table__t *meta = table->_;
+    if (meta->dirty_rows) {
+        return;
+    }
+
+    int32_t *dirty_state = flecs_table_get_dirty_state(world, table);
+    int32_t i, column_count = table->column_count;
+    int32_t chunk_count = (ecs_table_count(table) + 
+        (1 << FLECS_DIRTY_ROWS_CHUNK_SHIFT) - 1) >> 
+            FLECS_DIRTY_ROWS_CHUNK_SHIFT;
+
+    meta->dirty_rows = flecs_calloc_n(
+        &world->allocator, ecs_vec_t, column_count);
+
+    /* Changes that happened before tracking started can't be attributed to
+     * rows, so stamp existing chunks with the current column state. */
+    for (i = 0; i < column_count; i ++) {
+        ecs_vec_t *chunks = &meta->dirty_rows[i];
+        int32_t c, stamp = dirty_state[i + 1];
+        ecs_vec_init_t(&world->allocator, chunks, int32_t, chunk_count);
+        ecs_vec_set_count_t(&world->allocator, chunks, int32_t, chunk_count);
+        int32_t *stamps = ecs_vec_first_t(chunks, int32_t);
+        for (c = 0; c < chunk_count; c ++) {
+            stamps[c] = stamp;
+        }
+    }
+}
+
+/* Mark rows of table column dirty. Must be called after the dirty state of the
+ * column is incremented. Only does something if rows are tracked for table. 
+ * Doesn't allocate, so it can be called from worker threads. */
+void flecs_table_mark_dirty_rows(
+    ecs_table_t *table,
+    int32_t column,
+    int32_t row,
+    int32_t count)
+{
+    ecs_vec_t *dirty_rows = table->_->dirty_rows;
+    if (!dirty_rows || !count) {
+        return;
+    }
+
+    ecs_assert(column >= 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(column < table->column_count, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(row >= 0, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_vec_t *chunks = &dirty_rows[column];
+    int32_t first = row >> FLECS_DIRTY_ROWS_CHUNK_SHIFT;
+    int32_t last = (row + count - 1) >> FLECS_DIRTY_ROWS_CHUNK_SHIFT;
+    ecs_assert(last < ecs_vec_count(chunks), ECS_INTERNAL_ERROR, NULL);
+
+    int32_t i, stamp = table->dirty_state[column + 1];
+    int32_t *stamps = ecs_vec_first_t(chunks, int32_t);
+    for (i = first; i <= last; i ++) {
+        stamps[i] = stamp;
+    }
+}
+
 /* Table move logic for bitset (toggle component) column */
 static
 void flecs_table_move_bitset_columns(
@@ -1588,6 +1783,8 @@ int32_t flecs_table_grow_data(
     table->data.entities = v_entities.array;
     table->data.count = v_entities.count;
     table->data.size = v_entities.size;
+    flecs_table_grow_dirty_rows(world, table);
+    flecs_table_update_group_counts(world, table, to_add);
 
     /* Initialize entity ids and record ptrs */
     int32_t i;
@@ -1700,6 +1897,8 @@ int32_t flecs_table_append(
         flecs_table_fast_append(world, table);
         table->data.count = v_entities.count;
         table->data.size = v_entities.size;
+        flecs_table_grow_dirty_rows(world, table);
+        flecs_table_update_group_counts(world, table, 1);
         ecs_os_perf_trace_pop("flecs.table.append");
         return count;
     }
@@ -1713,6 +1912,8 @@ int32_t flecs_table_append(
         ECS_INTERNAL_ERROR, NULL);
     table->data.count = v_entities.count;
     table->data.size = v_entities.size;
+    flecs_table_grow_dirty_rows(world, table);
+    flecs_table_update_group_counts(world, table, 1);
 
     /* Reobtain size to ensure that the columns have the same size as the 
      * entities and record vectors. This keeps reasoning about when allocations
@@ -1827,6 +2028,7 @@ void flecs_table_delete(
         }
 
         table->data.count --;
+        flecs_table_update_group_counts(world, table, -1);
 
         flecs_table_check_sanity(table);
         ecs_os_perf_trace_pop("flecs.table.delete");
@@ -1891,6 +2093,7 @@ void flecs_table_delete(
     }
 
     table->data.count --;
+    flecs_table_update_group_counts(world, table, -1);
 
     ecs_os_perf_trace_pop("flecs.table.delete");
     
@@ -2243,6 +2446,96 @@ void flecs_table_swap(
     ecs_os_perf_trace_pop("flecs.table.swap");
 }
 
+/* Reorder rows so that row i contains the entity previously stored at rows[i].
+ * Used for table sorting. Unlike flecs_table_swap this doesn't mark the table
+ * dirty, so different tables can be reordered from multiple threads. The 
+ * caller is responsible for marking the table dirty afterwards. */
+void flecs_table_reorder(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    const int32_t *rows)
+{
+    ecs_assert(!table->_->lock, ECS_LOCKED_STORAGE, 
+        FLECS_LOCKED_STORAGE_MSG("table reorder"));
+    ecs_assert(rows != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    int32_t i, count = ecs_table_count(table);
+    if (count < 2) {
+        return;
+    }
+
+    ecs_os_perf_trace_push("flecs.table.reorder");
+
+    /* Temporary buffer that can hold any column. Uses the OS allocator as the
+     * world allocator isn't thread safe. */
+    ecs_column_t *columns = table->data.columns;
+    int32_t c, column_count = table->column_count;
+    ecs_size_t max_size = ECS_SIZEOF(ecs_entity_t);
+    for (c = 0; c < column_count; c ++) {
+        max_size = ECS_MAX(max_size, columns[c].ti->size);
+    }
+
+    void *tmp = ecs_os_malloc(max_size * count);
+
+    /* Reorder entities & update records */
+    ecs_entity_t *entities = table->data.entities;
+    ecs_entity_t *tmp_entities = tmp;
+    for (i = 0; i < count; i ++) {
+        tmp_entities[i] = entities[rows[i]];
+    }
+
+    ecs_os_memcpy_n(entities, tmp_entities, ecs_entity_t, count);
+
+    for (i = 0; i < count; i ++) {
+        ecs_record_t *r = flecs_entities_get(world, entities[i]);
+        ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+        r->row = ECS_ROW_TO_RECORD(i, ECS_RECORD_TO_ROW_FLAGS(r->row));
+    }
+
+    /* Reorder components */
+    for (c = 0; c < column_count; c ++) {
+        ecs_column_t *column = &columns[c];
+        const ecs_type_info_t *ti = column->ti;
+        ecs_size_t size = ti->size;
+        void *data = column->data;
+
+        if (!ti->hooks.move) {
+            for (i = 0; i < count; i ++) {
+                ecs_os_memcpy(ECS_ELEM(tmp, size, i), 
+                    ECS_ELEM(data, size, rows[i]), size);
+            }
+            ecs_os_memcpy(data, tmp, size * count);
+        } else {
+            ecs_move_t move = ti->hooks.ctor_move_dtor;
+            ecs_assert(move != NULL, ECS_INTERNAL_ERROR, NULL);
+            for (i = 0; i < count; i ++) {
+                move(ECS_ELEM(tmp, size, i), 
+                    ECS_ELEM(data, size, rows[i]), 1, ti);
+            }
+            move(data, tmp, count, ti);
+        }
+    }
+
+    /* Reorder toggle bitsets */
+    ecs_bitset_t *bs_columns = table->_->bs_columns;
+    int32_t b, bs_count = table->_->bs_count;
+    for (b = 0; b < bs_count; b ++) {
+        ecs_bitset_t *bs = &bs_columns[b];
+        uint64_t *tmp_bits = tmp;
+        ecs_os_memcpy_n(tmp_bits, bs->data, uint64_t, (count + 63) >> 6);
+        for (i = 0; i < count; i ++) {
+            int32_t row = rows[i];
+            flecs_bitset_set(bs, i, 
+                (tmp_bits[row >> 6] & (1llu << (row & 63))) != 0);
+        }
+    }
+
+    ecs_os_free(tmp);
+
+    flecs_table_check_sanity(table);
+    ecs_os_perf_trace_pop("flecs.table.reorder");
+}
+
 static
 void flecs_table_merge_vec(
     ecs_world_t *world,
@@ -2416,9 +2709,15 @@ void flecs_table_merge_data(
     /* Mark columns as potentially reallocated */
     flecs_increment_table_column_version(world, dst_table);
 
+    flecs_table_update_group_counts(world, dst_table, 
+        dst_entities.count - dst_table->data.count);
+    flecs_table_update_group_counts(world, src_table, 
+        src_entities.count - src_table->data.count);
+
     dst_table->data.entities = dst_entities.array;
     dst_table->data.count = dst_entities.count;
     dst_table->data.size = dst_entities.size;
+    flecs_table_grow_dirty_rows(world, dst_table);
 
     src_table->data.entities = src_entities.array;
     src_table->data.count = src_entities.count;
@@ -2462,8 +2761,10 @@ void flecs_table_merge(
     flecs_table_merge_data(world, dst_table, src_table, dst_count, src_count);
 
     if (src_count) {
-        flecs_table_traversable_add(dst_table, src_table->_->traversable_count);
-        flecs_table_traversable_add(src_table, -src_table->_->traversable_count);
+        flecs_table_traversable_add(
+            world, dst_table, src_table->_->traversable_count);
+        flecs_table_traversable_add(
+            world, src_table, -src_table->_->traversable_count);
         ecs_assert(src_table->_->traversable_count == 0, ECS_INTERNAL_ERROR, NULL);
     }
 
@@ -2954,6 +3255,23 @@ error:
     return NULL;
 }
 
+void ecs_record_find_n(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_record_t **records)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(count >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || (entities && records), ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    flecs_entities_try_n(world, entities, count, records);
+error:
+    return;
+}
+
 char* ecs_table_str(
     const ecs_world_t *world,
     const ecs_table_t *table)
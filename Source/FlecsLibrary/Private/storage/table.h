@@ -94,6 +94,9 @@ typedef struct ecs_table_overrides_t {
     ecs_ref_t *refs;                 /* Refs to base components (one for each column) */
 } ecs_table_overrides_t;
 
+/* Number of rows per chunk for dirty row tracking (EcsQueryDirtyRows) */
+#define FLECS_DIRTY_ROWS_CHUNK_SHIFT (6)
+
 /** Infrequently accessed data not stored inline in ecs_table_t */
 typedef struct ecs_table__t {
     uint64_t hash;                   /* Type hash */
@@ -107,6 +110,9 @@ typedef struct ecs_table__t {
     int16_t bs_offset;
     ecs_bitset_t *bs_columns;        /* Bitset columns */
 
+    ecs_vec_t *dirty_rows;           /* Per column chunk stamps (vec<int32_t>) */
+    ecs_vec_t group_counts;          /* vec<int32_t*>, entity counts of query groups */
+
     struct ecs_table_record_t *records; /* Array with table records */
     ecs_pair_record_t *childof_r;       /* ChildOf pair data */
 
@@ -228,6 +234,30 @@ int32_t* flecs_table_get_dirty_state(
     ecs_world_t *world,
     ecs_table_t *table);
 
+/* Start tracking dirty row chunks for table columns */
+void flecs_table_init_dirty_rows(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+/* Keep entity count of query group up to date with table */
+void flecs_table_add_group_count(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t *count);
+
+/* Stop updating entity count of query group */
+void flecs_table_remove_group_count(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t *count);
+
+/* Mark rows of table column dirty */
+void flecs_table_mark_dirty_rows(
+    ecs_table_t *table,
+    int32_t column,
+    int32_t row,
+    int32_t count);
+
 /* Initialize root table */
 void flecs_init_root_table(
     ecs_world_t *world);
@@ -259,10 +289,23 @@ void flecs_table_swap(
     int32_t row_1,
     int32_t row_2);
 
+/* Reorder rows of table, doesn't mark table dirty */
+void flecs_table_reorder(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    const int32_t *rows);
+
+/* Mark table column dirty (0 is the entity column) */
+void flecs_table_mark_table_dirty(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t index);
+
 void flecs_table_mark_dirty(
     ecs_world_t *world,
     ecs_table_t *table,
-    ecs_entity_t component);
+    ecs_entity_t component,
+    int32_t row);
 
 void flecs_table_notify(
     ecs_world_t *world,
@@ -276,6 +319,7 @@ void flecs_table_delete_entities(
 
 /* Increase observer count of table */
 void flecs_table_traversable_add(
+    ecs_world_t *world,
     ecs_table_t *table,
     int32_t value);
 
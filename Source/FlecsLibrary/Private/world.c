@@ -376,45 +376,115 @@ ecs_stage_t* flecs_stage_from_world(
     return ECS_CONST_CAST(ecs_stage_t*, world);
 }
 
+/* Add query to the list of queries that still need to be rematched. Until the
+ * query is rematched its cache can contain stale (but valid) results. */
+static
+void flecs_monitor_defer_rematch(
+    ecs_world_t *world,
+    ecs_query_t *q)
+{
+    ecs_query_cache_t *cache = flecs_query_impl(q)->cache;
+    ecs_assert(cache != NULL, ECS_INTERNAL_ERROR, NULL);
+    if (cache->rematch_pending) {
+        return;
+    }
+
+    cache->rematch_pending = true;
+    ecs_vec_append_t(&world->allocator, &world->monitors.pending, 
+        ecs_query_t*)[0] = q;
+}
+
+/* Rematch deferred queries in the order they were deferred until the rematch
+ * budget runs out. Queries are independent from each other, so a query is the
+ * unit of work. At least one query is rematched per call so that a query that
+ * takes longer than the budget can't stall rematching. */
+static
+void flecs_eval_deferred_rematch(
+    ecs_world_t *world)
+{
+    ecs_vec_t *pending = &world->monitors.pending;
+    if (!ecs_vec_count(pending)) {
+        return;
+    }
+
+    ecs_os_perf_trace_push("flecs.component_monitor.deferred_rematch");
+
+    ecs_ftime_t budget = world->monitors.rematch_budget;
+    ecs_ftime_t elapsed = 0;
+    ecs_time_t t = {0};
+    if (budget > 0) {
+        ecs_time_measure(&t);
+    }
+
+    bool first = true;
+    while (ecs_vec_count(pending)) {
+        if (!first && budget > 0 && elapsed >= budget) {
+            break;
+        }
+
+        /* Remove query before rematching, as rematching can invoke callbacks
+         * that modify the list. */
+        ecs_query_t *q = ecs_vec_first_t(pending, ecs_query_t*)[0];
+        ecs_vec_remove_ordered_t(pending, ecs_query_t*, 0);
+        flecs_query_impl(q)->cache->rematch_pending = false;
+        flecs_query_rematch(world, q);
+
+        if (budget > 0) {
+            elapsed += (ecs_ftime_t)ecs_time_measure(&t);
+        }
+
+        first = false;
+    }
+
+    if (!ecs_vec_count(pending)) {
+        ecs_vec_fini_t(&world->allocator, pending, ecs_query_t*);
+    }
+
+    ecs_os_perf_trace_pop("flecs.component_monitor.deferred_rematch");
+}
+
 /* Evaluate component monitor. If a monitored entity changed it will have set a
  * flag in one of the world's component monitors. Queries can register
  * themselves with component monitors to determine whether they need to rematch
- * with tables. */
+ * with tables. With a rematch budget, dirty queries are only queued. */
 static
 void flecs_eval_component_monitor(
     ecs_world_t *world)
 {
     flecs_poly_assert(world, ecs_world_t);
 
-    if (!world->monitors.is_dirty) {
-        return;
-    }
+    if (world->monitors.is_dirty) {
+        world->info.eval_comp_monitors_total ++;
 
-    world->info.eval_comp_monitors_total ++;
+        ecs_os_perf_trace_push("flecs.component_monitor.eval");
 
-    ecs_os_perf_trace_push("flecs.component_monitor.eval");
+        world->monitors.is_dirty = false;
+        bool defer = world->monitors.rematch_budget > 0;
 
-    world->monitors.is_dirty = false;
+        ecs_map_iter_t it = ecs_map_iter(&world->monitors.monitors);
+        while (ecs_map_next(&it)) {
+            ecs_monitor_t *m = ecs_map_ptr(&it);
+            if (!m->is_dirty) {
+                continue;
+            }
 
-    ecs_map_iter_t it = ecs_map_iter(&world->monitors.monitors);
-    while (ecs_map_next(&it)) {
-        ecs_monitor_t *m = ecs_map_ptr(&it);
-        if (!m->is_dirty) {
-            continue;
+            m->is_dirty = false;
+
+            int32_t i, count = ecs_vec_count(&m->queries);
+            ecs_query_t **elems = ecs_vec_first(&m->queries);
+            for (i = 0; i < count; i ++) {
+                ecs_query_t *q = elems[i];
+                flecs_poly_assert(q, ecs_query_t);
+                if (defer) {
+                    flecs_monitor_defer_rematch(world, q);
+                } else {
+                    flecs_query_rematch(world, q);
+                }
+            }
         }
 
-        m->is_dirty = false;
-
-        int32_t i, count = ecs_vec_count(&m->queries);
-        ecs_query_t **elems = ecs_vec_first(&m->queries);
-        for (i = 0; i < count; i ++) {
-            ecs_query_t *q = elems[i];
-            flecs_poly_assert(q, ecs_query_t);
-            flecs_query_rematch(world, q);
-        }
+        ecs_os_perf_trace_pop("flecs.component_monitor.eval");
     }
-
-    ecs_os_perf_trace_pop("flecs.component_monitor.eval");
 }
 
 static
@@ -497,6 +567,53 @@ void flecs_monitor_unregister(
     }
 }
 
+void flecs_monitor_cancel_rematch(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_vec_t *pending = &world->monitors.pending;
+    int32_t i, count = ecs_vec_count(pending);
+    ecs_query_t **queries = ecs_vec_first(pending);
+    for (i = 0; i < count; i ++) {
+        if (queries[i] == query) {
+            ecs_vec_remove_ordered_t(pending, ecs_query_t*, i);
+            break;
+        }
+    }
+
+    if (!ecs_vec_count(pending)) {
+        ecs_vec_fini_t(&world->allocator, pending, ecs_query_t*);
+    }
+}
+
+void flecs_monitor_replace_query(
+    ecs_world_t *world,
+    ecs_query_t *query,
+    ecs_query_t *with)
+{
+    flecs_poly_assert(with, ecs_query_t);
+
+    ecs_map_iter_t it = ecs_map_iter(&world->monitors.monitors);
+    while (ecs_map_next(&it)) {
+        ecs_monitor_t *m = ecs_map_ptr(&it);
+        int32_t i, count = ecs_vec_count(&m->queries);
+        ecs_query_t **queries = ecs_vec_first(&m->queries);
+        for (i = 0; i < count; i ++) {
+            if (queries[i] == query) {
+                queries[i] = with;
+            }
+        }
+    }
+
+    int32_t i, count = ecs_vec_count(&world->monitors.pending);
+    ecs_query_t **queries = ecs_vec_first(&world->monitors.pending);
+    for (i = 0; i < count; i ++) {
+        if (queries[i] == query) {
+            queries[i] = with;
+        }
+    }
+}
+
 /* Updating component monitors is a relatively expensive operation that only
  * happens for entities that are monitored. The approach balances the amount of
  * processing between the operation on the entity vs the amount of work that
@@ -544,6 +661,7 @@ void flecs_init_store(
     ecs_vec_init_t(a, &world->store.records, ecs_table_record_t, 0);
     ecs_vec_init_t(a, &world->store.marked_ids, ecs_marked_id_t, 0);
     ecs_vec_init_t(a, &world->store.deleted_components, ecs_entity_t, 0);
+    ecs_vec_init_t(a, &world->store.reclaim_ids, ecs_id_t, 0);
 
     /* Initialize entity index */
     flecs_entities_init(world);
@@ -692,6 +810,7 @@ void flecs_fini_store(ecs_world_t *world) {
     ecs_vec_fini_t(a, &world->store.records, ecs_table_record_t);
     ecs_vec_fini_t(a, &world->store.marked_ids, ecs_marked_id_t);
     ecs_vec_fini_t(a, &world->store.deleted_components, ecs_entity_t);
+    ecs_vec_fini_t(a, &world->store.reclaim_ids, ecs_id_t);
 }
 
 static 
@@ -708,6 +827,7 @@ void flecs_world_allocators_init(
     flecs_ballocator_init_t(&a->pair_record, ecs_pair_record_t);
     flecs_ballocator_init_t(&a->table_diff, ecs_table_diff_t);
     flecs_ballocator_init_n(&a->sparse_chunk, int32_t, FLECS_SPARSE_PAGE_SIZE);
+    flecs_allocator_init(&a->table_records);
     flecs_table_diff_builder_init(world, &world->allocators.diff_builder);
 }
 
@@ -723,6 +843,7 @@ void flecs_world_allocators_fini(
     flecs_ballocator_fini(&a->pair_record);
     flecs_ballocator_fini(&a->table_diff);
     flecs_ballocator_fini(&a->sparse_chunk);
+    flecs_allocator_fini(&a->table_records);
     flecs_table_diff_builder_fini(world, &world->allocators.diff_builder);
 
     flecs_allocator_fini(&world->allocator);
@@ -872,6 +993,10 @@ static const char *flecs_compiler_flags[] = {
 #ifdef FLECS_ENTITY_PAGE_BITS
     "FLECS_ENTITY_PAGE_BITS=" ECS_STRINGIFY(FLECS_ENTITY_PAGE_BITS),
 #endif
+#ifdef FLECS_ENTITY_INDEX_FLAT
+    "FLECS_ENTITY_INDEX_FLAT",
+    "FLECS_ENTITY_INDEX_FLAT_BITS=" ECS_STRINGIFY(FLECS_ENTITY_INDEX_FLAT_BITS),
+#endif
 #ifdef FLECS_SPARSE_PAGE_BITS
     "FLECS_SPARSE_PAGE_BITS=" ECS_STRINGIFY(FLECS_SPARSE_PAGE_BITS),
 #endif
@@ -1021,6 +1146,10 @@ ecs_world_t *ecs_mini(void) {
     ecs_vec_init_t(a, &world->fini_actions, ecs_action_elem_t, 0);
     ecs_vec_init_t(a, &world->component_ids, ecs_id_t, 0);
 
+    if (ecs_os_has_threading()) {
+        world->ordered_children_lock = ecs_os_mutex_new();
+    }
+
     world->info.time_scale = 1.0;
     if (ecs_os_has_time()) {
         ecs_os_get_time(&world->world_start_time);
@@ -1325,6 +1454,13 @@ int ecs_fini(
     flecs_observable_fini(&world->observable);
     flecs_name_index_fini(&world->aliases);
     flecs_name_index_fini(&world->symbols);
+    ecs_map_fini(&world->shared_caches);
+    ecs_vec_fini_t(&world->allocator, &world->observer_batches, 
+        ecs_observer_batch_t);
+    ecs_map_fini(&world->observer_batch_index);
+    if (world->ordered_children_lock) {
+        ecs_os_mutex_free(world->ordered_children_lock);
+    }
     ecs_set_stage_count(world, 0);
     ecs_vec_fini_t(&world->allocator, &world->component_ids, ecs_id_t);
     ecs_log_pop_1();
@@ -1362,6 +1498,26 @@ void flecs_eval_component_monitors(
 {
     flecs_poly_assert(world, ecs_world_t); 
     flecs_eval_component_monitor(world);
+    flecs_eval_deferred_rematch(world);
+}
+
+void flecs_eval_query_monitors(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    flecs_poly_assert(world, ecs_world_t); 
+    flecs_eval_component_monitor(world);
+
+    /* Don't return stale results if rematch was deferred. Other queued queries
+     * are left to the next merge, so that they don't use up the time of the 
+     * code iterating this query. Pending rematches are registered for the 
+     * owner of a shared cache. */
+    ecs_query_cache_t *cache = flecs_query_impl(query)->cache;
+    if (cache->rematch_pending) {
+        flecs_monitor_cancel_rematch(world, &cache->owner->pub);
+        cache->rematch_pending = false;
+        flecs_query_rematch(world, query);
+    }
 }
 
 void ecs_measure_frame_time(
@@ -1402,6 +1558,31 @@ error:
     return;
 }
 
+void ecs_set_rematch_budget(
+    ecs_world_t *world,
+    ecs_ftime_t budget)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ecs_check(budget <= 0 || ecs_os_has_time(), ECS_MISSING_OS_API, NULL);
+    world->monitors.rematch_budget = budget;
+error:
+    return;
+}
+
+ecs_ftime_t ecs_get_rematch_budget(
+    const ecs_world_t *world)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    return world->monitors.rematch_budget;
+}
+
+int32_t ecs_get_pending_rematch_count(
+    const ecs_world_t *world)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    return ecs_vec_count(&world->monitors.pending);
+}
+
 void ecs_set_default_query_flags(
     ecs_world_t *world,
     ecs_flags32_t flags)
@@ -1726,6 +1907,19 @@ int32_t ecs_delete_empty_tables(
         time_budget = true;
     }
 
+    /* Release pair records that lost their last table before this call and 
+     * weren't reused since. */
+    while (ecs_vec_count(&world->store.reclaim_ids)) {
+        flecs_components_reclaim(world, 100);
+
+        if (time_budget) {
+            cur = start;
+            if (ecs_time_measure(&cur) > time_budget_seconds) {
+                goto done;
+            }
+        }
+    }
+
     int32_t i, count = flecs_sparse_count(&world->store.tables);
 
     for (i = count - 1; i >= 0; i --) {
@@ -1785,17 +1979,6 @@ ecs_flags32_t ecs_world_get_flags(
     }
 }
 
-static
-bool flecs_component_record_in_use(
-    const ecs_component_record_t *cr)
-{
-    if (cr->flags & EcsIdDontFragment) {
-        return flecs_sparse_count(cr->sparse) != 0;
-    } else {
-        return cr->cache.tables.count != 0;
-    }
-}
-
 void ecs_shrink(
     ecs_world_t *world)
 {
@@ -1823,7 +2006,7 @@ void ecs_shrink(
     flecs_sparse_shrink(&world->store.tables);
 
     FLECS_EACH_COMPONENT_RECORD(cr, {
-        if (flecs_component_record_in_use(cr)) {
+        if (flecs_component_in_use(cr)) {
             flecs_component_shrink(cr);
         } else {
             if (cr->id != EcsAny && cr->id != ecs_isa(EcsWildcard)) {
@@ -1832,6 +2015,10 @@ void ecs_shrink(
         }
     })
 
+    /* Unused records have been released, no need to revisit them */
+    ecs_vec_clear(&world->store.reclaim_ids);
+    ecs_vec_reclaim_t(&world->allocator, &world->store.reclaim_ids, ecs_id_t);
+
     FLECS_EACH_QUERY(query, {
         flecs_query_reclaim(query);
     })
@@ -12,6 +12,12 @@
 /* The number of table versions to split tables across */
 #define ECS_TABLE_VERSION_ARRAY_SIZE (ECS_TABLE_VERSION_ARRAY_BITMASK + 1)
 
+/* The bitmask used when determining the name version array index */
+#define ECS_NAME_VERSION_ARRAY_BITMASK (0xff)
+
+/* The number of name versions to split entity names across */
+#define ECS_NAME_VERSION_ARRAY_SIZE (ECS_NAME_VERSION_ARRAY_BITMASK + 1)
+
 /* World level allocators are for operations that are not multithreaded */
 typedef struct ecs_world_allocators_t {
     ecs_block_allocator_t graph_edge_lo;
@@ -21,6 +27,9 @@ typedef struct ecs_world_allocators_t {
     ecs_block_allocator_t table_diff;
     ecs_block_allocator_t sparse_chunk;
 
+    /* Table record arrays, pooled by size class */
+    ecs_allocator_t table_records;
+
     /* Temporary vectors used for creating table diff id sequences */
     ecs_table_diff_builder_t diff_builder;
 } ecs_world_allocators_t;
@@ -34,6 +43,8 @@ typedef struct ecs_monitor_t {
 /* Component monitors */
 typedef struct ecs_monitor_set_t {
     ecs_map_t monitors;              /* map<id, ecs_monitor_t> */
+    ecs_vec_t pending;               /* vector<ecs_query_t*> with deferred rematch */
+    ecs_ftime_t rematch_budget;      /* Max time spent rematching per merge */
     bool is_dirty;                   /* Should monitors be evaluated? */
 } ecs_monitor_set_t;
 
@@ -68,6 +79,10 @@ typedef struct ecs_store_t {
      * type info so it's guaranteed that this data is available while the 
      * storage is cleaning up tables. */
     ecs_vec_t deleted_components;    /* vector<ecs_entity_t> */
+
+    /* Pair ids that lost their last table. Their records are released by
+     * ecs_delete_empty_tables() if they're still unused. */
+    ecs_vec_t reclaim_ids;           /* vector<ecs_id_t> */
 } ecs_store_t;
 
 /* fini actions */
@@ -117,6 +132,11 @@ struct ecs_world_t {
     /* Unique id per generated event used to prevent duplicate notifications */
     int32_t event_id;
 
+    /* Events for batched observers, recorded while merging commands */
+    ecs_vec_t observer_batches;      /* vector<ecs_observer_batch_t> */
+    ecs_map_t observer_batch_index;  /* map<hash, batch index> */
+    bool observer_batching;          /* Are events being recorded? */
+
     /* Array of table versions used with component refs to determine if the 
      * cached pointer is still valid. */
     uint32_t table_version[ECS_TABLE_VERSION_ARRAY_SIZE];
@@ -125,6 +145,22 @@ struct ecs_world_t {
      * a table change. */
     uint32_t table_column_version[ECS_TABLE_VERSION_ARRAY_SIZE];
 
+    /* Array of versions of entity names and aliases, indexed by name hash. Used
+     * to invalidate cached lookups of a name. */
+    uint32_t name_version[ECS_NAME_VERSION_ARRAY_SIZE];
+
+    /* Increases when entities are added to or removed from a table. Used to
+     * determine if query snapshots are out of date. */
+    uint32_t table_count_version;
+
+    /* Increases when traversable entities enter or leave a table. Used to
+     * determine if up traversal cache entries need to be revalidated. */
+    uint32_t trav_version;
+
+    /* Increases when the tables that events are propagated to can change. Used
+     * to determine if propagation caches need to be rebuilt. */
+    uint32_t propagate_version;
+
     /* Array for checking if components can be looked up trivially */
     ecs_flags8_t non_trivial_lookup[FLECS_HI_COMPONENT_ID];
 
@@ -140,12 +176,15 @@ struct ecs_world_t {
     /* Used to track when cache needs to be updated */
     ecs_monitor_set_t monitors;      /* map<id, ecs_monitor_t> */
 
+    /* Caches of queries created with EcsQueryShareCache */
+    ecs_map_t shared_caches;         /* map<hash, ecs_query_cache_t*> */
+
     /* -- Systems -- */
     ecs_entity_t pipeline;           /* Current pipeline */
 
     /* -- Identifiers -- */
-    ecs_hashmap_t aliases;
-    ecs_hashmap_t symbols;
+    ecs_name_index_t aliases;
+    ecs_name_index_t symbols;
 
     /* -- Staging -- */
     ecs_stage_t **stages;            /* Stages */
@@ -167,6 +206,7 @@ struct ecs_world_t {
     ecs_os_cond_t worker_cond;       /* Signal that worker threads can start */
     ecs_os_cond_t sync_cond;         /* Signal that worker thread job is done */
     ecs_os_mutex_t sync_mutex;       /* Mutex for job_cond */
+    ecs_os_mutex_t ordered_children_lock; /* Build ordered children arrays once */
     int32_t workers_running;         /* Number of threads running */
     int32_t workers_waiting;         /* Number of workers waiting on sync */
     ecs_pipeline_state_t* pq;        /* Pointer to the pipeline for the workers to execute */
@@ -246,6 +286,13 @@ void flecs_type_info_free(
 void flecs_eval_component_monitors(
     ecs_world_t *world);
 
+/* Same as flecs_eval_component_monitors, but instead of spending the rematch
+ * budget on the queue of deferred rematches, only rematches the specified query
+ * if it is waiting for a rematch. Used when a query is iterated. */
+void flecs_eval_query_monitors(
+    ecs_world_t *world,
+    ecs_query_t *query);
+
 /* Register component monitor. */
 void flecs_monitor_register(
     ecs_world_t *world,
@@ -258,6 +305,17 @@ void flecs_monitor_unregister(
     ecs_entity_t id,
     ecs_query_t *query);
 
+/* Remove query from the list of queries with a deferred rematch. */
+void flecs_monitor_cancel_rematch(
+    ecs_world_t *world,
+    ecs_query_t *query);
+
+/* Replace query in component monitors and pending rematches. */
+void flecs_monitor_replace_query(
+    ecs_world_t *world,
+    ecs_query_t *query,
+    ecs_query_t *with);
+
 /* Update component monitors for added/removed components. */
 void flecs_update_component_monitors(
     ecs_world_t *world,
@@ -292,6 +292,22 @@
 #define FLECS_ENTITY_PAGE_BITS 10
 #endif
 
+/** @def FLECS_ENTITY_INDEX_FLAT
+ * When enabled, entity records are stored in a single range of address space
+ * that is reserved when the world is created and committed on demand, one
+ * entity page at a time. This turns a record lookup into a single indexed load
+ * instead of loading a page pointer first. Requires the vm_ callbacks of the
+ * OS API, and reserves address space for FLECS_ENTITY_INDEX_FLAT_BITS ids per
+ * world, so it should only be enabled on 64-bit targets. */
+// #define FLECS_ENTITY_INDEX_FLAT
+
+/** @def FLECS_ENTITY_INDEX_FLAT_BITS
+ * Number of entity id bits that can be stored in a flat entity index. Creating
+ * entities with ids outside of this range is not allowed. */
+#ifndef FLECS_ENTITY_INDEX_FLAT_BITS
+#define FLECS_ENTITY_INDEX_FLAT_BITS 32
+#endif
+
 /** @def FLECS_USE_OS_ALLOC
  * When enabled, Flecs will use the OS allocator provided in the OS API directly
  * instead of the builtin block allocator. This can decrease memory utilization
@@ -665,6 +681,12 @@ typedef int (*ecs_order_by_action_t)(
     ecs_entity_t e2,
     const void *ptr2);
 
+/** Callback used for extracting a sort key from a component. Results are
+ * ordered by ascending key. */
+typedef uint64_t (*ecs_order_by_key_action_t)(
+    ecs_entity_t e,
+    const void *ptr);
+
 /** Callback used for sorting the entire table of components */
 typedef void (*ecs_sort_table_action_t)(
     ecs_world_t* world,
@@ -1087,6 +1109,7 @@ struct ecs_type_info_t {
 #include "flecs/private/api_types.h"        /* Supporting API types */
 #include "flecs/private/api_support.h"      /* Supporting API functions */
 #include "flecs/datastructures/hashmap.h"   /* Hashmap */
+#include "flecs/datastructures/name_index.h" /* Name index */
 #include "flecs/private/api_internals.h"    /* Supporting API functions */
 
 /** Utility to hold a value of a dynamic type. */
@@ -1303,6 +1326,18 @@ struct ecs_iter_t {
  */
 #define EcsQueryMatchEmptyTables      (1u << 3u)
 
+/** Share query cache with other queries that have the same terms.
+ * Can be combined with other query flags on the ecs_query_desc_t::flags field.
+ * 
+ * Cached queries created with this flag that have identical (normalized) terms
+ * and flags use a single cache, instead of each query matching and storing the
+ * same tables. The cache is deleted when the last query using it is deleted.
+ * Queries that use order_by, group_by or change detection don't share caches.
+ * 
+ * \ingroup queries
+ */
+#define EcsQueryShareCache            (1u << 4u)
+
 /** Query may have unresolved entity identifiers.
  * Can be combined with other query flags on the ecs_query_desc_t::flags field.
  * \ingroup queries
@@ -1327,6 +1362,43 @@ struct ecs_iter_t {
  */
 #define EcsQueryDetectChanges         (1u << 8u)
 
+/** Yield toggle results as whole ranges with a mask of enabled rows.
+ * Can be combined with other query flags on the ecs_query_desc_t::flags field.
+ * 
+ * By default a query with toggle fields yields the ranges of enabled entities
+ * in between disabled entities, which can result in many small results for
+ * tables with scattered disabled entities. With this flag the query yields the
+ * matched range at once, and ecs_iter_get_row_mask() returns which rows of the
+ * result are enabled. Optional toggle fields are still yielded as ranges.
+ * 
+ * \ingroup queries
+ */
+#define EcsQueryToggleRowMask         (1u << 9u)
+
+/** Only yield rows of which fields changed since the last iteration.
+ * Can be combined with other query flags on the ecs_query_desc_t::flags field.
+ * 
+ * Implies EcsQueryDetectChanges. Tables iterated by the query keep track of
+ * which chunks of rows were written to, per component. Instead of yielding an
+ * entire table when one of its [in] fields changed, the query splits the table
+ * into ranges of changed chunks and skips the rest. Rows are written to by
+ * ecs_set(), ecs_modified() and by iterating queries with [out] fields.
+ * 
+ * A table is still yielded as a whole when entities were added to or removed
+ * from it, or when a field matched on another entity (e.g. a parent) changed.
+ * Results that only cover part of a table are yielded as is.
+ * 
+ * Changes are tracked with a granularity of 64 rows, so a result can contain
+ * rows that did not change. Rows are tracked for the tables matched by the
+ * query cache, so the query must be cached. Row chunks are only allocated on
+ * the main thread, so the query can be iterated from stages. Because rows 
+ * that are written while iterating are also tracked, this mode can't be used
+ * with worker iterators.
+ * 
+ * \ingroup queries
+ */
+#define EcsQueryDirtyRows             (1u << 10u)
+
 
 /** Used with ecs_query_init().
  * 
@@ -1357,8 +1429,17 @@ typedef struct ecs_query_desc_t {
      * but more efficient. */
     ecs_sort_table_action_t order_by_table_callback;
 
-    /** Component to sort on, used together with order_by_callback or
-     * order_by_table_callback. */
+    /** Callback used for ordering query results by a key. Instead of 
+     * comparing components, the callback maps a component to an integer key,
+     * which lets tables be radix sorted. If the OS API provides tasks, changed
+     * tables are sorted in parallel, so the callback must be thread safe. Use
+     * ecs_order_by_key_i64() and ecs_order_by_key_f64() to create keys from 
+     * signed or floating point values. Can't be combined with 
+     * order_by_callback. */
+    ecs_order_by_key_action_t order_by_key_callback;
+
+    /** Component to sort on, used together with order_by_callback,
+     * order_by_table_callback or order_by_key_callback. */
     ecs_entity_t order_by;
 
     /** Component id to be used for grouping. Used together with the
@@ -1386,6 +1467,12 @@ typedef struct ecs_query_desc_t {
     /** Function to free group_by_ctx */
     ecs_ctx_free_t group_by_ctx_free;
 
+    /** Lowest group id returned by group_by. Groups with ids in the range
+     * [group_id_offset, group_id_offset + 2^24) are found with an array lookup,
+     * other groups are found with a hash lookup. Set this when group ids don't
+     * start near 0, for example when they are packed coordinates. */
+    uint64_t group_id_offset;
+
     /** User context to pass to callback */
     void *ctx;
 
@@ -1423,6 +1510,29 @@ typedef struct ecs_observer_desc_t {
      * #EcsOnAdd `Position` would match all existing instances of `Position`. */
     bool yield_existing;
 
+    /** Batch OnAdd and OnSet events that are emitted while merging deferred
+     * commands. Instead of being invoked for each entity, the observer is
+     * invoked once per contiguous range of entities in a table after all
+     * commands have been merged. Only applies to single-term observers.
+     *
+     * Batched observers run after non-batched observers for the same events,
+     * in the order in which their first event was recorded. Observers see
+     * component values at the time of delivery, and are not invoked for
+     * entities that were deleted or no longer have the component. Events that
+     * are not emitted by a merge (like OnRemove) are delivered immediately. */
+    bool batched;
+
+    /** Queue OnAdd and OnSet events and invoke the observer from a
+     * multi-threaded system in this pipeline phase, instead of invoking it
+     * while the event is emitted. The observer runs on a readonly stage, so
+     * operations it does are deferred. Only applies to single-term observers,
+     * and requires the system addon.
+     * Like batched observers, async observers get the component value at the
+     * time of delivery, so an entity is only queued once per event until the
+     * queue is drained. This does not apply to observers for a wildcard id,
+     * which queue every event. */
+    ecs_entity_t async_phase;
+
     /** Callback to invoke on an event, invoked when the observer matches. */
     ecs_iter_action_t callback;
 
@@ -1560,6 +1670,8 @@ typedef struct ecs_world_info_t {
     int64_t systems_ran_total;        /**< Total number of systems ran */
     int64_t observers_ran_total;      /**< Total number of times observer was invoked */
     int64_t queries_ran_total;        /**< Total number of times a query was evaluated */
+    int64_t event_forward_total;      /**< Total number of times events were forwarded or propagated by traversing relationships */
+    int64_t event_forward_cached_total; /**< Total number of times events were forwarded or propagated using cached tables/ids */
 
     int32_t tag_id_count;             /**< Number of tag (no data) ids in the world */
     int32_t component_id_count;       /**< Number of component (data) ids in the world */
@@ -1596,6 +1708,7 @@ typedef struct ecs_query_group_info_t {
     uint64_t id;
     int32_t match_count;  /**< How often tables have been matched/unmatched */
     int32_t table_count;  /**< Number of tables in group */
+    int32_t entity_count; /**< Number of entities in group (only for queries with group_by) */
     void *ctx;            /**< Group context, returned by on_group_create */
 } ecs_query_group_info_t;
 
@@ -1614,7 +1727,7 @@ typedef struct EcsIdentifier {
     ecs_size_t length;    /**< Length of identifier */
     uint64_t hash;        /**< Hash of current value */
     uint64_t index_hash;  /**< Hash of existing record in current index */
-    ecs_hashmap_t *index; /**< Current index */
+    ecs_name_index_t *index; /**< Current index */
 } EcsIdentifier;
 
 /** Component information. */
@@ -2267,6 +2380,48 @@ void ecs_set_target_fps(
     ecs_world_t *world,
     ecs_ftime_t fps);
 
+/** Set time budget for rematching query caches.
+ * When a traversed entity changes (for example, a component is removed from a 
+ * parent), cached queries that matched through that entity are rematched 
+ * during the next merge. By default all queries are rematched immediately,
+ * which can cause spikes after large hierarchy changes.
+ *
+ * When a budget is set, queries are rematched one at a time until the budget
+ * is spent, and the remaining queries are rematched in subsequent merges. Until
+ * then a query returns stale but valid results: results for which the 
+ * traversed source no longer has the matched component are skipped, but new
+ * matches may not be returned yet. Iterating a query outside of a frame 
+ * (when the world is not readonly) always rematches it first. Only the query
+ * being iterated is rematched, other pending queries wait for the next merge.
+ *
+ * @param world The world.
+ * @param budget Time budget in seconds, or 0 to rematch immediately.
+ */
+FLECS_API
+void ecs_set_rematch_budget(
+    ecs_world_t *world,
+    ecs_ftime_t budget);
+
+/** Get time budget for rematching query caches.
+ *
+ * @param world The world.
+ * @return The budget in seconds, 0 if queries are rematched immediately.
+ * @see ecs_set_rematch_budget()
+ */
+FLECS_API
+ecs_ftime_t ecs_get_rematch_budget(
+    const ecs_world_t *world);
+
+/** Get number of queries with a deferred rematch.
+ *
+ * @param world The world.
+ * @return The number of queries that still need to be rematched.
+ * @see ecs_set_rematch_budget()
+ */
+FLECS_API
+int32_t ecs_get_pending_rematch_count(
+    const ecs_world_t *world);
+
 /** Set default query flags. 
  * Set a default value for the ecs_filter_desc_t::flags field. Default flags
  * are applied in addition to the flags provided in the descriptor. For a
@@ -2760,6 +2915,9 @@ typedef struct ecs_delete_empty_tables_desc_t {
  * should have. Often the more components a table has, the more specific it is
  * and therefore less likely to be reused.
  *
+ * Pair records (like (ChildOf, parent)) that lost their last table are queued,
+ * and released by the next call to this operation if they are still unused.
+ *
  * The time budget specifies how long the operation should take at most.
  *
  * @param world The world.
@@ -3346,6 +3504,29 @@ FLECS_ALWAYS_INLINE const void* ecs_get_id(
     ecs_entity_t entity,
     ecs_id_t component);
 
+/** Get immutable pointers to a component for multiple entities.
+ * Same as calling ecs_get_id() for each entity, except that entities that are
+ * not alive are allowed and produce NULL. Entity records are looked up in
+ * batches so that the cache misses of multiple lookups overlap, which is faster
+ * than calling ecs_get_id() for entities in random order.
+ *
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param component The component to get.
+ * @param ptrs Output array with count elements. Elements are NULL for entities 
+ *             that are not alive or don't have the component.
+ *
+ * @see ecs_get_id()
+ */
+FLECS_API
+void ecs_get_id_n(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_id_t component,
+    const void **ptrs);
+
 /** Get a mutable pointer to a component.
  * This operation obtains a mutable pointer to the requested component. The
  * operation accepts the component entity id.
@@ -3566,6 +3747,25 @@ bool ecs_is_alive(
     const ecs_world_t *world,
     ecs_entity_t e);
 
+/** Test whether multiple entities are alive.
+ * Same as calling ecs_is_alive() for each entity, except that 0 is allowed and
+ * is not alive. Entity records are looked up in batches so that the cache 
+ * misses of multiple lookups overlap.
+ *
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param alive Output array with count elements.
+ * @return The number of alive entities.
+ * @see ecs_is_alive()
+ */
+FLECS_API
+int32_t ecs_is_alive_n(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    bool *alive);
+
 /** Remove generation from entity id.
  *
  * @param e The entity id.
@@ -4069,6 +4269,34 @@ ecs_entity_t ecs_lookup_symbol(
     bool lookup_as_path,
     bool recursive);
 
+/** Compute the hash of an entity name.
+ * The hash can be used with ecs_get_name_version().
+ *
+ * @param name The name.
+ * @param length The length of the name, or 0 if the name is 0-terminated.
+ * @return The hash of the name.
+ */
+FLECS_API
+uint64_t ecs_name_hash(
+    const char *name,
+    ecs_size_t length);
+
+/** Get the version of an entity name.
+ * The version increases when an entity with the name is created, deleted,
+ * renamed or reparented, and when an alias with the name is set or removed.
+ * Applications can use it to invalidate cached lookups per name instead of for
+ * all names. Names share a fixed number of versions, so the version can also
+ * increase when a different name changed.
+ *
+ * @param world The world.
+ * @param name_hash The hash of the name, see ecs_name_hash().
+ * @return The version of the name.
+ */
+FLECS_API
+uint32_t ecs_get_name_version(
+    const ecs_world_t *world,
+    uint64_t name_hash);
+
 /** Get a path identifier for an entity.
  * This operation creates a path that contains the names of the entities from
  * the specified parent to the provided entity, separated by the provided
@@ -5039,6 +5267,29 @@ FLECS_API
 bool ecs_query_changed(
     ecs_query_t *query);
 
+/** Convert signed integer to sort key.
+ * Returns a key that preserves the order of signed values when used with
+ * ecs_query_desc_t::order_by_key_callback.
+ * 
+ * @param value The value.
+ * @return The sort key.
+ */
+FLECS_API
+uint64_t ecs_order_by_key_i64(
+    int64_t value);
+
+/** Convert floating point value to sort key.
+ * Returns a key that preserves the order of floating point values when used
+ * with ecs_query_desc_t::order_by_key_callback. NaN values are ordered after 
+ * positive infinity.
+ * 
+ * @param value The value.
+ * @return The sort key.
+ */
+FLECS_API
+uint64_t ecs_order_by_key_f64(
+    double value);
+
 /** Get query object.
  * Returns the query object. Can be used to access various information about
  * the query.
@@ -5119,6 +5370,62 @@ const ecs_query_group_info_t* ecs_query_get_group_info(
     const ecs_query_t *query,
     uint64_t group_id);
 
+/** Get number of groups in query.
+ * Returns the number of groups created by the query's group_by callback. The
+ * default group (group id 0) is not included. A group exists while it has at
+ * least one matched table. Because queries also match empty tables, a group
+ * can have no entities: use ecs_query_group_info_t::entity_count to skip 
+ * groups without entities.
+ *
+ * @param query The query.
+ * @return The number of groups.
+ */
+FLECS_API
+int32_t ecs_query_group_count(
+    const ecs_query_t *query);
+
+/** Get information about query group by index.
+ * Groups are stored in a dense array, which allows for iterating all groups of
+ * a query in O(1) per group without knowing the group ids. Indices are not 
+ * stable across matching/unmatching tables.
+ *
+ * @param query The query.
+ * @param index The group index (0 ..ecs_query_group_count()).
+ * @return The group info.
+ */
+FLECS_API
+const ecs_query_group_info_t* ecs_query_get_group_info_at(
+    const ecs_query_t *query,
+    int32_t index);
+
+/** Snapshot of the table ranges matched by a cached query. */
+typedef struct ecs_query_snapshot_t {
+    const ecs_table_range_t *ranges; /**< Matched (non-empty) table ranges. */
+    int32_t count;                   /**< Number of ranges. */
+    int32_t entity_count;            /**< Number of entities in ranges. */
+    int64_t frame;                   /**< Frame in which snapshot was taken. */
+} ecs_query_snapshot_t;
+
+/** Get snapshot of the table ranges matched by a cached query.
+ * The snapshot is rebuilt at most once per frame, or when tables were matched
+ * or unmatched by the query, or when entities were added to or removed from a
+ * table. Queries that share a cache (see 
+ * EcsQueryShareCache) also share the snapshot, which lets multiple systems
+ * walk the matched tables without each setting up a query iterator.
+ * 
+ * A snapshot only reflects the cached terms of a query, and does not take into
+ * account change detection or toggled components.
+ * 
+ * The returned pointer remains valid until the query is deleted. The ranges it
+ * points to are valid until the snapshot is rebuilt.
+ *
+ * @param query The query.
+ * @return The snapshot.
+ */
+FLECS_API
+const ecs_query_snapshot_t* ecs_query_snapshot(
+    const ecs_query_t *query);
+
 /** Struct returned by ecs_query_count(). */
 typedef struct ecs_query_count_t {
     int32_t results;      /**< Number of results returned by query. */
@@ -5138,6 +5445,35 @@ FLECS_API
 ecs_query_count_t ecs_query_count(
     const ecs_query_t *query);
 
+/** Struct returned by ecs_query_trav_stats(). */
+typedef struct ecs_query_trav_stats_t {
+    int64_t hits;         /**< Up traversals answered by a valid cache entry. */
+    int64_t rebuilds;     /**< Cache entries (re)computed because they were 
+                           * missing or invalidated by a hierarchy change. */
+} ecs_query_trav_stats_t;
+
+/** Get statistics for the up traversal caches of a query.
+ * Queries that traverse relationships upwards for a known source (for example
+ * a ChildOf hierarchy) keep an up traversal cache across iterations. Entries
+ * store the table of the traversed entity, and are only recomputed when that
+ * entity or one of the entities it inherited the result from changed tables.
+ * Caches are not used (and stats are not updated) while the world is in 
+ * multithreaded mode.
+ *
+ * Only terms that are evaluated after the source is known use the cache. If
+ * the first term of a query is an up term, as in "Position(up ChildOf), Foo",
+ * tables are found by traversing down from the entities with the component
+ * for each iteration, which is not cached and not counted in the stats. To
+ * cache the traversal, start the query with a term that is matched by the 
+ * entity itself, as in "Foo, Position(up ChildOf)".
+ *
+ * @param query The query.
+ * @return Cache statistics accumulated since the query was created.
+ */
+FLECS_API
+ecs_query_trav_stats_t ecs_query_trav_stats(
+    const ecs_query_t *query);
+
 /** Does query return one or more results. 
  * 
  * @param query The query.
@@ -5505,6 +5841,19 @@ FLECS_API
 uint64_t ecs_iter_get_group(
     const ecs_iter_t *it);
 
+/** Return the mask of enabled rows for the currently iterated result.
+ * This operation returns the enabled rows of toggle fields for queries created
+ * with EcsQueryToggleRowMask. The mask is indexed by table row: bit (row % 64)
+ * of element (row / 64) is set if table row `row` is enabled. Only the bits for
+ * rows it->offset up to it->offset + it->count are valid.
+ * 
+ * @param it The iterator.
+ * @return The row mask, or NULL if all rows of the result are enabled.
+ */
+FLECS_API
+const uint64_t* ecs_iter_get_row_mask(
+    const ecs_iter_t *it);
+
 /** Returns whether current iterator result has changed.
  * This operation must be used in combination with a query that supports change
  * detection (e.g. is cached). The operation returns whether the currently
@@ -24,6 +24,8 @@ using table_t = ecs_table_t;
 using term_t = ecs_term_t;
 using query_t = ecs_query_t;
 using query_group_info_t = ecs_query_group_info_t;
+using query_snapshot_t = ecs_query_snapshot_t;
+using query_trav_stats_t = ecs_query_trav_stats_t;
 using observer_t = ecs_observer_t;
 using iter_t = ecs_iter_t;
 using ref_t = ecs_ref_t;
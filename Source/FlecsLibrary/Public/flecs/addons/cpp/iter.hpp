@@ -365,6 +365,30 @@ public:
         return ecs_iter_get_group(iter_);
     }
 
+    /** Get mask of enabled rows for the current result.
+     * Only set for queries with the EcsQueryToggleRowMask flag. The mask is 
+     * indexed by table row, use is_enabled() to test a row of the result.
+     *
+     * @return The row mask, or nullptr if all rows are enabled.
+     */
+    const uint64_t* row_mask() const {
+        return ecs_iter_get_row_mask(iter_);
+    }
+
+    /** Check if row of the current result is enabled.
+     * Always true unless the query uses the EcsQueryToggleRowMask flag.
+     *
+     * @param row The row of the result (0 .. count()).
+     */
+    bool is_enabled(size_t row) const {
+        const uint64_t *mask = ecs_iter_get_row_mask(iter_);
+        if (!mask) {
+            return true;
+        }
+        size_t table_row = static_cast<size_t>(iter_->offset) + row;
+        return (mask[table_row / 64] >> (table_row % 64)) & 1u;
+    }
+
     /** Get value of variable by id.
      * Get value of a query variable for current result.
      */
@@ -49,6 +49,18 @@ struct observer_builder_i : query_builder_i<Base, Components ...> {
         return *this;
     }
 
+    /** Invoke observer once per table range for events from command merges */
+    Base& batched(bool value = true) {
+        desc_->batched = value;
+        return *this;
+    }
+
+    /** Queue events and invoke observer from a system in the specified phase */
+    Base& async_phase(flecs::entity_t phase) {
+        desc_->async_phase = phase;
+        return *this;
+    }
+
     /** Set observer flags */
     Base& observer_flags(ecs_flags32_t flags) {
         desc_->flags_ |= flags;
@@ -40,6 +40,21 @@ struct query_builder_i : term_builder_i<Base> {
         return *this;
     }
 
+    Base& toggle_row_mask() {
+        desc_->flags |= EcsQueryToggleRowMask;
+        return *this;
+    }
+
+    Base& dirty_rows() {
+        desc_->flags |= EcsQueryDirtyRows;
+        return *this;
+    }
+
+    Base& share_cache() {
+        desc_->flags |= EcsQueryShareCache;
+        return *this;
+    }
+
     Base& expr(const char *expr) {
         ecs_check(expr_count_ == 0, ECS_INVALID_OPERATION,
             "query_builder::expr() called more than once");
@@ -318,6 +333,34 @@ struct query_builder_i : term_builder_i<Base> {
         return *this;
     }
 
+    /** Sort the output of a query by a key.
+     * Same as order_by<T>, but instead of comparing components the function
+     * returns an integer key for a component. Results are ordered by ascending
+     * key. Tables are radix sorted, and may be sorted in parallel on task 
+     * threads, so the function must be thread safe.
+     *
+     * @tparam T The component used to sort.
+     * @param key The function that returns the sort key for a component.
+     */
+    template <typename T>
+    Base& order_by_key(uint64_t(*key)(flecs::entity_t, const T*)) {
+        ecs_order_by_key_action_t fn = 
+            reinterpret_cast<ecs_order_by_key_action_t>(key);
+        return this->order_by_key(_::type<T>::id(this->world_v()), fn);
+    }
+
+    /** Sort the output of a query by a key.
+     * Same as order_by_key<T>, but with component identifier.
+     *
+     * @param component The component used to sort.
+     * @param key The function that returns the sort key for a component.
+     */
+    Base& order_by_key(flecs::entity_t component, uint64_t(*key)(flecs::entity_t, const void*)) {
+        desc_->order_by_key_callback = key;
+        desc_->order_by = component;
+        return *this;
+    }
+
     /** Group and sort matched tables.
      * Similar to ecs_query_order_by(), but instead of sorting individual entities, this
      * operation only sorts matched tables. This can be useful of a query needs to
@@ -383,6 +426,16 @@ struct query_builder_i : term_builder_i<Base> {
         return *this;
     }
 
+    /** Specify lowest group id returned by group_by. Groups with ids in the
+     * range [offset, offset + 2^24) are found without hashing.
+     * 
+     * @param offset The lowest group id.
+     */
+    Base& group_id_offset(uint64_t offset) {
+        desc_->group_id_offset = offset;
+        return *this;
+    }
+
     /** Specify on_group_create action.
      */
     Base& on_group_create(ecs_group_create_action_t action) {
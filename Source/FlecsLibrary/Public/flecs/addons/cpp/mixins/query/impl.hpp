@@ -129,6 +129,32 @@ struct query_base {
         return ecs_query_get_group_info(query_, group_id);
     }
 
+    /** Get number of groups. 
+     * 
+     * @return The number of groups, excluding the default group. Includes 
+     *         groups of which all tables are empty.
+     */
+    int32_t group_count() const {
+        return ecs_query_group_count(query_);
+    }
+
+    /** Get info for group by index. 
+     * 
+     * @param index The group index (0 ..group_count()).
+     * @return The group info.
+     */
+    const flecs::query_group_info_t* group_info_at(int32_t index) const {
+        return ecs_query_get_group_info_at(query_, index);
+    }
+
+    /** Get snapshot of matched table ranges. 
+     * 
+     * @return The snapshot, rebuilt at most once per frame.
+     */
+    const flecs::query_snapshot_t* snapshot() const {
+        return ecs_query_snapshot(query_);
+    }
+
     /** Get context for group. 
      * 
      * @param group_id The group id for which to retrieve the context.
@@ -182,6 +208,13 @@ struct query_base {
         return flecs::string(result);
     }
 
+    /** Get statistics for the up traversal caches of the query.
+     * @see ecs_query_trav_stats
+     */
+    flecs::query_trav_stats_t trav_stats() const {
+        return ecs_query_trav_stats(query_);
+    }
+
     operator query<>() const;
 
 #   ifdef FLECS_JSON
@@ -316,6 +316,32 @@ struct world {
         ecs_frame_end(world_);
     }
 
+    /** Set time budget for rematching query caches.
+     *
+     * @param budget Time budget in seconds, or 0 to rematch immediately.
+     *
+     * @see ecs_set_rematch_budget()
+     */
+    void set_rematch_budget(ecs_ftime_t budget) const {
+        ecs_set_rematch_budget(world_, budget);
+    }
+
+    /** Get time budget for rematching query caches.
+     *
+     * @see ecs_get_rematch_budget()
+     */
+    ecs_ftime_t get_rematch_budget() const {
+        return ecs_get_rematch_budget(world_);
+    }
+
+    /** Get number of queries with a deferred rematch.
+     *
+     * @see ecs_get_pending_rematch_count()
+     */
+    int32_t get_pending_rematch_count() const {
+        return ecs_get_pending_rematch_count(world_);
+    }
+
     /** Begin readonly mode.
      *
      * @param multi_threaded Whether to enable readonly/multi threaded mode.
@@ -576,7 +576,7 @@ typedef struct ecs_meta_op_t {
     ecs_entity_t type;                             /**< Type entity */
     const ecs_type_info_t *type_info;              /**< Type info */
     union {
-        ecs_hashmap_t *members;                    /**< string -> member index (structs) */
+        ecs_name_index_t *members;                 /**< string -> member index (structs) */
         ecs_map_t *constants;                      /**< (u)int -> constant entity (enums/bitmasks) */
         ecs_meta_serialize_t opaque;               /**< Serialize callback for opaque types */
     } is;
@@ -606,7 +606,7 @@ typedef struct ecs_meta_scope_t {
     int16_t prev_depth;                            /**< Depth to restore, in case dotmember was used */
     void *ptr;                                     /**< Pointer to ops[0] */
     const EcsOpaque *opaque;                       /**< Opaque type interface */
-    ecs_hashmap_t *members;                        /**< string -> member index */
+    ecs_name_index_t *members;                     /**< string -> member index */
     bool is_collection;                            /**< Is the scope iterating elements? */
     bool is_empty_scope;                           /**< Was scope populated (for vectors) */
     bool is_moved_scope;                           /**< Was scope moved in (with ecs_meta_elem, for vectors) */
@@ -68,7 +68,7 @@ typedef struct ecs_script_vars_t {
     struct ecs_script_vars_t *parent;
     int32_t sp;
 
-    ecs_hashmap_t var_index;
+    ecs_name_index_t var_index;
     ecs_vec_t vars;
 
     const ecs_world_t *world;
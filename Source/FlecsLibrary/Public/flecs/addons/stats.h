@@ -116,6 +116,8 @@ typedef struct ecs_world_stats_t {
         ecs_metric_t systems_ran;          /**< Number of systems ran. */
         ecs_metric_t observers_ran;        /**< Number of times an observer was invoked. */
         ecs_metric_t event_emit_count;     /**< Number of events emitted */
+        ecs_metric_t event_forward_count;  /**< Number of events forwarded/propagated by traversing relationships */
+        ecs_metric_t event_forward_cached_count; /**< Number of events forwarded/propagated using cached data */
     } frame;
 
     /* Timing */
@@ -524,8 +526,10 @@ typedef struct {
     ecs_size_t bytes_component_record;  /** Bytes used by ecs_component_record_t struct. */
     ecs_size_t bytes_table_cache;       /** Bytes used by table cache. */
     ecs_size_t bytes_name_index;        /** Bytes used by name index. */
-    ecs_size_t bytes_ordered_children;  /** Bytes used by ordered children vector. */
+    ecs_size_t bytes_ordered_children;  /** Bytes used by ordered children storage. */
     ecs_size_t bytes_reachable_cache;   /** Bytes used by reachable cache. */
+    int32_t reclaim_count;              /** Number of pair records queued for release. */
+    ecs_size_t bytes_reclaim_queue;     /** Bytes used by queue of pair records to release. */
 } ecs_component_index_memory_t;
 
 /** Query memory. */
@@ -593,6 +597,7 @@ typedef struct {
     ecs_size_t bytes_pair_record;       /** Pair record allocator. */
     ecs_size_t bytes_table_diff;        /** Table diff allocator. */
     ecs_size_t bytes_sparse_chunk;      /** Sparse chunk allocator. */
+    ecs_size_t bytes_table_records;     /** Table record allocator. */
     ecs_size_t bytes_allocator;         /** Generic allocator. */
     ecs_size_t bytes_stack_allocator;   /** Stack allocator. */
     ecs_size_t bytes_cmd_entry_chunk;   /** Command batching entry chunk allocator. */
@@ -0,0 +1,39 @@
+/**
+ * @file name_index.h
+ * @brief Name index data structure.
+ */
+
+#ifndef FLECS_NAME_INDEX_H
+#define FLECS_NAME_INDEX_H
+
+#include "../private/api_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Name index entry. The name is not owned by the index. */
+typedef struct ecs_name_index_entry_t {
+    uint64_t hash;
+    uint64_t id;
+    const char *name;
+    ecs_size_t length;
+} ecs_name_index_entry_t;
+
+/** Open addressing hash table from names to 64bit keys. Entries are found by
+ * scanning groups of control bytes that hold the upper bits of the stored
+ * hash, so a lookup only compares names of entries with a matching hash. */
+typedef struct ecs_name_index_t {
+    uint8_t *ctrl;                    /**< Control bytes (NULL if not initialized) */
+    ecs_name_index_entry_t *entries;  /**< Entries (size is capacity) */
+    int32_t count;                    /**< Number of entries */
+    int32_t tombstones;               /**< Number of removed slots */
+    int32_t capacity;                 /**< Number of slots (power of 2 or 0) */
+    ecs_allocator_t *allocator;       /**< Allocator (may be NULL) */
+} ecs_name_index_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -95,6 +95,26 @@ typedef
 void* (*ecs_os_api_calloc_t)(
     ecs_size_t size);
 
+/** OS API vm_reserve function type. Reserves a range of address space without
+ * backing it with memory. Returns NULL if the range could not be reserved. */
+typedef
+void* (*ecs_os_api_vm_reserve_t)(
+    size_t size);
+
+/** OS API vm_commit function type. Backs a range of reserved address space 
+ * with zero initialized memory. Returns false if the range could not be 
+ * committed. */
+typedef
+bool (*ecs_os_api_vm_commit_t)(
+    void *ptr,
+    size_t size);
+
+/** OS API vm_release function type. Releases a reserved range. */
+typedef
+void (*ecs_os_api_vm_release_t)(
+    void *ptr,
+    size_t size);
+
 /** OS API strdup function type. */
 typedef
 char* (*ecs_os_api_strdup_t)(
@@ -265,6 +285,11 @@ typedef struct ecs_os_api_t {
     ecs_os_api_calloc_t calloc_;                   /**< calloc callback. */
     ecs_os_api_free_t free_;                       /**< free callback. */
 
+    /* Virtual memory */
+    ecs_os_api_vm_reserve_t vm_reserve_;           /**< vm_reserve callback. */
+    ecs_os_api_vm_commit_t vm_commit_;             /**< vm_commit callback. */
+    ecs_os_api_vm_release_t vm_release_;           /**< vm_release callback. */
+
     /* Strings */
     ecs_os_api_strdup_t strdup_;                   /**< strdup callback. */
 
@@ -427,6 +452,11 @@ void ecs_os_set_api_defaults(void);
 #define ecs_os_alloca_t(T) ECS_CAST(T*, ecs_os_alloca(ECS_SIZEOF(T)))
 #define ecs_os_alloca_n(T, count) ECS_CAST(T*, ecs_os_alloca(ECS_SIZEOF(T) * (count)))
 
+/* Virtual memory */
+#define ecs_os_vm_reserve(size) ecs_os_api.vm_reserve_(size)
+#define ecs_os_vm_commit(ptr, size) ecs_os_api.vm_commit_(ptr, size)
+#define ecs_os_vm_release(ptr, size) ecs_os_api.vm_release_(ptr, size)
+
 /* Strings */
 #ifndef ecs_os_strdup
 #define ecs_os_strdup(str) ecs_os_api.strdup_(str)
@@ -734,6 +764,10 @@ void* ecs_os_memdup(
 FLECS_API
 bool ecs_os_has_heap(void);
 
+/** Are virtual memory functions available? */
+FLECS_API
+bool ecs_os_has_vm(void);
+
 /** Are threading functions available? */
 FLECS_API
 bool ecs_os_has_threading(void);
@@ -66,6 +66,23 @@ ecs_record_t* ecs_record_find(
     const ecs_world_t *world,
     ecs_entity_t entity);
 
+/** Find records for multiple entities.
+ * Same as calling ecs_record_find() for each entity, except that records are
+ * looked up in batches so that the cache misses of multiple lookups overlap.
+ * 
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param records Output array with count elements. Elements are NULL for 
+ *                entities that are not alive.
+ */
+FLECS_API
+void ecs_record_find_n(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_record_t **records);
+
 /** Get entity corresponding with record.
  * This operation only works for entities that are not empty.
  *
@@ -112,6 +112,14 @@ typedef struct ecs_each_iter_t {
     const ecs_table_record_t* trs;
 } ecs_each_iter_t;
 
+/* Iterator for blocks of ordered children */
+typedef struct ecs_children_iter_t {
+    void **blocks;               /* Blocks with children */
+    int32_t index;               /* Index of next block */
+    int32_t count;               /* Number of blocks */
+    bool is_blocks;              /* Iterate blocks instead of it->entities */
+} ecs_children_iter_t;
+
 typedef struct ecs_query_op_profile_t {
     int32_t count[2]; /* 0 = enter, 1 = redo */
 } ecs_query_op_profile_t;
@@ -133,8 +141,14 @@ typedef struct ecs_query_iter_t {
 
     ecs_query_op_profile_t *profile;
 
+    const uint64_t *row_mask;                 /* Enabled rows for EcsQueryToggleRowMask, indexed by table row */
+
+    int32_t dirty_row, dirty_end;             /* Next row & end of result split by EcsQueryDirtyRows */
+    ecs_termset_t dirty_fields;               /* Changed fields of result split by EcsQueryDirtyRows */
+
     int16_t op;                               /* Currently iterated query plan operation (index into ops) */
     bool iter_single_group;
+    bool dirty_skip;                          /* Skipped dirty rows of current result */
 } ecs_query_iter_t;
 
 /* Private iterator data. Used by iterator implementations to keep track of
@@ -145,6 +159,7 @@ typedef struct ecs_iter_private_t {
         ecs_page_iter_t page;
         ecs_worker_iter_t worker;
         ecs_each_iter_t each;
+        ecs_children_iter_t children;
     } iter;                       /* Iterator specific data */
 
     void *entity_iter;            /* Query applied after matching a table */
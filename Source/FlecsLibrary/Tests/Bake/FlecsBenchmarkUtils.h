@@ -0,0 +1,82 @@
+// Elie Wiese-Namir © 2025. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "flecs.h"
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "FlecsTestTypes.h"
+
+/* Benchmarks populate large worlds, so they only run when performance tests
+ * are requested. Checks on the results go after the timed code. */
+#define FLECS_BENCHMARK_TEST_FLAGS \
+	(EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/* Number of entities in benchmarks that measure a per entity cost. */
+static constexpr int32_t BenchmarkEntityCount = 1000000;
+
+/* Number of times the timed code of a benchmark is repeated. */
+static constexpr int32_t BenchmarkIterations = 3;
+
+/* Seed for the random order in which benchmarks access entities. */
+static constexpr int32_t BenchmarkSeed = 1;
+
+/* Creates count entities after registering the test types. init is invoked
+ * with each new entity and its index. */
+template <typename Func>
+static inline void BenchmarkPopulateWorld(
+	flecs::world& world, int32_t count, TArray<flecs::entity>& entities, const Func& init)
+{
+	RegisterTestTypeComponents(world);
+
+	entities.Reserve(entities.Num() + count);
+	for (int32_t i = 0; i < count; i ++) {
+		flecs::entity e = world.entity();
+		init(e, i);
+		entities.Add(e);
+	}
+}
+
+/* Returns the indices [0, count) in a random order that is the same for each
+ * run, so that results don't depend on the order in which entities were
+ * created. */
+static inline TArray<int32_t> BenchmarkShuffle(int32_t count) {
+	TArray<int32_t> order;
+	order.Reserve(count);
+	for (int32_t i = 0; i < count; i ++) {
+		order.Add(i);
+	}
+
+	FRandomStream random(BenchmarkSeed);
+	for (int32_t i = count - 1; i > 0; i --) {
+		order.Swap(i, random.RandRange(0, i));
+	}
+
+	return order;
+}
+
+/* Returns the time in seconds it takes to run func. */
+template <typename Func>
+static inline double BenchmarkTime(const Func& func) {
+	const double start = FPlatformTime::Seconds();
+	func();
+	return FPlatformTime::Seconds() - start;
+}
+
+/* Adds the total time and the time per operation to the log of the current
+ * test. */
+static inline void BenchmarkReport(const TCHAR* name, double elapsed, double count) {
+	if (FAutomationTestBase* CurrentTest = FAutomationTestFramework::Get().GetCurrentTest()) {
+		CurrentTest->AddInfo(FString::Printf(TEXT("%s: %.3f ms, %.1f ns per op, %.1f M/s"),
+			name, elapsed * 1000.0, (elapsed * 1000000000.0) / count,
+			count / (elapsed * 1000000.0)));
+	}
+}
+
+#endif // WITH_AUTOMATION_TESTS
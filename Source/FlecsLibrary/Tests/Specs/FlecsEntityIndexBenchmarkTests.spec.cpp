@@ -0,0 +1,163 @@
+﻿
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS && defined(FLECS_TESTS)
+
+#include "flecs.h"
+
+#include "Bake/FlecsTestUtils.h"
+#include "Bake/FlecsTestTypes.h"
+#include "Bake/FlecsBenchmarkUtils.h"
+
+/* Benchmarks for random access into the entity index, which is the access 
+ * pattern of code that resolves entities from an external list. Run with and
+ * without FLECS_ENTITY_INDEX_FLAT to compare the entity index layouts. */
+
+BEGIN_DEFINE_SPEC(FFlecsEntityIndexBenchmarkTestsSpec,
+                  "FlecsLibrary.EntityIndexBenchmark",
+                  FLECS_BENCHMARK_TEST_FLAGS);
+
+void PopulateWorld(flecs::world& world, TArray<flecs::entity>& entities, TArray<int32_t>& order) {
+	BenchmarkPopulateWorld(world, BenchmarkEntityCount, entities, 
+		[](flecs::entity e, int32_t i) {
+			e.set<Position>({ static_cast<float>(i), 0 });
+		});
+
+	order = BenchmarkShuffle(BenchmarkEntityCount);
+}
+
+void ReportThroughput(const TCHAR* name, double elapsed) {
+#ifdef FLECS_ENTITY_INDEX_FLAT
+	const FString label = FString::Printf(TEXT("%s (flat)"), name);
+#else
+	const FString label = FString::Printf(TEXT("%s (paged)"), name);
+#endif
+
+	BenchmarkReport(*label, elapsed, 
+		static_cast<double>(BenchmarkIterations) * BenchmarkEntityCount);
+}
+
+void EntityIndexBenchmark_get_random(void) {
+	flecs::world world;
+	TArray<flecs::entity> entities;
+	TArray<int32_t> order;
+	PopulateWorld(world, entities, order);
+
+	double sum = 0;
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t iter = 0; iter < BenchmarkIterations; iter ++) {
+			for (int32_t i : order) {
+				sum += entities[i].get<Position>().x;
+			}
+		}
+	});
+
+	ReportThroughput(TEXT("get"), elapsed);
+
+	const double n = BenchmarkEntityCount;
+	test_assert(sum == BenchmarkIterations * (n * (n - 1) / 2));
+}
+
+void EntityIndexBenchmark_is_alive_random(void) {
+	flecs::world world;
+	TArray<flecs::entity> entities;
+	TArray<int32_t> order;
+	PopulateWorld(world, entities, order);
+
+	/* Delete every other entity so that the result isn't always the same */
+	for (int32_t i = 0; i < BenchmarkEntityCount; i += 2) {
+		entities[i].destruct();
+	}
+
+	int32_t alive = 0;
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t iter = 0; iter < BenchmarkIterations; iter ++) {
+			for (int32_t i : order) {
+				alive += ecs_is_alive(world, entities[i]);
+			}
+		}
+	});
+
+	ReportThroughput(TEXT("is_alive"), elapsed);
+
+	test_int(alive, BenchmarkIterations * (BenchmarkEntityCount / 2));
+}
+
+void EntityIndexBenchmark_get_n_random(void) {
+	flecs::world world;
+	TArray<flecs::entity> entities;
+	TArray<int32_t> order;
+	PopulateWorld(world, entities, order);
+
+	TArray<ecs_entity_t> ids;
+	ids.Reserve(BenchmarkEntityCount);
+	for (int32_t i : order) {
+		ids.Add(entities[i]);
+	}
+
+	TArray<const void*> ptrs;
+	ptrs.SetNumUninitialized(BenchmarkEntityCount);
+
+	double sum = 0;
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t iter = 0; iter < BenchmarkIterations; iter ++) {
+			ecs_get_id_n(world, ids.GetData(), ids.Num(), world.id<Position>(), 
+				ptrs.GetData());
+			for (const void *ptr : ptrs) {
+				sum += static_cast<const Position*>(ptr)->x;
+			}
+		}
+	});
+
+	ReportThroughput(TEXT("get_n"), elapsed);
+
+	const double n = BenchmarkEntityCount;
+	test_assert(sum == BenchmarkIterations * (n * (n - 1) / 2));
+}
+
+void EntityIndexBenchmark_is_alive_n_random(void) {
+	flecs::world world;
+	TArray<flecs::entity> entities;
+	TArray<int32_t> order;
+	PopulateWorld(world, entities, order);
+
+	for (int32_t i = 0; i < BenchmarkEntityCount; i += 2) {
+		entities[i].destruct();
+	}
+
+	TArray<ecs_entity_t> ids;
+	ids.Reserve(BenchmarkEntityCount);
+	for (int32_t i : order) {
+		ids.Add(entities[i]);
+	}
+
+	TArray<bool> is_alive;
+	is_alive.SetNumUninitialized(BenchmarkEntityCount);
+
+	int32_t alive = 0;
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t iter = 0; iter < BenchmarkIterations; iter ++) {
+			alive += ecs_is_alive_n(world, ids.GetData(), ids.Num(), 
+				is_alive.GetData());
+		}
+	});
+
+	ReportThroughput(TEXT("is_alive_n"), elapsed);
+
+	test_int(alive, BenchmarkIterations * (BenchmarkEntityCount / 2));
+	for (int32_t i = 0; i < ids.Num(); i ++) {
+		test_bool(is_alive[i], ecs_is_alive(world, ids[i]));
+	}
+}
+
+END_DEFINE_SPEC(FFlecsEntityIndexBenchmarkTestsSpec);
+
+void FFlecsEntityIndexBenchmarkTestsSpec::Define()
+{
+	It("EntityIndexBenchmark_get_random", [&]() { EntityIndexBenchmark_get_random(); });
+	It("EntityIndexBenchmark_is_alive_random", [&]() { EntityIndexBenchmark_is_alive_random(); });
+	It("EntityIndexBenchmark_get_n_random", [&]() { EntityIndexBenchmark_get_n_random(); });
+	It("EntityIndexBenchmark_is_alive_n_random", [&]() { EntityIndexBenchmark_is_alive_n_random(); });
+}
+
+#endif // WITH_AUTOMATION_TESTS
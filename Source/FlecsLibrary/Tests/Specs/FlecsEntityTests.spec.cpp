@@ -6215,6 +6215,76 @@ void Entity_assign_non_copy_assignable_w_move_assign(void) {
 	test_int(comp->moved, 1);
 }
 
+void Entity_get_n_mixed(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	world.component<Velocity>().add(flecs::DontFragment);
+
+	const flecs::entity base = world.prefab().set<Position>({1, 2});
+	const flecs::entity e1 = world.entity().set<Position>({10, 20});
+	const flecs::entity e2 = world.entity().is_a(base);
+	const flecs::entity e3 = world.entity().set<Velocity>({1, 1});
+	const flecs::entity e4 = world.entity().set<Position>({30, 40});
+	e4.destruct();
+
+	ecs_entity_t ids[] = { e1, 0, e2, e3, e4, e1 };
+	const void *ptrs[6];
+	ecs_get_id_n(world, ids, 6, world.id<Position>(), ptrs);
+
+	test_assert(ptrs[0] == e1.try_get<Position>());
+	test_assert(ptrs[1] == nullptr);
+	test_assert(ptrs[2] == e2.try_get<Position>());
+	test_assert(ptrs[2] != nullptr);
+	test_assert(ptrs[3] == nullptr);
+	test_assert(ptrs[4] == nullptr);
+	test_assert(ptrs[5] == ptrs[0]);
+
+	ecs_get_id_n(world, ids, 6, world.id<Velocity>(), ptrs);
+	test_assert(ptrs[0] == nullptr);
+	test_assert(ptrs[3] == e3.try_get<Velocity>());
+	test_assert(ptrs[3] != nullptr);
+
+	bool is_alive[6];
+	test_int(ecs_is_alive_n(world, ids, 6, is_alive), 4);
+	test_bool(is_alive[1], false);
+	test_bool(is_alive[4], false);
+
+	ecs_record_t *records[6];
+	ecs_record_find_n(world, ids, 6, records);
+	test_assert(records[0] == ecs_record_find(world, e1));
+	test_assert(records[1] == nullptr);
+	test_assert(records[4] == nullptr);
+}
+
+void Entity_high_ids(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	/* Ids far from the last created id only allocate the memory around them */
+	const flecs::entity hi = world.make_alive(3000000000u);
+	hi.set<Position>({10, 20});
+	test_assert(hi.is_alive());
+	test_int(hi.get<Position>().y, 20);
+
+	test_assert(!world.exists(2999999999u));
+	test_assert(!world.exists(3000000001u));
+	test_assert(!world.exists(4000000000u));
+
+	const flecs::entity e = world.entity().set<Position>({30, 40});
+	world.shrink();
+
+	test_assert(hi.is_alive());
+	test_assert(e.is_alive());
+	test_int(hi.get<Position>().y, 20);
+	test_int(e.get<Position>().y, 40);
+
+	hi.destruct();
+	test_assert(!hi.is_alive());
+	test_assert(e.is_alive());
+	test_int(e.get<Position>().y, 40);
+}
+
 END_DEFINE_SPEC(FFlecsEntityTestsSpec);
 
 /*""id": "Entity",
@@ -6574,7 +6644,9 @@ END_DEFINE_SPEC(FFlecsEntityTestsSpec);
                 "set_non_copy_assignable",
                 "set_non_copy_assignable_w_move_assign",
                 "assign_non_copy_assignable",
-                "assign_non_copy_assignable_w_move_assign"
+                "assign_non_copy_assignable_w_move_assign",
+                "get_n_mixed",
+                "high_ids"
                 
             ]*/
 
@@ -6891,6 +6963,8 @@ void FFlecsEntityTestsSpec::Define()
 	It("Entity_set_non_copy_assignable_w_move_assign", [&]() { Entity_set_non_copy_assignable_w_move_assign(); });
 	It("Entity_assign_non_copy_assignable", [&]() { Entity_assign_non_copy_assignable(); });
 	It("Entity_assign_non_copy_assignable_w_move_assign", [&]() { Entity_assign_non_copy_assignable_w_move_assign(); });
+	It("Entity_get_n_mixed", [&]() { Entity_get_n_mixed(); });
+	It("Entity_high_ids", [&]() { Entity_high_ids(); });
 }
 
 #endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,143 @@
+﻿
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS && defined(FLECS_TESTS)
+
+#include "flecs.h"
+
+#include "Bake/FlecsTestUtils.h"
+#include "Bake/FlecsTestTypes.h"
+#include "Bake/FlecsBenchmarkUtils.h"
+
+/* Benchmarks for the name index with named entities per actor. Names repeat 
+ * across parents, so each parent has its own index with the same strings. */
+
+static constexpr int32_t NameIndexParentCount = 100;
+
+BEGIN_DEFINE_SPEC(FFlecsNameIndexBenchmarkTestsSpec,
+                  "FlecsLibrary.NameIndexBenchmark",
+                  FLECS_BENCHMARK_TEST_FLAGS);
+
+const char* FormatName(TArray<ANSICHAR>& buffer, const char* fmt, int32_t value) {
+	buffer.SetNumZeroed(32);
+	FCStringAnsi::Snprintf(buffer.GetData(), buffer.Num(), fmt, value);
+	return buffer.GetData();
+}
+
+void PopulateWorld(flecs::world& world, TArray<flecs::entity>& parents, TArray<flecs::entity>& entities) {
+	TArray<ANSICHAR> buffer;
+
+	for (int32_t i = 0; i < NameIndexParentCount; i ++) {
+		parents.Add(world.entity(FormatName(buffer, "Parent_%d", i)));
+	}
+
+	BenchmarkPopulateWorld(world, BenchmarkEntityCount, entities, 
+		[&](flecs::entity e, int32_t i) {
+			e.child_of(parents[i % NameIndexParentCount])
+				.set_name(FormatName(buffer, "Actor_%d", i / NameIndexParentCount));
+		});
+}
+
+void NameIndexBenchmark_create(void) {
+	flecs::world world;
+	TArray<flecs::entity> parents;
+	TArray<flecs::entity> entities;
+
+	const double elapsed = BenchmarkTime([&]() {
+		PopulateWorld(world, parents, entities);
+	});
+
+	BenchmarkReport(TEXT("create"), elapsed, BenchmarkEntityCount);
+
+	test_int(entities.Num(), BenchmarkEntityCount);
+
+#ifdef FLECS_STATS
+	const ecs_component_index_memory_t memory = ecs_component_index_memory_get(world);
+	test_assert(memory.bytes_name_index > 0);
+
+	AddInfo(FString::Printf(TEXT("name index: %.3f MB (%.1f bytes per name)"), 
+		memory.bytes_name_index / (1024.0 * 1024.0),
+		static_cast<double>(memory.bytes_name_index) / BenchmarkEntityCount));
+#endif
+}
+
+void NameIndexBenchmark_lookup(void) {
+	flecs::world world;
+	TArray<flecs::entity> parents;
+	TArray<flecs::entity> entities;
+	PopulateWorld(world, parents, entities);
+
+	/* Look up in random order, so that the result doesn't depend on names 
+	 * being allocated in the order in which they're looked up. */
+	const TArray<int32_t> order = BenchmarkShuffle(BenchmarkEntityCount);
+
+	static constexpr int32_t NameSize = 16;
+	TArray<ANSICHAR> names;
+	names.SetNumZeroed(BenchmarkEntityCount * NameSize);
+	for (int32_t i = 0; i < BenchmarkEntityCount; i ++) {
+		FCStringAnsi::Snprintf(&names[i * NameSize], NameSize, 
+			"Actor_%d", i / NameIndexParentCount);
+	}
+
+	int32_t mismatches = 0;
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t iter = 0; iter < BenchmarkIterations; iter ++) {
+			for (int32_t i : order) {
+				const flecs::entity e = parents[i % NameIndexParentCount]
+					.lookup(&names[i * NameSize]);
+				mismatches += e != entities[i];
+			}
+		}
+	});
+
+	BenchmarkReport(TEXT("lookup"), elapsed, 
+		static_cast<double>(BenchmarkIterations) * BenchmarkEntityCount);
+
+	test_int(mismatches, 0);
+	test_assert(!parents[0].lookup("Actor_unknown"));
+}
+
+void NameIndexBenchmark_rename_delete(void) {
+	flecs::world world;
+	TArray<flecs::entity> parents;
+	TArray<flecs::entity> entities;
+	PopulateWorld(world, parents, entities);
+
+	TArray<ANSICHAR> buffer;
+
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t i = 0; i < BenchmarkEntityCount; i += 2) {
+			entities[i].set_name(FormatName(buffer, "Renamed_%d", i));
+		}
+		for (int32_t i = 1; i < BenchmarkEntityCount; i += 2) {
+			entities[i].destruct();
+		}
+	});
+
+	BenchmarkReport(TEXT("rename + delete"), elapsed, BenchmarkEntityCount);
+
+	for (int32_t i = 0; i < BenchmarkEntityCount; i += 1000) {
+		const flecs::entity parent = parents[i % NameIndexParentCount];
+		test_assert(!parent.lookup(FormatName(buffer, "Actor_%d", i / NameIndexParentCount)));
+		test_assert(parent.lookup(FormatName(buffer, "Renamed_%d", i)) == entities[i]);
+	}
+
+	/* Names of deleted entities can be reused */
+	for (int32_t i = 1; i < BenchmarkEntityCount; i += 1000) {
+		const flecs::entity parent = parents[i % NameIndexParentCount];
+		const flecs::entity e = world.entity().child_of(parent)
+			.set_name(FormatName(buffer, "Actor_%d", i / NameIndexParentCount));
+		test_assert(parent.lookup(FormatName(buffer, "Actor_%d", i / NameIndexParentCount)) == e);
+	}
+}
+
+END_DEFINE_SPEC(FFlecsNameIndexBenchmarkTestsSpec);
+
+void FFlecsNameIndexBenchmarkTestsSpec::Define()
+{
+	It("NameIndexBenchmark_create", [&]() { NameIndexBenchmark_create(); });
+	It("NameIndexBenchmark_lookup", [&]() { NameIndexBenchmark_lookup(); });
+	It("NameIndexBenchmark_rename_delete", [&]() { NameIndexBenchmark_rename_delete(); });
+}
+
+#endif // WITH_AUTOMATION_TESTS
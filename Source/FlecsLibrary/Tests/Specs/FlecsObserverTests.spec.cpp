@@ -1687,6 +1687,451 @@ void Observer_untyped_field(void) {
 	test_int(count, 1);
 }
 
+void Observer_batched_on_add(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<MyTag>();
+
+	int32_t invoked = 0, count = 0;
+
+	world.observer()
+		.with<MyTag>()
+		.event(flecs::OnAdd)
+		.batched()
+		.run([&](flecs::iter& it) {
+			while (it.next()) {
+				invoked ++;
+				count += it.count();
+			}
+		});
+
+	flecs::entity entities[100];
+	for (int32_t i = 0; i < 100; i ++) {
+		entities[i] = world.entity();
+		if (i % 2) {
+			entities[i].add<Position>();
+		}
+	}
+
+	entities[0].add<MyTag>();
+	test_int(invoked, 1);
+	test_int(count, 1);
+	entities[0].remove<MyTag>();
+
+	invoked = 0;
+	count = 0;
+
+	world.defer_begin();
+	for (int32_t i = 0; i < 100; i ++) {
+		entities[i].add<MyTag>();
+	}
+	test_int(invoked, 0);
+	world.defer_end();
+
+	test_int(invoked, 2);
+	test_int(count, 100);
+}
+
+void Observer_batched_on_set(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	int32_t invoked = 0, count = 0;
+
+	world.observer<const Position>()
+		.event(flecs::OnSet)
+		.batched()
+		.run([&](flecs::iter& it) {
+			while (it.next()) {
+				auto p = it.field<const Position>(0);
+				for (auto i : it) {
+					test_int(p[i].x, 10);
+					test_int(p[i].y, 20);
+				}
+				invoked ++;
+				count += it.count();
+			}
+		});
+
+	flecs::entity deleted;
+
+	world.defer_begin();
+	for (int32_t i = 0; i < 10; i ++) {
+		flecs::entity e = world.entity().set(Position{10, 20});
+		if (i == 5) {
+			deleted = e;
+		}
+	}
+	deleted.destruct();
+	world.defer_end();
+
+	test_int(count, 9);
+	test_assert(invoked >= 1);
+}
+
+void Observer_batched_add_in_callback(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<MyTag>();
+
+	int32_t count = 0;
+
+	world.observer()
+		.with<MyTag>()
+		.event(flecs::OnAdd)
+		.batched()
+		.run([&](flecs::iter& it) {
+			while (it.next()) {
+				for (auto i : it) {
+					it.entity(i).add<Tag>();
+				}
+				count += static_cast<int32>(it.count());
+			}
+		});
+
+	flecs::entity entities[10];
+
+	/* Operations of batched observers are deferred while batches are flushed */
+	world.defer_begin();
+	for (int32_t i = 0; i < 10; i ++) {
+		entities[i] = world.entity().add<MyTag>();
+	}
+	world.defer_end();
+
+	test_int(count, 10);
+	for (int32_t i = 0; i < 10; i ++) {
+		test_assert(entities[i].has<Tag>());
+	}
+
+	flecs::entity e = world.entity().add<MyTag>();
+	test_int(count, 11);
+	test_assert(e.has<Tag>());
+}
+
+void Observer_batched_benchmark(void) {
+	static constexpr int32_t EntityCount = 50000;
+
+	for (bool batched : { false, true }) {
+		flecs::world world;
+		RegisterTestTypeComponents(world);
+		world.component<MyTag>();
+
+		int32_t invoked = 0, count = 0;
+
+		world.observer()
+			.with<MyTag>()
+			.event(flecs::OnAdd)
+			.batched(batched)
+			.run([&](flecs::iter& it) {
+				while (it.next()) {
+					invoked ++;
+					count += it.count();
+				}
+			});
+
+		TArray<flecs::entity> entities;
+		for (int32_t i = 0; i < EntityCount; i ++) {
+			entities.Add(world.entity().add<Position>());
+		}
+
+		const double start = FPlatformTime::Seconds();
+		world.defer_begin();
+		for (flecs::entity e : entities) {
+			e.add<MyTag>();
+		}
+		world.defer_end();
+		const double elapsed = FPlatformTime::Seconds() - start;
+
+		test_int(count, EntityCount);
+		if (batched) {
+			test_int(invoked, 1);
+		} else {
+			test_int(invoked, EntityCount);
+		}
+
+		AddInfo(FString::Printf(TEXT("%s: %.3f ms for %d entities, %d invocations"), 
+			batched ? TEXT("batched") : TEXT("unbatched"), 
+			elapsed * 1000.0, EntityCount, invoked));
+	}
+}
+
+void Observer_async_on_set(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<MyTag>();
+
+	int32_t invoked = 0, count = 0;
+
+	world.observer<const Position>()
+		.event(flecs::OnSet)
+		.async_phase(flecs::OnStore)
+		.run([&](flecs::iter& it) {
+			while (it.next()) {
+				test_assert(it.world().is_deferred());
+				auto p = it.field<const Position>(0);
+				for (auto i : it) {
+					test_int(p[i].x, 10);
+					test_int(p[i].y, 20);
+					it.entity(i).add<MyTag>();
+				}
+				invoked ++;
+				count += it.count();
+			}
+		});
+
+	flecs::entity e1 = world.entity().set(Position{10, 20});
+	flecs::entity e2 = world.entity().set(Position{10, 20});
+	flecs::entity e3 = world.entity().set(Position{10, 20});
+	e2.destruct();
+
+	test_int(invoked, 0);
+
+	world.progress();
+
+	test_int(count, 2);
+	test_assert(e1.has<MyTag>());
+	test_assert(e3.has<MyTag>());
+
+	world.progress();
+	test_int(count, 2);
+}
+
+void Observer_async_multi_threaded(void) {
+	static constexpr int32_t EntityCount = 1000;
+
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<MyTag>();
+
+	world.set_threads(4);
+
+	int32_t count = 0;
+
+	world.observer<const Position>()
+		.event(flecs::OnSet)
+		.async_phase(flecs::OnStore)
+		.run([&](flecs::iter& it) {
+			while (it.next()) {
+				for (auto i : it) {
+					it.entity(i).add<MyTag>();
+				}
+				FPlatformAtomics::InterlockedAdd(&count, static_cast<int32>(it.count()));
+			}
+		});
+
+	for (int32_t i = 0; i < EntityCount; i ++) {
+		world.entity().set(Position{10, 20});
+	}
+
+	world.progress();
+
+	test_int(count, EntityCount);
+	test_int(world.count<MyTag>(), EntityCount);
+}
+
+void Observer_async_on_set_dedupe(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	int32_t count = 0;
+
+	world.observer<const Position>()
+		.event(flecs::OnSet)
+		.async_phase(flecs::OnStore)
+		.each([&](const Position& p) {
+			test_int(p.x, 30);
+			count ++;
+		});
+
+	/* Repeated events for an entity are queued once, and deliver the value at
+	 * the time the observer runs */
+	flecs::entity e = world.entity().set(Position{10, 20});
+	e.set(Position{20, 20});
+	e.add<Tag>();
+	e.set(Position{30, 20});
+
+	world.progress();
+	test_int(count, 1);
+
+	e.set(Position{30, 20});
+	world.progress();
+	test_int(count, 2);
+}
+
+void Observer_on_set_propagate_cached(void) {
+	flecs::world ecs;
+
+	ecs.component<Position>().add(flecs::OnInstantiate, flecs::Inherit);
+
+	int32_t instance_count = 0, child_count = 0;
+
+	ecs.observer<Position>()
+		.term_at(0).up(flecs::IsA)
+		.event(flecs::OnSet)
+		.each([&](Position& p) {
+			instance_count ++;
+		});
+
+	ecs.observer<Position>()
+		.term_at(0).up(flecs::ChildOf)
+		.event(flecs::OnSet)
+		.each([&](Position& p) {
+			child_count ++;
+		});
+
+	auto p = ecs.prefab().set(Position{10, 20});
+
+	TArray<flecs::entity> instances;
+	for (int32_t i = 0; i < 10; i ++) {
+		flecs::entity inst = ecs.entity().is_a(p);
+		ecs.entity().child_of(inst);
+		instances.Add(inst);
+	}
+
+	/* Instantiating already emits OnSet for the inherited component */
+	instance_count = child_count = 0;
+	p.set(Position{20, 30});
+	test_int(instance_count, 10);
+	test_int(child_count, 10);
+
+	const int64_t cached = ecs.get_info()->event_forward_cached_total;
+	p.set(Position{30, 40});
+	test_int(instance_count, 20);
+	test_int(child_count, 20);
+	test_assert(ecs.get_info()->event_forward_cached_total > cached);
+
+	/* New instance invalidates cache */
+	flecs::entity inst = ecs.entity().is_a(p);
+	ecs.entity().child_of(inst);
+	instance_count = child_count = 0;
+	p.set(Position{40, 50});
+	test_int(instance_count, 11);
+	test_int(child_count, 11);
+
+	/* Deleted instance invalidates cache */
+	instances[0].destruct();
+	instance_count = child_count = 0;
+	p.set(Position{50, 60});
+	test_int(instance_count, 10);
+	test_int(child_count, 10);
+}
+
+void Observer_on_remove_up_multi_level(void) {
+	flecs::world ecs;
+
+	ecs.component<Position>().add(flecs::OnInstantiate, flecs::Inherit);
+
+	int32_t instance_count = 0, child_count = 0;
+
+	ecs.observer<const Position>()
+		.term_at(0).up(flecs::IsA)
+		.event(flecs::OnRemove)
+		.each([&](const Position& p) {
+			instance_count ++;
+		});
+
+	ecs.observer<const Position>()
+		.term_at(0).up(flecs::ChildOf)
+		.event(flecs::OnRemove)
+		.each([&](const Position& p) {
+			child_count ++;
+		});
+
+	flecs::entity base = ecs.entity();
+	flecs::entity mid = ecs.entity().is_a(base);
+	flecs::entity inst = ecs.entity().is_a(mid);
+	ecs.entity().child_of(inst);
+
+	base.set(Position{10, 20});
+	test_int(inst.try_get<Position>()->x, 10);
+
+	mid.set(Position{20, 30});
+	test_int(inst.try_get<Position>()->x, 20);
+
+	base.remove<Position>();
+	test_int(instance_count, 2);
+	test_int(child_count, 1);
+	test_int(inst.try_get<Position>()->x, 20);
+
+	mid.remove<Position>();
+	test_int(instance_count, 3);
+	test_int(child_count, 2);
+	test_assert(inst.try_get<Position>() == nullptr);
+
+	/* Tables that inherited from base must not still point to it */
+	mid.set(Position{30, 40});
+	test_int(inst.try_get<Position>()->x, 30);
+
+	mid.remove<Position>();
+	test_int(instance_count, 4);
+	test_int(child_count, 3);
+}
+
+void Observer_on_set_propagate_forward_existing_table(void) {
+	flecs::world ecs;
+
+	ecs.component<Position>().add(flecs::OnInstantiate, flecs::Inherit);
+	ecs.component<Tag>();
+
+	flecs::entity a = ecs.entity(), b = ecs.entity(), c = ecs.entity();
+	flecs::entity d = ecs.entity(), e = ecs.entity(), f = ecs.entity();
+
+	int32_t add_count = 0, set_count = 0, remove_count = 0;
+
+	ecs.observer<const Position>()
+		.term_at(0).up(flecs::IsA)
+		.event(flecs::OnAdd)
+		.event(flecs::OnSet)
+		.event(flecs::OnRemove)
+		.each([&](flecs::iter& it, size_t row, const Position& p) {
+			if (it.entity(row) != f) {
+				return;
+			}
+
+			if (it.event() == flecs::OnAdd) {
+				add_count ++;
+			} else if (it.event() == flecs::OnSet) {
+				set_count ++;
+			} else {
+				remove_count ++;
+			}
+		});
+
+	b.is_a(a);
+
+	ecs.defer_begin();
+	a.set(Position{10, 20});
+	d.add<Tag>();
+	d.is_a(a);
+	ecs.defer_end();
+
+	ecs.defer_begin();
+	c.set(Position{20, 30});
+	b.add<Tag>();
+	b.is_a(c);
+	ecs.defer_end();
+
+	d.child_of(e);
+	c.add<Tag>();
+	d.remove<Tag>();
+
+	/* The OnSet propagated for c must not leave a stale reachable cache for
+	 * (IsA, c) behind, which f is forwarded from when it moves to the table of
+	 * b, which already exists */
+	ecs.defer_begin();
+	c.set(Position{30, 40});
+	f.add<Tag>();
+	f.is_a(c);
+	ecs.defer_end();
+
+	test_int(add_count, 1);
+	test_int(set_count, 1);
+	test_int(remove_count, 0);
+
+	f.remove(flecs::IsA, c);
+	test_int(remove_count, 1);
+}
+
 END_DEFINE_SPEC(FFlecsObserverTestsSpec);
 
 /*"id": "Observer",
@@ -1754,7 +2199,17 @@ END_DEFINE_SPEC(FFlecsObserverTestsSpec);
                 "trigger_on_set_in_on_add_implicit_registration_namespaced",
                 "fixed_src_w_each",
                 "fixed_src_w_run",
-                "untyped_field"
+                "untyped_field",
+                "batched_on_add",
+                "batched_on_set",
+                "batched_add_in_callback",
+                "batched_benchmark",
+                "async_on_set",
+                "async_multi_threaded",
+                "async_on_set_dedupe",
+                "on_set_propagate_cached",
+                "on_remove_up_multi_level",
+                "on_set_propagate_forward_existing_table"
             ]*/
 
 void FFlecsObserverTestsSpec::Define()
@@ -1823,6 +2278,16 @@ void FFlecsObserverTestsSpec::Define()
 	It("fixed_src_w_each", [&]() { Observer_fixed_src_w_each(); });
 	It("fixed_src_w_run", [&]() { Observer_fixed_src_w_run(); });
 	It("untyped_field", [&]() { Observer_untyped_field(); });
+	It("batched_on_add", [&]() { Observer_batched_on_add(); });
+	It("batched_on_set", [&]() { Observer_batched_on_set(); });
+	It("batched_add_in_callback", [&]() { Observer_batched_add_in_callback(); });
+	It("batched_benchmark", [&]() { Observer_batched_benchmark(); });
+	It("async_on_set", [&]() { Observer_async_on_set(); });
+	It("async_multi_threaded", [&]() { Observer_async_multi_threaded(); });
+	It("async_on_set_dedupe", [&]() { Observer_async_on_set_dedupe(); });
+	It("on_set_propagate_cached", [&]() { Observer_on_set_propagate_cached(); });
+	It("on_remove_up_multi_level", [&]() { Observer_on_remove_up_multi_level(); });
+	It("on_set_propagate_forward_existing_table", [&]() { Observer_on_set_propagate_forward_existing_table(); });
 }
 
 #endif // WITH_AUTOMATION_TESTS
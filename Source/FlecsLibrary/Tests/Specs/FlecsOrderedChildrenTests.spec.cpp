@@ -3,6 +3,8 @@
 
 #if WITH_AUTOMATION_TESTS && defined(FLECS_TESTS)
 
+#include <algorithm>
+
 #include "flecs.h"
 
 #include "Bake/FlecsTestUtils.h"
@@ -98,6 +100,220 @@ void OrderedChildren_set_child_order(void) {
     }
 }
 
+void OrderedChildren_children_n_blocks(void) {
+    flecs::world world;
+
+    flecs::entity parent = world.entity().add(flecs::OrderedChildren);
+
+    std::vector<flecs::entity> children;
+    for (int i = 0; i < 1000; i ++) {
+        children.push_back(world.entity().child_of(parent));
+    }
+
+    std::vector<flecs::entity> v;
+    parent.children([&](flecs::entity e) {
+        v.push_back(e);
+    });
+
+    test_int(v.size(), 1000);
+    test_assert(v == children);
+
+    ecs_entities_t ordered = ecs_get_ordered_children(world, parent);
+    test_int(ordered.count, 1000);
+    for (int i = 0; i < 1000; i ++) {
+        test_assert(ordered.ids[i] == children[i]);
+    }
+}
+
+void OrderedChildren_remove_n_blocks(void) {
+    flecs::world world;
+
+    flecs::entity parent = world.entity().add(flecs::OrderedChildren);
+
+    std::vector<flecs::entity> children;
+    for (int i = 0; i < 1000; i ++) {
+        children.push_back(world.entity().child_of(parent));
+    }
+
+    std::vector<flecs::entity> expect;
+    for (int i = 0; i < 1000; i ++) {
+        if (i % 3) {
+            children[i].destruct();
+        } else {
+            expect.push_back(children[i]);
+        }
+    }
+
+    std::vector<flecs::entity> v;
+    parent.children([&](flecs::entity e) {
+        v.push_back(e);
+    });
+
+    test_assert(v == expect);
+
+    ecs_entities_t ordered = ecs_get_ordered_children(world, parent);
+    test_int(ordered.count, static_cast<int32_t>(expect.size()));
+    for (int32_t i = 0; i < ordered.count; i ++) {
+        test_assert(ordered.ids[i] == expect[i]);
+    }
+}
+
+void OrderedChildren_reparent_n_blocks(void) {
+    flecs::world world;
+
+    flecs::entity parent_a = world.entity().add(flecs::OrderedChildren);
+    flecs::entity parent_b = world.entity().add(flecs::OrderedChildren);
+
+    std::vector<flecs::entity> children;
+    for (int i = 0; i < 600; i ++) {
+        children.push_back(world.entity().child_of(parent_a));
+    }
+
+    std::vector<flecs::entity> expect_a, expect_b;
+    for (int i = 599; i >= 0; i --) {
+        if (i % 2) {
+            children[i].child_of(parent_b);
+            expect_b.push_back(children[i]);
+        }
+    }
+
+    for (int i = 0; i < 600; i += 2) {
+        expect_a.push_back(children[i]);
+    }
+
+    std::vector<flecs::entity> a, b;
+    parent_a.children([&](flecs::entity e) { a.push_back(e); });
+    parent_b.children([&](flecs::entity e) { b.push_back(e); });
+
+    test_assert(a == expect_a);
+    test_assert(b == expect_b);
+}
+
+void OrderedChildren_set_child_order_n_blocks(void) {
+    flecs::world world;
+
+    flecs::entity parent = world.entity().add(flecs::OrderedChildren);
+
+    std::vector<flecs::entity_t> children;
+    for (int i = 0; i < 1000; i ++) {
+        children.push_back(world.entity().child_of(parent));
+    }
+
+    std::reverse(children.begin(), children.end());
+    parent.set_child_order(children.data(), 1000);
+
+    {
+        std::vector<flecs::entity_t> v;
+        parent.children([&](flecs::entity e) {
+            v.push_back(e);
+        });
+
+        test_assert(v == children);
+    }
+
+    /* Reorder the array returned by get_ordered_children in place */
+    ecs_entities_t ordered = ecs_get_ordered_children(world, parent);
+    flecs::entity_t *ids = const_cast<flecs::entity_t*>(ordered.ids);
+    std::reverse(ids, ids + ordered.count);
+    parent.set_child_order(ids, ordered.count);
+
+    {
+        std::vector<flecs::entity_t> v;
+        parent.children([&](flecs::entity e) {
+            v.push_back(e);
+        });
+
+        std::reverse(children.begin(), children.end());
+        test_assert(v == children);
+    }
+}
+
+/* Scale benchmarks for parents with many children, like world partition cells.
+ * Timings are reported with AddInfo. */
+static constexpr int OrderedChildrenScaleCount = 50000;
+
+void OrderedChildren_scale_add(void) {
+    flecs::world world;
+    world.component<Position>();
+
+    flecs::entity parent = world.entity().add(flecs::OrderedChildren);
+
+    const double start = FPlatformTime::Seconds();
+    for (int i = 0; i < OrderedChildrenScaleCount; i ++) {
+        world.entity().child_of(parent).add<Position>();
+    }
+    const double elapsed = FPlatformTime::Seconds() - start;
+
+    AddInfo(FString::Printf(TEXT("add: %.1f ns per child"),
+        (elapsed * 1000000000.0) / OrderedChildrenScaleCount));
+
+    int32_t count = 0;
+    parent.children([&](flecs::entity) {
+        count ++;
+    });
+
+    test_int(count, OrderedChildrenScaleCount);
+}
+
+void OrderedChildren_scale_remove_random(void) {
+    flecs::world world;
+
+    flecs::entity parent = world.entity().add(flecs::OrderedChildren);
+
+    TArray<flecs::entity> children;
+    for (int i = 0; i < OrderedChildrenScaleCount; i ++) {
+        children.Add(world.entity().child_of(parent));
+    }
+
+    TArray<flecs::entity> shuffled = children;
+    FRandomStream random(1);
+    for (int32 i = shuffled.Num() - 1; i > 0; i --) {
+        shuffled.Swap(i, random.RandRange(0, i));
+    }
+
+    const int32 remove_count = OrderedChildrenScaleCount / 2;
+    const double start = FPlatformTime::Seconds();
+    for (int32 i = 0; i < remove_count; i ++) {
+        shuffled[i].destruct();
+    }
+    const double elapsed = FPlatformTime::Seconds() - start;
+
+    AddInfo(FString::Printf(TEXT("remove random: %.1f ns per child"),
+        (elapsed * 1000000000.0) / remove_count));
+
+    /* Remaining children are still in creation order */
+    int32 index = 0;
+    bool in_order = true;
+    parent.children([&](flecs::entity e) {
+        while (index < children.Num() && !children[index].is_alive()) {
+            index ++;
+        }
+
+        in_order &= index < children.Num() && children[index] == e;
+        index ++;
+    });
+
+    test_assert(in_order);
+}
+
+void OrderedChildren_scale_delete_parent(void) {
+    flecs::world world;
+
+    flecs::entity parent = world.entity().add(flecs::OrderedChildren);
+    for (int i = 0; i < OrderedChildrenScaleCount; i ++) {
+        world.entity().child_of(parent);
+    }
+
+    const double start = FPlatformTime::Seconds();
+    parent.destruct();
+    const double elapsed = FPlatformTime::Seconds() - start;
+
+    AddInfo(FString::Printf(TEXT("delete parent: %.1f ns per child"),
+        (elapsed * 1000000000.0) / OrderedChildrenScaleCount));
+
+    test_assert(!parent.is_alive());
+}
+
 END_DEFINE_SPEC(FFlecsOrderedChildrenTestsSpec);
 
 /*{
@@ -106,7 +322,14 @@ END_DEFINE_SPEC(FFlecsOrderedChildrenTestsSpec);
 "iter_no_children",
 "children_1_table",
 "children_2_tables",
-"set_child_order"
+"set_child_order",
+"children_n_blocks",
+"remove_n_blocks",
+"reparent_n_blocks",
+"set_child_order_n_blocks",
+"scale_add",
+"scale_remove_random",
+"scale_delete_parent"
 ]*/
 
 void FFlecsOrderedChildrenTestsSpec::Define()
@@ -115,6 +338,13 @@ void FFlecsOrderedChildrenTestsSpec::Define()
     It("children_1_table", [this]() { OrderedChildren_children_1_table(); });
     It("children_2_tables", [this]() { OrderedChildren_children_2_tables(); });
     It("set_child_order", [this]() { OrderedChildren_set_child_order(); });
+    It("children_n_blocks", [this]() { OrderedChildren_children_n_blocks(); });
+    It("remove_n_blocks", [this]() { OrderedChildren_remove_n_blocks(); });
+    It("reparent_n_blocks", [this]() { OrderedChildren_reparent_n_blocks(); });
+    It("set_child_order_n_blocks", [this]() { OrderedChildren_set_child_order_n_blocks(); });
+    It("scale_add", [this]() { OrderedChildren_scale_add(); });
+    It("scale_remove_random", [this]() { OrderedChildren_scale_remove_random(); });
+    It("scale_delete_parent", [this]() { OrderedChildren_scale_delete_parent(); });
 }
 
 
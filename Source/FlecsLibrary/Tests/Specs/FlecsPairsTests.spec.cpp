@@ -1404,6 +1404,165 @@ void Pairs_modified_tag_first(void) {
     test_int(count, 1);
 }
 
+void Pairs_delete_empty_tables_reclaim_pair(void) {
+    flecs::world ecs;
+
+    flecs::entity rel = ecs.entity();
+    flecs::entity tgt = ecs.entity();
+
+    flecs::entity e = ecs.entity().add(rel, tgt);
+    int32_t pair_count = ecs_get_world_info(ecs)->pair_id_count;
+
+    e.destruct();
+
+    ecs_delete_empty_tables_desc_t desc = {};
+    desc.delete_generation = 1;
+
+    /* Tables are deleted on the second call, pair records on the next */
+    int32_t deleted_count = ecs_delete_empty_tables(ecs, &desc);
+    test_int(deleted_count, 0);
+    deleted_count = ecs_delete_empty_tables(ecs, &desc);
+    test_assert(deleted_count > 0);
+    test_assert(ecs_component_index_memory_get(ecs).reclaim_count > 0);
+    test_int(ecs_get_world_info(ecs)->pair_id_count, pair_count);
+
+    ecs_delete_empty_tables(ecs, &desc);
+    test_int(ecs_component_index_memory_get(ecs).reclaim_count, 0);
+    test_int(ecs_get_world_info(ecs)->pair_id_count, pair_count - 2);
+
+    test_assert(tgt.is_alive());
+    flecs::entity e2 = ecs.entity().add(rel, tgt);
+    test_assert(e2.has(rel, tgt));
+    test_assert(e2.target(rel) == tgt);
+    test_int(ecs.count(rel, tgt), 1);
+}
+
+void Pairs_delete_empty_tables_keep_reused_pair(void) {
+    flecs::world ecs;
+
+    flecs::entity rel = ecs.entity();
+    flecs::entity tgt = ecs.entity();
+
+    ecs.entity().add(rel, tgt).destruct();
+
+    ecs_delete_empty_tables_desc_t desc = {};
+    desc.delete_generation = 1;
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+
+    int32_t pair_count = ecs_get_world_info(ecs)->pair_id_count;
+
+    /* Pair is used again before the queued record is released */
+    flecs::entity e = ecs.entity().add(rel, tgt);
+    ecs_delete_empty_tables(ecs, &desc);
+
+    test_int(ecs_component_index_memory_get(ecs).reclaim_count, 0);
+    test_int(ecs_get_world_info(ecs)->pair_id_count, pair_count);
+    test_assert(e.has(rel, tgt));
+    test_int(ecs.count(rel, tgt), 1);
+}
+
+void Pairs_delete_empty_tables_keep_ordered_children(void) {
+    flecs::world ecs;
+
+    flecs::entity parent = ecs.entity().add(flecs::OrderedChildren);
+    ecs.entity().child_of(parent).destruct();
+
+    ecs_delete_empty_tables_desc_t desc = {};
+    desc.delete_generation = 1;
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+
+    test_int(ecs_get_ordered_children(ecs, parent).count, 0);
+
+    flecs::entity child = ecs.entity().child_of(parent);
+    ecs_entities_t children = ecs_get_ordered_children(ecs, parent);
+    test_int(children.count, 1);
+    test_assert(children.ids[0] == child);
+}
+
+void Pairs_delete_empty_tables_reuse_traversable_target(void) {
+    flecs::world ecs;
+
+    ecs.component<Position>().add(flecs::OnInstantiate, flecs::Inherit);
+
+    int32_t count = 0;
+    ecs.observer<Position>()
+        .term_at(0).up(flecs::IsA)
+        .event(flecs::OnSet)
+        .each([&](Position&) { count ++; });
+
+    flecs::entity base = ecs.entity().set<Position>({10, 20});
+    int32_t pair_count = ecs_get_world_info(ecs)->pair_id_count;
+
+    ecs.entity().is_a(base).destruct();
+
+    ecs_delete_empty_tables_desc_t desc = {};
+    desc.delete_generation = 1;
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+
+    /* (IsA, base) and (*, base) are released while base is alive */
+    test_int(ecs_get_world_info(ecs)->pair_id_count, pair_count);
+    count = 0;
+
+    base.set<Position>({30, 40});
+    test_int(count, 0);
+
+    flecs::entity inst = ecs.entity().is_a(base);
+    test_int(count, 1);
+    test_int(inst.get<Position>().x, 30);
+
+    base.set<Position>({50, 60});
+    test_int(count, 2);
+    test_int(inst.get<Position>().x, 50);
+
+    base.destruct();
+    test_assert(!inst.has(flecs::IsA, base));
+}
+
+void Pairs_delete_empty_tables_reclaim_propagated_pair(void) {
+    flecs::world ecs;
+
+    ecs.component<Position>().add(flecs::OnInstantiate, flecs::Inherit);
+
+    flecs::entity evt = ecs.entity();
+    flecs::entity rel = ecs.entity();
+    flecs::entity base = ecs.entity();
+
+    int32_t count = 0;
+    ecs.observer<Position>()
+        .term_at(0).up(flecs::IsA)
+        .event(evt)
+        .event(flecs::OnSet)
+        .each([&](Position&) { count ++; });
+
+    /* Keeps (*, base) alive while (IsA, base) is released */
+    ecs.entity().add(rel, base);
+
+    ecs.entity().is_a(base).destruct();
+
+    ecs_delete_empty_tables_desc_t desc = {};
+    desc.delete_generation = 1;
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+
+    /* Propagation caches (IsA, base) on (*, base) before it is released */
+    base.set<Position>({10, 20});
+    ecs_delete_empty_tables(ecs, &desc);
+    ecs_delete_empty_tables(ecs, &desc);
+
+    ecs.event(evt).id<Position>().entity(base).emit();
+    test_int(count, 0);
+
+    ecs.entity().is_a(base);
+    count = 0;
+    ecs.event(evt).id<Position>().entity(base).emit();
+    test_int(count, 1);
+}
+
 END_DEFINE_SPEC(FFlecsPairsTestsSpec);
 
 /*"id": "Pairs",
@@ -1477,7 +1636,12 @@ END_DEFINE_SPEC(FFlecsPairsTestsSpec);
                 "set_R_existing_value",
                 "symmetric_w_childof",
                 "modified_tag_second",
-                "modified_tag_first"
+                "modified_tag_first",
+                "delete_empty_tables_reclaim_pair",
+                "delete_empty_tables_keep_reused_pair",
+                "delete_empty_tables_keep_ordered_children",
+                "delete_empty_tables_reuse_traversable_target",
+                "delete_empty_tables_reclaim_propagated_pair"
             ]*/
 
 void FFlecsPairsTestsSpec::Define()
@@ -1552,6 +1716,11 @@ void FFlecsPairsTestsSpec::Define()
     It("Pairs_symmetric_w_childof", [&]() { Pairs_symmetric_w_childof(); });
     It("Pairs_modified_tag_second", [&]() { Pairs_modified_tag_second(); });
     It("Pairs_modified_tag_first", [&]() { Pairs_modified_tag_first(); });
+    It("Pairs_delete_empty_tables_reclaim_pair", [&]() { Pairs_delete_empty_tables_reclaim_pair(); });
+    It("Pairs_delete_empty_tables_keep_reused_pair", [&]() { Pairs_delete_empty_tables_keep_reused_pair(); });
+    It("Pairs_delete_empty_tables_keep_ordered_children", [&]() { Pairs_delete_empty_tables_keep_ordered_children(); });
+    It("Pairs_delete_empty_tables_reuse_traversable_target", [&]() { Pairs_delete_empty_tables_reuse_traversable_target(); });
+    It("Pairs_delete_empty_tables_reclaim_propagated_pair", [&]() { Pairs_delete_empty_tables_reclaim_propagated_pair(); });
     
 }
 
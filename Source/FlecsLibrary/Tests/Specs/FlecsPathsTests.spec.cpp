@@ -309,6 +309,35 @@ void Paths_id_from_str_invalid_pair(void) {
     test_assert(id == 0);
 }
 
+void Paths_name_version(void) {
+    flecs::world ecs;
+
+    uint64_t foo = ecs_name_hash("Foo", 0);
+    test_assert(foo == ecs_name_hash("Foo::Bar", 3));
+
+    uint32_t v = ecs_get_name_version(ecs, foo);
+
+    auto e = ecs.entity("Foo");
+    test_assert(ecs_get_name_version(ecs, foo) != v);
+    v = ecs_get_name_version(ecs, foo);
+
+    auto parent = ecs.entity();
+    e.child_of(parent);
+    test_assert(ecs_get_name_version(ecs, foo) != v);
+    v = ecs_get_name_version(ecs, foo);
+
+    e.set_name("Bar");
+    test_assert(ecs_get_name_version(ecs, foo) != v);
+    v = ecs_get_name_version(ecs, foo);
+
+    ecs.use(parent, "Foo");
+    test_assert(ecs_get_name_version(ecs, foo) != v);
+    v = ecs_get_name_version(ecs, foo);
+
+    parent.destruct();
+    test_assert(ecs_get_name_version(ecs, foo) != v);
+}
+
 END_DEFINE_SPEC(FFlecsPathsTestsSpec);
 
 /*"id": "Paths",
@@ -337,7 +366,8 @@ END_DEFINE_SPEC(FFlecsPathsTestsSpec);
 	"id_from_str_unresolved_pair_from_str",
 	"id_from_str_wildcard_pair_from_str",
 	"id_from_str_any_pair_from_str",
-	"id_from_str_invalid_pair"
+	"id_from_str_invalid_pair",
+	"name_version"
 ]*/
 
 void FFlecsPathsTestsSpec::Define()
@@ -365,6 +395,7 @@ void FFlecsPathsTestsSpec::Define()
 	It("Paths_id_from_str_wildcard_pair_from_str", [this]() { Paths_id_from_str_wildcard_pair_from_str(); });
 	It("Paths_id_from_str_any_pair_from_str", [this]() { Paths_id_from_str_any_pair_from_str(); });
 	It("Paths_id_from_str_invalid_pair", [this]() { Paths_id_from_str_invalid_pair(); });
+	It("Paths_name_version", [this]() { Paths_name_version(); });
 }
 
 #endif // WITH_AUTOMATION_TESTS
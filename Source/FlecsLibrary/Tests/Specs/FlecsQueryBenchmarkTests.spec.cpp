@@ -0,0 +1,221 @@
+﻿
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS && defined(FLECS_TESTS)
+
+#include "flecs.h"
+
+#include "Bake/FlecsTestUtils.h"
+#include "Bake/FlecsTestTypes.h"
+#include "Bake/FlecsBenchmarkUtils.h"
+
+/* Microbenchmarks for the query shapes used in FlecsQueryTests that the query
+ * compiler specializes (And + With, And + With + Not, And + Up, And + Toggle).
+ * Uncached queries are evaluated by the query engine on every iteration, the 
+ * cached variant of the same query is used as reference for the result. */
+
+static constexpr int32_t QueryBenchmarkEntityCount = 10000;
+static constexpr int32_t QueryBenchmarkTableCount = 64;
+static constexpr int32_t QueryBenchmarkIterations = 100;
+
+BEGIN_DEFINE_SPEC(FFlecsQueryBenchmarkTestsSpec,
+                  "FlecsLibrary.QueryBenchmark",
+                  FLECS_BENCHMARK_TEST_FLAGS);
+
+void PopulateWorld(flecs::world& world) {
+	RegisterTestTypeComponents(world);
+
+	world.component<Velocity>().add(flecs::CanToggle);
+
+	flecs::entity tags[QueryBenchmarkTableCount];
+	for (int32_t i = 0; i < QueryBenchmarkTableCount; i ++) {
+		tags[i] = world.entity();
+	}
+
+	flecs::entity parent = world.entity().add<Mass>();
+
+	TArray<flecs::entity> entities;
+	BenchmarkPopulateWorld(world, QueryBenchmarkEntityCount, entities, 
+		[&](flecs::entity e, int32_t i) {
+			e.add<Position>().add(tags[i % QueryBenchmarkTableCount]);
+			if (i % 2) {
+				e.add<Velocity>();
+				if (i % 5 == 0) {
+					e.disable<Velocity>();
+				}
+			}
+			if (i % 3 == 0) {
+				e.add<Mass>();
+			}
+			if (i % 7 == 0) {
+				e.add<Rotation>();
+			}
+			if (i % 4 == 0) {
+				e.child_of(parent);
+			}
+		});
+}
+
+void RunBenchmark(flecs::world& world, const TCHAR* Name, flecs::query_builder<>& builder) {
+	flecs::query<> uncached = builder.cache_kind(flecs::QueryCacheNone).build();
+	flecs::query<> cached = builder.cache_kind(flecs::QueryCacheAuto).build();
+
+	const int32_t expected = cached.count();
+	test_assert(expected > 0);
+
+	int32_t mismatches = 0;
+	const double elapsed = BenchmarkTime([&]() {
+		for (int32_t i = 0; i < QueryBenchmarkIterations; i ++) {
+			int32_t count = 0;
+			uncached.run([&](flecs::iter& it) {
+				while (it.next()) {
+					count += it.count();
+				}
+			});
+			mismatches += count != expected;
+		}
+	});
+
+	BenchmarkReport(Name, elapsed, 
+		static_cast<double>(QueryBenchmarkIterations) * expected);
+
+	test_int(mismatches, 0);
+}
+
+void QueryBenchmark_and_with(void) {
+	flecs::world world;
+	PopulateWorld(world);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Mass>();
+
+	RunBenchmark(world, TEXT("and_with"), builder);
+}
+
+void QueryBenchmark_and_with_not(void) {
+	flecs::world world;
+	PopulateWorld(world);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Mass>()
+		.without<Rotation>();
+
+	RunBenchmark(world, TEXT("and_with_not"), builder);
+}
+
+void QueryBenchmark_and_up(void) {
+	flecs::world world;
+	PopulateWorld(world);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Mass>().up(flecs::ChildOf);
+
+	RunBenchmark(world, TEXT("and_up"), builder);
+}
+
+void QueryBenchmark_and_toggle(void) {
+	flecs::world world;
+	PopulateWorld(world);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Velocity>();
+
+	RunBenchmark(world, TEXT("and_toggle"), builder);
+}
+
+/* Compares a DontFragment (sparse) component with the same component stored in
+ * tables, for add/remove churn and for iterating a query with the component. */
+void RunStorageBenchmark(const TCHAR* Name, bool bSparse) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	if (bSparse) {
+		world.component<Rotation>().add(flecs::DontFragment);
+	}
+
+	flecs::entity tags[QueryBenchmarkTableCount];
+	for (int32_t i = 0; i < QueryBenchmarkTableCount; i ++) {
+		tags[i] = world.entity();
+	}
+
+	TArray<flecs::entity> entities;
+	int32_t expected = 0;
+	BenchmarkPopulateWorld(world, QueryBenchmarkEntityCount, entities, 
+		[&](flecs::entity e, int32_t i) {
+			e.add<Position>().add(tags[i % QueryBenchmarkTableCount]);
+			if ((i / QueryBenchmarkTableCount) % 4) {
+				e.set<Rotation>({ static_cast<float>(i) });
+				expected ++;
+			}
+		});
+
+	double elapsed = BenchmarkTime([&]() {
+		for (int32_t i = 0; i < QueryBenchmarkIterations; i ++) {
+			for (int32_t j = 0; j < entities.Num(); j += 2) {
+				if (entities[j].has<Rotation>()) {
+					entities[j].remove<Rotation>();
+					entities[j].set<Rotation>({ static_cast<float>(j) });
+				}
+			}
+		}
+	});
+
+	BenchmarkReport(*FString::Printf(TEXT("%s churn"), Name), elapsed, 
+		static_cast<double>(QueryBenchmarkIterations) * entities.Num() / 2);
+
+	flecs::query<> q = world.query_builder()
+		.with<Position>()
+		.with<Rotation>()
+		.build();
+
+	int32_t results = 0, mismatches = 0, negative = 0;
+	elapsed = BenchmarkTime([&]() {
+		for (int32_t i = 0; i < QueryBenchmarkIterations; i ++) {
+			int32_t count = 0;
+			results = 0;
+			q.run([&](flecs::iter& it) {
+				while (it.next()) {
+					for (auto row : it) {
+						const Rotation& r = it.field_at<const Rotation>(1, row);
+						negative += r.value < 0;
+					}
+					count += it.count();
+					results ++;
+				}
+			});
+			mismatches += count != expected;
+		}
+	});
+
+	BenchmarkReport(*FString::Printf(TEXT("%s iter (%d results)"), Name, results), 
+		elapsed, static_cast<double>(QueryBenchmarkIterations) * expected);
+
+	test_int(mismatches, 0);
+	test_int(negative, 0);
+}
+
+void QueryBenchmark_sparse_storage(void) {
+	RunStorageBenchmark(TEXT("sparse_storage"), true);
+}
+
+void QueryBenchmark_table_storage(void) {
+	RunStorageBenchmark(TEXT("table_storage"), false);
+}
+
+END_DEFINE_SPEC(FFlecsQueryBenchmarkTestsSpec);
+
+void FFlecsQueryBenchmarkTestsSpec::Define()
+{
+	It("QueryBenchmark_and_with", [&]() { QueryBenchmark_and_with(); });
+	It("QueryBenchmark_and_with_not", [&]() { QueryBenchmark_and_with_not(); });
+	It("QueryBenchmark_and_up", [&]() { QueryBenchmark_and_up(); });
+	It("QueryBenchmark_and_toggle", [&]() { QueryBenchmark_and_toggle(); });
+	It("QueryBenchmark_sparse_storage", [&]() { QueryBenchmark_sparse_storage(); });
+	It("QueryBenchmark_table_storage", [&]() { QueryBenchmark_table_storage(); });
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -116,6 +116,28 @@ int compare_position(
 	return (p1->x > p2->x) - (p1->x < p2->x);
 }
 
+static
+uint64_t key_position(
+	flecs::entity_t e,
+	const Position *p)
+{
+	return ecs_order_by_key_f64(p->x);
+}
+
+static
+uint64_t group_by_large_id(
+	flecs::world_t *world,
+	flecs::table_t *table,
+	flecs::id_t id,
+	void *ctx)
+{
+	flecs::id_t match;
+	if (ecs_search(world, table, ecs_pair(id, flecs::Wildcard), &match) != -1) {
+		return (1ull << 40) + ECS_PAIR_SECOND(match);
+	}
+	return 0;
+}
+
 static int invoked_count = 0;
 
 BEGIN_DEFINE_SPEC(FFlecsQueryTestsSpec,
@@ -3829,6 +3851,704 @@ void Query_copy_operators(void) {
 	test_assert(copyAssign.c_ptr() == defaultInit.c_ptr());
 }
 
+void Query_toggle_row_mask(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	world.component<Position>().add(flecs::CanToggle);
+
+	flecs::entity e1 = world.entity().add<Position>().enable<Position>();
+	flecs::entity e2 = world.entity().add<Position>().disable<Position>();
+	flecs::entity e3 = world.entity().add<Position>().enable<Position>();
+	flecs::entity e4 = world.entity().add<Position>().disable<Position>();
+
+	flecs::query<> q = world.query_builder()
+		.with<Position>()
+		.toggle_row_mask()
+		.build();
+
+	int32_t results = 0, enabled = 0;
+	q.run([&](flecs::iter& it) {
+		while (it.next()) {
+			test_int(it.count(), 4);
+			test_assert(it.row_mask() != nullptr);
+			test_assert(it.entity(0) == e1);
+			test_assert(it.entity(1) == e2);
+			test_assert(it.entity(2) == e3);
+			test_assert(it.entity(3) == e4);
+			test_bool(it.is_enabled(0), true);
+			test_bool(it.is_enabled(1), false);
+			test_bool(it.is_enabled(2), true);
+			test_bool(it.is_enabled(3), false);
+			for (size_t i = 0; i < it.count(); i ++) {
+				enabled += it.is_enabled(i);
+			}
+			results ++;
+		}
+	});
+
+	test_int(results, 1);
+	test_int(enabled, 2);
+}
+
+void Query_up_trav_cache(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity parent = world.entity().add<Position>();
+	flecs::entity child = world.entity().child_of(parent);
+	flecs::entity grandchild = world.entity().child_of(child).add<Velocity>();
+
+	flecs::query<> q = world.query_builder()
+		.with<Velocity>()
+		.with<Position>().up()
+		.build();
+
+	auto expect_src = [&](flecs::entity src) {
+		int32_t count = 0;
+		q.each([&](flecs::iter& it, size_t row) {
+			test_assert(it.entity(row) == grandchild);
+			test_assert(it.src(1) == src);
+			count ++;
+		});
+		test_int(count, 1);
+	};
+
+	expect_src(parent);
+	flecs::query_trav_stats_t stats = q.trav_stats();
+	test_assert(stats.rebuilds > 0);
+
+	/* Nothing moved, second iteration reuses cache entries */
+	expect_src(parent);
+	flecs::query_trav_stats_t reused = q.trav_stats();
+	test_int(reused.rebuilds, stats.rebuilds);
+	test_assert(reused.hits > stats.hits);
+
+	/* Moving an entity in the hierarchy invalidates its entry */
+	child.add<Position>();
+	expect_src(child);
+	test_assert(q.trav_stats().rebuilds > reused.rebuilds);
+
+	child.remove<Position>();
+	expect_src(parent);
+}
+
+void Query_up_trav_cache_recycled_target(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity parent = world.entity().add<Position>();
+	flecs::entity child = world.entity().child_of(parent).add<Velocity>();
+
+	flecs::query<> q = world.query_builder()
+		.with<Velocity>()
+		.with<Position>().up()
+		.build();
+
+	auto expect_src = [&](flecs::entity src) {
+		int32_t count = 0;
+		q.each([&](flecs::iter& it, size_t row) {
+			test_assert(it.entity(row) == child);
+			test_assert(it.src(1) == src);
+			count ++;
+		});
+		test_int(count, 1);
+	};
+
+	expect_src(parent);
+
+	child.remove(flecs::ChildOf, parent);
+	parent.destruct();
+
+	/* Recycled id in the same table, the entry of the deleted parent must be
+	 * recomputed instead of reused */
+	flecs::entity parent_2 = world.entity().add<Position>();
+	test_int((uint32_t)parent_2.id(), (uint32_t)parent.id());
+	test_assert(parent_2 != parent);
+
+	flecs::query_trav_stats_t stats = q.trav_stats();
+	child.child_of(parent_2);
+	expect_src(parent_2);
+	test_assert(q.trav_stats().rebuilds > stats.rebuilds);
+}
+
+void Query_rematch_budget(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity parent = world.entity().add<Position>();
+	world.entity().child_of(parent).add<Velocity>();
+
+	flecs::query<> q1 = world.query_builder()
+		.with<Velocity>()
+		.with<Position>().up()
+		.cached()
+		.build();
+
+	flecs::query<> q2 = world.query_builder()
+		.with<Velocity>()
+		.with<Position>().up()
+		.cached()
+		.build();
+
+	test_int(q1.count(), 1);
+	test_int(q2.count(), 1);
+
+	/* Budget is smaller than a single rematch, so one query per merge */
+	world.set_rematch_budget(0.000000001f);
+	parent.remove<Position>();
+
+	world.readonly_begin();
+	world.readonly_end();
+	test_int(world.get_pending_rematch_count(), 1);
+
+	/* Stale query skips results for which the source lost the component */
+	world.readonly_begin();
+	test_int(q1.count(), 0);
+	test_int(q2.count(), 0);
+	world.readonly_end();
+	test_int(world.get_pending_rematch_count(), 0);
+
+	/* Iterating outside of readonly mode rematches the query first */
+	parent.add<Position>();
+	world.readonly_begin();
+	world.readonly_end();
+	test_int(world.get_pending_rematch_count(), 1);
+	test_int(q1.count(), 1);
+	test_int(q2.count(), 1);
+	test_int(world.get_pending_rematch_count(), 0);
+}
+
+void Query_rematch_budget_iter(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity parent = world.entity().add<Position>();
+	world.entity().child_of(parent).add<Velocity>();
+
+	flecs::query<> q1 = world.query_builder()
+		.with<Velocity>()
+		.with<Position>().up()
+		.cached()
+		.build();
+
+	flecs::query<> q2 = world.query_builder()
+		.with<Velocity>()
+		.with<Position>().up()
+		.cached()
+		.build();
+
+	test_int(q1.count(), 1);
+	test_int(q2.count(), 1);
+
+	/* Budget is large enough to rematch both queries */
+	world.set_rematch_budget(1.0f);
+	parent.remove<Position>();
+
+	/* Iterating a query only rematches that query */
+	test_int(q1.count(), 0);
+	test_int(world.get_pending_rematch_count(), 1);
+	test_int(q2.count(), 0);
+	test_int(world.get_pending_rematch_count(), 0);
+}
+
+void Query_dirty_rows(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity e[150];
+	for (int i = 0; i < 150; i ++) {
+		e[i] = world.entity().set<Position>({10, 20});
+	}
+
+	flecs::query<> q = world.query_builder()
+		.with<const Position>()
+		.dirty_rows()
+		.build();
+
+	int32_t results = 0, count = 0;
+	flecs::entity first;
+	auto run = [&]() {
+		results = 0;
+		count = 0;
+		q.run([&](flecs::iter& it) {
+			while (it.next()) {
+				if (!results) {
+					first = it.entity(0);
+				}
+				results ++;
+				count += it.count();
+			}
+		});
+	};
+
+	run();
+	test_int(results, 1);
+	test_int(count, 150);
+
+	run();
+	test_int(results, 0);
+	test_int(count, 0);
+
+	/* Changes are tracked per chunk of 64 rows */
+	e[3].set<Position>({30, 40});
+	e[140].set<Position>({30, 40});
+
+	run();
+	test_int(results, 2);
+	test_int(count, 64 + 22);
+	test_assert(first == e[0]);
+
+	e[70].set<Position>({50, 60});
+	run();
+	test_int(results, 1);
+	test_int(count, 64);
+	test_assert(first == e[64]);
+
+	/* Adding entities to the table yields the whole table */
+	world.entity().set<Position>({10, 20});
+	run();
+	test_int(results, 1);
+	test_int(count, 151);
+
+	run();
+	test_int(results, 0);
+}
+
+void Query_dirty_rows_w_tag_query(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity Tag = world.entity();
+	for (int i = 0; i < 100; i ++) {
+		world.entity().add(Tag).set<Position>({10, 20});
+	}
+
+	flecs::query<> q = world.query_builder()
+		.with<const Position>()
+		.dirty_rows()
+		.build();
+
+	/* Writes both fields, the tag has no column to mark dirty */
+	flecs::query<> q_tag = world.query_builder()
+		.with(Tag)
+		.with<Position>()
+		.cached()
+		.build();
+
+	auto count = [](const flecs::query<>& InQuery) {
+		int32_t result = 0;
+		InQuery.run([&](flecs::iter& it) {
+			while (it.next()) {
+				result += it.count();
+			}
+		});
+		return result;
+	};
+
+	test_int(count(q), 100);
+	test_int(count(q), 0);
+
+	test_int(count(q_tag), 100);
+	test_int(count(q), 100);
+	test_int(count(q), 0);
+}
+
+void Query_order_by_key(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	world.entity().set<Position>({3, 0});
+	world.entity().set<Position>({-1, 0}).set<Velocity>({0, 0});
+	world.entity().set<Position>({5, 0});
+	world.entity().set<Position>({-4.5, 0});
+	world.entity().set<Position>({2, 0}).set<Velocity>({0, 0});
+	world.entity().set<Position>({0, 0});
+
+	auto q = world.query_builder<Position>()
+		.order_by_key(key_position)
+		.build();
+
+	float expect[] = {-4.5, -1, 0, 2, 3, 5};
+	int32_t count = 0, results = 0;
+	q.run([&](flecs::iter& it) {
+		while (it.next()) {
+			auto p = it.field<Position>(0);
+			for (auto i : it) {
+				test_assert(count < 6);
+				test_flt(p[i].x, expect[count]);
+				count ++;
+			}
+			results ++;
+		}
+	});
+
+	test_int(count, 6);
+	test_int(results, 5);
+}
+
+void Query_order_by_key_parallel(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	/* Enough rows in enough tables to sort tables in multiple tasks */
+	for (int i = 0; i < 10000; i ++) {
+		flecs::entity e = world.entity().set<Position>(
+			{static_cast<float>((i * 7919) % 10007), static_cast<float>(i)});
+		if (i % 2) {
+			e.add<Tag>();
+		}
+	}
+
+	auto q = world.query_builder<Position>()
+		.order_by_key(key_position)
+		.build();
+
+	int32_t count = 0;
+	float prev = -1;
+	q.each([&](Position& p) {
+		test_assert(p.x >= prev);
+		test_flt(p.x, static_cast<float>((static_cast<int32_t>(p.y) * 7919) % 10007));
+		prev = p.x;
+		count ++;
+	});
+
+	test_int(count, 10000);
+}
+
+void Query_order_by_key_resort_mid_frame(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity e1 = world.entity().set<Position>({1, 0});
+	world.entity().set<Position>({2, 0});
+	world.entity().set<Position>({3, 0});
+
+	auto q = world.query_builder<Position>()
+		.order_by_key(key_position)
+		.build();
+
+	world.frame_begin(0);
+
+	flecs::entity first;
+	q.each([&](flecs::entity e, Position&) {
+		if (!first) {
+			first = e;
+		}
+	});
+	test_assert(first == e1);
+
+	/* Changes merged in the middle of a frame must be sorted again */
+	world.defer_begin();
+	e1.set<Position>({4, 0});
+	world.defer_end();
+
+	float expect[] = {2, 3, 4};
+	int32_t count = 0;
+	q.each([&](Position& p) {
+		test_assert(count < 3);
+		test_flt(p.x, expect[count]);
+		count ++;
+	});
+	test_int(count, 3);
+
+	world.frame_end();
+}
+
+void Query_order_by_key_multi_threaded_system(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	world.set_threads(2);
+
+	for (int i = 0; i < 10; i ++) {
+		world.entity().set<Position>({static_cast<float>(10 - i), 0});
+	}
+
+	world.system<Position>()
+		.order_by_key(key_position)
+		.multi_threaded()
+		.each([](Position& p) {
+			p.y ++;
+		});
+
+	world.progress();
+
+	/* Tables are sorted in place before the workers start */
+	auto q = world.query<const Position>();
+
+	int32_t count = 0;
+	float prev = -1;
+	q.each([&](const Position& p) {
+		test_assert(p.x > prev);
+		test_int(p.y, 1);
+		prev = p.x;
+		count ++;
+	});
+
+	test_int(count, 10);
+}
+
+void Query_group_directory(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity Rel = world.entity();
+	flecs::entity TgtA = world.entity();
+	flecs::entity TgtB = world.entity();
+
+	flecs::query<Position> q = world.query_builder<Position>()
+		.group_by(Rel)
+		.build();
+
+	test_int(q.group_count(), 0);
+
+	world.entity().set<Position>({10, 20}).add(Rel, TgtA);
+	world.entity().set<Position>({20, 30}).add(Rel, TgtA);
+	flecs::entity e = world.entity().set<Position>({30, 40}).add(Rel, TgtB);
+	world.entity().set<Position>({40, 50});
+
+	test_int(q.group_count(), 2);
+
+	int32_t entity_count = 0;
+	for (int32_t i = 0; i < q.group_count(); i ++) {
+		const flecs::query_group_info_t *gi = q.group_info_at(i);
+		test_assert(gi != nullptr);
+		test_assert(gi == q.group_info(gi->id));
+		test_int(gi->table_count, 1);
+		entity_count += gi->entity_count;
+	}
+	test_int(entity_count, 3);
+
+	test_int(q.group_info(TgtA)->entity_count, 2);
+	test_int(q.group_info(TgtB)->entity_count, 1);
+	test_int(q.group_info(0)->entity_count, 1);
+
+	e.remove(Rel, TgtB);
+	test_int(q.group_info(TgtB)->entity_count, 0);
+	test_int(q.group_info(0)->entity_count, 2);
+
+	/* Deleting the target deletes the table, which removes the group */
+	TgtB.destruct();
+	test_int(q.group_count(), 1);
+	test_assert(q.group_info(TgtB) == nullptr);
+	test_assert(q.group_info_at(0)->id == TgtA);
+}
+
+void Query_group_entity_count(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::entity Rel = world.entity().add(flecs::Exclusive);
+	flecs::entity TgtA = world.entity();
+	flecs::entity TgtB = world.entity();
+
+	flecs::query<Position> q = world.query_builder<Position>()
+		.group_by(Rel, group_by_large_id)
+		.group_id_offset(1ull << 40)
+		.build();
+
+	const uint64_t GroupA = (1ull << 40) + static_cast<uint32_t>(TgtA.id());
+	const uint64_t GroupB = (1ull << 40) + static_cast<uint32_t>(TgtB.id());
+
+	flecs::entity e1 = world.entity().set<Position>({10, 20}).add(Rel, TgtA);
+	flecs::entity e2 = world.entity().set<Position>({20, 30}).add(Rel, TgtA);
+	world.entity().set<Position>({30, 40}).add(Rel, TgtB);
+
+	test_int(q.group_count(), 2);
+	test_int(q.group_info(GroupA)->entity_count, 2);
+	test_int(q.group_info(GroupB)->entity_count, 1);
+
+	/* Counts follow entities that move between groups or get deleted */
+	e1.add(Rel, TgtB);
+	test_int(q.group_info(GroupA)->entity_count, 1);
+	test_int(q.group_info(GroupB)->entity_count, 2);
+
+	e2.destruct();
+	test_int(q.group_info(GroupA)->entity_count, 0);
+
+	/* Group stays while its table is matched, even if it has no entities */
+	test_int(q.group_count(), 2);
+
+	world.defer_begin();
+	for (int i = 0; i < 10; i ++) {
+		world.entity().set<Position>({0, 0}).add(Rel, TgtA);
+	}
+	world.defer_end();
+	test_int(q.group_info(GroupA)->entity_count, 10);
+
+	/* Deleting all entities with the pair also deletes its tables */
+	world.delete_with(Rel, TgtB);
+	test_int(q.group_count(), 1);
+	test_assert(q.group_info(GroupB) == nullptr);
+	test_int(q.group_info(GroupA)->entity_count, 10);
+}
+
+void Query_share_cache(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::query<Position, const Velocity> q_1 = world.query_builder<Position, const Velocity>()
+		.cached()
+		.share_cache()
+		.build();
+
+	flecs::query<Position, const Velocity> q_2 = world.query_builder<Position, const Velocity>()
+		.cached()
+		.share_cache()
+		.build();
+
+	flecs::query<Position, const Velocity> q_3 = world.query_builder<Position, const Velocity>()
+		.cached()
+		.build();
+
+	test_assert(ecs_query_get_cache_query(q_1) == ecs_query_get_cache_query(q_2));
+	test_assert(ecs_query_get_cache_query(q_1) != ecs_query_get_cache_query(q_3));
+
+	world.entity().set<Position>({10, 20}).set<Velocity>({1, 2});
+	world.entity().set<Position>({20, 30}).set<Velocity>({1, 2}).add<Tag>();
+	world.entity().set<Position>({30, 40});
+
+	test_int(q_1.count(), 2);
+	test_int(q_2.count(), 2);
+	test_int(q_3.count(), 2);
+
+	const flecs::query_snapshot_t *s = q_1.snapshot();
+	test_assert(s == q_2.snapshot());
+	test_int(s->count, 2);
+	test_int(s->entity_count, 2);
+
+	/* Cache outlives the query that created it */
+	q_1.destruct();
+
+	world.entity().set<Position>({40, 50}).set<Velocity>({1, 2});
+	test_int(q_2.count(), 3);
+}
+
+void Query_share_cache_empty(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::query<Position> q_1 = world.query_builder<Position>()
+		.cached()
+		.share_cache()
+		.build();
+
+	flecs::query<Position> q_2 = world.query_builder<Position>()
+		.cached()
+		.share_cache()
+		.build();
+
+	test_assert(ecs_query_get_cache_query(q_1) == ecs_query_get_cache_query(q_2));
+	test_assert(q_1.entity().has(flecs::Empty));
+	test_assert(q_2.entity().has(flecs::Empty));
+
+	/* Matching a table clears the tag on all queries that use the cache */
+	world.entity().set<Position>({10, 20});
+	test_assert(!q_1.entity().has(flecs::Empty));
+	test_assert(!q_2.entity().has(flecs::Empty));
+}
+
+void Query_snapshot_after_delete(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+
+	flecs::query<const Position> q = world.query_builder<const Position>()
+		.cached()
+		.build();
+
+	flecs::entity e1 = world.entity().set<Position>({10, 20});
+	world.entity().set<Position>({20, 30});
+	world.entity().set<Position>({30, 40}).add<Tag>();
+
+	const flecs::query_snapshot_t *s = q.snapshot();
+	test_int(s->count, 2);
+	test_int(s->entity_count, 3);
+
+	/* Snapshot is rebuilt in the same frame after the table count changed */
+	e1.destruct();
+	s = q.snapshot();
+	test_int(s->count, 2);
+	test_int(s->entity_count, 2);
+
+	for (int32_t i = 0; i < s->count; i ++) {
+		test_assert(s->ranges[i].count <= ecs_table_count(s->ranges[i].table));
+	}
+}
+
+/* Checks that the plan of the uncached query contains the specialized ops. */
+void TestPlan(flecs::query_builder<>& builder, std::initializer_list<const char*> expected) {
+	flecs::query<> q = builder.cache_kind(flecs::QueryCacheNone).build();
+
+	flecs::string plan = q.plan();
+	for (const char* op : expected) {
+		test_assert(strstr(plan.c_str(), op) != nullptr);
+	}
+}
+
+void Query_plan_with_after_triv(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<Velocity>().add(flecs::CanToggle);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Mass>()
+		.with<Velocity>();
+
+	TestPlan(builder, { "triv", "with", "toggle" });
+}
+
+void Query_plan_not_with(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<Velocity>().add(flecs::CanToggle);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.without<Mass>();
+
+	TestPlan(builder, { "not_w" });
+}
+
+void Query_plan_not_with_after_triv(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<Velocity>().add(flecs::CanToggle);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Mass>()
+		.without<Rotation>();
+
+	TestPlan(builder, { "triv", "not_w" });
+}
+
+void Query_plan_up_with(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<Velocity>().add(flecs::CanToggle);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Rotation>()
+		.with<Mass>().up(flecs::ChildOf);
+
+	TestPlan(builder, { "triv", "up_w" });
+}
+
+void Query_plan_toggle_and(void) {
+	flecs::world world;
+	RegisterTestTypeComponents(world);
+	world.component<Velocity>().add(flecs::CanToggle);
+
+	flecs::query_builder<> builder = world.query_builder()
+		.with<Position>()
+		.with<Velocity>();
+
+	TestPlan(builder, { "toggle_and" });
+}
+
 END_DEFINE_SPEC(FFlecsQueryTestsSpec);
 
 /*"id": "Query",
@@ -3960,7 +4680,28 @@ END_DEFINE_SPEC(FFlecsQueryTestsSpec);
                 "pair_with_variable_src_no_row_fields",
                 "iter_targets",
                 "iter_targets_2nd_field",
-                "copy_operators"
+                "copy_operators",
+                "toggle_row_mask",
+                "up_trav_cache",
+                "up_trav_cache_recycled_target",
+                "rematch_budget",
+                "rematch_budget_iter",
+                "dirty_rows",
+                "dirty_rows_w_tag_query",
+                "order_by_key",
+                "order_by_key_parallel",
+                "order_by_key_resort_mid_frame",
+                "order_by_key_multi_threaded_system",
+                "group_directory",
+                "group_entity_count",
+                "share_cache",
+                "share_cache_empty",
+                "snapshot_after_delete",
+                "plan_with_after_triv",
+                "plan_not_with",
+                "plan_not_with_after_triv",
+                "plan_up_with",
+                "plan_toggle_and"
             ]*/
 
 void FFlecsQueryTestsSpec::Define()
@@ -4093,6 +4834,27 @@ void FFlecsQueryTestsSpec::Define()
 	It("Query_iter_targets", [&]() { Query_iter_targets(); });
 	It("Query_iter_targets_2nd_field", [&]() { Query_iter_targets_2nd_field(); });
 	It("Query_copy_operators", [&]() { Query_copy_operators(); });
+	It("Query_toggle_row_mask", [&]() { Query_toggle_row_mask(); });
+	It("Query_up_trav_cache", [&]() { Query_up_trav_cache(); });
+	It("Query_up_trav_cache_recycled_target", [&]() { Query_up_trav_cache_recycled_target(); });
+	It("Query_rematch_budget", [&]() { Query_rematch_budget(); });
+	It("Query_rematch_budget_iter", [&]() { Query_rematch_budget_iter(); });
+	It("Query_dirty_rows", [&]() { Query_dirty_rows(); });
+	It("Query_dirty_rows_w_tag_query", [&]() { Query_dirty_rows_w_tag_query(); });
+	It("Query_order_by_key", [&]() { Query_order_by_key(); });
+	It("Query_order_by_key_parallel", [&]() { Query_order_by_key_parallel(); });
+	It("Query_order_by_key_resort_mid_frame", [&]() { Query_order_by_key_resort_mid_frame(); });
+	It("Query_order_by_key_multi_threaded_system", [&]() { Query_order_by_key_multi_threaded_system(); });
+	It("Query_group_directory", [&]() { Query_group_directory(); });
+	It("Query_group_entity_count", [&]() { Query_group_entity_count(); });
+	It("Query_share_cache", [&]() { Query_share_cache(); });
+	It("Query_share_cache_empty", [&]() { Query_share_cache_empty(); });
+	It("Query_snapshot_after_delete", [&]() { Query_snapshot_after_delete(); });
+	It("Query_plan_with_after_triv", [&]() { Query_plan_with_after_triv(); });
+	It("Query_plan_not_with", [&]() { Query_plan_not_with(); });
+	It("Query_plan_not_with_after_triv", [&]() { Query_plan_not_with_after_triv(); });
+	It("Query_plan_up_with", [&]() { Query_plan_up_with(); });
+	It("Query_plan_toggle_and", [&]() { Query_plan_toggle_and(); });
 }
 
 #endif // WITH_AUTOMATION_TESTS
@@ -25,7 +25,7 @@ void UFlecsSignalSubsystem::SignalEntities(FName SignalName, TConstArrayView<FFl
 	FCsvProfiler::RecordCustomStat(*SignalName.ToString(), CSV_CATEGORY_INDEX(FlecsSignalsCounters), Entities.Num(), ECsvCustomStatOp::Accumulate);
 #endif
 
-	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Raising signal [%s] to entity [%s]"), *SignalName.ToString(), *Entities[0].DebugGetDescription());
+	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Raising signal [%s] to entity [%s]"), *SignalName.ToString(), *WriteToString<128>(Entities[0]));
 	UE_CVLOG(Entities.Num() > 1, this, LogFlecsSignals, Log, TEXT("Raising signal [%s] to %d entities"), *SignalName.ToString(), Entities.Num());
 }
 
@@ -51,7 +51,7 @@ void UFlecsSignalSubsystem::DelaySignalEntities(FName SignalName, TConstArrayVie
 	check(CachedWorld);
 	DelayedSignal.TargetTimestamp = CachedWorld->GetTimeSeconds() + DelayInSeconds;
 
-	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Delay signal [%s] to entity [%s] in %.2f"), *SignalName.ToString(), *Entities[0].DebugGetDescription(), DelayInSeconds);
+	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Delay signal [%s] to entity [%s] in %.2f"), *SignalName.ToString(), *WriteToString<128>(Entities[0]), DelayInSeconds);
 	UE_CVLOG(Entities.Num() > 1, this, LogFlecsSignals, Log, TEXT("Delay signal [%s] to %d entities in %.2f"), *SignalName.ToString(), Entities.Num(), DelayInSeconds);
 }
 
@@ -70,7 +70,7 @@ void UFlecsSignalSubsystem::SignalEntitiesDeferred(FFlecsWorld& FlecsWorld, FNam
 		SignalSubsystem->SignalEntities(SignalName, InEntities);
 	});
 
-	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Raising deferred signal [%s] to entity [%s]"), *SignalName.ToString(), *Entities[0].DebugGetDescription());
+	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Raising deferred signal [%s] to entity [%s]"), *SignalName.ToString(), *WriteToString<128>(Entities[0]));
 	UE_CVLOG(Entities.Num() > 1, this, LogFlecsSignals, Log, TEXT("Raising deferred signal [%s] to %d entities"), *SignalName.ToString(), Entities.Num());
 }
 
@@ -90,7 +90,7 @@ void UFlecsSignalSubsystem::DelaySignalEntitiesDeferred(FFlecsWorld& FlecsWorld,
 		SignalSubsystem->DelaySignalEntities(SignalName, InEntities, DelayInSeconds);
 	});
 
-	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Delay deferred signal [%s] to entity [%s] in %.2f"), *SignalName.ToString(), *Entities[0].DebugGetDescription(), DelayInSeconds);
+	UE_CVLOG(Entities.Num() == 1, this, LogFlecsSignals, Log, TEXT("Delay deferred signal [%s] to entity [%s] in %.2f"), *SignalName.ToString(), *WriteToString<128>(Entities[0]), DelayInSeconds);
 	UE_CVLOG(Entities.Num() > 1, this, LogFlecsSignals, Log, TEXT("Delay deferred signal [%s] to %d entities in %.2f"), *SignalName.ToString(), Entities.Num(), DelayInSeconds);
 }
 
@@ -1,7 +1,9 @@
 ﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
 
 #include "FlecsSystem_SignalBase.h"
+#include "FlecsEntitySubsystem.h"
 #include "FlecsSignalSubsystem.h"
+#include "World/FlecsWorld.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_SignalBase)
 
@@ -10,6 +12,12 @@ UFlecsSystem_SignalBase::UFlecsSystem_SignalBase(const FObjectInitializer& Objec
 	ExecutionFlags = (int32)EFlecsSystemExecutionFlags::AllNetModes;
 }
 
+void UFlecsSystem_SignalBase::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+	EntitySubsystem = UWorld::GetSubsystem<UFlecsEntitySubsystem>(InOwner.GetWorld());
+}
+
 void UFlecsSystem_SignalBase::BuildSystem(flecs::system_builder<>& SystemBuilder)
 {
 }
@@ -35,9 +43,38 @@ void UFlecsSystem_SignalBase::Run(flecs::iter& Iterator)
 		return;
 	}
 
-	// TODO - The rest!!!
-	ensure(false);
+	// Also flags the signaled entities that are still alive in SignaledEntityAlive
+	BuildSignaledTables(SignaledEntities);
+
+	SignalNameLookup.Reset();
+	for (FEntitySignalRange& Range : ReceivedSignalRanges)
+	{
+		if (Range.bProcessed)
+		{
+			continue;
+		}
+
+		const uint64 SignalFlag = SignalNameLookup.GetOrAddSignalName(Range.SignalName);
+		ensureMsgf(SignalFlag != 0, TEXT("Max number of different signals reached for the system %s"), *GetSystemName());
+		for (int32 Index = Range.Begin; Index < Range.End; ++Index)
+		{
+			if (SignaledEntityAlive[Index])
+			{
+				SignalNameLookup.AddSignalToEntity(SignaledEntities[Index], SignalFlag);
+			}
+		}
+		Range.bProcessed = true;
+	}
 
+	if (SignaledTables.Num() > 0)
+	{
+		check(EntitySubsystem);
+		SignalEntities(EntitySubsystem->GetMutableFlecsWorld(), SignalNameLookup);
+	}
+
+	SignaledTables.Reset();
+	SignaledEntitiesByTable.Reset();
+	SignaledRowsByTable.Reset();
 	ReceivedSignalRanges.Reset();
 	SignaledEntities.Reset();
 }
@@ -76,3 +113,96 @@ void UFlecsSystem_SignalBase::SubscribeToSignal(UFlecsSignalSubsystem& SignalSub
 	RegisteredSignals.Add(SignalName);
 	SignalSubsystem.GetSignalDelegateByName(SignalName).AddUObject(this, &ThisClass::OnSignalReceived);
 }
+
+void UFlecsSystem_SignalBase::ForEachSignaledTable(TFunctionRef<void(const flecs::table& Table, TConstArrayView<FFlecsEntityView> Entities, TConstArrayView<int32> Rows)> Function) const
+{
+	for (const FSignaledTable& SignaledTable : SignaledTables)
+	{
+		const int32 Num = SignaledTable.End - SignaledTable.Begin;
+		Function(flecs::table(SignaledTable.World, SignaledTable.Table),
+			MakeArrayView(SignaledEntitiesByTable.GetData() + SignaledTable.Begin, Num),
+			MakeArrayView(SignaledRowsByTable.GetData() + SignaledTable.Begin, Num));
+	}
+}
+
+void UFlecsSystem_SignalBase::BuildSignaledTables(TConstArrayView<FFlecsEntityView> Entities)
+{
+	struct FSignaledEntity
+	{
+		flecs::table_t* Table;
+		int32 Row;
+		FFlecsEntityView Entity;
+	};
+
+	TArray<FSignaledEntity> SortedEntities;
+	SortedEntities.Reserve(Entities.Num());
+	SignaledEntityAlive.Init(false, Entities.Num());
+
+	TArray<ecs_entity_t, TInlineAllocator<256>> Ids;
+	TArray<ecs_record_t*, TInlineAllocator<256>> Records;
+	for (int32 Begin = 0; Begin < Entities.Num();)
+	{
+		// Look up the records of consecutive entities of the same world in one batch
+		flecs::world_t* const World = Entities[Begin].GetRawWorld();
+		int32 End = Begin + 1;
+		while (End < Entities.Num() && Entities[End].GetRawWorld() == World)
+		{
+			++End;
+		}
+
+		if (World)
+		{
+			Ids.Reset();
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Ids.Add(Entities[Index].GetRawId());
+			}
+
+			// Entities might have been destroyed since they were signaled, their record is null then
+			Records.SetNumUninitialized(Ids.Num(), EAllowShrinking::No);
+			ecs_record_find_n(World, Ids.GetData(), Ids.Num(), Records.GetData());
+
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const ecs_record_t* Record = Records[Index - Begin];
+				if (Record && Record->table)
+				{
+					SignaledEntityAlive[Index] = true;
+					SortedEntities.Add({ Record->table, static_cast<int32>(ECS_RECORD_TO_ROW(Record->row)), Entities[Index] });
+				}
+			}
+		}
+
+		Begin = End;
+	}
+
+	SortedEntities.Sort([](const FSignaledEntity& A, const FSignaledEntity& B)
+	{
+		return A.Table != B.Table ? A.Table < B.Table : A.Row < B.Row;
+	});
+
+	SignaledEntitiesByTable.Reset(SortedEntities.Num());
+	SignaledRowsByTable.Reset(SortedEntities.Num());
+	SignaledTables.Reset();
+	for (int32 Index = 0; Index < SortedEntities.Num(); ++Index)
+	{
+		const FSignaledEntity& SignaledEntity = SortedEntities[Index];
+		if (Index > 0 && SortedEntities[Index - 1].Table == SignaledEntity.Table && SortedEntities[Index - 1].Row == SignaledEntity.Row)
+		{
+			// Same entity signaled more than once, its signals are already merged in the lookup
+			continue;
+		}
+
+		if (SignaledTables.IsEmpty() || SignaledTables.Last().Table != SignaledEntity.Table)
+		{
+			FSignaledTable& SignaledTable = SignaledTables.AddDefaulted_GetRef();
+			SignaledTable.World = SignaledEntity.Entity.GetRawWorld();
+			SignaledTable.Table = SignaledEntity.Table;
+			SignaledTable.Begin = SignaledEntitiesByTable.Num();
+		}
+
+		SignaledEntitiesByTable.Add(SignaledEntity.Entity);
+		SignaledRowsByTable.Add(SignaledEntity.Row);
+		SignaledTables.Last().End = SignaledEntitiesByTable.Num();
+	}
+}
@@ -11,6 +11,7 @@
 
 #define UE_API FLECSSIGNALS_API
 
+class UFlecsEntitySubsystem;
 class UFlecsSignalSubsystem;
 
 /**
@@ -26,6 +27,7 @@ public:
 	UE_API UFlecsSystem_SignalBase(const FObjectInitializer& ObjectInitializer);
 
 protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
 	UE_API virtual void BuildSystem(flecs::system_builder<>& SystemBuilder) override;
 
 	UE_API virtual void Run(flecs::iter& Iterator) override;
@@ -52,7 +54,26 @@ protected:
 	 */
 	UE_API void SubscribeToSignal(UFlecsSignalSubsystem& SignalSubsystem, const FName SignalName);
 
+	/**
+	 * Visits the entities signaled this frame one table at a time, only valid during SignalEntities.
+	 * Entities are unique, alive and sorted by row within their table.
+	 * @param Function called with the table, its signaled entities and their rows in the table
+	 */
+	UE_API void ForEachSignaledTable(TFunctionRef<void(const flecs::table& Table, TConstArrayView<FFlecsEntityView> Entities, TConstArrayView<int32> Rows)> Function) const;
+
 private:
+	/** Groups the alive signaled entities per table into SignaledEntitiesByTable and flags them in SignaledEntityAlive */
+	void BuildSignaledTables(TConstArrayView<FFlecsEntityView> Entities);
+
+	/** Range of SignaledEntitiesByTable living in the same table */
+	struct FSignaledTable
+	{
+		flecs::world_t* World = nullptr;
+		flecs::table_t* Table = nullptr;
+		int32 Begin = 0;
+		int32 End = 0;
+	};
+
 	/** Stores a range of indices in the SignaledEntities TArray of Entities and the associated signal name */
 	struct FEntitySignalRange
 	{
@@ -82,6 +103,20 @@ private:
 	TArray<FName> RegisteredSignals;
 
 	FTransactionallySafeRWLock ReceivedSignalLock;
+
+	/** Signals raised for each alive entity this frame */
+	FFlecsSignalNameLookup SignalNameLookup;
+
+	/** Liveness of each entity of SignaledEntities this frame */
+	TBitArray<> SignaledEntityAlive;
+
+	/** Entities signaled this frame grouped per table, along with their rows */
+	TArray<FFlecsEntityView> SignaledEntitiesByTable;
+	TArray<int32> SignaledRowsByTable;
+	TArray<FSignaledTable> SignaledTables;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsEntitySubsystem> EntitySubsystem;
 };
 
 #undef UE_API
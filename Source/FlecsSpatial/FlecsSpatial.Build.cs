@@ -0,0 +1,27 @@
+﻿using UnrealBuildTool;
+
+public class FlecsSpatial : ModuleRules
+{
+    public FlecsSpatial(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "FlecsEntity",
+                "FlecsLibrary",
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Engine",
+                "FlecsEngine",
+            }
+        );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSpatialSubsystem.h"
+#include "FlecsSpatialTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Transform/FlecsEngineTransformComponents.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFlecsSpatial, Log, All);
+
+namespace UE::FlecsSpatial::Private
+{
+	/** Tag of the entities moved every frame, the others are static and stay in their own table */
+	struct FBenchmarkMovingTag {};
+
+	/**
+	 * Runs the spatial index in a standalone world: a share of the entities moves every frame, the index is updated from
+	 * the dirty rows and a number of radius queries are performed. Timings are averaged over the frames.
+	 */
+	void RunBenchmark(const TArray<FString>& Args)
+	{
+		const int32 NumEntities = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+		const int32 NumFrames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 60;
+		const int32 MovingPercent = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 0, 100) : 100;
+		const int32 NumQueries = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 1000;
+
+		constexpr double Extent = 100000.;
+		constexpr float CellSize = 1000.f;
+		constexpr float QueryRadius = 1500.f;
+		constexpr double MaxStep = 100.;
+
+		flecs::world World;
+		World.component<FFlecsTransformComponent>();
+		World.component<FFlecsSpatialCellComponent>();
+		World.component<FBenchmarkMovingTag>();
+
+		FRandomStream Random(NumEntities);
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			const FVector Location(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), 0.);
+			flecs::entity Entity = World.entity()
+				.set<FFlecsTransformComponent>(FFlecsTransformComponent(FTransform(Location)))
+				.add<FFlecsSpatialCellComponent>();
+			if (Index * 100 < NumEntities * MovingPercent)
+			{
+				Entity.add<FBenchmarkMovingTag>();
+			}
+		}
+
+		flecs::query<FFlecsTransformComponent> Movers = World.query_builder<FFlecsTransformComponent>()
+			.with<FBenchmarkMovingTag>()
+			.build();
+
+		flecs::query<> IndexQuery = World.query_builder()
+			.with<FFlecsTransformComponent>().in()
+			.with<FFlecsSpatialCellComponent>().out()
+			.dirty_rows()
+			.build();
+
+		FFlecsSpatialGrid Grid(CellSize);
+
+		double StartTime = FPlatformTime::Seconds();
+		IndexQuery.run([&Grid](flecs::iter& Iterator) { UFlecsSpatialSubsystem::UpdateIndex(Grid, Iterator); });
+		const double BuildTime = FPlatformTime::Seconds() - StartTime;
+
+		double MoveTime = 0.;
+		double UpdateTime = 0.;
+		double QueryTime = 0.;
+		int64 NumFound = 0;
+		TArray<flecs::entity_t> Found;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			StartTime = FPlatformTime::Seconds();
+			Movers.each([&Random](FFlecsTransformComponent& Transform)
+			{
+				FTransform& MutableTransform = Transform.GetMutableTransform();
+				MutableTransform.AddToTranslation(FVector(Random.FRandRange(-MaxStep, MaxStep), Random.FRandRange(-MaxStep, MaxStep), 0.));
+			});
+			MoveTime += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			IndexQuery.run([&Grid](flecs::iter& Iterator) { UFlecsSpatialSubsystem::UpdateIndex(Grid, Iterator); });
+			UpdateTime += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumQueries; ++Query)
+			{
+				Found.Reset();
+				Grid.QueryRadius(FVector(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), 0.), QueryRadius, Found);
+				NumFound += Found.Num();
+			}
+			QueryTime += FPlatformTime::Seconds() - StartTime;
+		}
+
+		const double FrameScale = 1000. / FMath::Max(NumFrames, 1);
+		UE_LOG(LogFlecsSpatial, Display, TEXT("Spatial index benchmark: %d entities (%d%% moving), %d cells, %d frames"),
+			Grid.Num(), MovingPercent, Grid.NumCells(), NumFrames);
+		UE_LOG(LogFlecsSpatial, Display, TEXT("  Build: %.3f ms, Move: %.3f ms/frame, Index update: %.3f ms/frame"),
+			BuildTime * 1000., MoveTime * FrameScale, UpdateTime * FrameScale);
+		UE_LOG(LogFlecsSpatial, Display, TEXT("  %d radius queries: %.3f ms/frame, %.1f entities per query"),
+			NumQueries, QueryTime * FrameScale, static_cast<double>(NumFound) / FMath::Max(NumFrames * NumQueries, 1));
+	}
+
+	FAutoConsoleCommand BenchmarkCommand(
+		TEXT("flecs.Spatial.Benchmark"),
+		TEXT("Benchmarks the spatial index. Arguments: [NumEntities=100000] [NumFrames=60] [MovingPercent=100] [NumQueries=1000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmark));
+}
@@ -0,0 +1,175 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSpatialGrid.h"
+
+namespace UE::FlecsSpatial::Private
+{
+	constexpr int32 CoordBits = 21;
+	constexpr int32 MinCoord = -(1 << (CoordBits - 1));
+	constexpr int32 MaxCoord = (1 << (CoordBits - 1)) - 1;
+	constexpr uint64 CoordMask = (1ull << CoordBits) - 1;
+}
+
+void FFlecsSpatialGrid::SetCellSize(const float InCellSize)
+{
+	checkf(NumEntities == 0, TEXT("Cell size can only be changed while the grid is empty"));
+	CellSize = FMath::Max(InCellSize, UE_KINDA_SMALL_NUMBER);
+	InvCellSize = 1.f / CellSize;
+}
+
+FIntVector FFlecsSpatialGrid::GetCellCoords(const FVector& Location) const
+{
+	using namespace UE::FlecsSpatial::Private;
+	return FIntVector(
+		FMath::Clamp(FMath::FloorToInt32(Location.X * InvCellSize), MinCoord, MaxCoord),
+		FMath::Clamp(FMath::FloorToInt32(Location.Y * InvCellSize), MinCoord, MaxCoord),
+		FMath::Clamp(FMath::FloorToInt32(Location.Z * InvCellSize), MinCoord, MaxCoord));
+}
+
+UE::FlecsSpatial::FCellKey FFlecsSpatialGrid::PackCellCoords(const FIntVector& Coords)
+{
+	using namespace UE::FlecsSpatial::Private;
+	return ((static_cast<uint64>(Coords.X) & CoordMask) << (CoordBits * 2))
+		| ((static_cast<uint64>(Coords.Y) & CoordMask) << CoordBits)
+		| (static_cast<uint64>(Coords.Z) & CoordMask);
+}
+
+FIntVector FFlecsSpatialGrid::UnpackCellCoords(const UE::FlecsSpatial::FCellKey CellKey)
+{
+	using namespace UE::FlecsSpatial::Private;
+
+	// Shift each coordinate to the top bits and back to sign extend it
+	constexpr int32 SignShift = 64 - CoordBits;
+	return FIntVector(
+		static_cast<int32>(static_cast<int64>(CellKey << (SignShift - CoordBits * 2)) >> SignShift),
+		static_cast<int32>(static_cast<int64>(CellKey << (SignShift - CoordBits)) >> SignShift),
+		static_cast<int32>(static_cast<int64>(CellKey << SignShift) >> SignShift));
+}
+
+UE::FlecsSpatial::FCellKey FFlecsSpatialGrid::GetCellKey(const FVector& Location) const
+{
+	return PackCellCoords(GetCellCoords(Location));
+}
+
+void FFlecsSpatialGrid::Update(const flecs::entity_t Entity, const FVector& Location, UE::FlecsSpatial::FCellKey& InOutCellKey,
+	int32& InOutCellIndex, UE::FlecsSpatial::FOnEntityMoved OnEntityMoved)
+{
+	const UE::FlecsSpatial::FCellKey CellKey = GetCellKey(Location);
+	if (CellKey == InOutCellKey)
+	{
+		FCell& Cell = Cells.FindChecked(CellKey);
+		checkSlow(Cell.Entities[InOutCellIndex] == Entity);
+		Cell.Locations[InOutCellIndex] = FVector3f(Location);
+		return;
+	}
+
+	if (InOutCellKey != UE::FlecsSpatial::InvalidCellKey)
+	{
+		Remove(InOutCellKey, InOutCellIndex, OnEntityMoved);
+	}
+
+	FCell& Cell = Cells.FindOrAdd(CellKey);
+	InOutCellIndex = Cell.Entities.Add(Entity);
+	Cell.Locations.Add(FVector3f(Location));
+	++NumEntities;
+
+	InOutCellKey = CellKey;
+}
+
+void FFlecsSpatialGrid::Remove(const UE::FlecsSpatial::FCellKey CellKey, const int32 CellIndex, UE::FlecsSpatial::FOnEntityMoved OnEntityMoved)
+{
+	FCell& Cell = Cells.FindChecked(CellKey);
+	check(Cell.Entities.IsValidIndex(CellIndex));
+
+	Cell.Entities.RemoveAtSwap(CellIndex, EAllowShrinking::No);
+	Cell.Locations.RemoveAtSwap(CellIndex, EAllowShrinking::No);
+	--NumEntities;
+
+	if (Cell.Entities.IsEmpty())
+	{
+		Cells.Remove(CellKey);
+	}
+	else if (CellIndex < Cell.Entities.Num())
+	{
+		OnEntityMoved(Cell.Entities[CellIndex], CellIndex);
+	}
+}
+
+void FFlecsSpatialGrid::Reset()
+{
+	Cells.Reset();
+	NumEntities = 0;
+}
+
+void FFlecsSpatialGrid::ForEachCell(const FBox& Box, TFunctionRef<void(TConstArrayView<flecs::entity_t>, TConstArrayView<FVector3f>)> Visitor) const
+{
+	if (!Box.IsValid || Cells.IsEmpty())
+	{
+		return;
+	}
+
+	const FIntVector Min = GetCellCoords(Box.Min);
+	const FIntVector Max = GetCellCoords(Box.Max);
+	const int64 NumBoxCells = static_cast<int64>(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) * (Max.Z - Min.Z + 1);
+
+	// Large boxes cover more cells than there are non-empty ones, visit the stored cells instead.
+	if (NumBoxCells > Cells.Num())
+	{
+		for (const TPair<UE::FlecsSpatial::FCellKey, FCell>& Pair : Cells)
+		{
+			const FIntVector Coords = UnpackCellCoords(Pair.Key);
+			if (Coords.X >= Min.X && Coords.X <= Max.X && Coords.Y >= Min.Y && Coords.Y <= Max.Y && Coords.Z >= Min.Z && Coords.Z <= Max.Z)
+			{
+				Visitor(Pair.Value.Entities, Pair.Value.Locations);
+			}
+		}
+		return;
+	}
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				if (const FCell* Cell = Cells.Find(PackCellCoords(FIntVector(X, Y, Z))))
+				{
+					Visitor(Cell->Entities, Cell->Locations);
+				}
+			}
+		}
+	}
+}
+
+void FFlecsSpatialGrid::QueryBox(const FBox& Box, TArray<flecs::entity_t>& OutEntities) const
+{
+	const FVector3f Min(Box.Min);
+	const FVector3f Max(Box.Max);
+	ForEachCell(Box, [&](TConstArrayView<flecs::entity_t> Entities, TConstArrayView<FVector3f> Locations)
+	{
+		for (int32 Index = 0; Index < Entities.Num(); ++Index)
+		{
+			const FVector3f& Location = Locations[Index];
+			if (Location.X >= Min.X && Location.X <= Max.X && Location.Y >= Min.Y && Location.Y <= Max.Y && Location.Z >= Min.Z && Location.Z <= Max.Z)
+			{
+				OutEntities.Add(Entities[Index]);
+			}
+		}
+	});
+}
+
+void FFlecsSpatialGrid::QueryRadius(const FVector& Center, const float Radius, TArray<flecs::entity_t>& OutEntities) const
+{
+	const FVector3f Center3f(Center);
+	const float RadiusSq = FMath::Square(Radius);
+	ForEachCell(FBox(Center - FVector(Radius), Center + FVector(Radius)), [&](TConstArrayView<flecs::entity_t> Entities, TConstArrayView<FVector3f> Locations)
+	{
+		for (int32 Index = 0; Index < Entities.Num(); ++Index)
+		{
+			if (FVector3f::DistSquared(Locations[Index], Center3f) <= RadiusSq)
+			{
+				OutEntities.Add(Entities[Index]);
+			}
+		}
+	});
+}
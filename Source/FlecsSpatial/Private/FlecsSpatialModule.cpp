@@ -0,0 +1,10 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "IFlecsSpatialModule.h"
+
+class FFlecsSpatialModule : public IFlecsSpatialModule
+{
+};
+
+IMPLEMENT_MODULE(FFlecsSpatialModule, FlecsSpatial)
@@ -0,0 +1,120 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSpatialSubsystem.h"
+
+#include "FlecsEntitySubsystem.h"
+#include "FlecsSpatialTypes.h"
+#include "Transform/FlecsEngineTransformComponents.h"
+#include "World/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSpatialSubsystem)
+
+namespace UE::FlecsSpatial::Private
+{
+	/** Keeps the cell index of an entity moved within its cell in sync, this is bookkeeping and doesn't emit OnSet */
+	void SetCellIndex(const flecs::world& World, const flecs::entity_t Entity, const int32 NewCellIndex)
+	{
+		FFlecsSpatialCellComponent* Cell = flecs::entity(World, Entity).try_get_mut<FFlecsSpatialCellComponent>();
+		check(Cell != nullptr);
+		Cell->CellIndex = NewCellIndex;
+	}
+}
+
+void UFlecsSpatialSubsystem::EachNear(const flecs::query_base& Query, const FVector& Center, const float Radius, TFunctionRef<void(flecs::entity)> Function) const
+{
+	flecs::query_t* QueryPtr = const_cast<flecs::query_t*>(Query.c_ptr());
+	flecs::world_t* World = QueryPtr->world;
+
+	TArray<flecs::entity_t> Candidates;
+	Grid.QueryRadius(Center, Radius, Candidates);
+
+	for (const flecs::entity_t Candidate : Candidates)
+	{
+		ecs_iter_t It;
+		if (ecs_query_has(QueryPtr, Candidate, &It))
+		{
+			ecs_iter_fini(&It);
+			Function(flecs::entity(World, Candidate));
+		}
+	}
+}
+
+void UFlecsSpatialSubsystem::UpdateIndex(FFlecsSpatialGrid& Grid, flecs::iter& Iterator)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FlecsSpatialUpdateIndex);
+
+	const flecs::world World = Iterator.world();
+	const auto OnEntityMoved = [&World](const flecs::entity_t Entity, const int32 NewCellIndex)
+	{
+		UE::FlecsSpatial::Private::SetCellIndex(World, Entity, NewCellIndex);
+	};
+
+	while (Iterator.next())
+	{
+		const flecs::field<const FFlecsTransformComponent> Transforms = Iterator.field<const FFlecsTransformComponent>(0);
+		const flecs::field<FFlecsSpatialCellComponent> Cells = Iterator.field<FFlecsSpatialCellComponent>(1);
+		const flecs::entity_t* Entities = Iterator.c_ptr()->entities;
+
+		for (const size_t Index : Iterator)
+		{
+			FFlecsSpatialCellComponent& Cell = Cells[Index];
+			Grid.Update(Entities[Index], Transforms[Index].GetTransform().GetLocation(), Cell.CellKey, Cell.CellIndex, OnEntityMoved);
+		}
+	}
+}
+
+void UFlecsSpatialSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UFlecsEntitySubsystem* EntitySubsystem = Collection.InitializeDependency<UFlecsEntitySubsystem>();
+	checkfSlow(EntitySubsystem != nullptr, TEXT("FlecsEntitySubsystem is required"));
+
+	Grid.Reset();
+	Grid.SetCellSize(CellSize);
+
+	const FFlecsWorld& FlecsWorld = EntitySubsystem->GetFlecsWorld();
+	FlecsWorld.Component<FFlecsSpatialIndexedTag>().add(flecs::With, FlecsWorld.Component<FFlecsSpatialCellComponent>());
+
+	// Covers both destroyed entities and entities that stop being indexed, the component is still readable on OnRemove.
+	const flecs::world& World = FlecsWorld;
+	RemoveObserver = World.observer<const FFlecsSpatialCellComponent>()
+		.event(flecs::OnRemove)
+		.each([this](flecs::iter& Iterator, size_t, const FFlecsSpatialCellComponent& Cell)
+		{
+			if (Cell.CellKey != UE::FlecsSpatial::InvalidCellKey)
+			{
+				const flecs::world World = Iterator.world();
+				Grid.Remove(Cell.CellKey, Cell.CellIndex, [&World](const flecs::entity_t Entity, const int32 NewCellIndex)
+				{
+					UE::FlecsSpatial::Private::SetCellIndex(World, Entity, NewCellIndex);
+				});
+			}
+		});
+
+	// With only applies when the tag gets added, the cell component has to be removed explicitly along with it.
+	UnindexObserver = World.observer()
+		.with<FFlecsSpatialIndexedTag>()
+		.event(flecs::OnRemove)
+		.each([](flecs::entity Entity)
+		{
+			Entity.remove<FFlecsSpatialCellComponent>();
+		});
+}
+
+void UFlecsSpatialSubsystem::Deinitialize()
+{
+	if (UnindexObserver)
+	{
+		UnindexObserver.destruct();
+	}
+
+	if (RemoveObserver)
+	{
+		RemoveObserver.destruct();
+	}
+
+	Grid.Reset();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,45 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#include "FlecsSystem_SpatialIndexUpdate.h"
+
+#include "FlecsSpatialSubsystem.h"
+#include "FlecsSpatialTypes.h"
+#include "Phases/FlecsPhase.h"
+#include "Transform/FlecsEngineTransformComponents.h"
+#include "World/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSystem_SpatialIndexUpdate)
+
+UFlecsSystem_SpatialIndexUpdate::UFlecsSystem_SpatialIndexUpdate()
+{
+	ExecutionFlags = (int32)EFlecsSystemExecutionFlags::AllNetModes;
+	// After the systems moving the entities, so that the index is up to date for the rest of the frame.
+	ExecuteInPhase = UFlecsPhase_PostUpdate::StaticClass();
+
+	// The grid is shared by all the entities.
+	bMultithreaded = false;
+}
+
+void UFlecsSystem_SpatialIndexUpdate::InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld)
+{
+	Super::InitializeInternal(InOwner, InFlecsWorld);
+	SpatialSubsystem = UWorld::GetSubsystem<UFlecsSpatialSubsystem>(InOwner.GetWorld());
+}
+
+void UFlecsSystem_SpatialIndexUpdate::BuildSystem(flecs::system_builder<>& SystemBuilder)
+{
+	Super::BuildSystem(SystemBuilder);
+
+	// The cell is written as out so that updating it doesn't make the rows dirty for this system again.
+	SystemBuilder
+		.with<FFlecsTransformComponent>().in()
+		.with<FFlecsSpatialCellComponent>().out()
+		.with<FFlecsSpatialIndexedTag>()
+		.dirty_rows();
+}
+
+void UFlecsSystem_SpatialIndexUpdate::Run(flecs::iter& Iterator)
+{
+	check(SpatialSubsystem);
+	UFlecsSpatialSubsystem::UpdateIndex(SpatialSubsystem->GetMutableGrid(), Iterator);
+}
@@ -0,0 +1,94 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "flecs.h"
+#include "Templates/Function.h"
+
+#define UE_API FLECSSPATIAL_API
+
+namespace UE::FlecsSpatial
+{
+	/** Key of a grid cell, packs the signed cell coordinates in 21 bits each */
+	using FCellKey = uint64;
+
+	/** Key of the entities that have not been indexed yet */
+	constexpr FCellKey InvalidCellKey = MAX_uint64;
+
+	/** Called when an entity got moved to another index of its cell to fill the slot of a removed one */
+	using FOnEntityMoved = TFunctionRef<void(flecs::entity_t Entity, int32 NewCellIndex)>;
+}
+
+/**
+ * Uniform grid indexing entity locations. Only non-empty cells are stored, in a map keyed by their packed coordinates.
+ * Each cell keeps its entities and their locations in parallel arrays, so a query only looks up the cells overlapping
+ * its bounds and then tests contiguous locations.
+ */
+class FFlecsSpatialGrid
+{
+public:
+	struct FCell
+	{
+		TArray<flecs::entity_t> Entities;
+		TArray<FVector3f> Locations;
+	};
+
+	explicit FFlecsSpatialGrid(const float InCellSize = 1000.f) { SetCellSize(InCellSize); }
+
+	/** Changes the size of the cells, only valid while the grid is empty */
+	UE_API void SetCellSize(const float InCellSize);
+	float GetCellSize() const { return CellSize; }
+
+	/** @return Key of the cell containing Location */
+	UE_API UE::FlecsSpatial::FCellKey GetCellKey(const FVector& Location) const;
+
+	/**
+	 * Adds the entity or updates its location, moving it to another cell if needed.
+	 * @param InOutCellKey Cell the entity is in, InvalidCellKey if it is not indexed yet. Updated to the new cell.
+	 * @param InOutCellIndex Index of the entity in its cell. Updated along with InOutCellKey.
+	 * @param OnEntityMoved Called for the entity moved into the previous slot of Entity when it changes cell
+	 */
+	UE_API void Update(const flecs::entity_t Entity, const FVector& Location, UE::FlecsSpatial::FCellKey& InOutCellKey,
+		int32& InOutCellIndex, UE::FlecsSpatial::FOnEntityMoved OnEntityMoved);
+
+	/**
+	 * Removes the entity at CellIndex of the cell, moving the last entity of the cell into its slot.
+	 * @param OnEntityMoved Called for the entity moved into CellIndex, if any
+	 */
+	UE_API void Remove(const UE::FlecsSpatial::FCellKey CellKey, const int32 CellIndex, UE::FlecsSpatial::FOnEntityMoved OnEntityMoved);
+
+	UE_API void Reset();
+
+	/** @return Number of indexed entities */
+	int32 Num() const { return NumEntities; }
+
+	/** @return Number of non-empty cells */
+	int32 NumCells() const { return Cells.Num(); }
+
+	/**
+	 * Calls Visitor with the entities and locations of every cell overlapping Box. The spans are only valid during the
+	 * call and may contain entities outside of Box.
+	 */
+	UE_API void ForEachCell(const FBox& Box, TFunctionRef<void(TConstArrayView<flecs::entity_t>, TConstArrayView<FVector3f>)> Visitor) const;
+
+	/** Appends the entities located inside Box */
+	UE_API void QueryBox(const FBox& Box, TArray<flecs::entity_t>& OutEntities) const;
+
+	/** Appends the entities within Radius of Center */
+	UE_API void QueryRadius(const FVector& Center, const float Radius, TArray<flecs::entity_t>& OutEntities) const;
+
+private:
+	FIntVector GetCellCoords(const FVector& Location) const;
+	static UE::FlecsSpatial::FCellKey PackCellCoords(const FIntVector& Coords);
+	static FIntVector UnpackCellCoords(const UE::FlecsSpatial::FCellKey CellKey);
+
+	TMap<UE::FlecsSpatial::FCellKey, FCell> Cells;
+
+	float CellSize = 1000.f;
+	float InvCellSize = 1.f / 1000.f;
+
+	int32 NumEntities = 0;
+};
+
+#undef UE_API
@@ -0,0 +1,64 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "flecs.h"
+#include "FlecsSpatialGrid.h"
+#include "FlecsSubsystemBase.h"
+
+#include "FlecsSpatialSubsystem.generated.h"
+
+#define UE_API FLECSSPATIAL_API
+
+/**
+ * Subsystem owning the spatial index of the entities tagged with FFlecsSpatialIndexedTag. The index is a uniform grid
+ * kept up to date by UFlecsSystem_SpatialIndexUpdate, which only visits the entities whose transform changed, and
+ * entities are dropped from it as soon as they get destroyed or lose the tag.
+ */
+UCLASS(MinimalAPI)
+class UFlecsSpatialSubsystem : public UFlecsSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	const FFlecsSpatialGrid& GetGrid() const { return Grid; }
+	FFlecsSpatialGrid& GetMutableGrid() { return Grid; }
+
+	/** Appends the indexed entities within Radius of Center */
+	void QueryRadius(const FVector& Center, const float Radius, TArray<flecs::entity_t>& OutEntities) const { Grid.QueryRadius(Center, Radius, OutEntities); }
+
+	/** Appends the indexed entities inside Box */
+	void QueryBox(const FBox& Box, TArray<flecs::entity_t>& OutEntities) const { Grid.QueryBox(Box, OutEntities); }
+
+	/**
+	 * Calls Function for the entities matching Query that are within Radius of Center. The spatial index provides the
+	 * candidates, which are then matched against the query, so only the entities near Center are ever visited.
+	 */
+	UE_API void EachNear(const flecs::query_base& Query, const FVector& Center, const float Radius, TFunctionRef<void(flecs::entity)> Function) const;
+
+	/**
+	 * Updates Grid from a query whose fields are a FFlecsTransformComponent (in) and a FFlecsSpatialCellComponent
+	 * (out). Meant for queries built with dirty_rows(), so that only the rows whose transform changed get visited.
+	 */
+	static UE_API void UpdateIndex(FFlecsSpatialGrid& Grid, flecs::iter& Iterator);
+
+protected:
+	// USubsystem implementation Begin
+	UE_API virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	UE_API virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	/** Size of the grid cells, ideally around the radius of the most common queries */
+	UPROPERTY(EditDefaultsOnly, Category="Spatial", Config, meta=(ClampMin="1.0", UIMin="1.0"))
+	float CellSize = 1000.f;
+
+	FFlecsSpatialGrid Grid;
+
+	/** Removes the entities from the grid when they lose their FFlecsSpatialCellComponent */
+	flecs::observer RemoveObserver;
+
+	/** Removes the FFlecsSpatialCellComponent added along with FFlecsSpatialIndexedTag when the tag gets removed */
+	flecs::observer UnindexObserver;
+};
+
+#undef UE_API
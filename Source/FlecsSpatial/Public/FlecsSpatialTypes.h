@@ -0,0 +1,33 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "FlecsEntityElementTypes.h"
+#include "FlecsSpatialGrid.h"
+
+#include "FlecsSpatialTypes.generated.h"
+
+/**
+ * Entities with this tag and a FFlecsTransformComponent are kept in the spatial index of UFlecsSpatialSubsystem.
+ * Adding it also adds a FFlecsSpatialCellComponent, and removing it removes the component again.
+ */
+USTRUCT()
+struct FFlecsSpatialIndexedTag : public FFlecsTag
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Cell of the spatial index the entity is in, maintained by UFlecsSystem_SpatialIndexUpdate
+ */
+USTRUCT()
+struct FFlecsSpatialCellComponent : public FFlecsComponent
+{
+	GENERATED_BODY()
+
+	/** Key of the grid cell, InvalidCellKey until the entity got indexed */
+	UE::FlecsSpatial::FCellKey CellKey = UE::FlecsSpatial::InvalidCellKey;
+
+	/** Index of the entity in the arrays of its cell, kept up to date when other entities leave the cell */
+	int32 CellIndex = INDEX_NONE;
+};
@@ -0,0 +1,34 @@
+﻿// Copyright Hitbox Games, LLC. All Rights Reserved.
+
+#pragma once
+
+#include "Systems/FlecsSystem.h"
+
+#include "FlecsSystem_SpatialIndexUpdate.generated.h"
+
+#define UE_API FLECSSPATIAL_API
+
+class UFlecsSpatialSubsystem;
+
+/**
+ * System keeping the spatial index of UFlecsSpatialSubsystem up to date. Its query iterates dirty rows only, so the
+ * entities whose FFlecsTransformComponent didn't change since the last run are skipped without being visited.
+ */
+UCLASS(MinimalAPI)
+class UFlecsSystem_SpatialIndexUpdate : public UFlecsSystem
+{
+	GENERATED_BODY()
+
+public:
+	UE_API UFlecsSystem_SpatialIndexUpdate();
+
+protected:
+	UE_API virtual void InitializeInternal(UObject& InOwner, const FFlecsWorld& InFlecsWorld) override;
+	UE_API virtual void BuildSystem(flecs::system_builder<>& SystemBuilder) override;
+	UE_API virtual void Run(flecs::iter& Iterator) override;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFlecsSpatialSubsystem> SpatialSubsystem;
+};
+
+#undef UE_API